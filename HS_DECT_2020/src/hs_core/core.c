@@ -11,6 +11,8 @@
 #include <zephyr/drivers/hwinfo.h>
 #include "core.h"
 #include "perf.h"
+#include "rtt.h"
+#include "scheduller.h"
 #include "fping.h"
 #include "ping.h"
 LOG_MODULE_REGISTER(app);
@@ -23,22 +25,12 @@ static bool exit;
 static uint16_t device_id;
 static uint64_t modem_time;
 
-static bool mac_rtt_enabled = false;
-static uint64_t mac_last_tx_time_us = 0;
-static uint32_t mac_last_tx_cyc;     // cycle counter at TX time
-
-
-static bool mac_rtt_waiting_tx_time;
-static int64_t mac_last_tx_modem_time_us;
-
 static int    hs_carrier       = 1677;   /* default */
 static int    hs_band_group    = 0;      /* what you print now */
 static int    hs_mcs           = 1;
 static int    hs_tx_power      = 13;
 static uint32_t hs_network_id  = CONFIG_NETWORK_ID;
 static uint16_t hs_device_id   = 0;      /* set after hwinfo_get_device_id() */
-static uint8_t last_rx_buf[2048];
-static size_t  last_rx_len;
 
 /* ================= FILE TRANSFER (PING EXTENSION) ================= */
 
@@ -54,95 +46,605 @@ void dect_unlock(void)
     atomic_clear(&dect_busy);
 }
 
-/*Helpers */
+/* Header type 1, due to endianness the order is different than in the specification. */
+struct phy_ctrl_field_common {
+	uint32_t packet_length : 4;
+	uint32_t packet_length_type : 1;
+	uint32_t header_format : 3;
+	uint32_t short_network_id : 8;
+	uint32_t transmitter_id_hi : 8;
+	uint32_t transmitter_id_lo : 8;
+	uint32_t df_mcs : 3;
+	uint32_t reserved : 1;
+	uint32_t transmit_power : 4;
+	uint32_t pad : 24;
+};
+
+
 
-void mac_rtt_set_enabled(bool enable)
+
+/* Semaphore to synchronize modem calls. */
+K_SEM_DEFINE(operation_sem, 0, 1);
+
+K_SEM_DEFINE(deinit_sem, 0, 1);
+
+/* ============================================================
+ *               MODEM TIME
+ * ============================================================ */
+static struct k_spinlock modem_time_lock;
+static uint64_t modem_time_ref;        /* modem time of the latest event */
+static int64_t  modem_time_ref_ticks;  /* k_uptime_ticks() at that event */
+
+static void modem_time_ref_update(uint64_t time)
 {
-    mac_rtt_enabled = enable;
-    mac_rtt_waiting_tx_time = false;
+    k_spinlock_key_t key = k_spin_lock(&modem_time_lock);
+
+    if (time > modem_time_ref) {
+        modem_time_ref = time;
+        modem_time_ref_ticks = k_uptime_ticks();
+    }
+    k_spin_unlock(&modem_time_lock, key);
 }
 
-/* Called from ping.c right before transmit() just to “arm” RTT measurement */
-void mac_rtt_mark_tx(void)
+uint64_t hs_core_modem_time_now(void)
 {
-    if (!mac_rtt_enabled) {
-        return;
+    k_spinlock_key_t key = k_spin_lock(&modem_time_lock);
+    uint64_t elapsed_us = k_ticks_to_us_floor64(k_uptime_ticks() - modem_time_ref_ticks);
+    uint64_t now = modem_time_ref + HS_US_TO_MODEM_TICKS(elapsed_us);
+
+    k_spin_unlock(&modem_time_lock, key);
+    return now;
+}
+
+/* Transport block sizes in bits for packet lengths given in subslots (index:
+ * packet_length field, i.e. subslots - 1), mu = 1, one spatial stream.
+ * ETSI TS 103 636-3 section 5.3.
+ */
+#define HS_TBS_PACKET_LENGTHS 16
+#define HS_TBS_UNSUPPORTED    -1
+
+static const int16_t hs_tbs_bits[HS_MCS_MAX + 1][HS_TBS_PACKET_LENGTHS] = {
+    /* MCS-0 */
+    { 0, 136, 264, 400, 536, 664, 792, 920, 1064, 1192, 1320, 1448, 1576, 1704, 1864, 1992 },
+    /* MCS-1 */
+    { 32, 296, 552, 824, 1096, 1352, 1608, 1864, 2104, 2360, 2616, 2872, 3128, 3384, 3704, 3960 },
+    /* MCS-2 */
+    { 56, 456, 856, 1256, 1640, 2024, 2360, 2744, 3192, 3576, 3960, 4320, 4768, 5152, 5536, -1 },
+    /* MCS-3 */
+    { 88, 616, 1128, 1672, 2168, 2680, 3192, 3704, 4256, 4768, 5280, -1, -1, -1, -1, -1 },
+    /* MCS-4 */
+    { 144, 936, 1736, 2488, 3256, 4024, 4832, 5600, -1, -1, -1, -1, -1, -1, -1, -1 },
+};
+
+static int hs_tbs_bytes(int mcs, int packet_length)
+{
+    if (mcs < HS_MCS_MIN || mcs > HS_MCS_MAX ||
+        packet_length < 0 || packet_length >= HS_TBS_PACKET_LENGTHS) {
+        return -EINVAL;
+    }
+    if (hs_tbs_bits[mcs][packet_length] == HS_TBS_UNSUPPORTED) {
+        return -EINVAL;
+    }
+    return hs_tbs_bits[mcs][packet_length] / 8;
+}
+
+/* Minimal packet_length (subslots - 1) whose transport block fits data_len bytes.
+ * Lengths are given in subslots: at mu = 1 a slot length is two subslots,
+ * i.e. slot lengths of the table are the odd subslot ones.
+ */
+static int hs_tx_packet_length(int mcs, size_t data_len)
+{
+    for (int len = 0; len < HS_TBS_PACKET_LENGTHS; len++) {
+        int bytes = hs_tbs_bytes(mcs, len);
+
+        if (bytes < 0) {
+            break;
+        }
+        if ((size_t)bytes >= data_len) {
+            return len;
+        }
+    }
+    return -EMSGSIZE;
+}
+
+size_t hs_core_tx_payload_max_get(void)
+{
+    int max = 0;
+
+    for (int len = 0; len < HS_TBS_PACKET_LENGTHS; len++) {
+        int bytes = hs_tbs_bytes(hs_mcs, len);
+
+        if (bytes < 0) {
+            break;
+        }
+        max = bytes;
     }
-    mac_rtt_waiting_tx_time = true;
+    return (size_t)max;
 }
 
-/* Call this from the TX DONE / TX COMPLETE callback (modem event) */
-static void mac_rtt_on_tx_done_modem_time(int64_t tx_time_us)
+static uint64_t hs_tx_duration(int mcs, size_t data_len)
 {
-    if (!mac_rtt_enabled) {
+    int len = hs_tx_packet_length(mcs, data_len);
+
+    if (len < 0) {
+        len = HS_TBS_PACKET_LENGTHS - 1;
+    }
+    return (uint64_t)(len + 1) * HS_SUBSLOT_MDM_TICKS;
+}
+
+uint64_t hs_core_tx_duration_get(size_t data_len)
+{
+    return hs_tx_duration(hs_mcs, data_len);
+}
+
+/* ============================================================
+ *               IN-FLIGHT OPERATIONS
+ * ============================================================ */
+struct hs_core_op {
+    bool        used;
+    uint32_t    handle;
+    struct hs_core_op_cb cb;
+    bool        tx;
+    uint64_t    tx_start_time;  /* HS_CORE_START_NOW if not known at queuing */
+    size_t      tx_len;
+
+    /* Radio parameters taken at alloc, consistent with hs_core_apply_radio() */
+    uint16_t    carrier;
+    uint8_t     mcs;
+    int8_t      tx_power;
+    bool        reconf_canceled;
+
+    /* Future: completion is collected with hs_core_op_wait() */
+    struct k_sem done_sem;
+    bool        completed;
+    bool        abandoned;      /* Waiter timed out: freed on completion */
+    int         err;
+};
+
+static struct hs_core_op hs_ops[HS_CORE_OP_INFLIGHT_MAX];
+static struct k_spinlock hs_ops_lock;
+
+static void session_ttfp_check(void);
+
+/* hs_ops_lock held */
+static struct hs_core_op *op_find(uint32_t handle)
+{
+    for (int i = 0; i < HS_CORE_OP_INFLIGHT_MAX; i++) {
+        if (hs_ops[i].used && hs_ops[i].handle == handle) {
+            return &hs_ops[i];
+        }
+    }
+    return NULL;
+}
+
+static int op_alloc(uint32_t handle, const struct hs_core_op_cb *cb,
+                    struct hs_core_op **op_out)
+{
+    k_spinlock_key_t key = k_spin_lock(&hs_ops_lock);
+    struct hs_core_op *op = NULL;
+
+    if (op_find(handle)) {
+        k_spin_unlock(&hs_ops_lock, key);
+        return -EALREADY;
+    }
+    for (int i = 0; i < HS_CORE_OP_INFLIGHT_MAX; i++) {
+        if (!hs_ops[i].used) {
+            op = &hs_ops[i];
+            break;
+        }
+    }
+    if (!op) {
+        k_spin_unlock(&hs_ops_lock, key);
+        return -EBUSY;
+    }
+    op->used = true;
+    op->handle = handle;
+    if (cb) {
+        op->cb = *cb;
+    } else {
+        memset(&op->cb, 0, sizeof(op->cb));
+    }
+    op->tx = false;
+    op->tx_start_time = HS_CORE_START_NOW;
+    op->tx_len = 0;
+    op->carrier = hs_carrier;
+    op->mcs = hs_mcs;
+    op->tx_power = hs_tx_power;
+    op->reconf_canceled = false;
+    op->completed = false;
+    op->abandoned = false;
+    op->err = NRF_MODEM_DECT_PHY_SUCCESS;
+    k_sem_init(&op->done_sem, 0, 1);
+    k_spin_unlock(&hs_ops_lock, key);
+
+    *op_out = op;
+    return 0;
+}
+
+static void op_free(struct hs_core_op *op)
+{
+    k_spinlock_key_t key = k_spin_lock(&hs_ops_lock);
+
+    op->used = false;
+    k_spin_unlock(&hs_ops_lock, key);
+}
+
+static void op_completed(uint32_t handle, int err, uint64_t time)
+{
+    k_spinlock_key_t key = k_spin_lock(&hs_ops_lock);
+    struct hs_core_op *op = op_find(handle);
+    struct hs_core_op_cb cb;
+    uint64_t tx_start_time = 0;
+    bool tx_done;
+
+    if (!op) {
+        k_spin_unlock(&hs_ops_lock, key);
+        LOG_DBG("Completion of unknown handle %u", handle);
         return;
     }
-    if (!mac_rtt_waiting_tx_time) {
-        return; /* ignore other TXs */
+    tx_done = op->tx && err == NRF_MODEM_DECT_PHY_SUCCESS;
+    if (tx_done) {
+        /* Scheduled start, or back from completion by the air time with
+         * the MCS it was sent with
+         */
+        tx_start_time = op->tx_start_time;
+        if (tx_start_time == HS_CORE_START_NOW) {
+            tx_start_time = time - MIN(time, hs_tx_duration(op->mcs, op->tx_len));
+        }
     }
+    if (!op->cb.done) {
+        /* Future: freed by the waiter, or here if the waiter gave up */
+        op->err = err;
+        op->completed = true;
+        if (op->abandoned) {
+            op->used = false;
+        } else {
+            k_sem_give(&op->done_sem);
+        }
+        k_spin_unlock(&hs_ops_lock, key);
+        if (tx_done) {
+            hs_rtt_on_tx_done(handle, tx_start_time);
+            session_ttfp_check();
+        }
+        return;
+    }
+    cb = op->cb;
+    op->used = false;
+    k_spin_unlock(&hs_ops_lock, key);
+
+    if (tx_done) {
+        hs_rtt_on_tx_done(handle, tx_start_time);
+        session_ttfp_check();
+    }
+    cb.done(handle, err, time, cb.user_data);
+}
 
-    mac_last_tx_modem_time_us = tx_time_us;
-    mac_rtt_waiting_tx_time = false;
+/* All in flight are over with the session */
+static void ops_abort(void)
+{
+    for (int i = 0; i < HS_CORE_OP_INFLIGHT_MAX; i++) {
+        if (hs_ops[i].used) {
+            op_completed(hs_ops[i].handle, NRF_MODEM_DECT_PHY_ERR_OP_CANCELED,
+                         modem_time);
+        }
+    }
 }
 
-/* Call this when you receive PONG in on_pdc() */
-static void mac_rtt_on_pong_rx_modem_time(int64_t rx_time_us)
+int hs_core_op_wait(uint32_t handle, k_timeout_t timeout)
 {
-    if (!mac_rtt_enabled) {
+    k_spinlock_key_t key = k_spin_lock(&hs_ops_lock);
+    struct hs_core_op *op = op_find(handle);
+    int err;
+
+    if (!op || op->cb.done || op->abandoned) {
+        k_spin_unlock(&hs_ops_lock, key);
+        return -EINVAL;
+    }
+    k_spin_unlock(&hs_ops_lock, key);
+
+    if (k_sem_take(&op->done_sem, timeout)) {
+        if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+            /* Polling: still ours */
+            return -EAGAIN;
+        }
+        key = k_spin_lock(&hs_ops_lock);
+        if (!op->completed) {
+            /* Nobody waits for it anymore: cancel and let completion free it */
+            op->abandoned = true;
+            k_spin_unlock(&hs_ops_lock, key);
+            (void)nrf_modem_dect_phy_cancel(handle);
+            return -ETIMEDOUT;
+        }
+        k_spin_unlock(&hs_ops_lock, key);
+        /* Completed just after the timeout */
+        k_sem_take(&op->done_sem, K_NO_WAIT);
+    }
+    err = op->err;
+    op_free(op);
+    return err;
+}
+
+int hs_core_op_cancel(uint32_t handle)
+{
+    return nrf_modem_dect_phy_cancel(handle);
+}
+
+/* ============================================================
+ *               RX RING
+ * ============================================================ */
+BUILD_ASSERT((HS_CORE_RX_RING_SIZE & (HS_CORE_RX_RING_SIZE - 1)) == 0,
+             "HS_CORE_RX_RING_SIZE must be a power of 2");
+
+/* head: written by producer only, tail: by consumer only. Free running, the
+ * difference is the fill level.
+ */
+static struct {
+    atomic_t head;
+    atomic_t tail;
+    struct hs_core_rx_frame frames[HS_CORE_RX_RING_SIZE];
+} rx_ring;
+
+static struct {
+    atomic_t frames;
+    atomic_t overflows;
+    atomic_t truncated;
+    atomic_t max_used;
+} rx_ring_stats;
+
+static K_SEM_DEFINE(rx_ring_sem, 0, 1);
+
+/* Producer: modem callback context */
+static void rx_ring_push(const struct nrf_modem_dect_phy_pdc_event *evt, uint64_t time)
+{
+    uint32_t head = (uint32_t)atomic_get(&rx_ring.head);
+    uint32_t used = head - (uint32_t)atomic_get(&rx_ring.tail);
+    struct hs_core_rx_frame *frame;
+    size_t len = evt->len;
+
+    if (used >= HS_CORE_RX_RING_SIZE) {
+        atomic_inc(&rx_ring_stats.overflows);
         return;
     }
 
-    int64_t rtt_us = rx_time_us - mac_last_tx_modem_time_us;
+    frame = &rx_ring.frames[head & (HS_CORE_RX_RING_SIZE - 1)];
+    if (len > HS_CORE_RX_FRAME_DATA_MAX) {
+        len = HS_CORE_RX_FRAME_DATA_MAX;
+        atomic_inc(&rx_ring_stats.truncated);
+    }
+    frame->time = time;
+    frame->handle = evt->handle;
+    frame->rssi_2 = evt->rssi_2;
+    frame->snr = evt->snr;
+    frame->len = (uint16_t)len;
+    memcpy(frame->data, evt->data, len);
+
+    /* Publish */
+    atomic_set(&rx_ring.head, (atomic_val_t)(head + 1));
+
+    atomic_inc(&rx_ring_stats.frames);
+    if (used + 1 > (uint32_t)atomic_get(&rx_ring_stats.max_used)) {
+        atomic_set(&rx_ring_stats.max_used, (atomic_val_t)(used + 1));
+    }
+    k_sem_give(&rx_ring_sem);
+}
+
+static uint32_t rx_ring_used(void)
+{
+    return (uint32_t)atomic_get(&rx_ring.head) - (uint32_t)atomic_get(&rx_ring.tail);
+}
+
+uint32_t hs_core_rx_ring_wait(k_timeout_t timeout)
+{
+    uint32_t used = rx_ring_used();
 
-    LOG_INF("MAC RTT (client only): %lld us (%lld ms)",
-            rtt_us, rtt_us / 1000);
+    if (used == 0 && k_sem_take(&rx_ring_sem, timeout) == 0) {
+        used = rx_ring_used();
+    }
+    return used;
 }
 
+const struct hs_core_rx_frame *hs_core_rx_ring_frame_get(uint32_t idx)
+{
+    uint32_t tail = (uint32_t)atomic_get(&rx_ring.tail);
 
-void mac_rtt_on_rx(void)
+    if (idx >= rx_ring_used()) {
+        return NULL;
+    }
+    return &rx_ring.frames[(tail + idx) & (HS_CORE_RX_RING_SIZE - 1)];
+}
+
+void hs_core_rx_ring_release(uint32_t count)
 {
-    if (!mac_rtt_enabled) {
+    uint32_t used = rx_ring_used();
+
+    if (count > used) {
+        count = used;
+    }
+    atomic_add(&rx_ring.tail, (atomic_val_t)count);
+}
+
+void hs_core_rx_ring_flush(void)
+{
+    hs_core_rx_ring_release(rx_ring_used());
+    k_sem_reset(&rx_ring_sem);
+}
+
+void hs_core_rx_ring_stats_get(struct hs_core_rx_ring_stats *out)
+{
+    out->frames = (uint32_t)atomic_get(&rx_ring_stats.frames);
+    out->overflows = (uint32_t)atomic_get(&rx_ring_stats.overflows);
+    out->truncated = (uint32_t)atomic_get(&rx_ring_stats.truncated);
+    out->max_used = (uint32_t)atomic_get(&rx_ring_stats.max_used);
+}
+
+void hs_core_rx_ring_stats_reset(void)
+{
+    atomic_clear(&rx_ring_stats.frames);
+    atomic_clear(&rx_ring_stats.overflows);
+    atomic_clear(&rx_ring_stats.truncated);
+    atomic_clear(&rx_ring_stats.max_used);
+}
+
+/* ============================================================
+ *               MAC MESSAGES
+ * ============================================================ */
+static struct {
+    hs_msg_handler_t handler;
+    void            *user_data;
+} msg_handlers[HS_MSG_TYPE_COUNT];
+static struct k_spinlock msg_handlers_lock;
+
+int hs_msg_handler_register(uint8_t type, hs_msg_handler_t handler, void *user_data)
+{
+    k_spinlock_key_t key;
+    int err = 0;
+
+    if (type == 0 || type >= HS_MSG_TYPE_COUNT || !handler) {
+        return -EINVAL;
+    }
+    key = k_spin_lock(&msg_handlers_lock);
+    if (msg_handlers[type].handler) {
+        err = -EALREADY;
+    } else {
+        msg_handlers[type].handler = handler;
+        msg_handlers[type].user_data = user_data;
+    }
+    k_spin_unlock(&msg_handlers_lock, key);
+    return err;
+}
+
+void hs_msg_handler_unregister(uint8_t type)
+{
+    k_spinlock_key_t key;
+
+    if (type == 0 || type >= HS_MSG_TYPE_COUNT) {
         return;
     }
+    key = k_spin_lock(&msg_handlers_lock);
+    msg_handlers[type].handler = NULL;
+    msg_handlers[type].user_data = NULL;
+    k_spin_unlock(&msg_handlers_lock, key);
+}
 
-    /* Read RX timestamp */
-    uint32_t now_cyc  = k_cycle_get_32();
+int hs_msg_build(void *buf, size_t buf_size, uint8_t type, uint8_t flags, uint32_t seq,
+                 uint64_t tx_time, const void *payload, size_t payload_len)
+{
+    struct hs_msg_hdr hdr = {
+        .type = type,
+        .flags = flags,
+        .seq = seq,
+        .timestamp = (uint32_t)(tx_time != HS_CORE_START_NOW ? tx_time :
+                                hs_core_modem_time_now()),
+    };
 
-    /*
-     * Compute delta in cycles.
-     * Unsigned subtraction handles cycle wrap-around automatically.
-     */
-    uint32_t diff_cyc = now_cyc - mac_last_tx_cyc;
+    if (buf_size < sizeof(hdr) + payload_len) {
+        return -EMSGSIZE;
+    }
+    memcpy(buf, &hdr, sizeof(hdr));
+    if (payload_len) {
+        memcpy((uint8_t *)buf + sizeof(hdr), payload, payload_len);
+    }
+    return (int)(sizeof(hdr) + payload_len);
+}
+
+/* Handler of a PDC carrying a MAC message header, false if none */
+static bool msg_dispatch(const struct nrf_modem_dect_phy_pdc_event *evt, uint64_t time)
+{
+    const struct hs_msg_hdr *hdr = (const struct hs_msg_hdr *)evt->data;
+    hs_msg_handler_t handler = NULL;
+    void *user_data = NULL;
+    k_spinlock_key_t key;
 
-    /* Convert delta cycles → microseconds */
-    uint32_t diff_us  = k_cyc_to_us_near32(diff_cyc);
+    if (evt->len < sizeof(*hdr) || hdr->type == 0 || hdr->type >= HS_MSG_TYPE_COUNT) {
+        return false;
+    }
+    key = k_spin_lock(&msg_handlers_lock);
+    handler = msg_handlers[hdr->type].handler;
+    user_data = msg_handlers[hdr->type].user_data;
+    k_spin_unlock(&msg_handlers_lock, key);
 
-    LOG_INF("MAC RTT (client only): %u us (%u ms)",
-            diff_us, diff_us / 1000);
+    if (!handler) {
+        return false;
+    }
+    handler(evt->handle, hdr, (const uint8_t *)evt->data + sizeof(*hdr),
+            evt->len - sizeof(*hdr), time, user_data);
+    return true;
 }
 
-/* Header type 1, due to endianness the order is different than in the specification. */
-struct phy_ctrl_field_common {
-	uint32_t packet_length : 4;
-	uint32_t packet_length_type : 1;
-	uint32_t header_format : 3;
-	uint32_t short_network_id : 8;
-	uint32_t transmitter_id_hi : 8;
-	uint32_t transmitter_id_lo : 8;
-	uint32_t df_mcs : 3;
-	uint32_t reserved : 1;
-	uint32_t transmit_power : 4;
-	uint32_t pad : 24;
-};
+/* ============================================================
+ *               RX LOGGING AND CPU TIME
+ * ============================================================ */
+static atomic_t rx_log_enabled;
+static int64_t  rx_log_window_ms;
+static uint32_t rx_log_count;
+static uint32_t rx_log_suppressed;
 
+void hs_core_rx_log_set(bool enable)
+{
+    atomic_set(&rx_log_enabled, enable ? 1 : 0);
+}
 
+/* Modem callback context only */
+static void rx_log(const struct nrf_modem_dect_phy_pdc_event *evt)
+{
+    int64_t now_ms = k_uptime_get();
 
+    if (now_ms - rx_log_window_ms >= MSEC_PER_SEC) {
+        if (rx_log_suppressed) {
+            LOG_INF("RX log: %u frames not logged", rx_log_suppressed);
+        }
+        rx_log_window_ms = now_ms;
+        rx_log_count = 0;
+        rx_log_suppressed = 0;
+    }
+    if (rx_log_count >= HS_CORE_RX_LOG_PER_S) {
+        rx_log_suppressed++;
+        return;
+    }
+    rx_log_count++;
 
-/* Semaphore to synchronize modem calls. */
-K_SEM_DEFINE(operation_sem, 0, 1);
+    LOG_INF("PDC handle %u len %u rssi %d.%d dBm", evt->handle, evt->len,
+            evt->rssi_2 / 2, evt->rssi_2 & 1 ? 5 : 0);
+    LOG_HEXDUMP_INF(evt->data, MIN(evt->len, 32), "payload:");
+}
 
-K_SEM_DEFINE(deinit_sem, 0, 1);
-static size_t last_rx_len;
+static struct k_spinlock rx_cpu_lock;
+static uint32_t rx_cpu_frames;
+static uint64_t rx_cpu_cyc_sum;
+static uint32_t rx_cpu_cyc_max;
+
+static void rx_cpu_account(uint32_t cyc)
+{
+    k_spinlock_key_t key = k_spin_lock(&rx_cpu_lock);
+
+    rx_cpu_frames++;
+    rx_cpu_cyc_sum += cyc;
+    if (cyc > rx_cpu_cyc_max) {
+        rx_cpu_cyc_max = cyc;
+    }
+    k_spin_unlock(&rx_cpu_lock, key);
+}
+
+void hs_core_rx_cpu_stats_get(struct hs_core_rx_cpu_stats *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&rx_cpu_lock);
+
+    out->frames = rx_cpu_frames;
+    out->avg_ns = rx_cpu_frames ?
+                  (uint32_t)k_cyc_to_ns_floor64(rx_cpu_cyc_sum / rx_cpu_frames) : 0;
+    out->max_ns = (uint32_t)k_cyc_to_ns_floor64(rx_cpu_cyc_max);
+    k_spin_unlock(&rx_cpu_lock, key);
+}
+
+void hs_core_rx_cpu_stats_reset(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&rx_cpu_lock);
+
+    rx_cpu_frames = 0;
+    rx_cpu_cyc_sum = 0;
+    rx_cpu_cyc_max = 0;
+    k_spin_unlock(&rx_cpu_lock, key);
+}
 
 /* Callback after init operation. */
 static void on_init(const struct nrf_modem_dect_phy_init_event *evt)
@@ -235,25 +737,39 @@ static void on_latency_info_get(const struct nrf_modem_dect_phy_latency_info_eve
 static void on_time_get(const struct nrf_modem_dect_phy_time_get_event *evt)
 {
 	LOG_DBG("time_get cb time %"PRIu64" status %d", modem_time, evt->err);
+	if (evt->err == NRF_MODEM_DECT_PHY_SUCCESS) {
+		/* Frame timing of the slot scheduler */
+		hs_sched_sync(modem_time);
+	}
+	k_sem_give(&operation_sem);
 }
 
+/* Canceled operation itself completes with NRF_MODEM_DECT_PHY_ERR_OP_CANCELED */
 static void on_cancel(const struct nrf_modem_dect_phy_cancel_event *evt)
 {
 	LOG_DBG("on_cancel cb status %d", evt->err);
-	k_sem_give(&operation_sem);
 }
 
 /* Operation complete notification. */
 static void on_op_complete(const struct nrf_modem_dect_phy_op_complete_event *evt)
 {
 	LOG_DBG("op_complete cb time %"PRIu64" status %d", modem_time, evt->err);
-	k_sem_give(&operation_sem);
+	op_completed(evt->handle, evt->err, modem_time);
 }
 
+/* STF start of the latest PCC: the receive time given for its PDC */
+static uint64_t pcc_stf_start_time;
+static uint16_t pcc_transaction_id;
+static bool pcc_valid;
+
 /* Physical Control Channel reception notification. */
 static void on_pcc(const struct nrf_modem_dect_phy_pcc_event *evt)
 {
-	LOG_INF("Received header from device ID %d",
+	pcc_stf_start_time = evt->stf_start_time;
+	pcc_transaction_id = evt->transaction_id;
+	pcc_valid = true;
+
+	LOG_DBG("Received header from device ID %d",
 		evt->hdr.hdr_type_1.transmitter_id_hi << 8 | evt->hdr.hdr_type_1.transmitter_id_lo);
 }
 
@@ -266,38 +782,41 @@ static void on_pcc_crc_err(const struct nrf_modem_dect_phy_pcc_crc_failure_event
 /* Physical Data Channel reception notification. */
 static void on_pdc(const struct nrf_modem_dect_phy_pdc_event *evt)
 {
-    const char *payload = (const char *)evt->data;
+    uint32_t start_cyc = k_cycle_get_32();
+
+    if (atomic_get(&rx_log_enabled)) {
+        rx_log(evt);
+    }
 
-    /* 1) Classify message type by its text prefix */
-    bool is_ping = false;
-    bool is_pong = false;
+    /* Timestamp of the packet: its STF, event time if the PCC was not seen */
+    uint64_t rx_time = modem_time;
 
-    if (payload && evt->len >= 4) {
-        if (strncmp(payload, "PING", 4) == 0) {
-            is_ping = true;
-        } else if (strncmp(payload, "PONG", 4) == 0) {
-            is_pong = true;
-        }
+    if (pcc_valid && pcc_transaction_id == evt->transaction_id) {
+        rx_time = pcc_stf_start_time;
     }
 
-    /* 2) Print common PHY info (can be shared) */
-    LOG_INF("PDC frame received, len=%u", evt->len);
+    /* To the owner of the RX operation */
+    k_spinlock_key_t key = k_spin_lock(&hs_ops_lock);
+    struct hs_core_op *op = op_find(evt->handle);
+    struct hs_core_op_cb cb = {0};
+    bool owned = (op != NULL);
 
-    /* 3) Print depending on type */
-    if (is_ping || is_pong) {
-        LOG_INF("[PING] payload: %s", payload);
-        /* RTT only makes sense for the ping client */
-        //mac_rtt_on_rx();
-		mac_rtt_on_pong_rx_modem_time(modem_time);
-    } else {
-        LOG_INF("[MAC ] payload: %s", payload);
-        /* No RTT here – normal MAC traffic */
+    if (owned) {
+        cb = op->cb;
     }
+    k_spin_unlock(&hs_ops_lock, key);
 
-    /* (Optional) extra details like RSSI, header fields, hex dump:
-       we can also prefix them with [PING] or [MAC]
-       if you like cleaner logs.
-    */
+    session_ttfp_check();
+
+    if (msg_dispatch(evt, rx_time)) {
+        /* handled by type */
+    } else if (cb.pdc) {
+        cb.pdc(evt->handle, evt->data, evt->len, rx_time, cb.user_data);
+    } else if (owned) {
+        rx_ring_push(evt, rx_time);
+    }
+
+    rx_cpu_account(k_cycle_get_32() - start_cyc);
 }
 
 /* Physical Data Channel CRC error notification. */
@@ -320,6 +839,7 @@ static void on_stf_cover_seq_control(const struct nrf_modem_dect_phy_stf_control
 static void dect_phy_event_handler(const struct nrf_modem_dect_phy_event *evt)
 {
 	modem_time = evt->time;
+	modem_time_ref_update(evt->time);
 
 	switch (evt->id) {
 	case NRF_MODEM_DECT_PHY_EVT_INIT:
@@ -350,7 +870,6 @@ static void dect_phy_event_handler(const struct nrf_modem_dect_phy_event *evt)
 		on_rssi(&evt->rssi);
 		break;
 	case NRF_MODEM_DECT_PHY_EVT_PCC:
-		mac_rtt_on_tx_done_modem_time(modem_time);
 		on_pcc(&evt->pcc);
 		break;
 	case NRF_MODEM_DECT_PHY_EVT_PCC_ERROR:
@@ -391,54 +910,93 @@ static struct nrf_modem_dect_phy_config_params dect_phy_config_params = {
 };
 
 /* Send operation. */
-int transmit(uint32_t handle, void *data, size_t data_len)
+int hs_core_tx_async(uint32_t handle, const void *data, size_t data_len,
+                     uint64_t start_time, const struct hs_core_op_cb *cb)
 {
+    struct hs_core_op *op;
+    int packet_length;
     int err;
 
+    err = op_alloc(handle, cb, &op);
+    if (err) {
+        return err;
+    }
+
+    packet_length = hs_tx_packet_length(op->mcs, data_len);
+    if (packet_length < 0) {
+        LOG_ERR("TX of %u bytes does not fit MCS %d", (uint32_t)data_len, op->mcs);
+        op_free(op);
+        return packet_length;
+    }
+
+    /* No LBT in own reserved slots only when opted out */
+    uint32_t lbt_period = NRF_MODEM_DECT_LBT_PERIOD_MAX;
+
+    if (start_time != HS_CORE_START_NOW && hs_sched_lbt_skip_get() &&
+        hs_sched_in_reserved(start_time, (uint64_t)(packet_length + 1) * HS_SUBSLOT_MDM_TICKS)) {
+        lbt_period = 0;
+    }
+
     struct phy_ctrl_field_common header = {
         .header_format      = 0x0,
-        .packet_length_type = 0x0,
-        .packet_length      = 0x01,
+        .packet_length_type = 0x0,                      /* subslots */
+        .packet_length      = packet_length,
         .short_network_id   = (hs_network_id & 0xff),   /* or CONFIG_NETWORK_ID if you keep it fixed */
         .transmitter_id_hi  = (hs_device_id >> 8),
         .transmitter_id_lo  = (hs_device_id & 0xff),
-        .transmit_power     = hs_tx_power,              /* <-- runtime */
+        .transmit_power     = op->tx_power,             /* <-- runtime */
         .reserved           = 0,
-        .df_mcs             = hs_mcs,                   /* <-- runtime */
+        .df_mcs             = op->mcs,                  /* <-- runtime */
     };
 
     struct nrf_modem_dect_phy_tx_params tx_op_params = {
-        .start_time             = 0,
+        .start_time             = start_time,
         .handle                 = handle,
         .network_id             = hs_network_id,        /* or CONFIG_NETWORK_ID */
         .phy_type               = 0,
         .lbt_rssi_threshold_max = 0,
-        .carrier                = hs_carrier,           /* <-- runtime */
-        .lbt_period             = NRF_MODEM_DECT_LBT_PERIOD_MAX,
+        .carrier                = op->carrier,          /* <-- runtime */
+        .lbt_period             = lbt_period,
         .phy_header             = (union nrf_modem_dect_phy_hdr *)&header,
-        .data                   = data,
+        .data                   = (uint8_t *)data,
         .data_size              = data_len,
     };
 
+    op->tx = true;
+    op->tx_start_time = start_time;
+    op->tx_len = data_len;
+
+    /* Data is copied by modem lib: caller's buffer is free on return */
     err = nrf_modem_dect_phy_tx(&tx_op_params);
+    if (err) {
+        op_free(op);
+    }
     return err;
 }
 
 /* Receive operation. */
- int receive(uint32_t handle)
+int hs_core_rx_async(uint32_t handle, uint64_t start_time,
+                     uint32_t duration_mdm_ticks, const struct hs_core_op_cb *cb)
 {
+    struct hs_core_op *op;
     int err;
 
+    err = op_alloc(handle, cb, &op);
+    if (err) {
+        return err;
+    }
+
     struct nrf_modem_dect_phy_rx_params rx_op_params = {
-        .start_time   = 0,
+        .start_time   = start_time,
         .handle       = handle,
         .network_id   = hs_network_id,   /* or CONFIG_NETWORK_ID */
         .mode         = NRF_MODEM_DECT_PHY_RX_MODE_CONTINUOUS,
         .rssi_interval = NRF_MODEM_DECT_PHY_RSSI_INTERVAL_OFF,
         .link_id      = NRF_MODEM_DECT_PHY_LINK_UNSPECIFIED,
         .rssi_level   = -60,
-        .carrier      = hs_carrier,      /* <-- runtime */
-        .duration     = CONFIG_RX_PERIOD_S * MSEC_PER_SEC *
+        .carrier      = op->carrier,     /* <-- runtime */
+        .duration     = duration_mdm_ticks ? duration_mdm_ticks :
+                        CONFIG_RX_PERIOD_S * MSEC_PER_SEC *
                         NRF_MODEM_DECT_MODEM_TIME_TICK_RATE_KHZ,
         .filter.short_network_id        = hs_network_id & 0xff,
         .filter.is_short_network_id_used = 1,
@@ -446,14 +1004,68 @@ int transmit(uint32_t handle, void *data, size_t data_len)
     };
 
     err = nrf_modem_dect_phy_rx(&rx_op_params);
+    if (err) {
+        op_free(op);
+    }
     return err;
 }
 
-/* Session Start For the initialization of the Board    t */
-int dect_session_open(void)
+int transmit(uint32_t handle, void *data, size_t data_len)
+{
+    int err;
+
+    err = hs_core_tx_async(handle, data, data_len, HS_CORE_START_NOW, NULL);
+    if (err) {
+        return err;
+    }
+    return hs_core_op_wait(handle, K_FOREVER);
+}
+
+int receive(uint32_t handle)
+{
+    int err;
+
+    err = hs_core_rx_async(handle, HS_CORE_START_NOW, 0, NULL);
+    if (err) {
+        return err;
+    }
+    return hs_core_op_wait(handle, K_FOREVER);
+}
+
+/* ============================================================
+ *               SESSION
+ * ============================================================ */
+/*
+ * One long-lived modem session shared by the apps. The modem is initialized
+ * and configured at the first open and kept so. It is activated lazily at
+ * open and deactivated only after the last user has been gone for
+ * HS_CORE_SESSION_IDLE_MS.
+ */
+enum hs_session_state {
+    HS_SESSION_DOWN,
+    HS_SESSION_INITIALIZED,   /* modem lib and PHY initialized, configured */
+    HS_SESSION_ACTIVE,
+};
+
+static K_MUTEX_DEFINE(session_mutex);
+static enum hs_session_state session_state = HS_SESSION_DOWN;
+static int session_refcnt;
+
+/* Time to first packet after an open, for comparing cold and warm opens */
+static int64_t session_open_ms;
+static bool session_open_cold;
+static atomic_t session_ttfp_pending;
+
+static void session_idle_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(session_idle_work, session_idle_work_fn);
+
+/* session_mutex held */
+static int session_init(void)
 {
     int err;
 
+    exit = false;
+
     err = nrf_modem_lib_init();
     if (err) {
         LOG_ERR("modem init failed, err %d", err);
@@ -488,6 +1100,26 @@ int dect_session_open(void)
         return -EIO;
     }
 
+    hwinfo_get_device_id((void *)&device_id, sizeof(device_id));
+    LOG_INF("DECT NR+ PHY initialized, device ID: %d", device_id);
+
+    err = nrf_modem_dect_phy_capability_get();
+    if (err) {
+        LOG_ERR("nrf_modem_dect_phy_capability_get failed, err %d", err);
+        /* not fatal */
+    }
+
+    session_state = HS_SESSION_INITIALIZED;
+    return 0;
+}
+
+/* session_mutex held */
+static int session_activate(void)
+{
+    int err;
+
+    exit = false;
+
     err = nrf_modem_dect_phy_activate(NRF_MODEM_DECT_PHY_RADIO_MODE_LOW_LATENCY);
     if (err) {
         LOG_ERR("nrf_modem_dect_phy_activate failed, err %d", err);
@@ -499,24 +1131,24 @@ int dect_session_open(void)
         return -EIO;
     }
 
-    hwinfo_get_device_id((void *)&device_id, sizeof(device_id));
-    LOG_INF("DECT NR+ PHY initialized, device ID: %d", device_id);
-
-    err = nrf_modem_dect_phy_capability_get();
+    /* Reference for scheduling operations at explicit modem times */
+    err = nrf_modem_dect_phy_time_get();
     if (err) {
-        LOG_ERR("nrf_modem_dect_phy_capability_get failed, err %d", err);
+        LOG_ERR("nrf_modem_dect_phy_time_get failed, err %d", err);
         /* not fatal */
+    } else {
+        k_sem_take(&operation_sem, K_FOREVER);
     }
 
+    session_state = HS_SESSION_ACTIVE;
     return 0;
 }
 
-int dect_session_close(void)
+/* session_mutex held */
+static int session_deactivate(void)
 {
     int err;
 
-    LOG_INF("Shutting down DECT session");
-
     err = nrf_modem_dect_phy_deactivate();
     if (err) {
         LOG_ERR("nrf_modem_dect_phy_deactivate failed, err %d", err);
@@ -524,22 +1156,81 @@ int dect_session_close(void)
     }
 
     k_sem_take(&deinit_sem, K_FOREVER);
+    ops_abort();
 
-    err = nrf_modem_dect_phy_deinit();
-    if (err) {
-        LOG_ERR("nrf_modem_dect_phy_deinit() failed, err %d", err);
-        return err;
+    session_state = HS_SESSION_INITIALIZED;
+    return 0;
+}
+
+static void session_idle_work_fn(struct k_work *work)
+{
+    k_mutex_lock(&session_mutex, K_FOREVER);
+    if (session_refcnt == 0 && session_state == HS_SESSION_ACTIVE) {
+        LOG_INF("DECT session idle, deactivating");
+        (void)session_deactivate();
     }
+    k_mutex_unlock(&session_mutex);
+}
 
-    k_sem_take(&deinit_sem, K_FOREVER);
+/* First completed TX or received PDC after an open */
+static void session_ttfp_check(void)
+{
+    if (atomic_cas(&session_ttfp_pending, 1, 0)) {
+        LOG_INF("Time to first packet: %lld ms (%s open)",
+                k_uptime_get() - session_open_ms, session_open_cold ? "cold" : "warm");
+    }
+}
+
+int dect_session_open(void)
+{
+    int err = 0;
+
+    k_mutex_lock(&session_mutex, K_FOREVER);
 
-    err = nrf_modem_lib_shutdown();
+    (void)k_work_cancel_delayable(&session_idle_work);
+
+    session_open_ms = k_uptime_get();
+    session_open_cold = (session_state != HS_SESSION_ACTIVE);
+
+    if (session_state == HS_SESSION_DOWN) {
+        err = session_init();
+    }
+    if (!err && session_state == HS_SESSION_INITIALIZED) {
+        err = session_activate();
+    }
     if (err) {
-        LOG_ERR("nrf_modem_lib_shutdown() failed, err %d", err);
+        k_mutex_unlock(&session_mutex);
         return err;
     }
 
-    LOG_INF("DECT session closed");
+    if (session_refcnt++ == 0) {
+        /* Leftovers of the previous user */
+        hs_core_rx_ring_flush();
+    }
+    atomic_set(&session_ttfp_pending, 1);
+
+    LOG_INF("DECT session open (%s, users %d) in %lld ms",
+            session_open_cold ? "cold" : "warm", session_refcnt,
+            k_uptime_get() - session_open_ms);
+
+    k_mutex_unlock(&session_mutex);
+    return 0;
+}
+
+int dect_session_close(void)
+{
+    k_mutex_lock(&session_mutex, K_FOREVER);
+
+    if (session_refcnt == 0) {
+        k_mutex_unlock(&session_mutex);
+        return -EALREADY;
+    }
+    if (--session_refcnt == 0) {
+        k_work_reschedule(&session_idle_work, K_MSEC(HS_CORE_SESSION_IDLE_MS));
+    }
+    LOG_DBG("DECT session closed (users %d)", session_refcnt);
+
+    k_mutex_unlock(&session_mutex);
     return 0;
 }
 /*End of the Session functions  */
@@ -638,44 +1329,92 @@ int static hs_core_set_tx_power(int pwr)
     return 0;
 }
 
-int hs_core_apply_radio(uint16_t carrier, uint8_t mcs, int8_t tx_power)
+/* Ops in flight on old_carrier, see hs_core_apply_radio() */
+static int radio_conflicts_resolve(uint16_t old_carrier)
 {
-    int err;
+    int64_t drain_end_ms = k_uptime_get() + HS_CORE_RECONF_DRAIN_MS;
+
+    while (true) {
+        uint32_t cancel[HS_CORE_OP_INFLIGHT_MAX];
+        int cancel_count = 0;
+        int pending = 0;
+        bool drained = k_uptime_get() >= drain_end_ms;
+        k_spinlock_key_t key = k_spin_lock(&hs_ops_lock);
+
+        for (int i = 0; i < HS_CORE_OP_INFLIGHT_MAX; i++) {
+            struct hs_core_op *op = &hs_ops[i];
+
+            if (!op->used || op->completed || op->carrier != old_carrier) {
+                continue;
+            }
+            pending++;
+            if (!op->reconf_canceled && (!op->tx || drained)) {
+                op->reconf_canceled = true;
+                cancel[cancel_count++] = op->handle;
+            }
+        }
+        k_spin_unlock(&hs_ops_lock, key);
 
-   
-    err = hs_core_set_carrier(carrier);
-    if (err) {
-        LOG_ERR("hs_core_apply_radio: carrier %u rejected (err=%d)",
-                carrier, err);
-        return err;
+        if (pending == 0) {
+            return 0;
+        }
+        if (k_uptime_get() >= drain_end_ms + HS_CORE_RECONF_DRAIN_MS) {
+            return -ETIMEDOUT;
+        }
+        for (int i = 0; i < cancel_count; i++) {
+            (void)nrf_modem_dect_phy_cancel(cancel[i]);
+        }
+        k_msleep(1);
     }
+}
 
-    
-    err = hs_core_set_mcs(mcs);
-    if (err) {
-        LOG_ERR("hs_core_apply_radio: MCS %u rejected (err=%d)",
-                mcs, err);
-        return err;
+int hs_core_apply_radio(uint16_t carrier, uint8_t mcs, int8_t tx_power)
+{
+    if (!carrier_valid(carrier)) {
+        LOG_ERR("hs_core_apply_radio: carrier %u rejected", carrier);
+        return -EINVAL;
     }
-
-   
-    err = hs_core_set_tx_power(tx_power);
-    if (err) {
-        LOG_ERR("hs_core_apply_radio: TX power %d rejected (err=%d)",
-                tx_power, err);
-        return err;
+    if (!mcs_valid(mcs)) {
+        LOG_ERR("hs_core_apply_radio: MCS %u rejected", mcs);
+        return -EINVAL;
+    }
+    if (!txp_valid(tx_power)) {
+        LOG_ERR("hs_core_apply_radio: TX power %d rejected", tx_power);
+        return -EINVAL;
     }
 
-    
-    return 0;
-}
+    k_mutex_lock(&session_mutex, K_FOREVER);
 
-int core_get_last_rx(uint8_t *dst, size_t max_len, size_t *out_len)
-{
-    if (!dst || !out_len) return -EINVAL;
-    size_t n = last_rx_len;
-    if (n > max_len) n = max_len;
-    memcpy(dst, last_rx_buf, n);
-    *out_len = n;
-    return 0;
+    uint16_t old_carrier = hs_carrier;
+    int64_t start_ms;
+    k_spinlock_key_t key;
+    int err = 0;
+
+    /* To the next frame boundary, ops already queued keep the old values */
+    if (session_state == HS_SESSION_ACTIVE) {
+        uint64_t now = hs_core_modem_time_now();
+        uint64_t boundary = hs_sched_frame_boundary_next(now + HS_CORE_START_LEAD_MDM_TICKS);
+
+        k_usleep((int32_t)HS_MODEM_TICKS_TO_US(boundary - now));
+    }
+    start_ms = k_uptime_get();
+
+    /* Ops allocated from now on take the new ones */
+    key = k_spin_lock(&hs_ops_lock);
+    (void)hs_core_set_carrier(carrier);
+    (void)hs_core_set_mcs(mcs);
+    (void)hs_core_set_tx_power(tx_power);
+    k_spin_unlock(&hs_ops_lock, key);
+
+    if (carrier != old_carrier) {
+        err = radio_conflicts_resolve(old_carrier);
+        if (err) {
+            LOG_WRN("Ops on carrier %u did not end: %d", old_carrier, err);
+        }
+    }
+    LOG_INF("Radio reconfigured: carrier %u, MCS %u, TX power %d dBm (%lld ms)",
+            carrier, mcs, tx_power, k_uptime_get() - start_ms);
+
+    k_mutex_unlock(&session_mutex);
+    return err;
 }
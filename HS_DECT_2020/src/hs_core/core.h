@@ -2,6 +2,7 @@
 #define HS_CORE_H_
 
 #include <zephyr/kernel.h>
+#include <nrf_modem_dect_phy.h>
 #include <stdint.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -31,15 +32,227 @@ struct hs_config {
 };
 
 int hs_core_get_config(struct hs_config *out);
+
+/*
+ * Transactional radio reconfiguration: all values are validated, then taken
+ * into use together at the next frame boundary (scheduller.h) without
+ * touching the session. Operations in flight on a carrier that is left are
+ * handled: RX is canceled, TX is let to complete up to HS_CORE_RECONF_DRAIN_MS
+ * and canceled after that. Their owners see NRF_MODEM_DECT_PHY_ERR_OP_CANCELED.
+ * All other operations continue. Returns -ETIMEDOUT if the conflicting
+ * operations did not end; the new values are in use anyway.
+ */
+#define HS_CORE_RECONF_DRAIN_MS    20
+
 int hs_core_apply_radio(uint16_t carrier, uint8_t mcs, int8_t tx_power);
 int hs_core_set_network_id(uint32_t netid);
+
+/*
+ * Refcounted modem session: the first open initializes and activates the
+ * modem, later ones only take a reference. The modem stays initialized;
+ * it is deactivated HS_CORE_SESSION_IDLE_MS after the last close.
+ */
+#define HS_CORE_SESSION_IDLE_MS    30000
+
 int dect_session_open(void);
 int dect_session_close(void);
 
+/* === Modem time === */
+
+#define HS_MODEM_TICKS_PER_MS      NRF_MODEM_DECT_MODEM_TIME_TICK_RATE_KHZ
+#define HS_US_TO_MODEM_TICKS(us)   (((uint64_t)(us) * HS_MODEM_TICKS_PER_MS) / 1000)
+#define HS_MS_TO_MODEM_TICKS(ms)   ((uint64_t)(ms) * HS_MODEM_TICKS_PER_MS)
+#define HS_MODEM_TICKS_TO_US(t)    (((uint64_t)(t) * 1000) / HS_MODEM_TICKS_PER_MS)
+
+#define HS_FRAME_MDM_TICKS         HS_MS_TO_MODEM_TICKS(10)
+#define HS_SUBSLOT_MDM_TICKS       (HS_FRAME_MDM_TICKS / 48)
+
+/* An operation given with an explicit start time has to be this much ahead of now */
+#define HS_CORE_START_LEAD_MDM_TICKS  HS_US_TO_MODEM_TICKS(2000)
+
+/* Gap kept between operations scheduled back-to-back */
+#define HS_CORE_OP_GAP_MDM_TICKS      (2 * HS_SUBSLOT_MDM_TICKS)
+
+/* start_time: as soon as possible */
+#define HS_CORE_START_NOW          0
+
+/* Estimated current modem time, extrapolated from the latest modem event */
+uint64_t hs_core_modem_time_now(void);
+
+/* Largest transport block of the TBS table (MCS 4, 8 subslots) */
+#define HS_CORE_TBS_BYTES_MAX      700
+
+/* Air time of a TX of data_len bytes: the packet length of a TX is the minimal
+ * number of subslots whose transport block with the current MCS fits the data.
+ */
+uint64_t hs_core_tx_duration_get(size_t data_len);
+
+/* Max payload of a TX with the current radio config (largest transport block
+ * of the MCS). Bigger TX fails with -EMSGSIZE.
+ */
+size_t hs_core_tx_payload_max_get(void);
+
+/* === Asynchronous TX/RX === */
+
+/* Max operations in flight at a time, each with a unique handle */
+#define HS_CORE_OP_INFLIGHT_MAX    8
+
+/*
+ * Handle range of each app. Apps may run at the same time, so an app uses
+ * only handles of its own range: HS_CORE_HANDLE_<APP>_BASE and up to
+ * HS_CORE_HANDLE_RANGE_SIZE - 1 above it.
+ */
+#define HS_CORE_HANDLE_RANGE_SIZE  8
+#define HS_CORE_HANDLE_HELLO_BASE  0
+#define HS_CORE_HANDLE_PING_BASE   (HS_CORE_HANDLE_HELLO_BASE + HS_CORE_HANDLE_RANGE_SIZE)
+#define HS_CORE_HANDLE_FPING_BASE  (HS_CORE_HANDLE_PING_BASE + HS_CORE_HANDLE_RANGE_SIZE)
+
+/*
+ * Callbacks of an operation. Both are called in modem event context: they
+ * must not block.
+ *  done: operation completed, err is a modem status (NRF_MODEM_DECT_PHY_SUCCESS
+ *        or enum nrf_modem_dect_phy_err).
+ *  pdc:  data received by an RX operation, time is the modem time of the
+ *        STF start of the packet (for RTT, see rtt.h).
+ * Without done, the operation is a future: its completion has to be collected
+ * with hs_core_op_wait().
+ */
+typedef void (*hs_core_op_done_cb_t)(uint32_t handle, int err, uint64_t time,
+                                     void *user_data);
+typedef void (*hs_core_pdc_cb_t)(uint32_t handle, const void *data, size_t len,
+                                 uint64_t time, void *user_data);
+
+struct hs_core_op_cb {
+    hs_core_op_done_cb_t done;
+    hs_core_pdc_cb_t     pdc;
+    void                *user_data;
+};
+
+/* Return 0 when given to modem, -EALREADY if handle is in flight, -EBUSY if
+ * HS_CORE_OP_INFLIGHT_MAX are in flight or an error from modem.
+ * TX at a start_time fully inside own reserved slots (scheduller.h) is given
+ * without LBT if hs_sched_lbt_skip_set() opted out of it.
+ */
+int hs_core_tx_async(uint32_t handle, const void *data, size_t data_len,
+                     uint64_t start_time, const struct hs_core_op_cb *cb);
+
+/* duration_mdm_ticks 0: CONFIG_RX_PERIOD_S */
+int hs_core_rx_async(uint32_t handle, uint64_t start_time,
+                     uint32_t duration_mdm_ticks, const struct hs_core_op_cb *cb);
+
+/* Wait for a future. Returns the modem status, -EAGAIN if not completed with
+ * K_NO_WAIT (poll again later), -ETIMEDOUT if not completed in any other
+ * timeout (the operation is then canceled and released on its completion) or
+ * -EINVAL if handle is not a future in flight.
+ */
+int hs_core_op_wait(uint32_t handle, k_timeout_t timeout);
+
+/* Canceled operation completes with NRF_MODEM_DECT_PHY_ERR_OP_CANCELED */
+int hs_core_op_cancel(uint32_t handle);
+
+/* === RX ring ===
+ *
+ * PDCs of RX operations without a pdc callback are copied with their
+ * metadata into a lock-free single producer (modem callback) / single
+ * consumer ring. The consumer drains it in batches:
+ *
+ *   n = hs_core_rx_ring_wait(timeout);
+ *   for (i = 0; i < n; i++) handle(hs_core_rx_ring_frame_get(i));
+ *   hs_core_rx_ring_release(n);
+ */
+
+/* Power of 2 */
+#define HS_CORE_RX_RING_SIZE        16
+#define HS_CORE_RX_FRAME_DATA_MAX   HS_CORE_TBS_BYTES_MAX
+
+struct hs_core_rx_frame {
+    uint64_t time;      /* modem time of the STF start of the packet */
+    uint32_t handle;
+    int16_t  rssi_2;    /* 0.5 dBm */
+    int16_t  snr;       /* 0.25 dB */
+    uint16_t len;
+    uint8_t  data[HS_CORE_RX_FRAME_DATA_MAX];
+};
+
+struct hs_core_rx_ring_stats {
+    uint32_t frames;      /* queued */
+    uint32_t overflows;   /* dropped, ring full */
+    uint32_t truncated;   /* queued, longer than HS_CORE_RX_FRAME_DATA_MAX */
+    uint32_t max_used;    /* high watermark */
+};
+
+/* Number of frames available, waits up to timeout if there are none */
+uint32_t hs_core_rx_ring_wait(k_timeout_t timeout);
+
+/* idx: 0 for the oldest of the available ones */
+const struct hs_core_rx_frame *hs_core_rx_ring_frame_get(uint32_t idx);
+
+/* Consume count oldest frames */
+void hs_core_rx_ring_release(uint32_t count);
+
+/* Drop all queued frames, consumer side */
+void hs_core_rx_ring_flush(void);
+
+void hs_core_rx_ring_stats_get(struct hs_core_rx_ring_stats *out);
+void hs_core_rx_ring_stats_reset(void);
+
+/* === MAC messages ===
+ *
+ * Compact binary header in front of the app payload. A PDC starting with a
+ * header of a type with a registered handler goes to that handler; others
+ * go to the pdc callback of the RX operation, or to the RX ring.
+ * fping has its own header: its first byte (magic) is not a valid type.
+ */
+enum hs_msg_type {
+    HS_MSG_HELLO = 1,
+    HS_MSG_TEXT  = 2,   /* payload: text, not terminated */
+    HS_MSG_PING  = 3,
+    HS_MSG_PONG  = 4,   /* seq of the PING */
+
+    HS_MSG_TYPE_COUNT
+};
+
+struct __packed hs_msg_hdr {
+    uint8_t  type;
+    uint8_t  flags;       /* type specific */
+    uint32_t seq;
+    uint32_t timestamp;   /* TX start modem time, low 32 bits */
+};
+
+/* Called in modem event context, must not block. time as for pdc callback. */
+typedef void (*hs_msg_handler_t)(uint32_t handle, const struct hs_msg_hdr *hdr,
+                                 const void *payload, size_t len, uint64_t time,
+                                 void *user_data);
+
+/* Returns -EINVAL for a bad type, -EALREADY if the type has a handler */
+int hs_msg_handler_register(uint8_t type, hs_msg_handler_t handler, void *user_data);
+void hs_msg_handler_unregister(uint8_t type);
+
+/* Header and payload into buf for a TX at tx_time (HS_CORE_START_NOW: now).
+ * Returns the length or -EMSGSIZE.
+ */
+int hs_msg_build(void *buf, size_t buf_size, uint8_t type, uint8_t flags, uint32_t seq,
+                 uint64_t tx_time, const void *payload, size_t payload_len);
+
+/* RX logging, off by default. At most HS_CORE_RX_LOG_PER_S frames per second
+ * are logged, the rest are counted.
+ */
+#define HS_CORE_RX_LOG_PER_S        10
+
+void hs_core_rx_log_set(bool enable);
+
+/* CPU time of the PDC handling in the modem callback, dispatch included */
+struct hs_core_rx_cpu_stats {
+    uint32_t frames;
+    uint32_t avg_ns;
+    uint32_t max_ns;
+};
+
+void hs_core_rx_cpu_stats_get(struct hs_core_rx_cpu_stats *out);
+void hs_core_rx_cpu_stats_reset(void);
+
+/* Blocking TX/RX: given now and waited for completion */
 int transmit(uint32_t handle, void *data, size_t data_len);
 int receive(uint32_t handle);
 
-void mac_rtt_mark_tx(void);
-void mac_rtt_set_enabled(bool enable);
-
 #endif /* HS_CORE_H_ */
@@ -0,0 +1,110 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include "core.h"
+#include "rtt.h"
+#include "perf.h"
+
+LOG_MODULE_REGISTER(hs_rtt, LOG_LEVEL_INF);
+
+struct hs_rtt_probe {
+    bool     used;
+    bool     tx_done;
+    uint32_t seq;
+    uint32_t tx_handle;
+    uint64_t tx_time;
+    int64_t  created_ms;
+};
+
+/* Called also from modem callbacks */
+static struct k_spinlock probes_lock;
+static struct hs_rtt_probe probes[HS_RTT_PROBE_MAX];
+static uint32_t probes_next;
+
+void hs_rtt_reset(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&probes_lock);
+
+    memset(probes, 0, sizeof(probes));
+    probes_next = 0;
+    k_spin_unlock(&probes_lock, key);
+}
+
+void hs_rtt_probe_tx(uint32_t seq, uint32_t tx_handle)
+{
+    k_spinlock_key_t key = k_spin_lock(&probes_lock);
+    int64_t now_ms = k_uptime_get();
+    struct hs_rtt_probe *probe = NULL;
+
+    /* Reuse the probe of the same seq (retransmission) or a free or timed out one */
+    for (int i = 0; i < HS_RTT_PROBE_MAX; i++) {
+        if (probes[i].used && probes[i].seq == seq) {
+            probe = &probes[i];
+            break;
+        }
+    }
+    for (int i = 0; !probe && i < HS_RTT_PROBE_MAX; i++) {
+        if (!probes[i].used || now_ms - probes[i].created_ms > HS_RTT_PROBE_TIMEOUT_MS) {
+            probe = &probes[i];
+        }
+    }
+    if (!probe) {
+        probe = &probes[probes_next];
+        probes_next = (probes_next + 1) % HS_RTT_PROBE_MAX;
+    }
+
+    probe->used = true;
+    probe->tx_done = false;
+    probe->seq = seq;
+    probe->tx_handle = tx_handle;
+    probe->created_ms = now_ms;
+    k_spin_unlock(&probes_lock, key);
+}
+
+void hs_rtt_on_tx_done(uint32_t tx_handle, uint64_t tx_time)
+{
+    k_spinlock_key_t key = k_spin_lock(&probes_lock);
+    struct hs_rtt_probe *probe = NULL;
+
+    /* The latest registered one waiting for this handle */
+    for (int i = 0; i < HS_RTT_PROBE_MAX; i++) {
+        if (probes[i].used && !probes[i].tx_done && probes[i].tx_handle == tx_handle &&
+            (!probe || probes[i].created_ms >= probe->created_ms)) {
+            probe = &probes[i];
+        }
+    }
+    if (probe) {
+        probe->tx_done = true;
+        probe->tx_time = tx_time;
+    }
+    k_spin_unlock(&probes_lock, key);
+}
+
+int32_t hs_rtt_probe_rx(uint32_t seq, uint64_t rx_time)
+{
+    k_spinlock_key_t key = k_spin_lock(&probes_lock);
+    int64_t now_ms = k_uptime_get();
+    int32_t rtt_us = -ENOENT;
+
+    for (int i = 0; i < HS_RTT_PROBE_MAX; i++) {
+        struct hs_rtt_probe *probe = &probes[i];
+
+        if (!probe->used || probe->seq != seq ||
+            now_ms - probe->created_ms > HS_RTT_PROBE_TIMEOUT_MS) {
+            continue;
+        }
+        if (!probe->tx_done || rx_time < probe->tx_time) {
+            rtt_us = -EAGAIN;
+            break;
+        }
+        rtt_us = (int32_t)HS_MODEM_TICKS_TO_US(rx_time - probe->tx_time);
+        probe->used = false;
+        break;
+    }
+    k_spin_unlock(&probes_lock, key);
+
+    if (rtt_us >= 0) {
+        hs_perf_on_rtt((uint32_t)rtt_us);
+    }
+    return rtt_us;
+}
@@ -0,0 +1,39 @@
+#ifndef HS_RTT_H_
+#define HS_RTT_H_
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+
+/*
+ * RTT probes on modem timestamps.
+ *
+ * A probe is registered with the sequence number the app puts into the
+ * payload and the handle of the TX carrying it. hs_core gives the start time
+ * of the TX when the operation completes; the app gives the sequence number
+ * of a reply parsed in its pdc callback with the STF time of the packet.
+ * RTT is from the start of the TX to the start of the reply, in us. It is
+ * also given to hs_perf_on_rtt().
+ */
+
+/* Probes pending at a time, the oldest is overwritten when full */
+#define HS_RTT_PROBE_MAX         16
+
+/* Replies later than this are not matched */
+#define HS_RTT_PROBE_TIMEOUT_MS  1000
+
+/* Drop all pending probes */
+void hs_rtt_reset(void);
+
+/* Before giving the TX to hs_core */
+void hs_rtt_probe_tx(uint32_t seq, uint32_t tx_handle);
+
+/* From hs_core: a TX operation has completed, started at modem time tx_time */
+void hs_rtt_on_tx_done(uint32_t tx_handle, uint64_t tx_time);
+
+/* Reply with seq received, rx_time is the STF start modem time of it.
+ * Returns RTT in us, -ENOENT if no probe of seq is pending, -EAGAIN if the
+ * completion of its TX has not been seen yet.
+ */
+int32_t hs_rtt_probe_rx(uint32_t seq, uint64_t rx_time);
+
+#endif /* HS_RTT_H_ */
@@ -17,13 +17,19 @@
 
 LOG_MODULE_REGISTER(hello, LOG_LEVEL_INF);
 
-extern struct k_sem operation_sem;
+#define HELLO_TX_HANDLE      HS_CORE_HANDLE_HELLO_BASE
+#define HELLO_RX_HANDLE_BASE (HELLO_TX_HANDLE + 1)
+#define HELLO_RX_CHAIN_DEPTH 2
+
+BUILD_ASSERT(HELLO_RX_HANDLE_BASE + HELLO_RX_CHAIN_DEPTH <=
+             HS_CORE_HANDLE_HELLO_BASE + HS_CORE_HANDLE_RANGE_SIZE);
+
 /*End of the Session functions  */
 
 int hello_start_tx(uint32_t max_tx)
 {
     int err;
-    uint32_t tx_handle = 0;
+    uint32_t tx_handle = HELLO_TX_HANDLE;
     uint32_t tx_counter_value = 0;
     uint8_t tx_buf[DATA_LEN_MAX];
     size_t tx_len;
@@ -40,21 +46,25 @@ int hello_start_tx(uint32_t max_tx)
 
         LOG_INF("Transmitting %u", tx_counter_value);
 
-        tx_len = sprintf(tx_buf, "Hello DECT! %u", tx_counter_value) + 1;
-        err = transmit(tx_handle, tx_buf, tx_len);
+        err = hs_msg_build(tx_buf, sizeof(tx_buf), HS_MSG_HELLO, 0, tx_counter_value,
+                           HS_CORE_START_NOW, NULL, 0);
+        if (err < 0) {
+            break;
+        }
+        tx_len = err;
+        err = hs_core_tx_async(tx_handle, tx_buf, tx_len, HS_CORE_START_NOW, NULL);
         if (!err) {
-            hs_perf_on_tx(tx_len);
+            /* Wait for TX operation to complete. */
+            err = hs_core_op_wait(tx_handle, K_FOREVER);
         }
         if (err) {
             LOG_ERR("Transmission failed, err %d", err);
             break;
         }
+        hs_perf_on_tx(tx_len);
 
         tx_counter_value++;
 
-        /* Wait for TX operation to complete. */
-        k_sem_take(&operation_sem, K_FOREVER);
-
         /* Optional: stop after max_tx transmissions if max_tx > 0 */
         if (max_tx && tx_counter_value >= max_tx) {
             LOG_INF("Reached maximum number of transmissions (%u)", max_tx);
@@ -71,30 +81,84 @@ int hello_start_tx(uint32_t max_tx)
 
 
 
+static void hello_rx_pdc(uint32_t handle, const void *data, size_t len, uint64_t time,
+                         void *user_data)
+{
+    hs_perf_on_rx(len);
+}
+
+static void hello_rx_msg(uint32_t handle, const struct hs_msg_hdr *hdr, const void *payload,
+                         size_t len, uint64_t time, void *user_data)
+{
+    hs_perf_on_rx(sizeof(*hdr) + len);
+
+    if (hdr->type == HS_MSG_TEXT) {
+        LOG_INF("MAC text: '%.*s'", (int)len, (const char *)payload);
+    }
+}
+
+/* RX windows are chained: the next one is queued to start right after the current one
+ * so that there is no gap while the thread re-arms.
+ */
 int hello_start_rx(void)
 {
     int err;
-    uint32_t rx_handle = 1;
-     size_t rx_len;
+    const struct hs_core_op_cb cb = { .pdc = hello_rx_pdc };
+    const uint32_t rx_duration = CONFIG_RX_PERIOD_S * HS_MS_TO_MODEM_TICKS(MSEC_PER_SEC);
+    uint64_t next_start;
+    uint32_t idx = 0;
+
     LOG_INF("DECT NR+ PHY RX sample started");
 
     err = dect_session_open();
     if (err) {
         return err;
     }
+    (void)hs_msg_handler_register(HS_MSG_HELLO, hello_rx_msg, NULL);
+    (void)hs_msg_handler_register(HS_MSG_TEXT, hello_rx_msg, NULL);
 
-    while (atomic_get(&hello_running)) {
-        err = receive(rx_handle);
-        if (err) {
+    next_start = hs_core_modem_time_now() + HS_CORE_START_LEAD_MDM_TICKS;
+    for (int i = 0; i < HELLO_RX_CHAIN_DEPTH && !err; i++) {
+        err = hs_core_rx_async(HELLO_RX_HANDLE_BASE + i, next_start, rx_duration, &cb);
+        next_start += rx_duration + HS_CORE_OP_GAP_MDM_TICKS;
+    }
+
+    while (!err) {
+        uint32_t handle = HELLO_RX_HANDLE_BASE + (idx % HELLO_RX_CHAIN_DEPTH);
+
+        err = hs_core_op_wait(handle, K_FOREVER);
+        if (!atomic_get(&hello_running)) {
+            break;
+        }
+        if (err == NRF_MODEM_DECT_PHY_ERR_OP_CANCELED) {
+            /* e.g. carrier changed: the chain continues on the new one */
+            err = 0;
+        } else if (err) {
             LOG_ERR("Reception failed, err %d", err);
             break;
         }
 
-        /* Wait for RX operation to complete. */
-        k_sem_take(&operation_sem, K_FOREVER);
+        /* Fell behind, e.g. modem was busy: restart the chain from now */
+        if (next_start < hs_core_modem_time_now() + HS_CORE_START_LEAD_MDM_TICKS) {
+            next_start = hs_core_modem_time_now() + HS_CORE_START_LEAD_MDM_TICKS;
+        }
+        err = hs_core_rx_async(handle, next_start, rx_duration, &cb);
+        if (err) {
+            LOG_ERR("Reception failed, err %d", err);
+            break;
+        }
+        next_start += rx_duration + HS_CORE_OP_GAP_MDM_TICKS;
+        idx++;
+    }
 
-       hs_perf_on_rx(rx_len);
+    /* The other one of the chain is still queued */
+    for (int i = 0; i < HELLO_RX_CHAIN_DEPTH; i++) {
+        if (hs_core_op_cancel(HELLO_RX_HANDLE_BASE + i) == 0) {
+            (void)hs_core_op_wait(HELLO_RX_HANDLE_BASE + i, K_SECONDS(1));
+        }
     }
+    hs_msg_handler_unregister(HS_MSG_HELLO);
+    hs_msg_handler_unregister(HS_MSG_TEXT);
 
     err = dect_session_close();
     return err;
@@ -104,29 +168,33 @@ int hello_start_rx(void)
 int mac_send_text(const char *msg)
 {
     int err;
-    uint32_t tx_handle = 0;
+    uint32_t tx_handle = HELLO_TX_HANDLE;
     uint8_t tx_buf[DATA_LEN_MAX];
     size_t tx_len;
 
     LOG_INF("MAC send text: '%s'", msg);
 
-    tx_len = strlen(msg) + 1;
-    if (tx_len > DATA_LEN_MAX) {
-        tx_len = DATA_LEN_MAX;
+    /* Truncated to fit */
+    err = hs_msg_build(tx_buf, sizeof(tx_buf), HS_MSG_TEXT, 0, 0, HS_CORE_START_NOW, msg,
+                       MIN(strlen(msg), DATA_LEN_MAX - sizeof(struct hs_msg_hdr)));
+    if (err < 0) {
+        return err;
     }
-    memcpy(tx_buf, msg, tx_len);
+    tx_len = err;
 
     err = dect_session_open();
     if (err) {
         return err;
     }
 
-    err = transmit(tx_handle, tx_buf, tx_len);
+    err = hs_core_tx_async(tx_handle, tx_buf, tx_len, HS_CORE_START_NOW, NULL);
+    if (!err) {
+        /* Wait for TX to complete */
+        err = hs_core_op_wait(tx_handle, K_FOREVER);
+    }
     if (err) {
         LOG_ERR("Transmission failed, err %d", err);
     } else {
-        /* Wait for TX to complete */
-        k_sem_take(&operation_sem, K_FOREVER);
         LOG_INF("MAC message sent");
 
         /* ✅ Tell perf module about this TX */
@@ -2,94 +2,284 @@
 
 #include <string.h>
 
+/* TX/RX/RTT hooks only do atomic adds into the counters of the running interval.
+ * 32 bits are plenty for one interval: they are folded into the 64-bit totals
+ * and into the interval snapshot by the snapshot work or by hs_perf_get(),
+ * which is also the only place that reads the time.
+ */
+static struct {
+    atomic_t tx_pkts;
+    atomic_t rx_pkts;
+    atomic_t tx_bytes;
+    atomic_t rx_bytes;
+    atomic_t rtt_count;
+    atomic_t rtt_sum_us;
+    atomic_t rtt_min_us;
+    atomic_t rtt_max_us;
+} g_acc;
+
+static atomic_t g_running;
+
+/* Below with g_fold_lock */
+static struct k_spinlock g_fold_lock;
 static struct hs_perf_metrics g_perf;
-static bool g_running;
+
+static struct hs_perf_interval g_cur;     /* interval being built */
+static uint64_t g_cur_rtt_sum_us;
+static uint32_t g_cur_start_ms;
+
+static struct {
+    struct hs_perf_interval items[HS_PERF_SNAPSHOT_COUNT];
+    uint32_t next;     /* to be written */
+    uint32_t count;
+} g_hist;
+
+static void hs_perf_snapshot_work_fn(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(g_snapshot_work, hs_perf_snapshot_work_fn);
+
+static void hs_perf_atomic_min(atomic_t *target, uint32_t value)
+{
+    atomic_val_t old;
+
+    do {
+        old = atomic_get(target);
+        if ((uint32_t)old <= value) {
+            return;
+        }
+    } while (!atomic_cas(target, old, (atomic_val_t)value));
+}
+
+static void hs_perf_atomic_max(atomic_t *target, uint32_t value)
+{
+    atomic_val_t old;
+
+    do {
+        old = atomic_get(target);
+        if ((uint32_t)old >= value) {
+            return;
+        }
+    } while (!atomic_cas(target, old, (atomic_val_t)value));
+}
+
+static void hs_perf_acc_clear(void)
+{
+    atomic_clear(&g_acc.tx_pkts);
+    atomic_clear(&g_acc.rx_pkts);
+    atomic_clear(&g_acc.tx_bytes);
+    atomic_clear(&g_acc.rx_bytes);
+    atomic_clear(&g_acc.rtt_count);
+    atomic_clear(&g_acc.rtt_sum_us);
+    atomic_set(&g_acc.rtt_min_us, (atomic_val_t)UINT32_MAX);
+    atomic_clear(&g_acc.rtt_max_us);
+}
+
+/* g_fold_lock held */
+static void hs_perf_fold(uint32_t now_ms)
+{
+    uint32_t tx_pkts = (uint32_t)atomic_clear(&g_acc.tx_pkts);
+    uint32_t rx_pkts = (uint32_t)atomic_clear(&g_acc.rx_pkts);
+    uint32_t tx_bytes = (uint32_t)atomic_clear(&g_acc.tx_bytes);
+    uint32_t rx_bytes = (uint32_t)atomic_clear(&g_acc.rx_bytes);
+    uint32_t rtt_count = (uint32_t)atomic_clear(&g_acc.rtt_count);
+    uint32_t rtt_sum_us = (uint32_t)atomic_clear(&g_acc.rtt_sum_us);
+    uint32_t rtt_min_us = (uint32_t)atomic_set(&g_acc.rtt_min_us, (atomic_val_t)UINT32_MAX);
+    uint32_t rtt_max_us = (uint32_t)atomic_clear(&g_acc.rtt_max_us);
+
+    g_perf.tx_pkts += tx_pkts;
+    g_perf.rx_pkts += rx_pkts;
+    g_perf.tx_bytes += tx_bytes;
+    g_perf.rx_bytes += rx_bytes;
+
+    g_cur.tx_pkts += tx_pkts;
+    g_cur.rx_pkts += rx_pkts;
+    g_cur.tx_bytes += tx_bytes;
+    g_cur.rx_bytes += rx_bytes;
+
+    if (rtt_count) {
+        if (g_perf.rtt_count == 0 || rtt_min_us < g_perf.rtt_min_us) {
+            g_perf.rtt_min_us = rtt_min_us;
+        }
+        if (rtt_max_us > g_perf.rtt_max_us) {
+            g_perf.rtt_max_us = rtt_max_us;
+        }
+        g_perf.rtt_count += rtt_count;
+        g_perf.rtt_sum_us += rtt_sum_us;
+
+        if (g_cur.rtt_count == 0 || rtt_min_us < g_cur.rtt_min_us) {
+            g_cur.rtt_min_us = rtt_min_us;
+        }
+        if (rtt_max_us > g_cur.rtt_max_us) {
+            g_cur.rtt_max_us = rtt_max_us;
+        }
+        g_cur.rtt_count += rtt_count;
+        g_cur_rtt_sum_us += rtt_sum_us;
+    }
+
+    g_perf.end_ms = now_ms;
+    g_perf.duration_ms = now_ms - g_perf.start_ms;
+}
+
+/* g_fold_lock held: close the interval being built into the history */
+static void hs_perf_interval_close(uint32_t now_ms)
+{
+    g_cur.end_ms = now_ms - g_perf.start_ms;
+    g_cur.duration_ms = now_ms - g_cur_start_ms;
+    g_cur.rtt_avg_us = g_cur.rtt_count ? (uint32_t)(g_cur_rtt_sum_us / g_cur.rtt_count) : 0;
+
+    g_hist.items[g_hist.next] = g_cur;
+    g_hist.next = (g_hist.next + 1) % HS_PERF_SNAPSHOT_COUNT;
+    if (g_hist.count < HS_PERF_SNAPSHOT_COUNT) {
+        g_hist.count++;
+    }
+
+    memset(&g_cur, 0, sizeof(g_cur));
+    g_cur_rtt_sum_us = 0;
+    g_cur_start_ms = now_ms;
+}
+
+static void hs_perf_snapshot_work_fn(struct k_work *work)
+{
+    uint32_t now_ms = (uint32_t)k_uptime_get();
+    k_spinlock_key_t key;
+
+    if (!atomic_get(&g_running)) {
+        return;
+    }
+
+    key = k_spin_lock(&g_fold_lock);
+    hs_perf_fold(now_ms);
+    hs_perf_interval_close(now_ms);
+    k_spin_unlock(&g_fold_lock, key);
+
+    k_work_reschedule(&g_snapshot_work, K_MSEC(HS_PERF_INTERVAL_MS));
+}
 
 void hs_perf_reset(void)
 {
+    k_spinlock_key_t key;
+
+    atomic_clear(&g_running);
+    (void)k_work_cancel_delayable(&g_snapshot_work);
+
+    key = k_spin_lock(&g_fold_lock);
+    hs_perf_acc_clear();
     memset(&g_perf, 0, sizeof(g_perf));
-    g_running = false;
+    memset(&g_cur, 0, sizeof(g_cur));
+    g_cur_rtt_sum_us = 0;
+    g_hist.next = 0;
+    g_hist.count = 0;
+    k_spin_unlock(&g_fold_lock, key);
 }
 
 void hs_perf_start(void)
 {
+    uint32_t now_ms;
+
     hs_perf_reset();
-    g_running = true;
-    g_perf.start_ms = (uint32_t)k_uptime_get();
+
+    now_ms = (uint32_t)k_uptime_get();
+    g_perf.start_ms = now_ms;
+    g_perf.end_ms = now_ms;
+    g_cur_start_ms = now_ms;
+
+    atomic_set(&g_running, 1);
+    k_work_reschedule(&g_snapshot_work, K_MSEC(HS_PERF_INTERVAL_MS));
 }
 
 void hs_perf_stop(void)
 {
-    if (!g_running) {
+    uint32_t now_ms = (uint32_t)k_uptime_get();
+    k_spinlock_key_t key;
+
+    if (!atomic_cas(&g_running, 1, 0)) {
         return;
     }
-    g_running = false;
-    g_perf.end_ms = (uint32_t)k_uptime_get();
-    g_perf.duration_ms = g_perf.end_ms - g_perf.start_ms;
+    (void)k_work_cancel_delayable(&g_snapshot_work);
+
+    /* The partial last interval too */
+    key = k_spin_lock(&g_fold_lock);
+    hs_perf_fold(now_ms);
+    hs_perf_interval_close(now_ms);
+    k_spin_unlock(&g_fold_lock, key);
 }
 
 bool hs_perf_is_running(void)
 {
-    return g_running;
+    return atomic_get(&g_running) != 0;
 }
 
-static void hs_perf_update_time(void)
+void hs_perf_on_tx(size_t bytes)
 {
-    if (!g_running) {
+    if (!atomic_get(&g_running)) {
         return;
     }
-    uint32_t now_ms = (uint32_t)k_uptime_get();
-    g_perf.end_ms = now_ms;
-    g_perf.duration_ms = now_ms - g_perf.start_ms;
+    atomic_inc(&g_acc.tx_pkts);
+    atomic_add(&g_acc.tx_bytes, (atomic_val_t)bytes);
 }
 
-void hs_perf_on_tx(size_t bytes)
+void hs_perf_on_rx(size_t bytes)
 {
-    if (!g_running) {
+    if (!atomic_get(&g_running)) {
         return;
     }
-    g_perf.tx_pkts++;
-    g_perf.tx_bytes += (uint32_t)bytes;
-    hs_perf_update_time();
+    atomic_inc(&g_acc.rx_pkts);
+    atomic_add(&g_acc.rx_bytes, (atomic_val_t)bytes);
 }
 
-void hs_perf_on_rx(size_t bytes)
+void hs_perf_on_rtt(uint32_t rtt_us)
 {
-    if (!g_running) {
+    if (!atomic_get(&g_running)) {
         return;
     }
-    g_perf.rx_pkts++;
-    g_perf.rx_bytes += (uint32_t)bytes;
-    hs_perf_update_time();
+    hs_perf_atomic_min(&g_acc.rtt_min_us, rtt_us);
+    hs_perf_atomic_max(&g_acc.rtt_max_us, rtt_us);
+    atomic_add(&g_acc.rtt_sum_us, (atomic_val_t)rtt_us);
+    atomic_inc(&g_acc.rtt_count);
 }
 
-void hs_perf_on_rtt(uint32_t rtt_ms)
+void hs_perf_get(struct hs_perf_metrics *out)
 {
-    if (!g_running) {
+    k_spinlock_key_t key;
+
+    if (!out) {
         return;
     }
 
-    if (g_perf.rtt_count == 0) {
-        g_perf.rtt_min_ms = rtt_ms;
-        g_perf.rtt_max_ms = rtt_ms;
-    } else {
-        if (rtt_ms < g_perf.rtt_min_ms) {
-            g_perf.rtt_min_ms = rtt_ms;
-        }
-        if (rtt_ms > g_perf.rtt_max_ms) {
-            g_perf.rtt_max_ms = rtt_ms;
-        }
+    key = k_spin_lock(&g_fold_lock);
+    if (atomic_get(&g_running)) {
+        hs_perf_fold((uint32_t)k_uptime_get());
     }
+    *out = g_perf;
+    k_spin_unlock(&g_fold_lock, key);
+}
 
-    g_perf.rtt_count++;
-    g_perf.rtt_sum_ms += rtt_ms;
-    hs_perf_update_time();
+uint32_t hs_perf_interval_count(void)
+{
+    return g_hist.count;
 }
 
-void hs_perf_get(struct hs_perf_metrics *out)
+int hs_perf_interval_get(uint32_t idx, struct hs_perf_interval *out)
 {
-    if (!out) {
-        return;
+    k_spinlock_key_t key = k_spin_lock(&g_fold_lock);
+    int err = -ENOENT;
+
+    if (idx < g_hist.count) {
+        uint32_t pos = (g_hist.next + HS_PERF_SNAPSHOT_COUNT - 1 - idx) % HS_PERF_SNAPSHOT_COUNT;
+
+        *out = g_hist.items[pos];
+        err = 0;
     }
-    *out = g_perf;
+    k_spin_unlock(&g_fold_lock, key);
+    return err;
+}
+
+uint32_t hs_perf_kbps(uint64_t bytes, uint32_t duration_ms)
+{
+    /* bits per ms == kbit/s */
+    return duration_ms ? (uint32_t)((bytes * 8U) / duration_ms) : 0;
+}
+
+uint32_t hs_perf_pps(uint64_t pkts, uint32_t duration_ms)
+{
+    return duration_ms ? (uint32_t)((pkts * 1000U) / duration_ms) : 0;
 }
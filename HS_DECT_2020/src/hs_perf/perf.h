@@ -8,11 +8,15 @@
 extern "C" {
 #endif
 
+/* Interval snapshots: one per HS_PERF_INTERVAL_MS, the last HS_PERF_SNAPSHOT_COUNT kept */
+#define HS_PERF_INTERVAL_MS     1000
+#define HS_PERF_SNAPSHOT_COUNT  120
+
 struct hs_perf_metrics {
-    uint32_t tx_pkts;
-    uint32_t rx_pkts;
-    uint32_t tx_bytes;
-    uint32_t rx_bytes;
+    uint64_t tx_pkts;
+    uint64_t rx_pkts;
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;
 
     uint32_t start_ms;
     uint32_t end_ms;
@@ -20,9 +24,23 @@ struct hs_perf_metrics {
 
     /* Optional latency stats (used when you have RTT) */
     uint32_t rtt_count;
-    uint32_t rtt_min_ms;
-    uint32_t rtt_max_ms;
-    uint64_t rtt_sum_ms;   /* for average */
+    uint32_t rtt_min_us;
+    uint32_t rtt_max_us;
+    uint64_t rtt_sum_us;   /* for average */
+};
+
+/* Counts of one interval */
+struct hs_perf_interval {
+    uint32_t end_ms;       /* from start */
+    uint32_t duration_ms;
+    uint32_t tx_pkts;
+    uint32_t rx_pkts;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    uint32_t rtt_count;
+    uint32_t rtt_min_us;   /* valid if rtt_count */
+    uint32_t rtt_max_us;
+    uint32_t rtt_avg_us;
 };
 
 void hs_perf_reset(void);
@@ -30,16 +48,26 @@ void hs_perf_start(void);
 void hs_perf_stop(void);
 bool hs_perf_is_running(void);
 
-/* Hooks you call from TX/RX paths */
+/* Hooks you call from TX/RX paths: lock-free, no timestamping */
 void hs_perf_on_tx(size_t bytes);
 void hs_perf_on_rx(size_t bytes);
 
-/* Hook for RTT (e.g. from macsched ACK) */
-void hs_perf_on_rtt(uint32_t rtt_ms);
+/* Hook for RTT in us, see hs_core/rtt.h */
+void hs_perf_on_rtt(uint32_t rtt_us);
 
 /* Read current metrics snapshot */
 void hs_perf_get(struct hs_perf_metrics *out);
 
+/* Number of interval snapshots available */
+uint32_t hs_perf_interval_count(void);
+
+/* idx 0: the latest one. Returns -ENOENT if not available. */
+int hs_perf_interval_get(uint32_t idx, struct hs_perf_interval *out);
+
+/* Rates */
+uint32_t hs_perf_kbps(uint64_t bytes, uint32_t duration_ms);
+uint32_t hs_perf_pps(uint64_t pkts, uint32_t duration_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,8 @@
+#include <stdlib.h>
 #include <zephyr/shell/shell.h>
+#include <zephyr/sys/util.h>
 #include "perf.h"
+#include "core.h"
 
 int cmd_hdect_perf_start(const struct shell *shell,
                          size_t argc, char **argv)
@@ -30,6 +33,8 @@ int cmd_hdect_perf_reset(const struct shell *shell,
     ARG_UNUSED(argv);
 
     hs_perf_reset();
+    hs_core_rx_ring_stats_reset();
+    hs_core_rx_cpu_stats_reset();
     shell_print(shell, "perf: reset");
     return 0;
 }
@@ -43,17 +48,14 @@ int cmd_hdect_perf_show(const struct shell *shell,
     struct hs_perf_metrics m;
     hs_perf_get(&m);
 
-    float dur_s = (m.duration_ms > 0) ? (m.duration_ms / 1000.0f) : 0.0f;
-    ARG_UNUSED(dur_s); /* if you don’t use it */
-
     shell_print(shell,
         "perf metrics:\n"
         "  running      : %s\n"
         "  duration_ms  : %u\n"
-        "  tx_pkts      : %u\n"
-        "  rx_pkts      : %u\n"
-        "  tx_bytes     : %u\n"
-        "  rx_bytes     : %u",
+        "  tx_pkts      : %llu\n"
+        "  rx_pkts      : %llu\n"
+        "  tx_bytes     : %llu\n"
+        "  rx_bytes     : %llu",
         hs_perf_is_running() ? "yes" : "no",
         m.duration_ms,
         m.tx_pkts,
@@ -62,29 +64,185 @@ int cmd_hdect_perf_show(const struct shell *shell,
         m.rx_bytes);
 
     if (m.duration_ms > 0) {
-    /* bits per second = bytes * 8 / seconds
-     * here we compute kbps with integer math:
-     * kbps = (bytes * 8 * 1000) / duration_ms
-     */
-    uint32_t tx_kbps = (m.tx_bytes * 8U * 1000U) / (m.duration_ms ? m.duration_ms : 1U);
-    uint32_t rx_kbps = (m.rx_bytes * 8U * 1000U) / (m.duration_ms ? m.duration_ms : 1U);
-
-    /* and Mbps * 1000 to keep 3 decimals: Mbps = kbps / 1000.0
-     * print as X.YYY using integer division & remainder
-     */
-    uint32_t tx_mbps_int  = tx_kbps / 1000U;
-    uint32_t tx_mbps_frac = tx_kbps % 1000U;
-
-    uint32_t rx_mbps_int  = rx_kbps / 1000U;
-    uint32_t rx_mbps_frac = rx_kbps % 1000U;
+    /* Mbps with 3 decimals from kbps, integer math */
+    uint32_t tx_kbps = hs_perf_kbps(m.tx_bytes, m.duration_ms);
+    uint32_t rx_kbps = hs_perf_kbps(m.rx_bytes, m.duration_ms);
 
     shell_print(shell,
         "  tx_throughput [Mbps]: %u.%03u\n"
-        "  rx_throughput [Mbps]: %u.%03u",
-        tx_mbps_int, tx_mbps_frac,
-        rx_mbps_int, rx_mbps_frac);
+        "  rx_throughput [Mbps]: %u.%03u\n"
+        "  tx_pps       : %u\n"
+        "  rx_pps       : %u",
+        tx_kbps / 1000U, tx_kbps % 1000U,
+        rx_kbps / 1000U, rx_kbps % 1000U,
+        hs_perf_pps(m.tx_pkts, m.duration_ms),
+        hs_perf_pps(m.rx_pkts, m.duration_ms));
+}
+
+    if (m.rtt_count > 0) {
+    shell_print(shell,
+        "  rtt [us]     : min %u / avg %u / max %u (%u samples)",
+        m.rtt_min_us, (uint32_t)(m.rtt_sum_us / m.rtt_count), m.rtt_max_us,
+        m.rtt_count);
+}
+
+    struct hs_core_rx_ring_stats rs;
+    hs_core_rx_ring_stats_get(&rs);
+
+    shell_print(shell,
+        "rx ring (%u frames):\n"
+        "  queued       : %u\n"
+        "  overflows    : %u\n"
+        "  truncated    : %u\n"
+        "  max_used     : %u",
+        HS_CORE_RX_RING_SIZE,
+        rs.frames,
+        rs.overflows,
+        rs.truncated,
+        rs.max_used);
+
+    struct hs_core_rx_cpu_stats cs;
+    hs_core_rx_cpu_stats_get(&cs);
+
+    shell_print(shell,
+        "rx cpu per packet (%u packets):\n"
+        "  avg [ns]     : %u\n"
+        "  max [ns]     : %u",
+        cs.frames,
+        cs.avg_ns,
+        cs.max_ns);
+
+    return 0;
+}
+
+/* hdect perf history [n]: the latest n interval snapshots, oldest first */
+int cmd_hdect_perf_history(const struct shell *shell,
+                           size_t argc, char **argv)
+{
+    uint32_t n = hs_perf_interval_count();
+    struct hs_perf_interval iv;
+
+    if (argc >= 2) {
+        n = MIN(n, (uint32_t)strtoul(argv[1], NULL, 10));
+    }
+
+    shell_print(shell, "%8s %8s %8s %6s %6s %8s",
+                "t_ms", "tx_kbps", "rx_kbps", "tx_pps", "rx_pps", "rtt_us");
+
+    for (int i = (int)n - 1; i >= 0; i--) {
+        if (hs_perf_interval_get(i, &iv)) {
+            continue;
+        }
+        shell_print(shell, "%8u %8u %8u %6u %6u %8u",
+                    iv.end_ms,
+                    hs_perf_kbps(iv.tx_bytes, iv.duration_ms),
+                    hs_perf_kbps(iv.rx_bytes, iv.duration_ms),
+                    hs_perf_pps(iv.tx_pkts, iv.duration_ms),
+                    hs_perf_pps(iv.rx_pkts, iv.duration_ms),
+                    iv.rtt_avg_us);
+    }
+    return 0;
+}
+
+/*
+ * hdect perf export: totals and interval snapshots as a packed little endian
+ * binary, printed as hex lines between "HSPF BEGIN" and "HSPF END":
+ *   struct hs_perf_export_hdr, then hdr.count x struct hs_perf_export_rec,
+ *   oldest interval first.
+ */
+#define HS_PERF_EXPORT_MAGIC    0x46505348u /* 'HSPF' */
+#define HS_PERF_EXPORT_VERSION  2
+#define HS_PERF_EXPORT_LINE     32
+
+struct __packed hs_perf_export_hdr {
+    uint32_t magic;
+    uint8_t  version;
+    uint8_t  rec_size;
+    uint16_t interval_ms;
+    uint16_t count;
+    uint16_t rsv;
+    uint32_t duration_ms;
+    uint64_t tx_pkts;
+    uint64_t rx_pkts;
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;
+    uint32_t rtt_count;
+    uint32_t rtt_min_us;
+    uint32_t rtt_max_us;
+    uint32_t rtt_avg_us;
+};
+
+struct __packed hs_perf_export_rec {
+    uint32_t end_ms;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    uint16_t tx_pkts;
+    uint16_t rx_pkts;
+    uint16_t rtt_count;
+    uint32_t rtt_avg_us;
+};
+
+static void hs_perf_export_hex(const struct shell *shell, const void *data, size_t len)
+{
+    char hex[2 * HS_PERF_EXPORT_LINE + 1];
+    const uint8_t *p = data;
+
+    while (len) {
+        size_t n = MIN(len, HS_PERF_EXPORT_LINE);
+
+        bin2hex(p, n, hex, sizeof(hex));
+        shell_print(shell, "%s", hex);
+        p += n;
+        len -= n;
+    }
 }
 
+int cmd_hdect_perf_export(const struct shell *shell,
+                          size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    struct hs_perf_metrics m;
+    struct hs_perf_interval iv;
+    uint32_t count = hs_perf_interval_count();
+
+    hs_perf_get(&m);
 
+    struct hs_perf_export_hdr hdr = {
+        .magic = HS_PERF_EXPORT_MAGIC,
+        .version = HS_PERF_EXPORT_VERSION,
+        .rec_size = sizeof(struct hs_perf_export_rec),
+        .interval_ms = HS_PERF_INTERVAL_MS,
+        .count = (uint16_t)count,
+        .duration_ms = m.duration_ms,
+        .tx_pkts = m.tx_pkts,
+        .rx_pkts = m.rx_pkts,
+        .tx_bytes = m.tx_bytes,
+        .rx_bytes = m.rx_bytes,
+        .rtt_count = m.rtt_count,
+        .rtt_min_us = m.rtt_min_us,
+        .rtt_max_us = m.rtt_max_us,
+        .rtt_avg_us = m.rtt_count ? (uint32_t)(m.rtt_sum_us / m.rtt_count) : 0,
+    };
+
+    shell_print(shell, "HSPF BEGIN");
+    hs_perf_export_hex(shell, &hdr, sizeof(hdr));
+
+    for (int i = (int)count - 1; i >= 0; i--) {
+        struct hs_perf_export_rec rec = { 0 };
+
+        if (hs_perf_interval_get(i, &iv) == 0) {
+            rec.end_ms = iv.end_ms;
+            rec.tx_bytes = iv.tx_bytes;
+            rec.rx_bytes = iv.rx_bytes;
+            rec.tx_pkts = (uint16_t)MIN(iv.tx_pkts, UINT16_MAX);
+            rec.rx_pkts = (uint16_t)MIN(iv.rx_pkts, UINT16_MAX);
+            rec.rtt_count = (uint16_t)MIN(iv.rtt_count, UINT16_MAX);
+            rec.rtt_avg_us = iv.rtt_avg_us;
+        }
+        hs_perf_export_hex(shell, &rec, sizeof(rec));
+    }
+    shell_print(shell, "HSPF END");
     return 0;
 }
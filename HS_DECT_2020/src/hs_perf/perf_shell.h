@@ -6,3 +6,5 @@ int cmd_hdect_perf_start(const struct shell *shell, size_t argc, char **argv);
 int cmd_hdect_perf_stop (const struct shell *shell, size_t argc, char **argv);
 int cmd_hdect_perf_reset(const struct shell *shell, size_t argc, char **argv);
 int cmd_hdect_perf_show (const struct shell *shell, size_t argc, char **argv);
+int cmd_hdect_perf_history(const struct shell *shell, size_t argc, char **argv);
+int cmd_hdect_perf_export(const struct shell *shell, size_t argc, char **argv);
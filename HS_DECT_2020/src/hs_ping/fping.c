@@ -2,76 +2,104 @@
 #include <zephyr/logging/log.h>
 #include <string.h>
 #include <stdio.h>
-#include <zephyr/sys/crc.h>
 #include "hs_shell.h"
 #include "fping.h"
 #include "core.h"
-#include <stdbool.h> 
-#include <zephyr/sys/crc.h>
+#include "scheduller.h"
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
-extern struct k_sem operation_sem;
 LOG_MODULE_REGISTER(fping, LOG_LEVEL_INF);
 
-/* --- CONFIG --- */
-#define PING_BUF_SIZE 64
-#define PING_TIMEOUT_MS 50
-
 /* --- STATE --- */
 static atomic_t fping_running = ATOMIC_INIT(0);
-static uint32_t fping_expected_seq = 0;
-static uint32_t fping_count_cfg = 0;
-static uint8_t last_rx_buf[2048];
-static size_t  last_rx_len;
+static uint32_t fping_len_cfg = FPING_LEN_DEFAULT;
+static uint32_t fping_window_cfg = FPING_WINDOW_DEFAULT;
+static uint32_t fping_loss_pct_cfg;
 
-static uint64_t last_tx_time_ms;
-static volatile bool exit_flag = false;
 /* ================================================
  *                 FPING PROTOCOL
  * ================================================ */
+/*
+ * Windowed reliable transfer with selective repeat:
+ *
+ *  client                          server
+ *   BEGIN (len, crc, chunk_len) ->
+ *                               <- ACK
+ *   DATA seq .. seq+n (last with ACK_REQ) ->
+ *                               <- ACK (cum_ack, SACK bitmap)
+ *   (unacked ones of the window are sent again with the new ones)
+ *   END ->
+ *                               <- ACK (DONE, CRC_OK)
+ *
+ * Radio is half duplex: the client queues a burst of DATA and right after
+ * the last one an RX for the ACK. The server ACKs on ACK_REQ only.
+ */
+
+#define FPING_MAGIC           0xF5
+
+/* Client: TX operations queued to modem at a time, back to back */
+#define FPING_PIPELINE_DEPTH  4
+#define FPING_TX_HANDLE_BASE  HS_CORE_HANDLE_FPING_BASE
+#define FPING_RX_HANDLE       (FPING_TX_HANDLE_BASE + FPING_PIPELINE_DEPTH)
 
-#define FPING_MAX_CHUNK   200   /* keep small enough for your DECT payload */
-#define FPING_MAGIC       0x46504E47u /* 'FPNG' */
+BUILD_ASSERT(FPING_RX_HANDLE < HS_CORE_HANDLE_FPING_BASE + HS_CORE_HANDLE_RANGE_SIZE);
+
+/* Chunk data is limited by the max TBS of the current MCS and by this (server buffers a
+ * window of chunks)
+ */
+#define FPING_CHUNK_MAX       512
+
+#define FPING_ACK_TIMEOUT_MS  50
+
+/* Slots per frame reserved by the client for DATA bursts, the rest of the
+ * frame is left for the ACKs. The server reserves slots for one ACK.
+ */
+#define FPING_SCHED_CLIENT_SLOTS  16
+#define FPING_RETRY_MAX       10
+#define FPING_RX_POLL_MS      100
 
 enum fping_type {
     FPING_BEGIN = 1,
-    FPING_CHUNK = 2,
+    FPING_DATA  = 2,
     FPING_END   = 3,
+    FPING_ACK   = 4,
+};
+
+#define FPING_FLAG_ACK_REQ    BIT(0)  /* data: reply with ACK */
+#define FPING_FLAG_DONE       BIT(1)  /* ACK: END received with all chunks */
+#define FPING_FLAG_CRC_OK     BIT(2)  /* ACK: ... and CRC matched */
+
+struct __packed fping_hdr {
+    uint8_t  magic;
+    uint8_t  type;
+    uint8_t  flags;
+    uint16_t xfer_id;
 };
 
 struct __packed fping_begin_pkt {
-    uint32_t magic;
-    uint8_t  type;          /* FPING_BEGIN */
-    uint8_t  rsv0;
-    uint16_t rsv1;
+    struct fping_hdr hdr;
     uint32_t total_len;
     uint32_t crc32_expected;
+    uint16_t chunk_len;
 };
 
-struct __packed fping_chunk_hdr {
-    uint32_t magic;
-    uint8_t  type;          /* FPING_CHUNK */
-    uint8_t  seq;
-    uint16_t data_len;
-    uint32_t offset;
-    /* followed by data[data_len] */
+struct __packed fping_data_hdr {
+    struct fping_hdr hdr;
+    uint32_t seq;
+    /* followed by chunk data */
 };
 
 struct __packed fping_end_pkt {
-    uint32_t magic;
-    uint8_t  type;          /* FPING_END */
-    uint8_t  rsv0;
-    uint16_t rsv1;
+    struct fping_hdr hdr;
+    uint32_t chunk_count;
 };
 
-static struct {
-    bool     active;
-    uint32_t expected_len;
-    uint32_t expected_crc;
-    uint32_t rxlen;
-    uint32_t rx_crc;  
-    uint32_t rx_total;    /* running CRC */
-} fping_srv;
+struct __packed fping_ack_pkt {
+    struct fping_hdr hdr;
+    uint32_t cum_ack;   /* all below are received */
+    uint32_t sack;      /* bit i: cum_ack + 1 + i received */
+};
 
 static void fping_fill_deterministic(uint8_t *dst, size_t len, uint32_t offset)
 {
@@ -95,177 +123,674 @@ static uint32_t hs_crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t l
     }
     return ~crc;
 }
-extern int core_get_last_rx(uint8_t *dst, size_t max_len, size_t *out_len);
+
+/* xorshift32: transfer ids and loss injection, no need for an entropy source */
+static uint32_t fping_rand_state;
+
+static uint32_t fping_rand(void)
+{
+    uint32_t x = fping_rand_state;
+
+    if (x == 0) {
+        x = k_cycle_get_32() | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    fping_rand_state = x;
+    return x;
+}
+
+static uint32_t fping_chunk_data_len(uint32_t total_len, uint32_t chunk_len, uint32_t seq)
+{
+    uint32_t off = seq * chunk_len;
+
+    return MIN(chunk_len, total_len - off);
+}
+
+/* Stop a pending RX operation and collect its completion */
+static void fping_rx_stop(void)
+{
+    if (hs_core_op_cancel(FPING_RX_HANDLE) == 0) {
+        (void)hs_core_op_wait(FPING_RX_HANDLE, K_FOREVER);
+    }
+}
 
 /* ================================================
- *                 SERVER THREAD
+ *                 TX PIPELINE
  * ================================================ */
-/* You need a way to read the last received payload from core.
- * If your core already exposes something like: core_get_last_rx(...)
- * use it. If not, see section 2 below for a minimal core.c helper.
+/* Up to FPING_PIPELINE_DEPTH TX operations are given to modem at explicit start times one
+ * after another, a slot is freed by the completion callback.
  */
+static K_SEM_DEFINE(fping_tx_slots, FPING_PIPELINE_DEPTH, FPING_PIPELINE_DEPTH);
+static atomic_t fping_tx_failed;
+static uint64_t fping_tx_next_time;
+static uint32_t fping_tx_idx;
 
-static void fping_server_thread(void *a, void *b, void *c)
+/* Reservation of the running side, negative if none */
+static int fping_sched_id = -1;
+
+static void fping_sched_reserve(uint32_t slots, const char *owner)
 {
-    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
+    fping_sched_id = hs_sched_reserve_any(slots, 1, owner);
+    if (fping_sched_id < 0) {
+        LOG_WRN("No slots reserved (%d), TX with LBT", fping_sched_id);
+    }
+}
 
-    uint8_t rxbuf[300]; /* must be >= max packet size you expect */
-    size_t rxlen = 0;
+static void fping_sched_release(void)
+{
+    hs_sched_release(fping_sched_id);
+    fping_sched_id = -1;
+}
 
-    memset(&fping_srv, 0, sizeof(fping_srv));
+static void fping_tx_done(uint32_t handle, int err, uint64_t time, void *user_data)
+{
+    if (err) {
+        atomic_inc(&fping_tx_failed);
+    }
+    k_sem_give(&fping_tx_slots);
+}
 
-    while (!exit_flag) {
+static void fping_tx_pipeline_reset(void)
+{
+    k_sem_reset(&fping_tx_slots);
+    for (int i = 0; i < FPING_PIPELINE_DEPTH; i++) {
+        k_sem_give(&fping_tx_slots);
+    }
+    atomic_set(&fping_tx_failed, 0);
+    fping_tx_next_time = 0;
+    fping_tx_idx = 0;
+}
 
-        /* arm RX */
-        receive(0);
-        k_sem_take(&operation_sem, K_FOREVER);
+static int fping_tx_queue(const void *data, size_t len)
+{
+    static const struct hs_core_op_cb cb = { .done = fping_tx_done };
+    uint32_t handle = FPING_TX_HANDLE_BASE + (fping_tx_idx % FPING_PIPELINE_DEPTH);
+    uint64_t earliest;
+    int err;
 
-        if (core_get_last_rx(rxbuf, sizeof(rxbuf), &rxlen) != 0) {
-            continue;
+    k_sem_take(&fping_tx_slots, K_FOREVER);
+
+    /* Back to back with the previous one unless the pipeline has run dry */
+    earliest = hs_core_modem_time_now() + HS_CORE_START_LEAD_MDM_TICKS;
+    if (fping_tx_next_time < earliest) {
+        fping_tx_next_time = earliest;
+    }
+    /* Into the reserved slots, to the next frame if it does not fit */
+    fping_tx_next_time = hs_sched_place(fping_sched_id, fping_tx_next_time,
+                                        hs_core_tx_duration_get(len));
+
+    /* Copied by modem lib at queueing, data is free on return */
+    err = hs_core_tx_async(handle, data, len, fping_tx_next_time, &cb);
+    if (err) {
+        k_sem_give(&fping_tx_slots);
+        return err;
+    }
+    fping_tx_next_time += hs_core_tx_duration_get(len) + HS_CORE_OP_GAP_MDM_TICKS;
+    fping_tx_idx++;
+    return 0;
+}
+
+/* Wait for all queued to complete */
+static void fping_tx_drain(void)
+{
+    for (int i = 0; i < FPING_PIPELINE_DEPTH; i++) {
+        k_sem_take(&fping_tx_slots, K_FOREVER);
+    }
+    for (int i = 0; i < FPING_PIPELINE_DEPTH; i++) {
+        k_sem_give(&fping_tx_slots);
+    }
+}
+
+/* ================================================
+ *                 SERVER
+ * ================================================ */
+/* Out of order chunks are buffered within the window until the missing ones
+ * arrive: CRC is calculated in order.
+ */
+static struct {
+    bool     active;
+    bool     done;
+    bool     crc_ok;
+    uint16_t xfer_id;
+    uint32_t expected_len;
+    uint32_t expected_crc;
+    uint32_t chunk_len;
+    uint32_t chunk_count;
+
+    uint32_t rcv_base;    /* next in order */
+    uint32_t sack;        /* bit i: rcv_base + 1 + i buffered */
+    uint32_t rxlen;
+    uint32_t rx_crc;      /* running CRC */
+
+    uint32_t duplicates;
+    uint32_t dropped;     /* by loss injection */
+    int64_t  start_ms;
+
+    uint16_t slot_len[FPING_WINDOW_MAX];
+    uint8_t  slots[FPING_WINDOW_MAX][FPING_CHUNK_MAX];
+} fping_srv;
+
+static void fping_server_deliver(const uint8_t *data, uint32_t len)
+{
+    fping_srv.rx_crc = hs_crc32_ieee_update(fping_srv.rx_crc, data, len);
+    fping_srv.rxlen += len;
+    fping_srv.rcv_base++;
+}
+
+static void fping_server_begin(const struct fping_begin_pkt *p)
+{
+    if (fping_srv.active && fping_srv.xfer_id == p->hdr.xfer_id) {
+        return; /* retransmitted BEGIN */
+    }
+    if (p->chunk_len == 0 || p->chunk_len > FPING_CHUNK_MAX) {
+        LOG_WRN("FPING BEGIN: unsupported chunk_len %u", p->chunk_len);
+        return;
+    }
+
+    memset(&fping_srv, 0, offsetof(typeof(fping_srv), slot_len));
+    fping_srv.active = true;
+    fping_srv.xfer_id = p->hdr.xfer_id;
+    fping_srv.expected_len = p->total_len;
+    fping_srv.expected_crc = p->crc32_expected;
+    fping_srv.chunk_len = p->chunk_len;
+    fping_srv.chunk_count = DIV_ROUND_UP(p->total_len, p->chunk_len);
+    fping_srv.start_ms = k_uptime_get();
+
+    LOG_INF("FPING BEGIN: len=%u crc=0x%08x chunk_len=%u", p->total_len, p->crc32_expected,
+            p->chunk_len);
+}
+
+static void fping_server_data(const struct fping_data_hdr *h, size_t rxlen)
+{
+    const uint8_t *data = (const uint8_t *)(h + 1);
+    uint32_t seq = h->seq;
+    uint32_t n;
+
+    if (seq >= fping_srv.chunk_count) {
+        return;
+    }
+    n = fping_chunk_data_len(fping_srv.expected_len, fping_srv.chunk_len, seq);
+    if (sizeof(*h) + n > rxlen) {
+        return;
+    }
+
+    if (seq < fping_srv.rcv_base) {
+        fping_srv.duplicates++;
+        return;
+    }
+    if (seq - fping_srv.rcv_base >= FPING_WINDOW_MAX) {
+        return; /* beyond the window */
+    }
+    if (seq > fping_srv.rcv_base && (fping_srv.sack & BIT(seq - fping_srv.rcv_base - 1))) {
+        fping_srv.duplicates++;
+        return;
+    }
+
+    if (seq > fping_srv.rcv_base) {
+        uint32_t slot = seq % FPING_WINDOW_MAX;
+
+        memcpy(fping_srv.slots[slot], data, n);
+        fping_srv.slot_len[slot] = (uint16_t)n;
+        fping_srv.sack |= BIT(seq - fping_srv.rcv_base - 1);
+        return;
+    }
+
+    /* In order: this one and the buffered ones following it */
+    fping_server_deliver(data, n);
+
+    while (fping_srv.sack & BIT(0)) {
+        uint32_t slot = fping_srv.rcv_base % FPING_WINDOW_MAX;
+
+        fping_srv.sack >>= 1;
+        fping_server_deliver(fping_srv.slots[slot], fping_srv.slot_len[slot]);
+    }
+    fping_srv.sack >>= 1;
+}
+
+static void fping_server_end(void)
+{
+    int64_t elapsed_ms;
+
+    if (fping_srv.done || fping_srv.rcv_base != fping_srv.chunk_count) {
+        return;
+    }
+
+    fping_srv.done = true;
+    fping_srv.crc_ok = (fping_srv.rxlen == fping_srv.expected_len) &&
+                       (fping_srv.rx_crc == fping_srv.expected_crc);
+    elapsed_ms = k_uptime_get() - fping_srv.start_ms;
+
+    LOG_INF("FPING END: rxlen=%u exp_len=%u rx_crc=0x%08x exp_crc=0x%08x => %s",
+            fping_srv.rxlen, fping_srv.expected_len,
+            fping_srv.rx_crc, fping_srv.expected_crc,
+            fping_srv.crc_ok ? "OK" : "FAIL");
+    LOG_INF("FPING server: %lld ms, %u duplicates, %u dropped by loss injection",
+            elapsed_ms, fping_srv.duplicates, fping_srv.dropped);
+}
+
+/* Returns true if an ACK was requested */
+static bool fping_server_handle(const uint8_t *rxbuf, size_t rxlen)
+{
+    const struct fping_hdr *hdr = (const struct fping_hdr *)rxbuf;
+
+    if (rxlen < sizeof(*hdr) || hdr->magic != FPING_MAGIC) {
+        return false;
+    }
+
+    if (hdr->type == FPING_BEGIN) {
+        if (rxlen < sizeof(struct fping_begin_pkt)) {
+            return false;
         }
-        if (rxlen < 8) {
-            continue;
+        fping_server_begin((const struct fping_begin_pkt *)rxbuf);
+    } else if (!fping_srv.active || hdr->xfer_id != fping_srv.xfer_id) {
+        return false;
+    } else if (hdr->type == FPING_DATA) {
+        if (rxlen < sizeof(struct fping_data_hdr)) {
+            return false;
         }
+        if (fping_loss_pct_cfg && (fping_rand() % 100) < fping_loss_pct_cfg) {
+            fping_srv.dropped++;
+            return false;
+        }
+        fping_server_data((const struct fping_data_hdr *)rxbuf, rxlen);
+    } else if (hdr->type == FPING_END) {
+        fping_server_end();
+    } else {
+        return false;
+    }
 
-        uint32_t magic = *(uint32_t *)&rxbuf[0];
-        uint8_t type = rxbuf[4];
+    return fping_srv.active && hdr->xfer_id == fping_srv.xfer_id &&
+           (hdr->flags & FPING_FLAG_ACK_REQ);
+}
 
-        if (magic != FPING_MAGIC) {
-            continue;
-        }
+/* RX operation without a pdc callback: packets are queued into the hs_core RX ring */
+static int fping_server_rx_arm(void)
+{
+    return hs_core_rx_async(FPING_RX_HANDLE, HS_CORE_START_NOW, 0, NULL);
+}
 
-        if (type == FPING_BEGIN) {
-            if (rxlen < sizeof(struct fping_begin_pkt)) continue;
-            const struct fping_begin_pkt *p = (const struct fping_begin_pkt *)rxbuf;
+static int fping_server_ack_send(void)
+{
+    struct fping_ack_pkt ack = {
+        .hdr = {
+            .magic = FPING_MAGIC,
+            .type = FPING_ACK,
+            .flags = (fping_srv.done ? FPING_FLAG_DONE : 0) |
+                     (fping_srv.crc_ok ? FPING_FLAG_CRC_OK : 0),
+            .xfer_id = fping_srv.xfer_id,
+        },
+        .cum_ack = fping_srv.rcv_base,
+        .sack = fping_srv.sack,
+    };
+    int err;
+
+    /* Half duplex */
+    fping_rx_stop();
+
+    err = hs_core_tx_async(FPING_TX_HANDLE_BASE, &ack, sizeof(ack),
+                           hs_sched_place(fping_sched_id,
+                                          hs_core_modem_time_now() +
+                                          HS_CORE_START_LEAD_MDM_TICKS,
+                                          hs_core_tx_duration_get(sizeof(ack))),
+                           NULL);
+    if (!err) {
+        err = hs_core_op_wait(FPING_TX_HANDLE_BASE, K_FOREVER);
+    }
+    if (err) {
+        LOG_WRN("FPING ACK TX failed: %d", err);
+    }
+    return fping_server_rx_arm();
+}
 
-            fping_srv.active = true;
-            fping_srv.expected_len = p->total_len;
-            fping_srv.expected_crc = p->crc32_expected;
-            fping_srv.rxlen = 0;
-            fping_srv.rx_crc = 0;
+static void fping_server_thread(void *a, void *b, void *c)
+{
+    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
 
-            LOG_INF("FPING BEGIN: len=%u crc=0x%08x", p->total_len, p->crc32_expected);
-        }
-        else if (type == FPING_CHUNK) {
-            if (!fping_srv.active) continue;
-            if (rxlen < sizeof(struct fping_chunk_hdr)) continue;
-
-            const struct fping_chunk_hdr *h = (const struct fping_chunk_hdr *)rxbuf;
-            const uint8_t *data = rxbuf + sizeof(*h);
-            int rxlen = (int)last_rx_len;
-            if (rxlen < (int)sizeof(*h)) {
-                continue; /* not enough for header */
-            }
-            size_t data_len = (size_t)rxlen - sizeof(*h);
-            uint32_t n = h->data_len;
+    struct hs_core_rx_ring_stats stats;
+    uint32_t overflows_at_start;
+    int err;
 
-            if (sizeof(*h) + n > rxlen) continue;
+    memset(&fping_srv, 0, offsetof(typeof(fping_srv), slot_len));
 
-            /* update running CRC + length */
-           fping_srv.rx_crc = hs_crc32_ieee_update(fping_srv.rx_crc, data, data_len);
+    if (dect_session_open() != 0) {
+        LOG_ERR("Cannot open DECT session");
+        atomic_set(&fping_running, 0);
+        return;
+    }
+    hs_core_rx_ring_stats_get(&stats);
+    overflows_at_start = stats.overflows;
+    fping_sched_reserve(HS_SCHED_SLOTS_FOR(hs_core_tx_duration_get(sizeof(struct fping_ack_pkt))),
+                        "fping server");
 
+    LOG_INF("FPING server started, loss injection %u%%", fping_loss_pct_cfg);
 
-            fping_srv.rxlen += n;
+    err = fping_server_rx_arm();
+
+    while (!err && atomic_get(&fping_running)) {
+        uint32_t n = hs_core_rx_ring_wait(K_MSEC(FPING_RX_POLL_MS));
+        bool ack_req = false;
+
+        if (n == 0) {
+            /* RX window over: re-arm */
+            if (hs_core_op_wait(FPING_RX_HANDLE, K_NO_WAIT) != -EAGAIN) {
+                err = fping_server_rx_arm();
+            }
+            continue;
         }
-        else if (type == FPING_END) {
-            if (!fping_srv.active) continue;
 
-            bool ok_len = (fping_srv.rxlen == fping_srv.expected_len);
-            bool ok_crc = (fping_srv.rx_crc == fping_srv.expected_crc);
+        /* Drain in a batch, one ACK for all of it */
+        for (uint32_t i = 0; i < n; i++) {
+            const struct hs_core_rx_frame *frame = hs_core_rx_ring_frame_get(i);
 
-            LOG_INF("FPING END: rxlen=%u exp_len=%u rx_crc=0x%08x exp_crc=0x%08x => %s",
-                    fping_srv.rxlen, fping_srv.expected_len,
-                    fping_srv.rx_crc, fping_srv.expected_crc,
-                    (ok_len && ok_crc) ? "OK" : "FAIL");
+            ack_req |= fping_server_handle(frame->data, frame->len);
+        }
+        hs_core_rx_ring_release(n);
 
-            fping_srv.active = false;
+        if (ack_req) {
+            err = fping_server_ack_send();
         }
     }
+    if (err) {
+        LOG_ERR("FPING RX failed: %d", err);
+    }
+
+    fping_rx_stop();
+    hs_core_rx_ring_stats_get(&stats);
+    if (stats.overflows != overflows_at_start) {
+        LOG_WRN("FPING server: %u packets dropped, RX ring full",
+                stats.overflows - overflows_at_start);
+    }
+    fping_sched_release();
+    dect_session_close();
+    atomic_set(&fping_running, 0);
 }
 
 /* ================================================
- *                 CLIENT THREAD
+ *                 CLIENT
  * ================================================ */
-static void fping_client_thread(void *a, void *b, void *c)
+static struct {
+    uint16_t xfer_id;
+    uint32_t total_len;
+    uint32_t chunk_len;
+    uint32_t chunk_count;
+    uint32_t window;
+
+    uint32_t snd_base;    /* oldest unacked */
+    uint32_t snd_next;    /* next new one */
+    uint32_t acked;       /* bit i: snd_base + i selectively acked */
+
+    uint32_t data_tx;
+    uint32_t retx;
+    uint32_t ack_timeouts;
+} fping_cli;
+
+static void fping_client_hdr_init(struct fping_hdr *hdr, uint8_t type, uint8_t flags)
 {
-    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
+    hdr->magic = FPING_MAGIC;
+    hdr->type = type;
+    hdr->flags = flags;
+    hdr->xfer_id = fping_cli.xfer_id;
+}
 
-    /* You can change these defaults later */
-    const uint32_t total_len = 1024;   /* send 1 KB deterministic binary */
-    const uint32_t chunk_len = FPING_MAX_CHUNK;
+/* RX for the ACK right after the queued TX, then wait for the ACK */
+static int fping_client_ack_rx(struct fping_ack_pkt *ack)
+{
+    uint64_t start = MAX(fping_tx_next_time,
+                         hs_core_modem_time_now() + HS_CORE_START_LEAD_MDM_TICKS);
+    bool found = false;
+    int err;
+
+    err = hs_core_rx_async(FPING_RX_HANDLE, start, HS_MS_TO_MODEM_TICKS(FPING_ACK_TIMEOUT_MS),
+                           NULL);
+    fping_tx_drain();
+    if (err) {
+        return err;
+    }
 
-    /* compute expected CRC of deterministic data */
-    uint32_t crc = 0;
-    uint8_t tmp[FPING_MAX_CHUNK];
-    for (uint32_t off = 0; off < total_len; off += chunk_len) {
-        uint32_t n = total_len - off;
-        if (n > chunk_len) n = chunk_len;
-        fping_fill_deterministic(tmp, n, off);
-       
+    while (!found) {
+        /* PDCs are in the ring before the RX completion */
+        bool rx_over = (hs_core_op_wait(FPING_RX_HANDLE, K_NO_WAIT) != -EAGAIN);
+        uint32_t n = hs_core_rx_ring_wait(rx_over ? K_NO_WAIT : K_MSEC(10));
+
+        for (uint32_t i = 0; i < n; i++) {
+            const struct hs_core_rx_frame *frame = hs_core_rx_ring_frame_get(i);
+            const struct fping_ack_pkt *p = (const struct fping_ack_pkt *)frame->data;
+
+            if (frame->len >= sizeof(*p) && p->hdr.magic == FPING_MAGIC &&
+                p->hdr.type == FPING_ACK && p->hdr.xfer_id == fping_cli.xfer_id) {
+                *ack = *p;
+                found = true;
+            }
+        }
+        hs_core_rx_ring_release(n);
+
+        if (!found && rx_over) {
+            fping_cli.ack_timeouts++;
+            return -ETIMEDOUT;
+        }
+    }
+    fping_rx_stop();
+    return 0;
+}
+
+static void fping_client_ack_apply(const struct fping_ack_pkt *ack)
+{
+    uint32_t shift;
+
+    if (ack->cum_ack < fping_cli.snd_base || ack->cum_ack > fping_cli.snd_next) {
+        return; /* stale */
     }
 
-    /* SEND BEGIN */
+    shift = ack->cum_ack - fping_cli.snd_base;
+    fping_cli.acked = (shift >= 32) ? 0 : (fping_cli.acked >> shift);
+    fping_cli.snd_base = ack->cum_ack;
+
+    /* SACK bit i is snd_base + 1 + i */
+    fping_cli.acked |= ack->sack << 1;
+}
+
+static int fping_client_data_send(uint32_t seq, bool ack_req)
+{
+    uint8_t buf[sizeof(struct fping_data_hdr) + FPING_CHUNK_MAX];
+    struct fping_data_hdr *h = (struct fping_data_hdr *)buf;
+    uint32_t n = fping_chunk_data_len(fping_cli.total_len, fping_cli.chunk_len, seq);
+
+    fping_client_hdr_init(&h->hdr, FPING_DATA, ack_req ? FPING_FLAG_ACK_REQ : 0);
+    h->seq = seq;
+    fping_fill_deterministic(buf + sizeof(*h), n, seq * fping_cli.chunk_len);
+
+    fping_cli.data_tx++;
+    return fping_tx_queue(buf, sizeof(*h) + n);
+}
+
+/* Unacked ones of the window again, then new ones up to the window */
+static int fping_client_burst_send(void)
+{
+    uint32_t seqs[FPING_WINDOW_MAX];
+    uint32_t count = 0;
+    int err = 0;
+
+    for (uint32_t seq = fping_cli.snd_base; seq < fping_cli.snd_next; seq++) {
+        if (!(fping_cli.acked & BIT(seq - fping_cli.snd_base))) {
+            seqs[count++] = seq;
+            fping_cli.retx++;
+        }
+    }
+    while (fping_cli.snd_next < fping_cli.snd_base + fping_cli.window &&
+           fping_cli.snd_next < fping_cli.chunk_count) {
+        seqs[count++] = fping_cli.snd_next++;
+    }
+
+    for (uint32_t i = 0; i < count && !err; i++) {
+        err = fping_client_data_send(seqs[i], i == count - 1);
+    }
+    return err;
+}
+
+/* BEGIN/END until ACKed */
+static int fping_client_ctrl_exchange(const void *pkt, size_t len, struct fping_ack_pkt *ack)
+{
+    int err = -ETIMEDOUT;
+
+    for (int i = 0; i < FPING_RETRY_MAX && atomic_get(&fping_running); i++) {
+        err = fping_tx_queue(pkt, len);
+        if (err) {
+            fping_tx_drain();
+            return err;
+        }
+        err = fping_client_ack_rx(ack);
+        if (err != -ETIMEDOUT) {
+            return err;
+        }
+    }
+    return err;
+}
+
+static int fping_client_transfer(uint32_t crc)
+{
+    struct fping_ack_pkt ack;
+    uint32_t timeouts = 0;
+    int err;
+
     struct fping_begin_pkt begin = {
-        .magic = FPING_MAGIC,
-        .type = FPING_BEGIN,
-        .total_len = total_len,
+        .total_len = fping_cli.total_len,
         .crc32_expected = crc,
+        .chunk_len = (uint16_t)fping_cli.chunk_len,
     };
 
-    transmit(0, &begin, sizeof(begin));
-    k_sem_take(&operation_sem, K_FOREVER);
+    fping_client_hdr_init(&begin.hdr, FPING_BEGIN, FPING_FLAG_ACK_REQ);
+    err = fping_client_ctrl_exchange(&begin, sizeof(begin), &ack);
+    if (err) {
+        LOG_ERR("FPING BEGIN not acked: %d", err);
+        return err;
+    }
 
-    /* SEND CHUNKS */
-    uint8_t buf[sizeof(struct fping_chunk_hdr) + FPING_MAX_CHUNK];
-    uint8_t seq = 0;
+    while (fping_cli.snd_base < fping_cli.chunk_count) {
+        if (!atomic_get(&fping_running)) {
+            return -ECANCELED;
+        }
 
-    for (uint32_t off = 0; off < total_len; off += chunk_len) {
-        uint32_t n = total_len - off;
-        if (n > chunk_len) n = chunk_len;
+        err = fping_client_burst_send();
+        if (err) {
+            fping_tx_drain();
+            return err;
+        }
+        err = fping_client_ack_rx(&ack);
+        if (err == -ETIMEDOUT) {
+            if (++timeouts >= FPING_RETRY_MAX) {
+                LOG_ERR("FPING: no ACK in %u tries", timeouts);
+                return err;
+            }
+            continue;
+        } else if (err) {
+            return err;
+        }
+        timeouts = 0;
+        fping_client_ack_apply(&ack);
+    }
 
-        struct fping_chunk_hdr *h = (struct fping_chunk_hdr *)buf;
-        h->magic = FPING_MAGIC;
-        h->type = FPING_CHUNK;
-        h->seq = seq++;
-        h->data_len = (uint16_t)n;
-        h->offset = off;
+    struct fping_end_pkt end = {
+        .chunk_count = fping_cli.chunk_count,
+    };
 
-        fping_fill_deterministic(buf + sizeof(*h), n, off);
+    fping_client_hdr_init(&end.hdr, FPING_END, FPING_FLAG_ACK_REQ);
+    err = fping_client_ctrl_exchange(&end, sizeof(end), &ack);
+    if (err) {
+        LOG_ERR("FPING END not acked: %d", err);
+        return err;
+    }
+    if (!(ack.hdr.flags & FPING_FLAG_DONE)) {
+        return -EIO;
+    }
+    return (ack.hdr.flags & FPING_FLAG_CRC_OK) ? 0 : -EBADMSG;
+}
+
+static void fping_client_thread(void *a, void *b, void *c)
+{
+    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
 
-        transmit(0, buf, sizeof(*h) + n);
-        k_sem_take(&operation_sem, K_FOREVER);
+    uint8_t tmp[FPING_CHUNK_MAX];
+    size_t payload_max;
+    uint32_t crc = 0;
+    int64_t start_ms;
+    int64_t elapsed_ms;
+    int err;
+
+    if (dect_session_open() != 0) {
+        LOG_ERR("Cannot open DECT session");
+        atomic_set(&fping_running, 0);
+        return;
     }
 
-    /* SEND END */
-    struct fping_end_pkt end = {
-        .magic = FPING_MAGIC,
-        .type = FPING_END,
-    };
+    /* Chunks fill the transport block of the current MCS */
+    payload_max = hs_core_tx_payload_max_get();
+    if (payload_max <= sizeof(struct fping_data_hdr) ||
+        payload_max < sizeof(struct fping_begin_pkt)) {
+        LOG_ERR("FPING: max payload %u too small", (uint32_t)payload_max);
+        goto out;
+    }
+
+    memset(&fping_cli, 0, sizeof(fping_cli));
+    fping_cli.xfer_id = (uint16_t)fping_rand();
+    fping_cli.total_len = fping_len_cfg;
+    fping_cli.chunk_len = MIN(payload_max - sizeof(struct fping_data_hdr), FPING_CHUNK_MAX);
+    fping_cli.chunk_count = DIV_ROUND_UP(fping_cli.total_len, fping_cli.chunk_len);
+    fping_cli.window = fping_window_cfg;
 
-    transmit(0, &end, sizeof(end));
-    k_sem_take(&operation_sem, K_FOREVER);
+    /* compute expected CRC of deterministic data */
+    for (uint32_t off = 0; off < fping_cli.total_len; off += fping_cli.chunk_len) {
+        uint32_t n = MIN(fping_cli.chunk_len, fping_cli.total_len - off);
+
+        fping_fill_deterministic(tmp, n, off);
+        crc = hs_crc32_ieee_update(crc, tmp, n);
+    }
+
+    LOG_INF("FPING client: len=%u chunk_len=%u chunks=%u window=%u",
+            fping_cli.total_len, fping_cli.chunk_len, fping_cli.chunk_count, fping_cli.window);
+
+    fping_sched_reserve(FPING_SCHED_CLIENT_SLOTS, "fping client");
+    fping_tx_pipeline_reset();
+    start_ms = k_uptime_get();
+
+    err = fping_client_transfer(crc);
 
-    LOG_INF("FPING client finished: len=%u crc=0x%08x", total_len, crc);
+    elapsed_ms = k_uptime_get() - start_ms;
+
+    LOG_INF("FPING client finished: len=%u crc=0x%08x => %s (%d)",
+            fping_cli.total_len, crc, err ? "FAIL" : "OK", err);
+    LOG_INF("FPING client: %lld ms, goodput %u kbps, %u data TX, %u retransmitted, "
+            "%u ACK timeouts, %ld TX failed",
+            elapsed_ms,
+            (!err && elapsed_ms) ? (uint32_t)(fping_cli.total_len * 8LL / elapsed_ms) : 0,
+            fping_cli.data_tx, fping_cli.retx, fping_cli.ack_timeouts,
+            atomic_get(&fping_tx_failed));
+out:
+    fping_sched_release();
+    dect_session_close();
+    atomic_set(&fping_running, 0);
 }
 
 /* ================================================
  *             PUBLIC START/STOP FUNCTIONS
  * ================================================ */
 
-K_THREAD_STACK_DEFINE(fping_stack, 2048);
+K_THREAD_STACK_DEFINE(fping_stack, 3072);
 static struct k_thread fping_thread;
 
-int fping_server_start(void)
+int fping_server_start(uint32_t loss_pct)
 {
     if (atomic_get(&fping_running)) {
         LOG_WRN("FPING already running");
         return -EBUSY;
     }
-
-    mac_rtt_set_enabled(false);   /* <--- no MAC RTT on server */
+    if (loss_pct > 100) {
+        return -EINVAL;
+    }
 
     atomic_set(&fping_running, 1);
-    fping_expected_seq = 0;
+    fping_loss_pct_cfg = loss_pct;
 
     k_thread_create(&fping_thread, fping_stack, K_THREAD_STACK_SIZEOF(fping_stack),
                     fping_server_thread, NULL, NULL, NULL,
@@ -275,18 +800,20 @@ int fping_server_start(void)
 }
 
 
-int fping_client_start(uint32_t count)
+int fping_client_start(uint32_t total_len, uint32_t window)
 {
-    fping_count_cfg = count;
     if (atomic_get(&fping_running)) {
         LOG_WRN("FPING already running");
         return -EBUSY;
     }
+    if (total_len == 0 || window == 0 || window > FPING_WINDOW_MAX) {
+        return -EINVAL;
+    }
 
+    fping_len_cfg = total_len;
+    fping_window_cfg = window;
     atomic_set(&fping_running, 1);
 
-    mac_rtt_set_enabled(true);    /* <--- MAC RTT only on client */
-
     k_thread_create(&fping_thread, fping_stack, K_THREAD_STACK_SIZEOF(fping_stack),
                     fping_client_thread, NULL, NULL, NULL,
                     5, 0, K_NO_WAIT);
@@ -304,4 +831,4 @@ void fping_stop(void)
     LOG_INF("Stopping FPING...");
     atomic_set(&fping_running, 0);
 
-}
\ No newline at end of file
+}
@@ -1,28 +1,13 @@
 #pragma once
 #include <stdint.h>
 
-int fping_server_start(void);
-int fping_client_start(uint32_t count);
-void fping_stop(void);
-enum fping_pkt_type {
-    FPING_PKT_BEGIN = 1,
-    FPING_PKT_CHUNK = 2,
-    FPING_PKT_END   = 3,
-};
-
-struct fping_begin {
-    uint8_t  type;
-    uint32_t total_len;
-    uint32_t crc32;
-};
+/* Window of the reliable transfer: in chunks, limited by the SACK bitmap */
+#define FPING_WINDOW_MAX      32
+#define FPING_WINDOW_DEFAULT  16
 
-struct fping_chunk {
-    uint8_t  type;
-    uint16_t seq;
-    uint16_t len;
-    uint8_t  data[0];
-};
+#define FPING_LEN_DEFAULT     (16 * 1024)
 
-struct fping_end {
-    uint8_t  type;
-};
+/* loss_pct: received DATA dropped on purpose, for goodput vs loss tests */
+int fping_server_start(uint32_t loss_pct);
+int fping_client_start(uint32_t total_len, uint32_t window);
+void fping_stop(void);
@@ -2,32 +2,121 @@
 #include <zephyr/logging/log.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <zephyr/sys/crc.h>
 #include <zephyr/sys/byteorder.h>
 #include "hs_shell.h"
 #include "ping.h"
 #include "core.h"
-extern struct k_sem operation_sem;
+#include "rtt.h"
+#include "scheduller.h"
 LOG_MODULE_REGISTER(ping, LOG_LEVEL_INF);
 
 /* --- CONFIG --- */
 #define PING_BUF_SIZE 64
+#define PING_MSG_LEN  sizeof(struct hs_msg_hdr)
 #define PING_TIMEOUT_MS 50
 
 static atomic_t ping_running = ATOMIC_INIT(0);
 static uint32_t ping_expected_seq = 0;
 static uint32_t ping_count_cfg = 0;
 
-static uint64_t last_tx_time_ms;
+#define PING_TX_HANDLE HS_CORE_HANDLE_PING_BASE
+#define PING_RX_HANDLE (PING_TX_HANDLE + 1)
 
+/* Polling period of the stop request while waiting for a packet */
+#define PING_POLL_MS 100
+
+/* Both sides TX in own slots, every frame */
+#define PING_SCHED_PERIOD_FRAMES 1
+
+/* Reservation for the TX of the running side, negative if none */
+static int ping_sched_id = -1;
+
+static void ping_sched_reserve(const char *owner)
+{
+    uint32_t slots = HS_SCHED_SLOTS_FOR(hs_core_tx_duration_get(PING_MSG_LEN));
+
+    ping_sched_id = hs_sched_reserve_any(slots, PING_SCHED_PERIOD_FRAMES, owner);
+    if (ping_sched_id < 0) {
+        LOG_WRN("No slots reserved (%d), TX with LBT", ping_sched_id);
+    }
+}
+
+static void ping_sched_release(void)
+{
+    hs_sched_release(ping_sched_id);
+    ping_sched_id = -1;
+}
+
+/* Start of a TX of len in own slots */
+static uint64_t ping_tx_time_get(size_t len)
+{
+    return hs_sched_place(ping_sched_id,
+                          hs_core_modem_time_now() + HS_CORE_START_LEAD_MDM_TICKS,
+                          hs_core_tx_duration_get(len));
+}
+
+/* What the RX of each side accepts. Replies to the client are RTT probes. */
+struct ping_rx_ctx {
+    uint8_t type;
+    bool    rtt;
+};
+
+static const struct ping_rx_ctx ping_server_rx_ctx = { .type = HS_MSG_PING, .rtt = false };
+static const struct ping_rx_ctx ping_client_rx_ctx = { .type = HS_MSG_PONG, .rtt = true };
+
+/* Sequence number and RTT (negative if not measured) of the latest matching
+ * packet, given from the message handler
+ */
+static uint32_t ping_rx_seq;
+static int32_t ping_rx_rtt_us;
+static K_SEM_DEFINE(ping_rx_sem, 0, 1);
+
+static void ping_rx_msg(uint32_t handle, const struct hs_msg_hdr *hdr, const void *payload,
+                        size_t len, uint64_t time, void *user_data)
+{
+    const struct ping_rx_ctx *ctx = user_data;
+
+    if (handle != PING_RX_HANDLE) {
+        return;
+    }
+    ping_rx_seq = hdr->seq;
+    ping_rx_rtt_us = ctx->rtt ? hs_rtt_probe_rx(ping_rx_seq, time) : -ENOENT;
+    k_sem_give(&ping_rx_sem);
+}
+
+/* Other traffic received in the ping RX windows is dropped */
+static void ping_rx_other(uint32_t handle, const void *data, size_t len, uint64_t time,
+                          void *user_data)
+{
+}
+
+static int ping_rx_register(const struct ping_rx_ctx *ctx)
+{
+    int err = hs_msg_handler_register(ctx->type, ping_rx_msg, (void *)ctx);
+
+    if (err) {
+        LOG_ERR("Cannot register handler of type %u: %d", ctx->type, err);
+    }
+    return err;
+}
+
+/* Stop a pending RX operation and collect its completion */
+static void ping_rx_stop(void)
+{
+    if (hs_core_op_cancel(PING_RX_HANDLE) == 0) {
+        (void)hs_core_op_wait(PING_RX_HANDLE, K_FOREVER);
+    }
+}
 
 /* ================================================
  *                 SERVER MODE
  * ================================================ */
 static void ping_server_thread(void *p1, void *p2, void *p3)
 {
-    uint32_t rx_handle = 1;
-    char buf[PING_BUF_SIZE];
+    const struct hs_core_op_cb rx_cb = { .pdc = ping_rx_other };
+    uint8_t buf[PING_BUF_SIZE];
 
     LOG_INF("PING server started");
 
@@ -36,26 +125,62 @@ static void ping_server_thread(void *p1, void *p2, void *p3)
         atomic_set(&ping_running, 0);
         return;
     }
+    if (ping_rx_register(&ping_server_rx_ctx)) {
+        dect_session_close();
+        atomic_set(&ping_running, 0);
+        return;
+    }
+    ping_sched_reserve("ping server");
 
     while (atomic_get(&ping_running)) {
 
-        int ret = receive(rx_handle);   /* async call */
+        k_sem_reset(&ping_rx_sem);
+        int ret = hs_core_rx_async(PING_RX_HANDLE, HS_CORE_START_NOW, 0, &rx_cb);
         if (ret < 0) {
             LOG_ERR("RX failed: %d", ret);
             break;
         }
 
-        /* Wait until RX completes */
-        k_sem_take(&operation_sem, K_FOREVER);
+        /* Wait for a request or for the end of the RX window */
+        bool got_request = false;
+
+        while (atomic_get(&ping_running)) {
+            if (k_sem_take(&ping_rx_sem, K_MSEC(PING_POLL_MS)) == 0) {
+                got_request = true;
+                ping_rx_stop();
+                break;
+            }
+            if (hs_core_op_wait(PING_RX_HANDLE, K_NO_WAIT) != -EAGAIN) {
+                break;
+            }
+        }
+        if (!got_request) {
+            /* Stopped or RX window over without a request: re-arm */
+            ping_rx_stop();
+            continue;
+        }
+
+        /* Echo the sequence number of the request */
+        uint64_t tx_start = ping_tx_time_get(PING_MSG_LEN);
 
-        /* Simulate echo reply */
-        snprintf(buf, sizeof(buf), "PONG %lu", (unsigned long)ping_expected_seq);
-        transmit(0, buf, strlen(buf) + 1);
-        k_sem_take(&operation_sem, K_FOREVER);
+        ping_expected_seq = ping_rx_seq;
+        ret = hs_msg_build(buf, sizeof(buf), HS_MSG_PONG, 0, ping_expected_seq, tx_start,
+                           NULL, 0);
+        if (ret > 0) {
+            ret = hs_core_tx_async(PING_TX_HANDLE, buf, ret, tx_start, NULL);
+        }
+        if (ret == 0) {
+            ret = hs_core_op_wait(PING_TX_HANDLE, K_FOREVER);
+        }
+        if (ret) {
+            LOG_WRN("PONG %lu TX failed: %d", (unsigned long)ping_expected_seq, ret);
+        }
 
         ping_expected_seq++;
     }
 
+    ping_sched_release();
+    hs_msg_handler_unregister(HS_MSG_PING);
     dect_session_close();
     LOG_INF("PING server stopped");
 }
@@ -65,10 +190,9 @@ static void ping_server_thread(void *p1, void *p2, void *p3)
  * ================================================ */
 static void ping_client_thread(void *p1, void *p2, void *p3)
 {
-    uint32_t tx_handle = 0;
-    uint32_t rx_handle = 1;
+    const struct hs_core_op_cb rx_cb = { .pdc = ping_rx_other };
     uint32_t seq = 0;
-    char txbuf[PING_BUF_SIZE];
+    uint8_t txbuf[PING_BUF_SIZE];
 
     LOG_INF("PING client started, count=%u", ping_count_cfg);
 
@@ -77,56 +201,73 @@ static void ping_client_thread(void *p1, void *p2, void *p3)
         atomic_set(&ping_running, 0);
         return;
     }
+    if (ping_rx_register(&ping_client_rx_ctx)) {
+        dect_session_close();
+        atomic_set(&ping_running, 0);
+        return;
+    }
+    ping_sched_reserve("ping client");
 
     while (atomic_get(&ping_running) && seq < ping_count_cfg) {
-
-        snprintf(txbuf, sizeof(txbuf), "PING %u", seq);
-
-        /* High-level RTT in ms (existing one) */
-        last_tx_time_ms = k_uptime_get();
-
-        /* Low-level MAC RTT (client only, hello.c will use this) */
-        mac_rtt_mark_tx();
-
-        transmit(tx_handle, txbuf, strlen(txbuf) + 1);
-        k_sem_take(&operation_sem, K_FOREVER);
-
-
-        /* Wait for reply */
-        int waited = 0;
+        uint64_t tx_start = ping_tx_time_get(PING_MSG_LEN);
+        uint64_t rx_start = tx_start + hs_core_tx_duration_get(PING_MSG_LEN) +
+                            HS_CORE_OP_GAP_MDM_TICKS;
+        int tx_len = hs_msg_build(txbuf, sizeof(txbuf), HS_MSG_PING, 0, seq, tx_start,
+                                  NULL, 0);
         bool got_reply = false;
-
-        while (waited < PING_TIMEOUT_MS) {
-
-            int ret = receive(rx_handle);
-            if (ret < 0) break;
-
-            k_sem_take(&operation_sem, K_FOREVER);
-
-            /* If hello.c printed incoming frame: we check expected seq */
-            /* For now assume reply always arrives in PDC callback */
-
-            /* Fake matching logic: accept as reply */
-            got_reply = true;
-
-            if (got_reply) {
-                uint64_t now = k_uptime_get();
-                LOG_INF("PING %u RTT = %llu ms", seq, now - last_tx_time_ms);
-                break;
+        int ret;
+
+        k_sem_reset(&ping_rx_sem);
+        hs_rtt_probe_tx(seq, PING_TX_HANDLE);
+
+        /* TX and the RX for the reply are queued back to back */
+        ret = tx_len < 0 ? tx_len :
+              hs_core_tx_async(PING_TX_HANDLE, txbuf, tx_len, tx_start, NULL);
+        if (ret == 0) {
+            ret = hs_core_rx_async(PING_RX_HANDLE, rx_start,
+                                   HS_MS_TO_MODEM_TICKS(PING_TIMEOUT_MS), &rx_cb);
+            if (ret) {
+                (void)hs_core_op_wait(PING_TX_HANDLE, K_FOREVER);
             }
-
-            k_msleep(10);
-            waited += 10;
+        }
+        if (ret) {
+            LOG_ERR("PING %u: cannot schedule TX/RX: %d", seq, ret);
+            break;
         }
 
-        if (!got_reply) {
-            LOG_WRN("PING %u timeout", seq);
+        ret = hs_core_op_wait(PING_TX_HANDLE, K_FOREVER);
+        if (ret) {
+            LOG_WRN("PING %u TX failed: %d", seq, ret);
+            ping_rx_stop();
+        } else {
+            /* Reply or the end of the RX window */
+            while (!got_reply) {
+                if (k_sem_take(&ping_rx_sem, K_MSEC(PING_POLL_MS)) == 0) {
+                    got_reply = (ping_rx_seq == seq);
+                    continue;
+                }
+                if (hs_core_op_wait(PING_RX_HANDLE, K_NO_WAIT) != -EAGAIN) {
+                    break;
+                }
+            }
+            if (got_reply) {
+                if (ping_rx_rtt_us >= 0) {
+                    LOG_INF("PING %u RTT = %d us", seq, ping_rx_rtt_us);
+                } else {
+                    LOG_INF("PING %u reply, no RTT: %d", seq, ping_rx_rtt_us);
+                }
+                ping_rx_stop();
+            } else {
+                LOG_WRN("PING %u timeout", seq);
+            }
         }
 
         seq++;
         k_msleep(10);
     }
 
+    ping_sched_release();
+    hs_msg_handler_unregister(HS_MSG_PONG);
     dect_session_close();
     LOG_INF("PING client finished");
     atomic_set(&ping_running, 0);
@@ -150,8 +291,6 @@ int ping_start_server(void)
         return -EBUSY;
     }
 
-    mac_rtt_set_enabled(false);   /* <--- no MAC RTT on server */
-
     atomic_set(&ping_running, 1);
     ping_expected_seq = 0;
 
@@ -174,7 +313,7 @@ int ping_start_client(uint32_t count)
     ping_count_cfg = count;
     atomic_set(&ping_running, 1);
 
-    mac_rtt_set_enabled(true);    /* <--- MAC RTT only on client */
+    hs_rtt_reset();
 
     k_thread_create(&ping_thread, ping_stack, K_THREAD_STACK_SIZEOF(ping_stack),
                     ping_client_thread, NULL, NULL, NULL,
@@ -1 +1,243 @@
-/*we are implementing our schedualler her*/
\ No newline at end of file
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <errno.h>
+#include "scheduller.h"
+
+LOG_MODULE_REGISTER(hs_sched, LOG_LEVEL_INF);
+
+struct hs_sched_resv {
+    bool        used;
+    uint32_t    first_slot;
+    uint32_t    slot_count;
+    uint32_t    period_frames;
+    const char *owner;
+};
+
+/* Read from modem callbacks (LBT decision at TX) */
+static struct k_spinlock sched_lock;
+static struct hs_sched_resv sched_resv[HS_SCHED_RESV_MAX];
+static uint64_t sched_epoch;
+static bool sched_synced;
+static bool sched_lbt_skip;
+
+void hs_sched_sync(uint64_t modem_time)
+{
+    k_spinlock_key_t key = k_spin_lock(&sched_lock);
+
+    sched_epoch = modem_time;
+    sched_synced = true;
+    k_spin_unlock(&sched_lock, key);
+
+    LOG_DBG("Frame 0 at modem time %llu", modem_time);
+}
+
+bool hs_sched_is_synced(void)
+{
+    return sched_synced;
+}
+
+uint64_t hs_sched_frame_boundary_next(uint64_t time)
+{
+    k_spinlock_key_t key = k_spin_lock(&sched_lock);
+    uint64_t boundary = time;
+
+    if (sched_synced && time > sched_epoch) {
+        boundary = sched_epoch +
+                   DIV_ROUND_UP(time - sched_epoch, HS_FRAME_MDM_TICKS) * HS_FRAME_MDM_TICKS;
+    }
+    k_spin_unlock(&sched_lock, key);
+    return boundary;
+}
+
+/* sched_lock held */
+static bool sched_overlaps(uint32_t first_slot, uint32_t slot_count)
+{
+    for (int i = 0; i < HS_SCHED_RESV_MAX; i++) {
+        const struct hs_sched_resv *r = &sched_resv[i];
+
+        /* All periods start at frame 0: any slot overlap collides at some frame */
+        if (r->used && first_slot < r->first_slot + r->slot_count &&
+            r->first_slot < first_slot + slot_count) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* sched_lock held */
+static int sched_add(uint32_t first_slot, uint32_t slot_count, uint32_t period_frames,
+                     const char *owner)
+{
+    if (sched_overlaps(first_slot, slot_count)) {
+        return -EBUSY;
+    }
+    for (int i = 0; i < HS_SCHED_RESV_MAX; i++) {
+        struct hs_sched_resv *r = &sched_resv[i];
+
+        if (!r->used) {
+            r->used = true;
+            r->first_slot = first_slot;
+            r->slot_count = slot_count;
+            r->period_frames = period_frames;
+            r->owner = owner;
+            return i;
+        }
+    }
+    return -ENOMEM;
+}
+
+static bool sched_params_valid(uint32_t first_slot, uint32_t slot_count, uint32_t period_frames)
+{
+    return slot_count > 0 && period_frames > 0 &&
+           first_slot + slot_count <= HS_SCHED_SLOTS_PER_FRAME;
+}
+
+int hs_sched_reserve(uint32_t first_slot, uint32_t slot_count, uint32_t period_frames,
+                     const char *owner)
+{
+    k_spinlock_key_t key;
+    int id;
+
+    if (!sched_params_valid(first_slot, slot_count, period_frames)) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&sched_lock);
+    id = sched_add(first_slot, slot_count, period_frames, owner);
+    k_spin_unlock(&sched_lock, key);
+
+    if (id >= 0) {
+        LOG_INF("%s: slots %u..%u every %u frames", owner, first_slot,
+                first_slot + slot_count - 1, period_frames);
+    }
+    return id;
+}
+
+int hs_sched_reserve_any(uint32_t slot_count, uint32_t period_frames, const char *owner)
+{
+    k_spinlock_key_t key;
+    uint32_t first_slot = 0;
+    int id = -EBUSY;
+
+    if (!sched_params_valid(0, slot_count, period_frames)) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&sched_lock);
+    for (uint32_t first = 0; first + slot_count <= HS_SCHED_SLOTS_PER_FRAME; first++) {
+        id = sched_add(first, slot_count, period_frames, owner);
+        if (id != -EBUSY) {
+            /* Copy for the log: the reservation can be released once unlocked */
+            first_slot = first;
+            break;
+        }
+    }
+    k_spin_unlock(&sched_lock, key);
+
+    if (id >= 0) {
+        LOG_INF("%s: slots %u..%u every %u frames", owner, first_slot,
+                first_slot + slot_count - 1, period_frames);
+    }
+    return id;
+}
+
+void hs_sched_release(int id)
+{
+    k_spinlock_key_t key;
+
+    if (id < 0 || id >= HS_SCHED_RESV_MAX) {
+        return;
+    }
+    key = k_spin_lock(&sched_lock);
+    sched_resv[id].used = false;
+    k_spin_unlock(&sched_lock, key);
+}
+
+/* sched_lock held: is [start, start + duration) in an occurrence of r */
+static bool sched_resv_contains(const struct hs_sched_resv *r, uint64_t start, uint64_t duration)
+{
+    uint64_t rel, frame, offset;
+
+    if (!r->used || start < sched_epoch) {
+        return false;
+    }
+    rel = start - sched_epoch;
+    frame = rel / HS_FRAME_MDM_TICKS;
+    offset = rel % HS_FRAME_MDM_TICKS;
+
+    return (frame % r->period_frames) == 0 &&
+           offset >= (uint64_t)r->first_slot * HS_SCHED_SLOT_MDM_TICKS &&
+           offset + duration <=
+                (uint64_t)(r->first_slot + r->slot_count) * HS_SCHED_SLOT_MDM_TICKS;
+}
+
+uint64_t hs_sched_place(int id, uint64_t earliest, uint64_t duration)
+{
+    k_spinlock_key_t key;
+    const struct hs_sched_resv *r;
+    uint64_t frame, start;
+
+    if (id < 0 || id >= HS_SCHED_RESV_MAX) {
+        return earliest;
+    }
+
+    key = k_spin_lock(&sched_lock);
+    r = &sched_resv[id];
+    if (!sched_synced || !r->used) {
+        k_spin_unlock(&sched_lock, key);
+        return earliest;
+    }
+    if (sched_resv_contains(r, earliest, duration)) {
+        k_spin_unlock(&sched_lock, key);
+        return earliest;
+    }
+
+    /* Start of the first occurrence not before earliest */
+    frame = earliest > sched_epoch ? (earliest - sched_epoch) / HS_FRAME_MDM_TICKS : 0;
+    frame = DIV_ROUND_UP(frame, r->period_frames) * r->period_frames;
+    start = sched_epoch + frame * HS_FRAME_MDM_TICKS +
+            (uint64_t)r->first_slot * HS_SCHED_SLOT_MDM_TICKS;
+    if (start < earliest) {
+        start += (uint64_t)r->period_frames * HS_FRAME_MDM_TICKS;
+    }
+    k_spin_unlock(&sched_lock, key);
+    return start;
+}
+
+bool hs_sched_in_reserved(uint64_t start, uint64_t duration)
+{
+    k_spinlock_key_t key = k_spin_lock(&sched_lock);
+    bool in = false;
+
+    for (int i = 0; sched_synced && !in && i < HS_SCHED_RESV_MAX; i++) {
+        in = sched_resv_contains(&sched_resv[i], start, duration);
+    }
+    k_spin_unlock(&sched_lock, key);
+    return in;
+}
+
+void hs_sched_lbt_skip_set(bool skip)
+{
+    sched_lbt_skip = skip;
+}
+
+bool hs_sched_lbt_skip_get(void)
+{
+    return sched_lbt_skip;
+}
+
+void hs_sched_status_print(const struct shell *sh)
+{
+    shell_print(sh, "Scheduler: %s, %d slots of %u modem ticks per frame, LBT in reserved: %s",
+                sched_synced ? "synced" : "not synced", HS_SCHED_SLOTS_PER_FRAME,
+                (uint32_t)HS_SCHED_SLOT_MDM_TICKS, sched_lbt_skip ? "off" : "on");
+
+    for (int i = 0; i < HS_SCHED_RESV_MAX; i++) {
+        const struct hs_sched_resv *r = &sched_resv[i];
+
+        if (r->used) {
+            shell_print(sh, "  [%d] %s: slots %u..%u every %u frames", i, r->owner,
+                        r->first_slot, r->first_slot + r->slot_count - 1, r->period_frames);
+        }
+    }
+}
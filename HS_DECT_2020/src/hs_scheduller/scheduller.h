@@ -0,0 +1,73 @@
+#ifndef HS_SCHEDULLER_H_
+#define HS_SCHEDULLER_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "core.h"
+
+/*
+ * Frame/slot TDMA scheduler.
+ *
+ * Modem time is divided into 10 ms frames of HS_SCHED_SLOTS_PER_FRAME slots,
+ * frame 0 starting at the modem time given by time_get at session
+ * activation. Apps reserve a range of slots repeating every period_frames
+ * frames and place their operations in it. TX is given with LBT also in
+ * reserved slots unless skipped with hs_sched_lbt_skip_set().
+ *
+ * The frame epoch is per device: it is not aligned to other devices' frames
+ * (no beacon or hello time is used for it). Reservations therefore only keep
+ * the operations of this device from colliding with each other. Against
+ * other devices, LBT is still the only protection.
+ */
+
+#define HS_SCHED_SLOTS_PER_FRAME  24
+#define HS_SCHED_SLOT_MDM_TICKS   (HS_FRAME_MDM_TICKS / HS_SCHED_SLOTS_PER_FRAME)
+
+/* Max reservations at a time */
+#define HS_SCHED_RESV_MAX         8
+
+/* Slots covering a duration in modem ticks */
+#define HS_SCHED_SLOTS_FOR(mdm_ticks) \
+    ((uint32_t)DIV_ROUND_UP((uint64_t)(mdm_ticks), HS_SCHED_SLOT_MDM_TICKS))
+
+/* Frame 0 starts at modem_time, from hs_core at session activation */
+void hs_sched_sync(uint64_t modem_time);
+bool hs_sched_is_synced(void);
+
+/* Start of the first frame not before time, time if not synced */
+uint64_t hs_sched_frame_boundary_next(uint64_t time);
+
+/* Reserve slot_count slots from first_slot in every period_frames frames.
+ * Returns a reservation id, -EINVAL for bad params, -EBUSY if the slots
+ * overlap with another reservation, -ENOMEM if HS_SCHED_RESV_MAX are in use.
+ */
+int hs_sched_reserve(uint32_t first_slot, uint32_t slot_count, uint32_t period_frames,
+                     const char *owner);
+
+/* As hs_sched_reserve(), the first free slots that fit */
+int hs_sched_reserve_any(uint32_t slot_count, uint32_t period_frames, const char *owner);
+
+void hs_sched_release(int id);
+
+/*
+ * Start time for an operation of duration ticks not before earliest: within
+ * the reservation id, or the start of its next occurrence if the duration
+ * does not fit into one. earliest is returned if id is not valid or the
+ * scheduler is not synced.
+ */
+uint64_t hs_sched_place(int id, uint64_t earliest, uint64_t duration);
+
+/* Is [start, start + duration) inside an occurrence of any reservation */
+bool hs_sched_in_reserved(uint64_t start, uint64_t duration);
+
+/* Explicit opt-out: TX fully inside a reserved slot range is given without
+ * LBT (see hs_core_tx_async()). Off by default.
+ */
+void hs_sched_lbt_skip_set(bool skip);
+bool hs_sched_lbt_skip_get(void);
+
+void hs_sched_status_print(const struct shell *sh);
+
+#endif /* HS_SCHEDULLER_H_ */
@@ -20,6 +20,7 @@
 #include "utils.h"
 #include "perf.h"
 #include "perf_shell.h"
+#include "scheduller.h"
 /*====================================*/
 
 
@@ -273,25 +274,32 @@ static int cmd_ping_start(const struct shell *shell, size_t argc, char **argv)
         shell_print(shell, "Usage:");
         shell_print(shell, "  hdect ping start c [count]   (ping client)");
         shell_print(shell, "  hdect ping start s           (ping server)");
-        shell_print(shell, "  hdect ping start cf          (file-compare client)");
-        shell_print(shell, "  hdect ping start sf          (file-compare server)");
+        shell_print(shell, "  hdect ping start cf [len] [window]  (file transfer client)");
+        shell_print(shell, "  hdect ping start sf [loss_pct]      (file transfer server)");
         return -EINVAL;
     }
 
     /* ---- file compare modes ---- */
     if (strcmp(argv[1], "sf") == 0) {
-        int err = fping_server_start();
+        uint32_t loss_pct = 0;
+        if (argc >= 3) {
+            loss_pct = (uint32_t)strtoul(argv[2], NULL, 10);
+        }
+        int err = fping_server_start(loss_pct);
         shell_print(shell, (err == 0) ? "FPING SERVER started" : "FPING SERVER failed");
         return err;
     }
 
     if (strcmp(argv[1], "cf") == 0) {
-        
-        uint32_t count = 5; /* default */
+        uint32_t len = FPING_LEN_DEFAULT;
+        uint32_t window = FPING_WINDOW_DEFAULT;
         if (argc >= 3) {
-            count = (uint32_t)strtoul(argv[3], NULL, 10);
+            len = (uint32_t)strtoul(argv[2], NULL, 10);
+        }
+        if (argc >= 4) {
+            window = (uint32_t)strtoul(argv[3], NULL, 10);
         }
-        int err = fping_client_start(count);
+        int err = fping_client_start(len, window);
         if (err) {
             shell_error(shell, "FPING client start failed: %d", err);
             return err;
@@ -415,7 +423,9 @@ static int cmd_cfg_set(const struct shell *shell, size_t argc, char **argv)
 
     /* Push to core / modem */
     err = hs_core_apply_radio(cfg.carrier, cfg.mcs, cfg.tx_power);
-    if (err) {
+    if (err == -ETIMEDOUT) {
+        shell_warn(shell, "Ops on the old carrier did not end in time");
+    } else if (err) {
         shell_error(shell, "Failed to apply radio config: %d", err);
         return err;
     }
@@ -428,12 +438,36 @@ static int cmd_cfg_set(const struct shell *shell, size_t argc, char **argv)
     return 0;
 }
 
+/* hdect sched [lbt <on|off>]: frame timing and slot reservations, LBT opt-out */
+static int cmd_hdect_sched(const struct shell *shell, size_t argc, char **argv)
+{
+    if (argc == 1) {
+        hs_sched_status_print(shell);
+        return 0;
+    }
+    if (argc != 3 || strcmp(argv[1], "lbt") != 0 ||
+        (strcmp(argv[2], "on") != 0 && strcmp(argv[2], "off") != 0)) {
+        shell_error(shell, "Usage: hdect sched [lbt <on|off>]");
+        return -EINVAL;
+    }
 
+    hs_sched_lbt_skip_set(strcmp(argv[2], "off") == 0);
+    shell_print(shell, "LBT in reserved slots %s", argv[2]);
+    return 0;
+}
 
+/* hdect rxlog <on|off>: rate limited RX logging */
+static int cmd_hdect_rxlog(const struct shell *shell, size_t argc, char **argv)
+{
+    if (argc < 2 || (strcmp(argv[1], "on") != 0 && strcmp(argv[1], "off") != 0)) {
+        shell_error(shell, "Usage: hdect rxlog <on|off>");
+        return -EINVAL;
+    }
 
-
-
-
+    hs_core_rx_log_set(strcmp(argv[1], "on") == 0);
+    shell_print(shell, "RX logging %s", argv[1]);
+    return 0;
+}
 
 /* Register 'configuration ' subcommands */
 /* Forward declarations */
@@ -466,6 +500,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_hdect_perf,
     SHELL_CMD(stop,  NULL, "Stop perf measurement",  cmd_hdect_perf_stop),
     SHELL_CMD(reset, NULL, "Reset perf metrics",      cmd_hdect_perf_reset),
     SHELL_CMD(show,  NULL, "Show perf metrics",       cmd_hdect_perf_show),
+    SHELL_CMD(history, NULL, "Show interval snapshots: history [n]",
+              cmd_hdect_perf_history),
+    SHELL_CMD(export, NULL, "Export metrics and snapshots as binary (hex)",
+              cmd_hdect_perf_export),
     SHELL_SUBCMD_SET_END
 );
 
@@ -503,6 +541,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_hdect,
     SHELL_CMD(ping, &sub_hdect_ping, "DECT ping utility", NULL),
     SHELL_CMD(cfg,  &sub_hdect_cfg,  "HS-DECT config",    NULL),
     SHELL_CMD(perf,     &sub_hdect_perf,     "Performance metrics", NULL),
+    SHELL_CMD(sched,    NULL,                "TDMA slot reservations: sched [lbt <on|off>]", cmd_hdect_sched),
+    SHELL_CMD(rxlog,    NULL,                "RX logging: rxlog <on|off>", cmd_hdect_rxlog),
     SHELL_SUBCMD_SET_END
 );
 
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "dect_common_hdr_hist.h"
+
+BUILD_ASSERT(DECT_COMMON_HDR_HIST_MAX_MAGNITUDE > DECT_COMMON_HDR_HIST_SUB_BITS &&
+		     DECT_COMMON_HDR_HIST_MAX_MAGNITUDE <= 32,
+	     "Invalid histogram magnitude");
+
+/**************************************************************************************************/
+
+static uint32_t dect_common_hdr_hist_index_get(uint32_t value)
+{
+	uint32_t magnitude, shift;
+
+	if (value < DECT_COMMON_HDR_HIST_SUB_COUNT) {
+		return value;
+	}
+	magnitude = 31 - __builtin_clz(value);
+	if (magnitude >= DECT_COMMON_HDR_HIST_MAX_MAGNITUDE) {
+		return DECT_COMMON_HDR_HIST_BUCKET_COUNT - 1;
+	}
+	shift = magnitude - DECT_COMMON_HDR_HIST_SUB_BITS;
+
+	/* (value >> shift) is within [SUB_COUNT, 2 * SUB_COUNT) */
+	return DECT_COMMON_HDR_HIST_SUB_COUNT + (shift * DECT_COMMON_HDR_HIST_SUB_COUNT) +
+	       ((value >> shift) - DECT_COMMON_HDR_HIST_SUB_COUNT);
+}
+
+/* Highest value that maps to the bucket */
+static uint32_t dect_common_hdr_hist_bucket_high_get(uint32_t index)
+{
+	uint32_t shift, sub;
+
+	if (index < DECT_COMMON_HDR_HIST_SUB_COUNT) {
+		return index;
+	}
+	shift = (index - DECT_COMMON_HDR_HIST_SUB_COUNT) / DECT_COMMON_HDR_HIST_SUB_COUNT;
+	sub = (index - DECT_COMMON_HDR_HIST_SUB_COUNT) % DECT_COMMON_HDR_HIST_SUB_COUNT;
+
+	return (uint32_t)((((uint64_t)DECT_COMMON_HDR_HIST_SUB_COUNT + sub + 1) << shift) - 1);
+}
+
+/**************************************************************************************************/
+
+void dect_common_hdr_hist_init(struct dect_common_hdr_hist *hist)
+{
+	memset(hist, 0, sizeof(*hist));
+	hist->min = UINT32_MAX;
+}
+
+void dect_common_hdr_hist_record(struct dect_common_hdr_hist *hist, uint32_t value)
+{
+	uint32_t index = dect_common_hdr_hist_index_get(value);
+
+	if (index == DECT_COMMON_HDR_HIST_BUCKET_COUNT - 1 &&
+	    value > dect_common_hdr_hist_bucket_high_get(index)) {
+		hist->overflow_count++;
+	}
+	hist->buckets[index]++;
+	hist->count++;
+	hist->sum += value;
+	if (value < hist->min) {
+		hist->min = value;
+	}
+	if (value > hist->max) {
+		hist->max = value;
+	}
+}
+
+uint32_t dect_common_hdr_hist_percentile_get(const struct dect_common_hdr_hist *hist,
+					     uint16_t per_mille)
+{
+	uint64_t target;
+	uint32_t cumulative = 0;
+
+	if (hist->count == 0) {
+		return 0;
+	}
+	if (per_mille >= 1000) {
+		return hist->max;
+	}
+	target = DIV_ROUND_UP((uint64_t)hist->count * per_mille, 1000);
+	if (target == 0) {
+		target = 1;
+	}
+
+	for (uint32_t i = 0; i < DECT_COMMON_HDR_HIST_BUCKET_COUNT; i++) {
+		cumulative += hist->buckets[i];
+		if (cumulative >= target) {
+			return MIN(dect_common_hdr_hist_bucket_high_get(i), hist->max);
+		}
+	}
+	return hist->max;
+}
+
+uint32_t dect_common_hdr_hist_mean_get(const struct dect_common_hdr_hist *hist)
+{
+	if (hist->count == 0) {
+		return 0;
+	}
+	return (uint32_t)(hist->sum / hist->count);
+}
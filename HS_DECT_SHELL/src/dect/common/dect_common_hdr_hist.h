@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DECT_COMMON_HDR_HIST_H
+#define DECT_COMMON_HDR_HIST_H
+
+#include <zephyr/kernel.h>
+
+/* Log-linear histogram in the manner of HdrHistogram: values below 2^SUB_BITS have a bucket
+ * of their own, above that each power of two range is split into 2^SUB_BITS equal buckets.
+ * Relative error of a reported value is thus at most 1 / 2^SUB_BITS (~3%).
+ * Values from 2^MAX_MAGNITUDE on are clamped to the last bucket.
+ */
+#define DECT_COMMON_HDR_HIST_SUB_BITS	   5
+#define DECT_COMMON_HDR_HIST_MAX_MAGNITUDE 25 /* E.g. ~33 secs in usecs */
+
+#define DECT_COMMON_HDR_HIST_SUB_COUNT (1 << DECT_COMMON_HDR_HIST_SUB_BITS)
+#define DECT_COMMON_HDR_HIST_BUCKET_COUNT                                                          \
+	(DECT_COMMON_HDR_HIST_SUB_COUNT +                                                          \
+	 ((DECT_COMMON_HDR_HIST_MAX_MAGNITUDE - DECT_COMMON_HDR_HIST_SUB_BITS) *                   \
+	  DECT_COMMON_HDR_HIST_SUB_COUNT))
+
+struct dect_common_hdr_hist {
+	uint32_t count;
+	uint32_t overflow_count; /* Clamped to the last bucket */
+	uint32_t min;
+	uint32_t max;
+	uint64_t sum;
+
+	uint32_t buckets[DECT_COMMON_HDR_HIST_BUCKET_COUNT];
+};
+
+/******************************************************************************/
+
+void dect_common_hdr_hist_init(struct dect_common_hdr_hist *hist);
+
+void dect_common_hdr_hist_record(struct dect_common_hdr_hist *hist, uint32_t value);
+
+/* Value at or below which per_mille / 1000 of the recorded values are, e.g. 999 for p99.9.
+ * Highest value of the bucket, but never more than the max recorded. 0 if empty.
+ */
+uint32_t dect_common_hdr_hist_percentile_get(const struct dect_common_hdr_hist *hist,
+					     uint16_t per_mille);
+
+uint32_t dect_common_hdr_hist_mean_get(const struct dect_common_hdr_hist *hist);
+
+#endif /* DECT_COMMON_HDR_HIST_H */
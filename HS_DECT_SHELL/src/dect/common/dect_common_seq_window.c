@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dect_common_seq_window.h"
+
+BUILD_ASSERT((DECT_COMMON_SEQ_WINDOW_LEN % 32) == 0, "Window length must be a multiple of 32");
+
+#define DECT_COMMON_SEQ_WINDOW_WORDS (DECT_COMMON_SEQ_WINDOW_LEN / 32)
+
+/* Extended seq nbrs start from one wrap to keep (max - n) positive near the start */
+#define DECT_COMMON_SEQ_WINDOW_EXT_START (1UL << 16)
+
+/**************************************************************************************************/
+
+static bool dect_common_seq_window_bit_get(struct dect_common_seq_window *window, uint32_t n)
+{
+	return (window->bitmap[n / 32] & BIT(n % 32)) != 0;
+}
+
+static void dect_common_seq_window_bit_set(struct dect_common_seq_window *window, uint32_t n)
+{
+	window->bitmap[n / 32] |= BIT(n % 32);
+}
+
+/* Bit n moves to bit n + shift, i.e. the window slides forward by shift seq nbrs */
+static void dect_common_seq_window_slide(struct dect_common_seq_window *window, uint32_t shift)
+{
+	uint32_t word_shift = shift / 32;
+	uint32_t bit_shift = shift % 32;
+
+	if (shift >= DECT_COMMON_SEQ_WINDOW_LEN) {
+		memset(window->bitmap, 0, sizeof(window->bitmap));
+		return;
+	}
+	for (int i = DECT_COMMON_SEQ_WINDOW_WORDS - 1; i >= 0; i--) {
+		int src = i - (int)word_shift;
+		uint32_t value = 0;
+
+		if (src >= 0) {
+			value = window->bitmap[src] << bit_shift;
+			if (bit_shift && src > 0) {
+				value |= window->bitmap[src - 1] >> (32 - bit_shift);
+			}
+		}
+		window->bitmap[i] = value;
+	}
+}
+
+static void dect_common_seq_window_session_start(struct dect_common_seq_window *window,
+						 uint16_t seq_nbr)
+{
+	window->initialized = true;
+	window->base_ext_seq = DECT_COMMON_SEQ_WINDOW_EXT_START + seq_nbr;
+	window->max_ext_seq = window->base_ext_seq;
+	memset(window->bitmap, 0, sizeof(window->bitmap));
+	dect_common_seq_window_bit_set(window, 0);
+	window->bad_seq = UINT32_MAX;
+	window->transit_valid = false;
+}
+
+static void dect_common_seq_window_jitter_update(struct dect_common_seq_window *window,
+						 uint32_t tx_timestamp, uint32_t rx_timestamp)
+{
+	int32_t transit = (int32_t)(rx_timestamp - tx_timestamp);
+
+	if (window->transit_valid) {
+		uint32_t d = abs(transit - window->last_transit);
+
+		/* J = J + (|D| - J) / 16 */
+		window->jitter_q4 += d - ((window->jitter_q4 + 8) >> 4);
+	}
+	window->last_transit = transit;
+	window->transit_valid = true;
+}
+
+/* Packets received in the current sender session */
+static uint32_t dect_common_seq_window_session_received_get(
+	const struct dect_common_seq_window *window)
+{
+	return window->received_count - window->session_received_start;
+}
+
+/**************************************************************************************************/
+
+void dect_common_seq_window_init(struct dect_common_seq_window *window)
+{
+	memset(window, 0, sizeof(*window));
+}
+
+enum dect_common_seq_window_class
+dect_common_seq_window_update(struct dect_common_seq_window *window, uint16_t seq_nbr,
+			      bool has_timestamps, uint32_t tx_timestamp, uint32_t rx_timestamp)
+{
+	enum dect_common_seq_window_class class;
+	int16_t delta;
+
+	if (!window->initialized) {
+		dect_common_seq_window_session_start(window, seq_nbr);
+		window->session_received_start = window->received_count;
+		window->received_count++;
+		class = DECT_COMMON_SEQ_WINDOW_CLASS_NEW;
+		goto jitter_update;
+	}
+
+	delta = (int16_t)(seq_nbr - (uint16_t)window->max_ext_seq);
+
+	if (delta > 0 && delta < DECT_COMMON_SEQ_WINDOW_MAX_DROPOUT) {
+		/* In order, possibly with a gap */
+		dect_common_seq_window_slide(window, delta);
+		dect_common_seq_window_bit_set(window, 0);
+		window->max_ext_seq += delta;
+		window->bad_seq = UINT32_MAX;
+		window->received_count++;
+		class = DECT_COMMON_SEQ_WINDOW_CLASS_NEW;
+	} else if (delta == 0) {
+		window->duplicate_count++;
+		return DECT_COMMON_SEQ_WINDOW_CLASS_DUPLICATE;
+	} else if (delta < 0 && -delta <= DECT_COMMON_SEQ_WINDOW_MAX_MISORDER) {
+		uint32_t n = -delta;
+
+		if (window->max_ext_seq - n < window->base_ext_seq) {
+			/* From before the session start: not expected */
+			window->late_count++;
+			return DECT_COMMON_SEQ_WINDOW_CLASS_LATE;
+		}
+		if (n >= DECT_COMMON_SEQ_WINDOW_LEN) {
+			/* Cannot tell a duplicate: counted as received, like in RFC 3550 */
+			window->late_count++;
+			window->received_count++;
+			return DECT_COMMON_SEQ_WINDOW_CLASS_LATE;
+		}
+		if (dect_common_seq_window_bit_get(window, n)) {
+			window->duplicate_count++;
+			return DECT_COMMON_SEQ_WINDOW_CLASS_DUPLICATE;
+		}
+		dect_common_seq_window_bit_set(window, n);
+		window->reordered_count++;
+		window->received_count++;
+		class = DECT_COMMON_SEQ_WINDOW_CLASS_REORDERED;
+	} else {
+		/* Big jump: a sender restart if the next one follows this one */
+		if (seq_nbr != window->bad_seq) {
+			window->bad_seq = (uint16_t)(seq_nbr + 1);
+			window->late_count++;
+			return DECT_COMMON_SEQ_WINDOW_CLASS_LATE;
+		}
+		window->lost_before_restarts = dect_common_seq_window_lost_count_get(window);
+		window->restart_count++;
+		dect_common_seq_window_session_start(window, seq_nbr);
+		window->session_received_start = window->received_count;
+		window->received_count++;
+		class = DECT_COMMON_SEQ_WINDOW_CLASS_NEW;
+	}
+
+jitter_update:
+	if (has_timestamps) {
+		dect_common_seq_window_jitter_update(window, tx_timestamp, rx_timestamp);
+	}
+	return class;
+}
+
+uint32_t dect_common_seq_window_lost_count_get(const struct dect_common_seq_window *window)
+{
+	uint32_t expected, received;
+
+	if (!window->initialized) {
+		return 0;
+	}
+	expected = window->max_ext_seq - window->base_ext_seq + 1;
+	received = dect_common_seq_window_session_received_get(window);
+
+	return window->lost_before_restarts + ((expected > received) ? (expected - received) : 0);
+}
+
+uint32_t dect_common_seq_window_jitter_get(const struct dect_common_seq_window *window)
+{
+	return window->jitter_q4 >> 4;
+}
+
+const char *dect_common_seq_window_class_to_string(enum dect_common_seq_window_class class)
+{
+	switch (class) {
+	case DECT_COMMON_SEQ_WINDOW_CLASS_NEW:
+		return "new";
+	case DECT_COMMON_SEQ_WINDOW_CLASS_REORDERED:
+		return "reordered";
+	case DECT_COMMON_SEQ_WINDOW_CLASS_DUPLICATE:
+		return "duplicate";
+	case DECT_COMMON_SEQ_WINDOW_CLASS_LATE:
+		return "late";
+	default:
+		return "unknown";
+	}
+}
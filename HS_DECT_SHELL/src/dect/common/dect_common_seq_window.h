@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DECT_COMMON_SEQ_WINDOW_H
+#define DECT_COMMON_SEQ_WINDOW_H
+
+#include <zephyr/kernel.h>
+
+/* Receive window for 16-bit sequence numbers, in the manner of RFC 3550 A.1/A.8:
+ * sequence numbers are extended with a wrap count, a bitmap of the latest
+ * DECT_COMMON_SEQ_WINDOW_LEN sequence numbers tells duplicates from late arrivals
+ * and interarrival jitter is estimated from sender and receiver timestamps.
+ */
+#define DECT_COMMON_SEQ_WINDOW_LEN	    128 /* Multiple of 32 */
+#define DECT_COMMON_SEQ_WINDOW_MAX_DROPOUT  3000
+#define DECT_COMMON_SEQ_WINDOW_MAX_MISORDER 100
+
+enum dect_common_seq_window_class {
+	DECT_COMMON_SEQ_WINDOW_CLASS_NEW,	/* Beyond the highest so far (maybe after a gap) */
+	DECT_COMMON_SEQ_WINDOW_CLASS_REORDERED, /* Missing one within the window arrived */
+	DECT_COMMON_SEQ_WINDOW_CLASS_DUPLICATE,
+	DECT_COMMON_SEQ_WINDOW_CLASS_LATE,	/* Older than the window or a sender restart */
+};
+
+struct dect_common_seq_window {
+	bool initialized;
+	uint32_t base_ext_seq; /* 1st extended seq nbr of the current sender session */
+	uint32_t max_ext_seq;  /* Highest extended seq nbr so far */
+	uint32_t bitmap[DECT_COMMON_SEQ_WINDOW_LEN / 32]; /* Bit n: max_ext_seq - n received */
+	uint32_t bad_seq; /* Expected next seq nbr if the sender has restarted */
+
+	uint32_t received_count; /* Unique packets, including late ones */
+	uint32_t session_received_start; /* received_count when the sender session started */
+	uint32_t duplicate_count;
+	uint32_t reordered_count;
+	uint32_t late_count;
+	uint32_t restart_count;
+	uint32_t lost_before_restarts;
+
+	bool transit_valid;
+	int32_t last_transit;
+	uint32_t jitter_q4; /* Timestamp units in Q4 fixed point */
+};
+
+/******************************************************************************/
+
+void dect_common_seq_window_init(struct dect_common_seq_window *window);
+
+/* Classify a received packet and update the counters. Jitter is updated only when
+ * has_timestamps: tx_timestamp is in sender clock, rx_timestamp in own clock,
+ * both in the same units (e.g. modem ticks).
+ */
+enum dect_common_seq_window_class
+dect_common_seq_window_update(struct dect_common_seq_window *window, uint16_t seq_nbr,
+			      bool has_timestamps, uint32_t tx_timestamp, uint32_t rx_timestamp);
+
+/* Expected minus received, i.e. never arrived packets. Late arrivals reduce the count. */
+uint32_t dect_common_seq_window_lost_count_get(const struct dect_common_seq_window *window);
+
+/* Interarrival jitter in timestamp units */
+uint32_t dect_common_seq_window_jitter_get(const struct dect_common_seq_window *window);
+
+const char *dect_common_seq_window_class_to_string(enum dect_common_seq_window_class class);
+
+#endif /* DECT_COMMON_SEQ_WINDOW_H */
@@ -141,7 +141,7 @@ int dect_common_utils_phy_packet_length_calculate(uint16_t bytes_to_send, uint8_
 {
 	uint8_t estimate = 0;
 	uint8_t calculated = estimate;
-	uint16_t tbs_in_bytes = 0;
+	int tbs_in_bytes = 0;
 	int i;
 
 	for (i = estimate; tbs_in_bytes < bytes_to_send; i++) {
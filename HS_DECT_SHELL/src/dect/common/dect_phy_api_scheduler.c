@@ -122,6 +122,17 @@ static int dect_phy_api_scheduler_raise_event_with_data(uint16_t event_id, void
 
 /**************************************************************************************************/
 
+/* Op start time relative to its frame */
+static uint64_t
+dect_phy_api_scheduler_op_start_offset_get(const struct dect_phy_api_scheduler_list_item_config *conf)
+{
+	return conf->subslot_used
+		       ? (conf->start_subslot * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS)
+		       : (conf->start_slot * DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS);
+}
+
+/**************************************************************************************************/
+
 K_TIMER_DEFINE(scheduler_timer, dect_phy_api_scheduler_timer_handler, NULL);
 
 static void dect_phy_api_scheduler_timer_handler(struct k_timer *timer_id)
@@ -473,6 +484,24 @@ void dect_phy_api_scheduler_list_item_beacon_rx_sched_config_update_by_phy_op_ha
 	k_mutex_unlock(&to_be_sheduled_list_mutex);
 }
 
+void dect_phy_api_scheduler_list_item_channel_update_by_phy_op_handle_range(
+	uint32_t range_start, uint32_t range_end, uint16_t channel)
+{
+	struct dect_phy_api_scheduler_list_item *iterator = NULL;
+
+	k_mutex_lock(&to_be_sheduled_list_mutex, K_FOREVER);
+	SYS_DLIST_FOR_EACH_CONTAINER(&to_be_sheduled_list, iterator, dnode) {
+		if (iterator->phy_op_handle >= range_start &&
+		    iterator->phy_op_handle <= range_end) {
+			iterator->sched_config.channel = channel;
+			if (iterator->priority == DECT_PRIORITY1_RX_RSSI) {
+				iterator->sched_config.rssi.rssi_op_params.carrier = channel;
+			}
+		}
+	}
+	k_mutex_unlock(&to_be_sheduled_list_mutex);
+}
+
 struct dect_phy_api_scheduler_list_item *
 dect_phy_api_scheduler_list_item_add(struct dect_phy_api_scheduler_list_item *new_list_item)
 {
@@ -948,6 +977,11 @@ int dect_phy_api_scheduler_resume(void)
 	return dect_phy_api_scheduler_raise_event(DECT_PHY_API_EVENT_SCHEDULER_OP_RESUME);
 }
 
+bool dect_phy_api_scheduler_is_suspended(void)
+{
+	return scheduler_data.state == SCHEDULER_STATE_SUSPENDED;
+}
+
 int dect_phy_api_scheduler_next_frame(void)
 {
 	return dect_phy_api_scheduler_raise_event(DECT_PHY_API_EVENT_SCHEDULER_NEXT_FRAME);
@@ -1216,7 +1250,9 @@ static void dect_phy_api_scheduler_core_tick_th_schedule_next_frame(void)
 				}
 				if (iterator->priority == DECT_PRIORITY1_RX_RSSI) {
 					iterator->sched_config.rssi.rssi_op_params.start_time =
-						new_frame_time;
+						new_frame_time +
+						dect_phy_api_scheduler_op_start_offset_get(
+							&iterator->sched_config);
 				}
 
 				if (!dect_phy_api_scheduler_list_item_add(iterator)) {
@@ -1346,7 +1382,9 @@ static void dect_phy_api_scheduler_core_tick_th_schedule_next_frame(void)
 				}
 				if (iterator->priority == DECT_PRIORITY1_RX_RSSI) {
 					iterator->sched_config.rssi.rssi_op_params.start_time =
-						new_frame_time;
+						new_frame_time +
+						dect_phy_api_scheduler_op_start_offset_get(
+							&iterator->sched_config);
 				}
 
 				if (!dect_phy_api_scheduler_list_item_add(iterator)) {
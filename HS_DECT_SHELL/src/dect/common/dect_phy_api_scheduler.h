@@ -208,6 +208,13 @@ void dect_phy_api_scheduler_list_item_sched_config_frame_time_update_by_phy_op_h
 void dect_phy_api_scheduler_list_item_beacon_rx_sched_config_update_by_phy_op_handle_range(
 	uint16_t range_start, uint16_t range_end,
 	struct dect_phy_api_scheduler_list_item_config *rx_conf);
+
+/* Channel for the next operations of the items. Can be used from the cb_op_to_mdm of an item
+ * itself, e.g. for channel hopping.
+ */
+void dect_phy_api_scheduler_list_item_channel_update_by_phy_op_handle_range(
+	uint32_t range_start, uint32_t range_end, uint16_t channel);
+
 void dect_phy_api_scheduler_list_item_tx_phy_header_update_by_phy_handle(
 	uint32_t handle, union nrf_modem_dect_phy_hdr *phy_header,
 	dect_phy_header_type_t header_type);
@@ -251,6 +258,9 @@ int dect_phy_api_scheduler_mdm_pdc_data_recv(
 int dect_phy_api_scheduler_suspend(void);
 int dect_phy_api_scheduler_resume(void);
 
+/* Users giving operations directly to modem are expected to hold them while suspended */
+bool dect_phy_api_scheduler_is_suspended(void);
+
 int dect_phy_api_scheduler_next_frame(void);
 
 /**************************************************************************************************/
@@ -145,6 +145,8 @@ enum {
 	DECT_SHELL_PERF_HARQ_MDM_PROCESS_COUNT,
 	DECT_SHELL_PERF_HARQ_MDM_EXPIRY_TIME,
 	DECT_SHELL_PERF_DECT_HARQ_CLIENT_PROCESS_MAX_NBR,
+	DECT_SHELL_PERF_DECT_HARQ_CLIENT_RTX_MAX,
+	DECT_SHELL_PERF_CLIENT_TX_WINDOW,
 };
 
 static const char dect_phy_perf_cmd_usage_str[] =
@@ -173,6 +175,10 @@ static const char dect_phy_perf_cmd_usage_str[] =
 	"                                 \"dect status\" -command output.\n"
 	"                                 Default: from common tx settings.\n"
 	"      --c_tx_mcs <int>,          Set client TX MCS. Default: from common tx settings.\n"
+	"      --c_tx_window <int>,       Count of client TX operations kept scheduled\n"
+	"                                 ahead, refilled as each one completes [1-32].\n"
+	"                                 With HARQ, limited also by free HARQ processes.\n"
+	"                                 Default: 7.\n"
 	"  -d, --debug,                   Print CRC errors. Note: might impact on actual\n"
 	"                                 perf & timings.\n"
 	"For HARQ only:\n"
@@ -201,6 +207,9 @@ static const char dect_phy_perf_cmd_usage_str[] =
 	"                                      Note: can be bigger that\n"
 	"                                      mdm_init_harq_process_count\n"
 	"                                      but then all might not fit to server buffers.\n"
+	"      --c_harq_rtx_max <int>,         Max count of retransmissions per NACKed TX\n"
+	"                                      with redundancy versions 2, 3, 1 [0-3].\n"
+	"                                      Default: 3.\n"
 	"       Server side RX with HARQ iteration:\n"
 	"	RX data - s_harq_feedback_tx_delay_subslots - HARQ feedback -\n"
 	"       s_harq_feedback_tx_rx_delay_subslots - RX\n\n"
@@ -233,6 +242,8 @@ static struct option long_options_perf[] = {
 	 DECT_SHELL_PERF_SUBSLOT_COUNT_HARQ_FEEDBACK_RX_DELAY_SLOT_COUNT},
 	{"c_harq_process_nbr_max", required_argument, 0,
 	 DECT_SHELL_PERF_DECT_HARQ_CLIENT_PROCESS_MAX_NBR},
+	{"c_harq_rtx_max", required_argument, 0, DECT_SHELL_PERF_DECT_HARQ_CLIENT_RTX_MAX},
+	{"c_tx_window", required_argument, 0, DECT_SHELL_PERF_CLIENT_TX_WINDOW},
 	{"s_harq_feedback_tx_delay_subslots", required_argument, 0,
 	 DECT_SHELL_PERF_SLOT_COUNT_HARQ_FEEDBACK_TX_DELAY_SUBSLOT_COUNT},
 	{"s_harq_feedback_tx_rx_delay_subslots", required_argument, 0,
@@ -287,6 +298,8 @@ static int dect_phy_perf_cmd(const struct shell *shell, size_t argc, char **argv
 	params.client_harq_feedback_rx_delay_subslot_count =
 		current_settings->harq.harq_feedback_rx_delay_subslot_count;
 	params.client_harq_process_nbr_max = 3;
+	params.client_harq_rtx_max = 3;
+	params.client_tx_window_count = 7;
 	params.server_harq_feedback_tx_delay_subslot_count =
 		current_settings->harq.harq_feedback_tx_delay_subslot_count;
 	params.server_harq_feedback_tx_rx_delay_subslot_count = 4;
@@ -384,6 +397,24 @@ static int dect_phy_perf_cmd(const struct shell *shell, size_t argc, char **argv
 			params.client_harq_process_nbr_max = temp;
 			break;
 		}
+		case DECT_SHELL_PERF_DECT_HARQ_CLIENT_RTX_MAX: {
+			temp = atoi(optarg);
+			if (temp < 0 || temp > 3) {
+				desh_error("Not valid HARQ retransmission max count.");
+				goto show_usage;
+			}
+			params.client_harq_rtx_max = temp;
+			break;
+		}
+		case DECT_SHELL_PERF_CLIENT_TX_WINDOW: {
+			temp = atoi(optarg);
+			if (temp < 1 || temp > DECT_PHY_PERF_CLIENT_TX_WINDOW_MAX) {
+				desh_error("Not valid TX window count.");
+				goto show_usage;
+			}
+			params.client_tx_window_count = temp;
+			break;
+		}
 		case DECT_SHELL_PERF_HARQ_MDM_EXPIRY_TIME: {
 			temp = atoi(optarg);
 			if (temp <= 0 || temp > 5000000) {
@@ -808,6 +839,13 @@ static const char dect_phy_ping_cmd_usage_str[] =
 	"  -l, --c_slots <int>,       Payload length (in slots) to be sent. Default: 1.\n"
 	"  -i, --c_interval <int>,    Interval between successive packet transmissions\n"
 	"                             in seconds. Default: 2 secs.\n"
+	"      --c_interval_ms <int>, Interval between successive packet transmissions\n"
+	"                             in milliseconds. Overrides c_interval.\n"
+	"                             Min: 10 msecs (one frame).\n"
+	"      --c_outstanding <int>, Max number of ping requests waiting for a response\n"
+	"                             at a time, [1,16]. With more than one, timeout can be\n"
+	"                             longer than interval and responses are matched by\n"
+	"                             seq nbr. Per ping prints are then left out. Default: 1.\n"
 	"      --c_tx_mcs <int>,      Set client TX MCS. Default: from common tx settings.\n"
 	"      --c_tx_pwr <int>,      TX power (dBm),\n"
 	"                             [-40,-30,-20,-16,-12,-8,-4,0,4,7,10,13,16,19,21,23].\n"
@@ -853,6 +891,8 @@ enum {
 	DECT_SHELL_PING_DEST_SERVER_TX_ID,
 	DECT_SHELL_PING_TX_PWR_CTRL_AUTO,
 	DECT_SHELL_PING_TX_PWR_CTRL_PDU_RX_EXPECTED_RSSI_LEVEL,
+	DECT_SHELL_PING_INTERVAL_MS,
+	DECT_SHELL_PING_OUTSTANDING_MAX,
 };
 
 /* Specifying the expected options (both long and short): */
@@ -865,6 +905,8 @@ static struct option long_options_ping[] = {
 	{"c_timeout", required_argument, 0, 't'},
 	{"c_count", required_argument, 0, DECT_SHELL_PING_COUNT},
 	{"c_interval", required_argument, 0, 'i'},
+	{"c_interval_ms", required_argument, 0, DECT_SHELL_PING_INTERVAL_MS},
+	{"c_outstanding", required_argument, 0, DECT_SHELL_PING_OUTSTANDING_MAX},
 	{"c_slots", required_argument, 0, 'l'},
 	{"c_tx_pwr", required_argument, 0, DECT_SHELL_PING_TX_PWR},
 	{"c_tx_mcs", required_argument, 0, DECT_SHELL_PING_TX_MCS},
@@ -901,8 +943,9 @@ static int dect_phy_ping_cmd(const struct shell *shell, size_t argc, char **argv
 	/* Set defaults */
 	params.channel = 1665;
 	params.timeout_msecs = 1500;
-	params.interval_secs = 2;
+	params.interval_msecs = 2000;
 	params.ping_count = 5;
+	params.outstanding_max = 1;
 	params.role = DECT_PHY_COMMON_ROLE_NONE;
 	params.slot_count = 1;
 	params.destination_transmitter_id = DECT_PHY_DEFAULT_TRANSMITTER_LONG_RD_ID;
@@ -941,7 +984,27 @@ static int dect_phy_ping_cmd(const struct shell *shell, size_t argc, char **argv
 			break;
 		}
 		case 'i': {
-			params.interval_secs = atoi(optarg);
+			tmp_value = atoi(optarg);
+			if (tmp_value <= 0 || tmp_value > (DECT_PHY_PING_INTERVAL_MAX_MSECS / 1000)) {
+				desh_error("Invalid interval %d secs (range: [1,%d])", tmp_value,
+					   DECT_PHY_PING_INTERVAL_MAX_MSECS / 1000);
+				goto show_usage;
+			}
+			params.interval_msecs = tmp_value * 1000;
+			break;
+		}
+		case DECT_SHELL_PING_INTERVAL_MS: {
+			params.interval_msecs = atoi(optarg);
+			break;
+		}
+		case DECT_SHELL_PING_OUTSTANDING_MAX: {
+			tmp_value = atoi(optarg);
+			if (tmp_value <= 0 || tmp_value > DECT_PHY_PING_OUTSTANDING_MAX) {
+				desh_error("Invalid outstanding count %d (range: [1,%d])",
+					   tmp_value, DECT_PHY_PING_OUTSTANDING_MAX);
+				goto show_usage;
+			}
+			params.outstanding_max = tmp_value;
 			break;
 		}
 		case 'e': {
@@ -1037,8 +1100,18 @@ static int dect_phy_ping_cmd(const struct shell *shell, size_t argc, char **argv
 		goto show_usage;
 	}
 
-	if (params.timeout_msecs >= (params.interval_secs * 1000)) {
-		desh_error("Timeout needs to be less than interval.");
+	if (params.interval_msecs < DECT_PHY_PING_INTERVAL_MIN_MSECS ||
+	    params.interval_msecs > DECT_PHY_PING_INTERVAL_MAX_MSECS) {
+		desh_error("Invalid interval %d msecs (range: [%d,%d])", params.interval_msecs,
+			   DECT_PHY_PING_INTERVAL_MIN_MSECS, DECT_PHY_PING_INTERVAL_MAX_MSECS);
+		goto show_usage;
+	}
+	if (params.timeout_msecs >= (params.interval_msecs * params.outstanding_max)) {
+		desh_error("Timeout needs to be less than interval * outstanding count.");
+		goto show_usage;
+	}
+	if (params.use_harq && params.outstanding_max > 1) {
+		desh_error("HARQ is supported only with one outstanding ping request.");
 		goto show_usage;
 	}
 
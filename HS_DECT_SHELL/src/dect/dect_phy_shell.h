@@ -42,6 +42,12 @@ struct dect_phy_perf_params {
 	uint8_t mdm_init_harq_process_count;
 	uint8_t client_harq_process_nbr_max;
 
+	/* Max count of HARQ retransmissions for a NACKed TX */
+	uint8_t client_harq_rtx_max;
+
+	/* Count of client TX operations kept scheduled ahead in modem */
+	uint8_t client_tx_window_count;
+
 	/* RX duration for receiving HARQ feedback for our TX */
 	uint8_t client_harq_feedback_rx_subslot_count;
 
@@ -101,9 +107,10 @@ struct dect_phy_ping_params {
 	uint16_t channel;
 
 	uint32_t destination_transmitter_id;
-	int16_t interval_secs;
+	int32_t interval_msecs;
 	int16_t timeout_msecs;
 	int32_t ping_count;
+	uint8_t outstanding_max; /* Max ping requests waiting for a response at a time */
 	int8_t tx_power_dbm;
 	uint8_t tx_mcs;
 	uint8_t tx_lbt_period_symbols;
@@ -120,6 +127,10 @@ struct dect_phy_ping_params {
 	bool use_harq;
 };
 
+#define DECT_PHY_PING_OUTSTANDING_MAX 16
+#define DECT_PHY_PING_INTERVAL_MIN_MSECS DECT_RADIO_FRAME_DURATION_MS
+#define DECT_PHY_PING_INTERVAL_MAX_MSECS 60000 /* Interval in modem ticks must fit in 32bits */
+
 /******************************************************************************/
 
 #define DECT_PHY_SHELL_RSSI_SCAN_DEFAULT_DURATION_MS \
@@ -177,7 +188,8 @@ struct dect_phy_common_op_event_msgq_item {
 
 #define DECT_PHY_RADIO_MODE_CONFIG_HANDLE 70
 
-#define DECT_PHY_MAC_BEACON_LMS_RSSI_SCAN_HANDLE 99
+#define DECT_PHY_MAC_BEACON_LMS_RA_RSSI_SCAN_HANDLE 98
+#define DECT_PHY_MAC_BEACON_LMS_RSSI_SCAN_HANDLE    99
 
 #define DECT_PHY_MAC_BEACON_TX_HANDLE		 100
 #define DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START 101
@@ -186,8 +198,6 @@ struct dect_phy_common_op_event_msgq_item {
 	(x >= DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START &&                                          \
 	 x <= DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_END)
 
-#define DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE 1000
-
 #define DECT_PHY_MAC_CLIENT_RA_TX_HANDLE		1001
 #define DECT_PHY_MAC_CLIENT_RA_TX_CONTINUOUS_HANDLE	1002
 #define DECT_PHY_MAC_CLIENT_ASSOCIATION_TX_HANDLE	1003
@@ -198,11 +208,26 @@ struct dect_phy_common_op_event_msgq_item {
  * are reserved for associated bg scannings.
  */
 
+/* Above the range of associated bg scannings */
+#define DECT_PHY_MAC_CLIENT_KEEP_ALIVE_TX_HANDLE	1100
+#define DECT_PHY_MAC_BEACON_ASSOCIATION_REL_TX_HANDLE	1101
+#define DECT_PHY_MAC_CLIENT_UL_TX_HANDLE		1102
+
+/* One handle per association response of a burst */
+#define DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_START 1110
+#define DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_END   1125
+#define DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_IN_RANGE(x)                                          \
+	(x >= DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_START &&                                       \
+	 x <= DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_END)
+
 #define DECT_PHY_PERF_TX_HANDLE_START 10000
 #define DECT_PHY_PERF_TX_HANDLE_END   10049
 #define DECT_PHY_PERF_TX_HANDLE_IN_RANGE(x)                                                        \
 	(x >= DECT_PHY_PERF_TX_HANDLE_START && x <= DECT_PHY_PERF_TX_HANDLE_END)
 
+/* Must stay well below the count of TX handles */
+#define DECT_PHY_PERF_CLIENT_TX_WINDOW_MAX 32
+
 #define DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_START 10050
 #define DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_END   10099
 #define DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_IN_RANGE(x)                                          \
@@ -151,6 +151,10 @@ static void dect_phy_mac_message_print(dect_phy_mac_message_type_t message_type,
 			   message->association_rel.rel_cause);
 		break;
 	}
+	case DECT_PHY_MAC_MESSAGE_TYPE_KEEP_ALIVE: {
+		desh_print("      Received Keep Alive IE");
+		break;
+	}
 	case DECT_PHY_MAC_MESSAGE_TYPE_CLUSTER_BEACON: {
 		int beacon_interval_ms = dect_phy_mac_pdu_cluster_beacon_period_in_ms(
 			message->cluster_beacon.cluster_beacon_period);
@@ -462,6 +466,10 @@ bool dect_phy_mac_handle(struct dect_phy_commmon_op_pdc_rcv_params *rcv_params)
 						desh_print("FT: PT %u dissociated -> removed from assoc table",
 								pt_long_rd_id);
 					}
+				} else {
+					/* PT: released by FT, e.g. due to inactivity */
+					dect_phy_mac_client_association_rel_handle(
+						&common_header, &sdu_list_item->message.association_rel);
 				}
 			}
 
@@ -487,7 +495,7 @@ bool dect_phy_mac_handle(struct dect_phy_commmon_op_pdc_rcv_params *rcv_params)
 				common_header.transmitter_id,
 				rcv_params->last_received_pcc_transmitter_short_rd_id, beacon_msg,
 				ra_ie, /* Note: storing only the last RA IE */
-				print);
+				rssi_level, print);
 		}
 		if (association_resp != NULL) {
 			dect_phy_mac_client_associate_resp_handle(&common_header, association_resp);
@@ -546,17 +554,17 @@ bool dect_phy_mac_direct_pdc_handle(struct dect_phy_commmon_op_pdc_rcv_params *r
         return false;
     }
 
-    /* HS_DECT: optional “heard PT” update (safe). Remove if you want only true association. */
+    /* HS_DECT: per-PT link stats. PTs are added to the table only by association. */
     {
         struct dect_phy_settings *s = dect_common_settings_ref_get();
         if (s != NULL && s->mac_sched.role == DECT_MAC_ROLE_FT) {
             int16_t rssi_level = rcv_params->rx_status.rssi_2 / 2;
 
-            (void)dect_phy_mac_ft_assoc_add_or_update(
+            (void)dect_phy_mac_ft_assoc_rx_update(
                 common_header.transmitter_id,
-                rcv_params->last_received_pcc_transmitter_short_rd_id,
                 (int8_t)rssi_level,
-                rcv_params->time
+                rcv_params->time,
+                data_len
             );
         }
     }
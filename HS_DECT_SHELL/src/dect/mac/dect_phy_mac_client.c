@@ -29,11 +29,37 @@
 #include "dect_phy_mac_cluster_beacon.h"
 #include "dect_phy_mac.h"
 #include "dect_phy_mac_client.h"
+#include "dect_phy_mac_timer.h"
+#include "dect_phy_mac_rach_opp.h"
 
 /**************************************************************************************************/
 
 extern struct k_work_q dect_phy_ctrl_work_q;
 
+/* Cached future RA opportunities of one target, valid for as long as its beacon info is */
+struct dect_phy_mac_client_rach_opp_cache {
+	uint64_t beacon_rcvd_mdm_ticks; /* Cache key */
+	uint64_t opps_mdm_ticks[DECT_PHY_MAC_CLIENT_RACH_OPP_CACHE_LEN];
+	uint8_t count;
+	uint8_t next;
+};
+
+struct dect_phy_mac_client_ul_sdu {
+	sys_dnode_t dnode;
+	uint16_t data_len;
+	uint8_t data[DECT_DATA_MAX_LEN];
+};
+
+struct dect_phy_mac_client_ul_stats {
+	uint32_t sdus_sent;
+	uint32_t pdus_sent;
+	uint32_t sdus_dropped;
+	uint64_t bytes_sent;
+
+	int64_t first_enqueue_time_ms;
+	int64_t last_tx_scheduled_time_ms;
+};
+
 enum dect_phy_mac_client_association_states {
 	DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_DISASSOCIATED,
 	DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_WAITING_ASSOCIATION_RESP,
@@ -47,13 +73,28 @@ struct dect_phy_mac_client_association_data {
 	bool bg_scan_ongoing;
 
 	struct dect_phy_mac_nbr_info_list_item *target_nbr;
-	struct k_work_delayable association_resp_wait_work;
+	struct dect_phy_mac_associate_params params;
+
+	/* Last scheduled TX towards the target, to send keep alives only when idle */
+	uint64_t last_tx_time_mdm_ticks;
+
+	struct dect_phy_mac_timer association_resp_timer;
+	struct dect_phy_mac_timer keep_alive_timer;
+
+	/* Uplink SDUs towards the target. Queue is protected by client_data.ul_mutex. */
+	sys_dlist_t ul_queue;
+	uint16_t ul_queue_count;
+	struct dect_phy_mac_client_ul_stats ul_stats;
+	struct dect_phy_mac_client_rach_opp_cache rach_opps;
 };
 static struct dect_phy_mac_client_data {
 	uint16_t client_seq_nbr;
 	struct dect_phy_mac_client_association_data associations[DECT_PHY_MAC_MAX_NEIGBORS];
 
 	uint64_t last_tx_time_mdm_ticks;
+
+	struct k_mutex ul_mutex;
+	struct k_work_delayable ul_tx_work;
 } client_data = {
 	.client_seq_nbr = 0,
 	.last_tx_time_mdm_ticks = 0,
@@ -61,9 +102,14 @@ static struct dect_phy_mac_client_data {
 
 /**************************************************************************************************/
 
-static int dect_phy_mac_client_data_pdu_encode(struct dect_phy_mac_rach_tx_params *params,
+/* Encodes a MAC PDU of the given header type with the given, already filled SDUs.
+ * receiver_long_rd_id is used only with a unicast header. SDU list is consumed.
+ */
+static int dect_phy_mac_client_sdus_pdu_encode(dect_phy_mac_header_type_t header_type,
+					       uint8_t mcs, int8_t tx_power_dbm,
 					       uint32_t nw_id_24msb, uint8_t nw_id_8lsb,
 					       uint16_t target_short_rd_id,
+					       uint32_t receiver_long_rd_id, sys_dlist_t *sdu_list,
 					       uint8_t **target_ptr, /* In/Out */
 					       union nrf_modem_dect_phy_hdr *out_phy_header)
 {
@@ -75,8 +121,8 @@ static int dect_phy_mac_client_data_pdu_encode(struct dect_phy_mac_rach_tx_param
 		.short_network_id = nw_id_8lsb,
 		.transmitter_identity_hi = (uint8_t)(current_settings->common.short_rd_id >> 8),
 		.transmitter_identity_lo = (uint8_t)(current_settings->common.short_rd_id & 0xFF),
-		.df_mcs = params->mcs,
-		.transmit_power = dect_common_utils_dbm_to_phy_tx_power(params->tx_power_dbm),
+		.df_mcs = mcs,
+		.transmit_power = dect_common_utils_dbm_to_phy_tx_power(tx_power_dbm),
 		.receiver_identity_hi = (uint8_t)(target_short_rd_id >> 8),
 		.receiver_identity_lo = (uint8_t)(target_short_rd_id & 0xFF),
 		.feedback.format1.format = 0,
@@ -84,56 +130,33 @@ static int dect_phy_mac_client_data_pdu_encode(struct dect_phy_mac_rach_tx_param
 	dect_phy_mac_type_header_t type_header = {
 		.version = 0,
 		.security = 0, /* 0b00: Not used */
-		.type = DECT_PHY_MAC_HEADER_TYPE_PDU,
+		.type = header_type,
 	};
 	dect_phy_mac_common_header_t common_header = {
-		.type = DECT_PHY_MAC_HEADER_TYPE_PDU,
+		.type = header_type,
 		.reset = 1,
 		.seq_nbr = client_data.client_seq_nbr++,
 		.nw_id = nw_id_24msb, /* 24bit */
 		.transmitter_id = current_settings->common.transmitter_id,
+		.receiver_id = receiver_long_rd_id,
 	};
 	uint8_t *pdu_ptr = *target_ptr;
 
 	pdu_ptr = dect_phy_mac_pdu_type_header_encode(&type_header, pdu_ptr);
 	pdu_ptr = dect_phy_mac_pdu_common_header_encode(&common_header, pdu_ptr);
-
-	sys_dlist_t sdu_list;
-	dect_phy_mac_sdu_t *data_sdu_list_item =
-		(dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
-	if (data_sdu_list_item == NULL) {
-		return -ENOMEM;
-	}
-	uint8_t dlc_header_size = DECT_PHY_MAC_DLC_IE_TYPE_SERV_0_WITHOUT_ROUTING_LEN;
-	uint16_t dlc_payload_len = strlen(params->tx_data_str) + 1;
-	uint16_t payload_data_len = dlc_header_size + dlc_payload_len;
-
-	dect_phy_mac_mux_header_t mux_header1 = {
-		.mac_ext = DECT_PHY_MAC_EXT_16BIT_LEN,
-		.ie_type = DECT_PHY_MAC_IE_TYPE_USER_PLANE_DATA_FLOW1,
-		.payload_length = payload_data_len,
-	};
-
-	data_sdu_list_item->mux_header = mux_header1;
-	data_sdu_list_item->message_type = DECT_PHY_MAC_MESSAGE_TYPE_DATA_SDU;
-	memcpy(data_sdu_list_item->message.data_sdu.data, params->tx_data_str, dlc_payload_len);
-	data_sdu_list_item->message.data_sdu.data_length = dlc_payload_len;
-	data_sdu_list_item->message.data_sdu.dlc_ie_type =
-		DECT_PHY_MAC_DLC_IE_TYPE_SERV_0_WITHOUT_ROUTING;
-
-	sys_dlist_init(&sdu_list);
-	sys_dlist_append(&sdu_list, &data_sdu_list_item->dnode);
-	pdu_ptr = dect_phy_mac_pdu_sdus_encode(pdu_ptr, &sdu_list);
+	pdu_ptr = dect_phy_mac_pdu_sdus_encode(pdu_ptr, sdu_list);
 
 	/* Length so far  */
 	uint16_t encoded_pdu_length = pdu_ptr - *target_ptr;
 
-	header.packet_length = dect_common_utils_phy_packet_length_calculate(
+	int packet_length = dect_common_utils_phy_packet_length_calculate(
 		encoded_pdu_length, header.packet_length_type, header.df_mcs);
-	if (header.packet_length < 0) {
+
+	if (packet_length < 0) {
 		desh_error("(%s): Phy pkt len calculation failed", (__func__));
 		return -EINVAL;
 	}
+	header.packet_length = packet_length;
 	int16_t total_byte_count =
 		dect_common_utils_slots_in_bytes(header.packet_length, header.df_mcs);
 
@@ -144,7 +167,7 @@ static int dect_phy_mac_client_data_pdu_encode(struct dect_phy_mac_rach_tx_param
 	/* Fill padding if needed */
 	int16_t padding_need = total_byte_count - encoded_pdu_length;
 
-	int err = dect_phy_mac_pdu_sdu_list_add_padding(&pdu_ptr, &sdu_list, padding_need);
+	int err = dect_phy_mac_pdu_sdu_list_add_padding(&pdu_ptr, sdu_list, padding_need);
 
 	if (err) {
 		desh_warn("(%s): Failed to add padding: err %d (continue)", __func__, err);
@@ -159,107 +182,97 @@ static int dect_phy_mac_client_data_pdu_encode(struct dect_phy_mac_rach_tx_param
 	return header.packet_length;
 }
 
-static uint64_t dect_phy_mac_client_next_rach_tx_time_get(
-	struct dect_phy_mac_nbr_info_list_item *target_nbr)
+/* DLC service type 0 SDU with the given payload, to be freed by the SDU encoding */
+static dect_phy_mac_sdu_t *dect_phy_mac_client_data_sdu_alloc(const uint8_t *data,
+							      uint16_t data_len)
 {
-	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
-
-	uint64_t time_now = dect_app_modem_time_now();
-	uint64_t beacon_received = target_nbr->time_rcvd_mdm_ticks;
-	uint64_t first_possible_tx = time_now + dect_phy_ctrl_modem_latency_for_next_op_get(true) +
-		(US_TO_MODEM_TICKS(current_settings->scheduler.scheduling_delay_us));
-	uint64_t next_beacon_frame_start, beacon_interval_mdm_ticks, ra_start_mdm_ticks;
-	uint64_t ra_interval_mdm_ticks, last_valid_rach_rx_frame_time;
-
-	int32_t beacon_interval_ms = dect_phy_mac_pdu_cluster_beacon_period_in_ms(
-		target_nbr->beacon_msg.cluster_beacon_period);
+	dect_phy_mac_sdu_t *data_sdu_list_item =
+		(dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
 
-	if (beacon_interval_ms < 0) {
-		return 0;
+	if (data_sdu_list_item == NULL) {
+		return NULL;
 	}
-	bool our_beacon_is_running = dect_phy_mac_cluster_beacon_is_running();
+	dect_phy_mac_mux_header_t mux_header1 = {
+		.mac_ext = DECT_PHY_MAC_EXT_16BIT_LEN,
+		.ie_type = DECT_PHY_MAC_IE_TYPE_USER_PLANE_DATA_FLOW1,
+		.payload_length = DECT_PHY_MAC_DLC_IE_TYPE_SERV_0_WITHOUT_ROUTING_LEN + data_len,
+	};
 
-	if (our_beacon_is_running) {
-		/* If our beacon is running, send beyond the window to get the priority over others.
-		 * This adds more delay to TX but is more reliable to avoid scheduling collisions.
-		 */
-		first_possible_tx += MS_TO_MODEM_TICKS(DECT_PHY_API_SCHEDULER_OP_TIME_WINDOW_MS);
-	}
+	data_sdu_list_item->mux_header = mux_header1;
+	data_sdu_list_item->message_type = DECT_PHY_MAC_MESSAGE_TYPE_DATA_SDU;
+	memcpy(data_sdu_list_item->message.data_sdu.data, data, data_len);
+	data_sdu_list_item->message.data_sdu.data_length = data_len;
+	data_sdu_list_item->message.data_sdu.dlc_ie_type =
+		DECT_PHY_MAC_DLC_IE_TYPE_SERV_0_WITHOUT_ROUTING;
 
-	beacon_interval_mdm_ticks = MS_TO_MODEM_TICKS(beacon_interval_ms);
+	return data_sdu_list_item;
+}
 
-	/* We are sending after next beacon and ...  */
-	next_beacon_frame_start = beacon_received;
-	while (next_beacon_frame_start < first_possible_tx) {
-		next_beacon_frame_start += beacon_interval_mdm_ticks;
-	}
+static int dect_phy_mac_client_data_pdu_encode(struct dect_phy_mac_rach_tx_params *params,
+					       uint32_t nw_id_24msb, uint8_t nw_id_8lsb,
+					       uint16_t target_short_rd_id,
+					       uint8_t **target_ptr, /* In/Out */
+					       union nrf_modem_dect_phy_hdr *out_phy_header)
+{
+	sys_dlist_t sdu_list;
+	dect_phy_mac_sdu_t *data_sdu_list_item = dect_phy_mac_client_data_sdu_alloc(
+		(uint8_t *)params->tx_data_str, strlen(params->tx_data_str) + 1);
 
-	if (target_nbr->ra_ie.repeat == DECT_PHY_MAC_RA_REPEAT_TYPE_SINGLE) {
-		ra_interval_mdm_ticks = beacon_interval_mdm_ticks;
-		last_valid_rach_rx_frame_time = next_beacon_frame_start;
-	} else if (target_nbr->ra_ie.repeat == DECT_PHY_MAC_RA_REPEAT_TYPE_FRAMES) {
-		ra_interval_mdm_ticks =
-			target_nbr->ra_ie.repetition * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS;
-		last_valid_rach_rx_frame_time =
-			next_beacon_frame_start +
-			(target_nbr->ra_ie.validity * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS);
-	} else {
-		__ASSERT_NO_MSG(target_nbr->ra_ie.repeat == DECT_PHY_MAC_RA_REPEAT_TYPE_SUBSLOTS);
-		ra_interval_mdm_ticks =
-			target_nbr->ra_ie.repetition * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS;
-		last_valid_rach_rx_frame_time =
-			next_beacon_frame_start +
-			(target_nbr->ra_ie.validity * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS);
+	if (data_sdu_list_item == NULL) {
+		return -ENOMEM;
 	}
+	sys_dlist_init(&sdu_list);
+	sys_dlist_append(&sdu_list, &data_sdu_list_item->dnode);
 
-	/* .... and after the last client TX */
-	if (client_data.last_tx_time_mdm_ticks > first_possible_tx) {
-		first_possible_tx = client_data.last_tx_time_mdm_ticks + 1;
-	}
+	return dect_phy_mac_client_sdus_pdu_encode(DECT_PHY_MAC_HEADER_TYPE_PDU, params->mcs,
+						   params->tx_power_dbm, nw_id_24msb, nw_id_8lsb,
+						   target_short_rd_id, params->target_long_rd_id,
+						   &sdu_list, target_ptr, out_phy_header);
+}
 
-	/* ... and try to avoid collisions with our own beacon TX:  */
-	uint64_t next_our_beacon_frame_time = 0;
+/* Earliest RACH TX time: modem latency, scheduler delay and after our previous client TX */
+static uint64_t dect_phy_mac_client_first_possible_tx_get(void)
+{
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	uint64_t first_possible_tx =
+		dect_app_modem_time_now() + dect_phy_ctrl_modem_latency_for_next_op_get(true) +
+		(US_TO_MODEM_TICKS(current_settings->scheduler.scheduling_delay_us));
 
 	if (dect_phy_mac_cluster_beacon_is_running()) {
-		next_our_beacon_frame_time =
-			dect_phy_mac_cluster_beacon_last_tx_frame_time_get();
-		uint32_t our_beacon_interval_mdm_ticks =
-			MS_TO_MODEM_TICKS(DECT_PHY_MAC_CLUSTER_BEACON_INTERVAL_MS);
-
-		while (next_our_beacon_frame_time < first_possible_tx) {
-			next_our_beacon_frame_time += our_beacon_interval_mdm_ticks;
-		}
+		/* If our beacon is running, send beyond the window to get the priority over others.
+		 * This adds more delay to TX but is more reliable to avoid scheduling collisions.
+		 */
+		first_possible_tx += MS_TO_MODEM_TICKS(DECT_PHY_API_SCHEDULER_OP_TIME_WINDOW_MS);
+	}
+	if (client_data.last_tx_time_mdm_ticks >= first_possible_tx) {
+		first_possible_tx = client_data.last_tx_time_mdm_ticks + 1;
 	}
+	return first_possible_tx;
+}
 
-	/* ...and in 1st RA (if not associated). Additionally, to get RX really on target:
-	 * delay TX by 2 subslots.
-	 */
-	ra_start_mdm_ticks = next_beacon_frame_start + ((target_nbr->ra_ie.start_subslot + 2) *
-							DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
-
-	if (dect_phy_mac_client_associated_by_target_short_rd_id(target_nbr->short_rd_id)) {
-		/* To avoid collision with a background scan that is done with associated client */
-		ra_start_mdm_ticks += ra_interval_mdm_ticks;
-	}
-
-	while (ra_start_mdm_ticks < first_possible_tx &&
-	       ra_start_mdm_ticks < last_valid_rach_rx_frame_time) {
-		ra_start_mdm_ticks += ra_interval_mdm_ticks;
-		if (next_our_beacon_frame_time && dect_common_utils_mdm_ticks_is_in_range(
-							ra_start_mdm_ticks,
-							next_our_beacon_frame_time,
-							next_our_beacon_frame_time +
-							(DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS /
-								2))) {
-			ra_start_mdm_ticks += ra_interval_mdm_ticks;
-		}
+static uint64_t dect_phy_mac_client_next_rach_tx_time_get(
+	struct dect_phy_mac_nbr_info_list_item *target_nbr)
+{
+	struct dect_phy_mac_rach_opp_params opp_params;
+	struct dect_phy_mac_rach_opp_iter opp_iter;
+
+	/* With an associated client, skip the 1st RA to avoid collision with a background scan */
+	if (dect_phy_mac_rach_opp_params_from_nbr(
+		    target_nbr,
+		    dect_phy_mac_client_associated_by_target_short_rd_id(target_nbr->short_rd_id),
+		    &opp_params)) {
+		return 0;
 	}
+	dect_phy_mac_rach_opp_iter_init(&opp_iter, &opp_params,
+					dect_phy_mac_client_first_possible_tx_get());
 
-	return ra_start_mdm_ticks;
+	return dect_phy_mac_rach_opp_iter_next(&opp_iter);
 }
 
 static int dect_phy_mac_client_rach_tx(struct dect_phy_mac_nbr_info_list_item *target_nbr,
 				struct dect_phy_mac_rach_tx_params *params);
+static struct dect_phy_mac_client_association_data *dect_phy_mac_client_association_data_get(
+	uint32_t target_long_rd_id);
 
 struct dect_phy_mac_client_rach_tx_data {
 	struct k_work_delayable work;
@@ -295,16 +308,13 @@ static void dect_phy_mac_client_rach_tx_worker(struct k_work *work_item)
 	}
 
 	/* Get fresh nbr info */
-	struct dect_phy_mac_nbr_info_list_item *scan_info =
-		dect_phy_mac_nbr_info_get_by_long_rd_id(cmd_params.target_long_rd_id);
-
-	if (!scan_info) {
+	if (!dect_phy_mac_nbr_info_copy_by_long_rd_id(cmd_params.target_long_rd_id,
+						      &data->target_nbr)) {
 		desh_warn("(%s): Beacon with long RD ID %u has not been seen in scan results",
 			(__func__), cmd_params.target_long_rd_id);
 		return;
 	}
 
-	data->target_nbr = *scan_info;
 	err = dect_phy_mac_client_rach_tx(&data->target_nbr, &cmd_params);
 	if (err) {
 		desh_error("(%s): client_rach_tx failed: %d", (__func__), err);
@@ -387,7 +397,8 @@ static int dect_phy_mac_client_rach_tx(struct dect_phy_mac_nbr_info_list_item *t
 
 	sched_list_item_conf->cb_op_completed = NULL;
 
-	sched_list_item_conf->channel = target_nbr->channel;
+	sched_list_item_conf->channel =
+		dect_phy_mac_nbr_channel_at_time_get(target_nbr, ra_start_mdm_ticks);
 	sched_list_item_conf->frame_time = ra_start_mdm_ticks;
 	sched_list_item_conf->start_slot = 0;
 
@@ -424,6 +435,14 @@ static int dect_phy_mac_client_rach_tx(struct dect_phy_mac_nbr_info_list_item *t
 		dect_phy_api_scheduler_list_item_dealloc(sched_list_item);
 		return -EBUSY;
 	}
+
+	struct dect_phy_mac_client_association_data *association_data =
+		dect_phy_mac_client_association_data_get(params->target_long_rd_id);
+
+	if (association_data != NULL) {
+		/* Data counts as activity: no need for a keep alive */
+		association_data->last_tx_time_mdm_ticks = ra_start_mdm_ticks;
+	}
 	desh_print("Scheduled random access data TX:\n"
 		   "  target long rd id %u (0x%08x), short rd id %u (0x%04x),\n"
 		   "  target 32bit nw id %u (0x%08x), tx pwr %d dbm,\n"
@@ -431,7 +450,7 @@ static int dect_phy_mac_client_rach_tx(struct dect_phy_mac_nbr_info_list_item *t
 		   "  beacon interval %d, frame time %lld, beacon received %lld",
 		   params->target_long_rd_id, params->target_long_rd_id, target_nbr->short_rd_id,
 		   target_nbr->short_rd_id, target_nbr->nw_id_32bit, target_nbr->nw_id_32bit,
-		   params->tx_power_dbm, target_nbr->channel, encoded_pdu_length,
+		   params->tx_power_dbm, sched_list_item_conf->channel, encoded_pdu_length,
 		   beacon_interval_ms, sched_list_item_conf->frame_time, beacon_received);
 
 	return 0;
@@ -544,12 +563,14 @@ static int dect_phy_mac_client_association_req_pdu_encode(
 	/* Length so far  */
 	uint16_t encoded_pdu_length = pdu_ptr - *target_ptr;
 
-	header.packet_length = dect_common_utils_phy_packet_length_calculate(
+	int packet_length = dect_common_utils_phy_packet_length_calculate(
 		encoded_pdu_length, header.packet_length_type, header.df_mcs);
-	if (header.packet_length < 0) {
+
+	if (packet_length < 0) {
 		desh_error("(%s): Phy pkt len calculation failed", (__func__));
 		return -EINVAL;
 	}
+	header.packet_length = packet_length;
 	int16_t total_byte_count =
 		dect_common_utils_slots_in_bytes(header.packet_length, header.df_mcs);
 
@@ -629,7 +650,8 @@ static int dect_phy_mac_client_associate_msg_send(
 
 	sched_list_item_conf->cb_op_completed = NULL;
 
-	sched_list_item_conf->channel = target_nbr->channel;
+	sched_list_item_conf->channel =
+		dect_phy_mac_nbr_channel_at_time_get(target_nbr, ra_start_mdm_ticks);
 	sched_list_item_conf->frame_time = ra_start_mdm_ticks;
 	sched_list_item_conf->start_slot = 0;
 
@@ -681,7 +703,9 @@ static int dect_phy_mac_client_associate_msg_send(
 			   (3 * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
 
 	rach_list_item_conf->cb_op_completed = NULL;
-	rach_list_item_conf->channel = target_nbr->channel;
+	/* Response comes on the channel of the request */
+	rach_list_item_conf->channel =
+		dect_phy_mac_nbr_channel_at_time_get(target_nbr, ra_start_mdm_ticks);
 	rach_list_item_conf->frame_time = rx_time;
 	rach_list_item_conf->start_slot = 0;
 
@@ -718,7 +742,7 @@ static int dect_phy_mac_client_associate_msg_send(
 		   "  beacon interval %d, frame time %lld, beacon received %lld",
 		   params->target_long_rd_id, params->target_long_rd_id, target_nbr->short_rd_id,
 		   target_nbr->short_rd_id, target_nbr->nw_id_32bit, target_nbr->nw_id_32bit,
-		   params->tx_power_dbm, target_nbr->channel, encoded_pdu_length,
+		   params->tx_power_dbm, sched_list_item_conf->channel, encoded_pdu_length,
 		   beacon_interval_ms, sched_list_item_conf->frame_time, beacon_received);
 
 	return 0;
@@ -737,9 +761,18 @@ static struct dect_phy_mac_client_association_data *dect_phy_mac_client_free_ass
 	return NULL;
 }
 
+static void dect_phy_mac_client_associate_resp_timeout_cb(struct dect_phy_mac_timer *timer);
+static void dect_phy_mac_client_keep_alive_timer_cb(struct dect_phy_mac_timer *timer);
+static void dect_phy_mac_client_ul_queue_purge(
+	struct dect_phy_mac_client_association_data *association_data);
+
 static void dect_phy_mac_client_association_data_init(void)
 {
 	for (int i = 0; i < DECT_PHY_MAC_MAX_NEIGBORS; i++) {
+		dect_phy_mac_timer_init(&client_data.associations[i].association_resp_timer,
+					dect_phy_mac_client_associate_resp_timeout_cb);
+		dect_phy_mac_timer_init(&client_data.associations[i].keep_alive_timer,
+					dect_phy_mac_client_keep_alive_timer_cb);
 		client_data.associations[i].state =
 			DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_DISASSOCIATED;
 		client_data.associations[i].target_long_rd_id = 0;
@@ -747,6 +780,7 @@ static void dect_phy_mac_client_association_data_init(void)
 			DECT_PHY_MAC_CLIENT_ASSOCIATED_BG_SCAN + i;
 		client_data.associations[i].target_nbr = NULL;
 		client_data.associations[i].bg_scan_ongoing = false;
+		sys_dlist_init(&client_data.associations[i].ul_queue);
 	}
 }
 
@@ -761,12 +795,11 @@ static struct dect_phy_mac_client_association_data *dect_phy_mac_client_associat
 	return NULL;
 }
 
-static void dect_phy_mac_client_associate_resp_timeout_worker(struct k_work *work_item)
+static void dect_phy_mac_client_associate_resp_timeout_cb(struct dect_phy_mac_timer *timer)
 {
-	struct k_work_delayable *delayable_work = k_work_delayable_from_work(work_item);
 	struct dect_phy_mac_client_association_data *association_data =
-		CONTAINER_OF(delayable_work, struct dect_phy_mac_client_association_data,
-			     association_resp_wait_work);
+		CONTAINER_OF(timer, struct dect_phy_mac_client_association_data,
+			     association_resp_timer);
 
 	if (association_data->state !=
 		DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_WAITING_ASSOCIATION_RESP) {
@@ -775,6 +808,7 @@ static void dect_phy_mac_client_associate_resp_timeout_worker(struct k_work *wor
 
 	association_data->target_nbr = NULL;
 	association_data->state = DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_DISASSOCIATED;
+	(void)dect_phy_mac_nbr_info_pin_set(association_data->target_long_rd_id, false);
 	dect_phy_mac_nbr_bg_scan_stop(association_data->bg_scan_phy_handle);
 	association_data->bg_scan_ongoing = false;
 
@@ -806,18 +840,19 @@ int dect_phy_mac_client_associate(struct dect_phy_mac_nbr_info_list_item *target
 			(__func__), err);
 		return err;
 	}
+	dect_phy_mac_client_ul_queue_purge(association_data);
 	association_data->state = DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_WAITING_ASSOCIATION_RESP;
 	association_data->target_long_rd_id = params->target_long_rd_id;
 	association_data->target_nbr = target_nbr;
+	association_data->params = *params;
 
-	k_work_init_delayable(
-		&association_data->association_resp_wait_work,
-		dect_phy_mac_client_associate_resp_timeout_worker);
+	/* Keep target_nbr in place in nbr table for as long as associated */
+	(void)dect_phy_mac_nbr_info_pin_set(params->target_long_rd_id, true);
 
-	/* Start worker for waiting association response */
-	k_work_schedule_for_queue(&dect_phy_ctrl_work_q,
-				  &association_data->association_resp_wait_work,
-				  K_SECONDS(DECT_PHY_MAC_CLIENT_ASSOCIATION_RESP_WAIT_TIME_SEC));
+	/* Start timer for waiting association response */
+	dect_phy_mac_timer_stop(&association_data->keep_alive_timer);
+	dect_phy_mac_timer_start(&association_data->association_resp_timer,
+				 DECT_PHY_MAC_CLIENT_ASSOCIATION_RESP_WAIT_TIME_SEC * 1000);
 	return 0;
 }
 
@@ -860,11 +895,12 @@ void dect_phy_mac_client_associate_resp_handle(
 		return;
 	}
 
-	/* Stop timeout work */
-	k_work_cancel_delayable(&association_data->association_resp_wait_work);
+	/* Stop timeout timer */
+	dect_phy_mac_timer_stop(&association_data->association_resp_timer);
 
 	if (!association_resp->ack_bit) {
 		association_data->state = DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_DISASSOCIATED;
+		(void)dect_phy_mac_nbr_info_pin_set(association_data->target_long_rd_id, false);
 
 		desh_warn("(%s): association rejected by FT %u (reject_cause=%u)",
 			  __func__, common_header->transmitter_id,
@@ -876,6 +912,10 @@ void dect_phy_mac_client_associate_resp_handle(
 
 	/* ACK => associated */
 	association_data->state = DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_ASSOCIATED;
+	association_data->last_tx_time_mdm_ticks = dect_app_modem_time_now();
+	memset(&association_data->ul_stats, 0, sizeof(association_data->ul_stats));
+	dect_phy_mac_timer_start(&association_data->keep_alive_timer,
+				 DECT_PHY_MAC_CLIENT_KEEP_ALIVE_INTERVAL_SEC * 1000);
 
 	desh_print("(%s): associated with device %u - starting background scan",
 		   __func__, common_header->transmitter_id);
@@ -966,12 +1006,14 @@ static int dect_phy_mac_client_association_rel_pdu_encode(
 	/* Length so far  */
 	uint16_t encoded_pdu_length = pdu_ptr - *target_ptr;
 
-	header.packet_length = dect_common_utils_phy_packet_length_calculate(
+	int packet_length = dect_common_utils_phy_packet_length_calculate(
 		encoded_pdu_length, header.packet_length_type, header.df_mcs);
-	if (header.packet_length < 0) {
+
+	if (packet_length < 0) {
 		desh_error("(%s): Phy pkt len calculation failed", (__func__));
 		return -EINVAL;
 	}
+	header.packet_length = packet_length;
 	int16_t total_byte_count =
 		dect_common_utils_slots_in_bytes(header.packet_length, header.df_mcs);
 
@@ -1049,7 +1091,8 @@ static int dect_phy_mac_client_dissociate_msg_send(
 
 	sched_list_item_conf->cb_op_completed = NULL;
 
-	sched_list_item_conf->channel = target_nbr->channel;
+	sched_list_item_conf->channel =
+		dect_phy_mac_nbr_channel_at_time_get(target_nbr, ra_start_mdm_ticks);
 	sched_list_item_conf->frame_time = ra_start_mdm_ticks;
 	sched_list_item_conf->start_slot = 0;
 
@@ -1090,7 +1133,7 @@ static int dect_phy_mac_client_dissociate_msg_send(
 		   "  beacon interval %d, frame time %lld, beacon received %lld",
 		   params->target_long_rd_id, params->target_long_rd_id, target_nbr->short_rd_id,
 		   target_nbr->short_rd_id, target_nbr->nw_id_32bit, target_nbr->nw_id_32bit,
-		   params->tx_power_dbm, target_nbr->channel, encoded_pdu_length,
+		   params->tx_power_dbm, sched_list_item_conf->channel, encoded_pdu_length,
 		   beacon_interval_ms, sched_list_item_conf->frame_time, beacon_received);
 
 	return 0;
@@ -1109,14 +1152,17 @@ int dect_phy_mac_client_dissociate(struct dect_phy_mac_nbr_info_list_item *targe
 		return -EINVAL;
 	}
 
-	k_work_cancel_delayable(&association_data->association_resp_wait_work);
+	dect_phy_mac_timer_stop(&association_data->association_resp_timer);
+	dect_phy_mac_timer_stop(&association_data->keep_alive_timer);
 
 	dect_phy_mac_nbr_bg_scan_stop(association_data->bg_scan_phy_handle);
 	association_data->bg_scan_ongoing = false;
+	dect_phy_mac_client_ul_queue_purge(association_data);
 
 	association_data->state = DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_DISASSOCIATED;
 	association_data->target_nbr = NULL;
 	association_data->target_long_rd_id = 0;
+	(void)dect_phy_mac_nbr_info_pin_set(target_nbr->long_rd_id, false);
 
 	err = dect_phy_mac_client_dissociate_msg_send(target_nbr, params);
 	if (err) {
@@ -1127,6 +1173,510 @@ int dect_phy_mac_client_dissociate(struct dect_phy_mac_nbr_info_list_item *targe
 	return err;
 }
 
+/**************************************************************************************************/
+
+/* Encodes the SDUs into a PDU to the associated FT and schedules its TX at the given RA
+ * opportunity. SDU list is consumed. Returns the PDU length in slots, or negative errno.
+ */
+static int dect_phy_mac_client_sdus_tx_schedule(
+	struct dect_phy_mac_client_association_data *association_data,
+	struct dect_phy_mac_nbr_info_list_item *target_nbr, dect_phy_mac_header_type_t header_type,
+	sys_dlist_t *sdu_list, uint64_t tx_time_mdm_ticks, uint32_t phy_op_handle)
+{
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	struct dect_phy_mac_associate_params *params = &association_data->params;
+	union nrf_modem_dect_phy_hdr phy_header;
+	uint8_t encoded_data_to_send[DECT_DATA_MAX_LEN];
+	uint8_t *pdu_ptr = encoded_data_to_send;
+	uint8_t slot_count;
+	int ret;
+
+	memset(encoded_data_to_send, 0, DECT_DATA_MAX_LEN);
+
+	ret = dect_phy_mac_client_sdus_pdu_encode(
+		header_type, params->mcs, params->tx_power_dbm, target_nbr->nw_id_24msb,
+		target_nbr->nw_id_8lsb, target_nbr->short_rd_id, params->target_long_rd_id,
+		sdu_list, &pdu_ptr, &phy_header);
+	if (ret < 0) {
+		return ret;
+	}
+	slot_count = ret + 1;
+
+	struct dect_phy_api_scheduler_list_item_config *sched_list_item_conf;
+	struct dect_phy_api_scheduler_list_item *sched_list_item =
+		dect_phy_api_scheduler_list_item_alloc_tx_element(&sched_list_item_conf);
+
+	if (!sched_list_item) {
+		return -ENOMEM;
+	}
+
+	sched_list_item_conf->address_info.network_id = target_nbr->nw_id_32bit;
+	sched_list_item_conf->address_info.transmitter_long_rd_id =
+		current_settings->common.transmitter_id;
+	sched_list_item_conf->address_info.receiver_long_rd_id = params->target_long_rd_id;
+
+	sched_list_item_conf->cb_op_completed = NULL;
+
+	sched_list_item_conf->channel =
+		dect_phy_mac_nbr_channel_at_time_get(target_nbr, tx_time_mdm_ticks);
+	sched_list_item_conf->frame_time = tx_time_mdm_ticks;
+	sched_list_item_conf->start_slot = 0;
+
+	sched_list_item_conf->interval_mdm_ticks = 0;
+	sched_list_item_conf->length_slots = slot_count;
+	sched_list_item_conf->length_subslots = 0;
+
+	sched_list_item_conf->tx.phy_lbt_period = NRF_MODEM_DECT_LBT_PERIOD_MIN;
+	sched_list_item_conf->tx.phy_lbt_rssi_threshold_max =
+		current_settings->rssi_scan.busy_threshold;
+
+	sched_list_item_conf->tx.harq_feedback_requested = false;
+
+	sched_list_item->sched_config.tx.encoded_payload_pdu_size =
+		pdu_ptr - encoded_data_to_send;
+	memcpy(sched_list_item->sched_config.tx.encoded_payload_pdu, encoded_data_to_send,
+	       sched_list_item->sched_config.tx.encoded_payload_pdu_size);
+
+	sched_list_item->sched_config.tx.header_type = DECT_PHY_HEADER_TYPE2;
+	memcpy(&sched_list_item->sched_config.tx.phy_header.type_2, &phy_header.type_2,
+	       sizeof(phy_header.type_2));
+
+	sched_list_item->priority = DECT_PRIORITY1_TX;
+	sched_list_item->phy_op_handle = phy_op_handle;
+
+	if (!dect_phy_api_scheduler_list_item_add(sched_list_item)) {
+		dect_phy_api_scheduler_list_item_dealloc(sched_list_item);
+		return -EBUSY;
+	}
+	return slot_count;
+}
+
+static int dect_phy_mac_client_keep_alive_msg_send(
+	struct dect_phy_mac_client_association_data *association_data,
+	struct dect_phy_mac_nbr_info_list_item *target_nbr)
+{
+	uint64_t ra_start_mdm_ticks;
+	sys_dlist_t sdu_list;
+	int ret;
+
+	ra_start_mdm_ticks = dect_phy_mac_client_next_rach_tx_time_get(target_nbr);
+	if (ra_start_mdm_ticks == 0) {
+		desh_error("(%s): Failed to get next RACH TX time", __func__);
+		return -EINVAL;
+	}
+
+	dect_phy_mac_sdu_t *keep_alive_sdu_list_item =
+		(dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
+	if (keep_alive_sdu_list_item == NULL) {
+		return -ENOMEM;
+	}
+
+	/* MAC spec: Table 6.3.4-3: Keep alive is a short IE without a payload */
+	dect_phy_mac_mux_header_t mux_header1 = {
+		.mac_ext = DECT_PHY_MAC_EXT_SHORT_IE,
+		.ie_type = DECT_PHY_MAC_IE_TYPE_0BYTE_KEEP_ALIVE_IE,
+		.payload_length = 0,
+	};
+
+	keep_alive_sdu_list_item->mux_header = mux_header1;
+	keep_alive_sdu_list_item->message_type = DECT_PHY_MAC_MESSAGE_TYPE_KEEP_ALIVE;
+
+	sys_dlist_init(&sdu_list);
+	sys_dlist_append(&sdu_list, &keep_alive_sdu_list_item->dnode);
+
+	ret = dect_phy_mac_client_sdus_tx_schedule(
+		association_data, target_nbr, DECT_PHY_MAC_HEADER_TYPE_UNICAST, &sdu_list,
+		ra_start_mdm_ticks, DECT_PHY_MAC_CLIENT_KEEP_ALIVE_TX_HANDLE);
+	if (ret < 0) {
+		desh_error("(%s): Failed to schedule keep alive: %d", (__func__), ret);
+		return ret;
+	}
+	client_data.last_tx_time_mdm_ticks = ra_start_mdm_ticks;
+	association_data->last_tx_time_mdm_ticks = ra_start_mdm_ticks;
+
+	return 0;
+}
+
+static void dect_phy_mac_client_keep_alive_timer_cb(struct dect_phy_mac_timer *timer)
+{
+	struct dect_phy_mac_client_association_data *association_data =
+		CONTAINER_OF(timer, struct dect_phy_mac_client_association_data,
+			     keep_alive_timer);
+	uint64_t interval_mdm_ticks =
+		SECONDS_TO_MODEM_TICKS(DECT_PHY_MAC_CLIENT_KEEP_ALIVE_INTERVAL_SEC);
+	uint64_t time_now = dect_app_modem_time_now();
+	int err;
+
+	if (association_data->state != DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_ASSOCIATED) {
+		return;
+	}
+
+	if (association_data->last_tx_time_mdm_ticks + interval_mdm_ticks > time_now) {
+		/* Data has been sent meanwhile: re-arm for the rest of the idle interval */
+		uint64_t remaining_mdm_ticks =
+			association_data->last_tx_time_mdm_ticks + interval_mdm_ticks - time_now;
+
+		dect_phy_mac_timer_start(timer, (uint32_t)MODEM_TICKS_TO_MS(remaining_mdm_ticks));
+		return;
+	}
+
+	/* Get fresh nbr info as a copy: not updated by beacons meanwhile */
+	struct dect_phy_mac_nbr_info_list_item target_nbr;
+
+	if (!dect_phy_mac_nbr_info_copy_by_long_rd_id(association_data->target_long_rd_id,
+						      &target_nbr)) {
+		desh_warn("(%s): FT long RD ID %u not in nbr table, keep alive not sent",
+			  (__func__), association_data->target_long_rd_id);
+	} else {
+		err = dect_phy_mac_client_keep_alive_msg_send(association_data, &target_nbr);
+		if (err) {
+			desh_warn("(%s): keep alive to FT %u failed: %d", (__func__),
+				  association_data->target_long_rd_id, err);
+		}
+	}
+	dect_phy_mac_timer_start(timer, DECT_PHY_MAC_CLIENT_KEEP_ALIVE_INTERVAL_SEC * 1000);
+}
+
+void dect_phy_mac_client_association_rel_handle(
+	dect_phy_mac_common_header_t *common_header,
+	dect_phy_mac_association_rel_t *association_rel)
+{
+	struct dect_phy_mac_client_association_data *association_data =
+		dect_phy_mac_client_association_data_get(common_header->transmitter_id);
+
+	if (!association_data ||
+	    association_data->state == DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_DISASSOCIATED) {
+		return;
+	}
+
+	dect_phy_mac_timer_stop(&association_data->association_resp_timer);
+	dect_phy_mac_timer_stop(&association_data->keep_alive_timer);
+
+	dect_phy_mac_nbr_bg_scan_stop(association_data->bg_scan_phy_handle);
+	association_data->bg_scan_ongoing = false;
+	dect_phy_mac_client_ul_queue_purge(association_data);
+
+	association_data->state = DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_DISASSOCIATED;
+	association_data->target_nbr = NULL;
+	association_data->target_long_rd_id = 0;
+	(void)dect_phy_mac_nbr_info_pin_set(common_header->transmitter_id, false);
+
+	desh_warn("Association released by FT long RD ID %u: %s",
+		  common_header->transmitter_id,
+		  dect_phy_mac_pdu_association_rel_cause_string_get(association_rel->rel_cause));
+}
+
+/**************************************************************************************************/
+
+/* Fills the cache with the next RA opportunities of target_nbr at or after not_before */
+static void dect_phy_mac_client_rach_opp_cache_fill(
+	struct dect_phy_mac_client_rach_opp_cache *cache,
+	struct dect_phy_mac_nbr_info_list_item *target_nbr, uint64_t not_before)
+{
+	struct dect_phy_mac_rach_opp_params opp_params;
+	struct dect_phy_mac_rach_opp_iter opp_iter;
+
+	cache->beacon_rcvd_mdm_ticks = target_nbr->time_rcvd_mdm_ticks;
+	cache->count = 0;
+	cache->next = 0;
+
+	if (dect_phy_mac_rach_opp_params_from_nbr(
+		    target_nbr,
+		    dect_phy_mac_client_associated_by_target_short_rd_id(target_nbr->short_rd_id),
+		    &opp_params)) {
+		return;
+	}
+	dect_phy_mac_rach_opp_iter_init(&opp_iter, &opp_params, not_before);
+
+	while (cache->count < DECT_PHY_MAC_CLIENT_RACH_OPP_CACHE_LEN) {
+		uint64_t ra_time = dect_phy_mac_rach_opp_iter_next(&opp_iter);
+
+		if (ra_time == 0) {
+			break;
+		}
+		cache->opps_mdm_ticks[cache->count++] = ra_time;
+	}
+}
+
+/* Next cached RA opportunity at or after not_before. Returns 0 if there is none. */
+static uint64_t dect_phy_mac_client_rach_opp_next_get(
+	struct dect_phy_mac_client_association_data *association_data,
+	struct dect_phy_mac_nbr_info_list_item *target_nbr, uint64_t not_before)
+{
+	struct dect_phy_mac_client_rach_opp_cache *cache = &association_data->rach_opps;
+
+	if (cache->beacon_rcvd_mdm_ticks != target_nbr->time_rcvd_mdm_ticks) {
+		/* Beacon seen again: timing might have been shifted */
+		cache->count = 0;
+		cache->next = 0;
+	}
+	while (cache->next < cache->count && cache->opps_mdm_ticks[cache->next] < not_before) {
+		cache->next++;
+	}
+	if (cache->next >= cache->count) {
+		dect_phy_mac_client_rach_opp_cache_fill(cache, target_nbr, not_before);
+		if (cache->count == 0) {
+			return 0;
+		}
+	}
+	return cache->opps_mdm_ticks[cache->next++];
+}
+
+/* Max payload bytes in one RACH TX towards target_nbr with the given MCS */
+static int dect_phy_mac_client_rach_tbs_get(struct dect_phy_mac_nbr_info_list_item *target_nbr,
+					    uint8_t mcs)
+{
+	int tbs;
+
+	if (target_nbr->ra_ie.max_rach_length_type == DECT_PHY_HEADER_PKT_LENGTH_TYPE_SUBSLOTS) {
+		tbs = dect_common_utils_subslots_in_bytes(target_nbr->ra_ie.max_rach_length, mcs);
+	} else {
+		tbs = dect_common_utils_slots_in_bytes(target_nbr->ra_ie.max_rach_length, mcs);
+	}
+	return MIN(tbs, DECT_DATA_MAX_LEN);
+}
+
+static void dect_phy_mac_client_ul_queue_purge(
+	struct dect_phy_mac_client_association_data *association_data)
+{
+	k_mutex_lock(&client_data.ul_mutex, K_FOREVER);
+	while (!sys_dlist_is_empty(&association_data->ul_queue)) {
+		sys_dnode_t *node = sys_dlist_get(&association_data->ul_queue);
+
+		k_free(CONTAINER_OF(node, struct dect_phy_mac_client_ul_sdu, dnode));
+		association_data->ul_stats.sdus_dropped++;
+	}
+	association_data->ul_queue_count = 0;
+	association_data->rach_opps.count = 0;
+	association_data->rach_opps.next = 0;
+	k_mutex_unlock(&client_data.ul_mutex);
+}
+
+int dect_phy_mac_client_ul_sdu_enqueue(uint32_t target_long_rd_id, const uint8_t *data,
+				       uint16_t data_len)
+{
+	struct dect_phy_mac_client_association_data *association_data =
+		dect_phy_mac_client_association_data_get(target_long_rd_id);
+	struct dect_phy_mac_client_ul_sdu *ul_sdu;
+
+	if (!association_data ||
+	    association_data->state != DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_ASSOCIATED) {
+		return -ENOTCONN;
+	}
+	if (data_len == 0 || data_len > DECT_PHY_MAC_CLIENT_UL_SDU_MAX_LEN) {
+		return -EMSGSIZE;
+	}
+
+	k_mutex_lock(&client_data.ul_mutex, K_FOREVER);
+	if (association_data->ul_queue_count >= DECT_PHY_MAC_CLIENT_UL_QUEUE_MAX_SDUS) {
+		k_mutex_unlock(&client_data.ul_mutex);
+		return -ENOBUFS;
+	}
+	ul_sdu = k_malloc(sizeof(struct dect_phy_mac_client_ul_sdu));
+	if (ul_sdu == NULL) {
+		k_mutex_unlock(&client_data.ul_mutex);
+		return -ENOMEM;
+	}
+	ul_sdu->data_len = data_len;
+	memcpy(ul_sdu->data, data, data_len);
+	sys_dlist_append(&association_data->ul_queue, &ul_sdu->dnode);
+	association_data->ul_queue_count++;
+	if (association_data->ul_stats.first_enqueue_time_ms == 0) {
+		association_data->ul_stats.first_enqueue_time_ms = k_uptime_get();
+	}
+	k_mutex_unlock(&client_data.ul_mutex);
+
+	/* No-op if already pending */
+	k_work_schedule_for_queue(&dect_phy_ctrl_work_q, &client_data.ul_tx_work, K_NO_WAIT);
+	return 0;
+}
+
+/* Copies as many SDUs from the queue head as fit into tbs_bytes to sdu_list. They stay
+ * queued until released after a successful scheduling. With ul_mutex held.
+ */
+static int dect_phy_mac_client_ul_sdus_take(
+	struct dect_phy_mac_client_association_data *association_data, int tbs_bytes,
+	sys_dlist_t *sdu_list, uint32_t *out_byte_count)
+{
+	int space = tbs_bytes - dect_phy_mac_pdy_type_n_common_header_len_get(
+					DECT_PHY_MAC_HEADER_TYPE_PDU);
+	sys_dnode_t *node = sys_dlist_peek_head(&association_data->ul_queue);
+	int sdu_count = 0;
+
+	*out_byte_count = 0;
+	while (node != NULL) {
+		struct dect_phy_mac_client_ul_sdu *ul_sdu =
+			CONTAINER_OF(node, struct dect_phy_mac_client_ul_sdu, dnode);
+		dect_phy_mac_sdu_t *mac_sdu;
+		int needed;
+
+		node = sys_dlist_peek_next(&association_data->ul_queue, node);
+
+		mac_sdu = dect_phy_mac_client_data_sdu_alloc(ul_sdu->data, ul_sdu->data_len);
+		if (mac_sdu == NULL) {
+			break;
+		}
+		needed = dect_phy_mac_pdu_mux_header_length_get(&mac_sdu->mux_header) +
+			 mac_sdu->mux_header.payload_length;
+		if (needed > space) {
+			k_free(mac_sdu);
+			if (sdu_count == 0) {
+				/* Does not fit even alone: drop it */
+				desh_warn("(%s): UL SDU of %d bytes does not fit into RACH TBS %d "
+					  "- dropped", (__func__), ul_sdu->data_len, tbs_bytes);
+				sys_dlist_remove(&ul_sdu->dnode);
+				k_free(ul_sdu);
+				association_data->ul_queue_count--;
+				association_data->ul_stats.sdus_dropped++;
+				continue;
+			}
+			break;
+		}
+		space -= needed;
+		sys_dlist_append(sdu_list, &mac_sdu->dnode);
+		*out_byte_count += ul_sdu->data_len;
+		sdu_count++;
+	}
+	return sdu_count;
+}
+
+/* Frees sdu_count taken SDUs from the queue head. With ul_mutex held. */
+static void dect_phy_mac_client_ul_sdus_release(
+	struct dect_phy_mac_client_association_data *association_data, int sdu_count)
+{
+	while (sdu_count-- > 0) {
+		sys_dnode_t *node = sys_dlist_get(&association_data->ul_queue);
+
+		__ASSERT_NO_MSG(node != NULL);
+		k_free(CONTAINER_OF(node, struct dect_phy_mac_client_ul_sdu, dnode));
+		association_data->ul_queue_count--;
+	}
+}
+
+/* Schedules queued SDUs of one association into the next RA opportunities.
+ * Returns ms after which the queue needs to be served again, 0 if nothing left.
+ */
+static int32_t dect_phy_mac_client_ul_queue_serve(
+	struct dect_phy_mac_client_association_data *association_data)
+{
+	struct dect_phy_mac_nbr_info_list_item target_nbr_copy;
+	struct dect_phy_mac_nbr_info_list_item *target_nbr = &target_nbr_copy;
+	uint64_t not_before = dect_phy_mac_client_first_possible_tx_get();
+	uint64_t tx_time = 0;
+	int tbs;
+
+	if (!dect_phy_mac_nbr_info_copy_by_long_rd_id(association_data->target_long_rd_id,
+						      &target_nbr_copy)) {
+		desh_warn("(%s): FT %u not in nbr table, UL queue dropped", (__func__),
+			  association_data->target_long_rd_id);
+		dect_phy_mac_client_ul_queue_purge(association_data);
+		return 0;
+	}
+	tbs = dect_phy_mac_client_rach_tbs_get(target_nbr, association_data->params.mcs);
+
+	k_mutex_lock(&client_data.ul_mutex, K_FOREVER);
+	for (int i = 0; i < DECT_PHY_MAC_CLIENT_UL_MAX_PDUS_PER_ROUND &&
+			!sys_dlist_is_empty(&association_data->ul_queue); i++) {
+		sys_dlist_t sdu_list;
+		uint32_t byte_count;
+		int sdu_count, slot_count;
+
+		tx_time = dect_phy_mac_client_rach_opp_next_get(association_data, target_nbr,
+								not_before);
+		if (tx_time == 0) {
+			break;
+		}
+		sys_dlist_init(&sdu_list);
+		sdu_count = dect_phy_mac_client_ul_sdus_take(association_data, tbs, &sdu_list,
+							     &byte_count);
+		if (sdu_count == 0) {
+			/* Queue emptied by drops, or no memory: retry on the next round */
+			break;
+		}
+		slot_count = dect_phy_mac_client_sdus_tx_schedule(
+			association_data, target_nbr, DECT_PHY_MAC_HEADER_TYPE_PDU, &sdu_list,
+			tx_time, DECT_PHY_MAC_CLIENT_UL_TX_HANDLE);
+		if (slot_count < 0) {
+			/* SDUs stay queued for the next round */
+			desh_warn("(%s): UL PDU to FT %u failed: %d", (__func__),
+				  association_data->target_long_rd_id, slot_count);
+			break;
+		}
+		dect_phy_mac_client_ul_sdus_release(association_data, sdu_count);
+		association_data->ul_stats.sdus_sent += sdu_count;
+		association_data->ul_stats.pdus_sent++;
+		association_data->ul_stats.bytes_sent += byte_count;
+		association_data->ul_stats.last_tx_scheduled_time_ms = k_uptime_get();
+
+		/* Back-to-back: next one after this TX */
+		client_data.last_tx_time_mdm_ticks = tx_time;
+		association_data->last_tx_time_mdm_ticks = tx_time;
+		not_before = tx_time + (slot_count * DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS);
+	}
+	bool pending = !sys_dlist_is_empty(&association_data->ul_queue);
+
+	k_mutex_unlock(&client_data.ul_mutex);
+
+	if (!pending) {
+		return 0;
+	}
+	/* Scheduler list is limited: continue when the last scheduled TX is due */
+	uint64_t time_now = dect_app_modem_time_now();
+
+	if (tx_time > time_now) {
+		return MAX(1, (int32_t)MODEM_TICKS_TO_MS(tx_time - time_now));
+	}
+	return DECT_RADIO_FRAME_DURATION_MS;
+}
+
+static void dect_phy_mac_client_ul_tx_worker(struct k_work *work_item)
+{
+	int32_t next_round_ms = 0;
+
+	ARG_UNUSED(work_item);
+
+	for (int i = 0; i < DECT_PHY_MAC_MAX_NEIGBORS; i++) {
+		struct dect_phy_mac_client_association_data *association_data =
+			&client_data.associations[i];
+		int32_t ms;
+
+		if (association_data->state != DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_ASSOCIATED ||
+		    sys_dlist_is_empty(&association_data->ul_queue)) {
+			continue;
+		}
+		ms = dect_phy_mac_client_ul_queue_serve(association_data);
+		if (ms > 0 && (next_round_ms == 0 || ms < next_round_ms)) {
+			next_round_ms = ms;
+		}
+	}
+	if (next_round_ms) {
+		k_work_schedule_for_queue(&dect_phy_ctrl_work_q, &client_data.ul_tx_work,
+					  K_MSEC(next_round_ms));
+	}
+}
+
+static void dect_phy_mac_client_ul_status_print(
+	struct dect_phy_mac_client_association_data *association_data)
+{
+	struct dect_phy_mac_client_ul_stats *stats = &association_data->ul_stats;
+
+	if (stats->first_enqueue_time_ms == 0) {
+		return;
+	}
+	int64_t elapsed_ms =
+		stats->last_tx_scheduled_time_ms - stats->first_enqueue_time_ms;
+	uint32_t goodput_bps = 0;
+
+	if (elapsed_ms > 0) {
+		goodput_bps = (uint32_t)((stats->bytes_sent * 8 * 1000) / elapsed_ms);
+	}
+	desh_print("    UL: queued %d, sent %u SDUs / %llu bytes in %u PDUs, dropped %u, "
+		   "goodput %u bps",
+		   association_data->ul_queue_count, stats->sdus_sent,
+		   (unsigned long long)stats->bytes_sent, stats->pdus_sent, stats->sdus_dropped,
+		   goodput_bps);
+}
+
 bool dect_phy_mac_client_associated_by_target_short_rd_id(uint16_t target_short_rd_id)
 {
 	for (int i = 0; i < DECT_PHY_MAC_MAX_NEIGBORS; i++) {
@@ -1151,6 +1701,7 @@ void dect_phy_mac_client_status_print(void)
 		    DECT_PHY_MAC_CLIENT_ASSOCIATION_STATE_DISASSOCIATED) {
 			desh_print("  Association #%d: long RD ID %u",
 				i + 1, client_data.associations[i].target_long_rd_id);
+			dect_phy_mac_client_ul_status_print(&client_data.associations[i]);
 		}
 	}
 }
@@ -1158,6 +1709,8 @@ void dect_phy_mac_client_status_print(void)
 static int dect_phy_mac_client_init(void)
 {
 	k_work_init_delayable(&client_rach_tx_work_data.work, dect_phy_mac_client_rach_tx_worker);
+	k_work_init_delayable(&client_data.ul_tx_work, dect_phy_mac_client_ul_tx_worker);
+	k_mutex_init(&client_data.ul_mutex);
 	dect_phy_mac_client_association_data_init();
 
 	return 0;
@@ -12,6 +12,17 @@
 
 #define DECT_PHY_MAC_CLIENT_ASSOCIATION_RESP_WAIT_TIME_SEC (3)
 
+/* Keep Alive IE is sent to an associated FT only if nothing else has been sent for this long */
+#define DECT_PHY_MAC_CLIENT_KEEP_ALIVE_INTERVAL_SEC (10)
+
+/* Uplink queue per associated FT. Queued SDUs are aggregated into RACH PDUs up to
+ * the TBS of the FT's RA resource.
+ */
+#define DECT_PHY_MAC_CLIENT_UL_QUEUE_MAX_SDUS	   (16)
+#define DECT_PHY_MAC_CLIENT_UL_SDU_MAX_LEN	   (DECT_DATA_MAX_LEN - 16)
+#define DECT_PHY_MAC_CLIENT_UL_MAX_PDUS_PER_ROUND (4)
+#define DECT_PHY_MAC_CLIENT_RACH_OPP_CACHE_LEN	   (8)
+
 /******************************************************************************/
 
 int dect_phy_mac_client_rach_tx_start(
@@ -30,8 +41,18 @@ void dect_phy_mac_client_associate_resp_handle(
 	dect_phy_mac_common_header_t *common_header,
 	dect_phy_mac_association_resp_t *association_resp);
 
+void dect_phy_mac_client_association_rel_handle(
+	dect_phy_mac_common_header_t *common_header,
+	dect_phy_mac_association_rel_t *association_rel);
+
 void dect_phy_mac_client_status_print(void);
 
+/* Queue an SDU towards an associated FT. Returns -ENOTCONN if not associated,
+ * -ENOBUFS if the queue is full.
+ */
+int dect_phy_mac_client_ul_sdu_enqueue(uint32_t target_long_rd_id, const uint8_t *data,
+				       uint16_t data_len);
+
 /******************************************************************************/
 
 bool dect_phy_mac_client_associated_by_target_short_rd_id(uint16_t target_short_rd_id);
@@ -30,8 +30,12 @@
 #include "dect_phy_mac_pdu.h"
 #include "dect_phy_mac_ctrl.h"
 #include "dect_phy_mac_ft_assoc.h"
+#include "dect_phy_mac_ft_rach_rx.h"
+#include "dect_phy_mac_rach_opp.h"
 #include "dect_app_time.h"
 
+extern struct k_work_q dect_phy_ctrl_work_q;
+
 /*=============================Constant Fixed Scheduall  ===========================================*/
 #define HS_DECT_IE_EXT_TYPE_SCHED_ASSIGN  0xA1
 
@@ -62,6 +66,18 @@ static void hs_sdu_list_free_all(sys_dlist_t *list)
 	}
 }
 
+/* Cluster beacon is encoded once at start. Per interval changing fields are then patched in
+ * place in the scheduler owned TX buffer. Offsets are from the PDU start, 0: not included.
+ */
+struct dect_phy_mac_cluster_beacon_template {
+	uint8_t *sched_payload; /* Valid only in scheduler callbacks of the beacon TX item */
+	uint16_t sfn_offset;
+	uint16_t time_to_next_offset;
+	uint16_t next_channel_offset;
+	uint16_t ra_validity_offset;
+	uint16_t hs_sched_mode_offset;
+};
+
 static struct dect_phy_mac_cluster_beacon_data {
 	bool running;
 
@@ -70,11 +86,27 @@ static struct dect_phy_mac_cluster_beacon_data {
 	uint8_t encoded_cluster_beacon_pdu[DECT_DATA_MAX_LEN];
 	uint16_t encoded_cluster_beacon_pdu_len;
 
+	struct dect_phy_mac_cluster_beacon_template template;
+	uint32_t update_cycles_last;
+	uint32_t update_cycles_max;
+
 	dect_phy_mac_cluster_beacon_t last_cluster_beacon_msg;
-	dect_phy_mac_random_access_resource_ie_t last_rach_ie;
+	dect_phy_mac_random_access_resource_ie_t
+		last_rach_ies[DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT];
 	uint64_t last_tx_frame_time;
 
+	/* Defaults filled in */
 	struct dect_phy_mac_beacon_start_params start_params;
+	dect_phy_mac_cluster_beacon_period_t period;
+
+	uint64_t first_frame_time;
+	uint8_t slot_count;
+
+	/* LMS: frames before the beacon frame, -1: no LMS */
+	int8_t lms_beacon_frames_back;
+	int8_t lms_ra_frames_back;
+	uint32_t lms_interval_ms;
+	bool relocation_pending;
 } beacon_data;
 
 struct dect_phy_mac_cluster_beacon_lms_rssi_scan_data {
@@ -90,18 +122,212 @@ struct dect_phy_mac_cluster_beacon_lms_rssi_scan_data {
 } lms_rssi_scan_data;
 
 static void dect_phy_mac_cluster_beacon_scheduler_list_items_remove(void);
+static void dect_phy_mac_cluster_beacon_assoc_reset(void);
+static void dect_phy_mac_cluster_beacon_assoc_status_print(void);
+
+/**************************************************************************************************/
+
+/* RA frames of a resource within a beacon period: the beacon frame and then every 'repetition'
+ * frame as long as the allocation is valid.
+ */
+bool dect_phy_mac_cluster_beacon_ra_in_frame(const struct dect_phy_mac_beacon_ra_resource *ra,
+					     uint32_t frame_index)
+{
+	if (ra->repetition == 0) {
+		return frame_index == 0;
+	}
+	return frame_index < ra->validity && (frame_index % ra->repetition) == 0;
+}
+
+/* Fills in defaults and checks the beacon period and RA resources */
+static int dect_phy_mac_cluster_beacon_params_resolve(
+	struct dect_phy_mac_beacon_start_params *params,
+	dect_phy_mac_cluster_beacon_period_t *period_out)
+{
+	uint32_t frames_in_period;
+
+	if (params->period_ms == 0) {
+		params->period_ms = DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_DEFAULT_MS;
+	}
+	if (dect_phy_mac_pdu_cluster_beacon_period_from_ms(params->period_ms, period_out)) {
+		desh_error("(%s): Unsupported cluster beacon period %d ms", __func__,
+			   params->period_ms);
+		return -EINVAL;
+	}
+	frames_in_period = params->period_ms / DECT_RADIO_FRAME_DURATION_MS;
+
+	if (params->ra_resource_count == 0) {
+		struct dect_phy_mac_beacon_ra_resource *ra = &params->ra_resources[0];
+
+		ra->start_subslot = DECT_PHY_MAC_CLUSTER_BEACON_RA_START_SUBSLOT;
+		ra->length_slots = DECT_PHY_MAC_CLUSTER_BEACON_RA_LENGTH_SLOTS;
+		if (frames_in_period >= (2 * DECT_PHY_MAC_CLUSTER_BEACON_RA_REPETITION)) {
+			ra->repetition = DECT_PHY_MAC_CLUSTER_BEACON_RA_REPETITION;
+			ra->validity = MIN(frames_in_period / 2, UINT8_MAX);
+		} else {
+			ra->repetition = 0;
+			ra->validity = 0;
+		}
+		params->ra_resource_count = 1;
+	}
+	if (params->ra_resource_count > DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT) {
+		desh_error("(%s): Max %d RA resources", __func__,
+			   DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT);
+		return -EINVAL;
+	}
+
+	for (int i = 0; i < params->ra_resource_count; i++) {
+		struct dect_phy_mac_beacon_ra_resource *ra = &params->ra_resources[i];
+		int start_slot = ra->start_subslot / DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT;
+
+		if ((ra->start_subslot % DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT) ||
+		    ra->length_slots == 0 ||
+		    (start_slot + ra->length_slots) > DECT_RADIO_FRAME_SLOT_COUNT) {
+			desh_error("(%s): RA resource #%d: invalid start subslot %d / length %d",
+				   __func__, i, ra->start_subslot, ra->length_slots);
+			return -EINVAL;
+		}
+		if (ra->repetition != 0 &&
+		    (ra->validity == 0 || ra->validity > frames_in_period)) {
+			desh_error("(%s): RA resource #%d: validity %d not within 1-%d frames",
+				   __func__, i, ra->validity, frames_in_period);
+			return -EINVAL;
+		}
+		for (int j = 0; j < i; j++) {
+			struct dect_phy_mac_beacon_ra_resource *other = &params->ra_resources[j];
+			int other_start_slot =
+				other->start_subslot / DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT;
+
+			/* All resources have the beacon frame as a RA frame */
+			if (start_slot < (other_start_slot + other->length_slots) &&
+			    other_start_slot < (start_slot + ra->length_slots)) {
+				desh_error("(%s): RA resource #%d overlaps with #%d", __func__, i,
+					   j);
+				return -EINVAL;
+			}
+		}
+	}
+
+	if (params->hop_channel_count > DECT_PHY_MAC_BEACON_HOP_CHANNEL_MAX_COUNT) {
+		desh_error("(%s): Max %d hop channels", __func__,
+			   DECT_PHY_MAC_BEACON_HOP_CHANNEL_MAX_COUNT);
+		return -EINVAL;
+	}
+	if (params->hop_channel_count) {
+		if (params->hop_dwell == 0) {
+			params->hop_dwell = 1;
+		}
+		params->beacon_channel = params->hop_channels[0];
+	}
+	return 0;
+}
+
+/* Channel hopping: the cell is on hop_channels[(k / hop_dwell) % hop_channel_count] during
+ * the k:th beacon period from the first beacon. Beacon announces the channel of the next beacon
+ * and all scheduled cell operations update their channel for their next round by themselves.
+ */
+static bool dect_phy_mac_cluster_beacon_hopping(void)
+{
+	return beacon_data.start_params.hop_channel_count > 0;
+}
+
+static uint32_t dect_phy_mac_cluster_beacon_period_index_get(uint64_t time)
+{
+	uint64_t period_mdm_ticks = MS_TO_MODEM_TICKS((uint64_t)beacon_data.start_params.period_ms);
+
+	if (time < beacon_data.first_frame_time) {
+		return 0;
+	}
+	return (time - beacon_data.first_frame_time) / period_mdm_ticks;
+}
+
+static uint16_t dect_phy_mac_cluster_beacon_channel_get(uint32_t period_index)
+{
+	const struct dect_phy_mac_beacon_start_params *params = &beacon_data.start_params;
+
+	if (!dect_phy_mac_cluster_beacon_hopping()) {
+		return params->beacon_channel;
+	}
+	return params->hop_channels[(period_index / params->hop_dwell) %
+				    params->hop_channel_count];
+}
+
+uint16_t dect_phy_mac_cluster_beacon_channel_at_time_get(uint64_t time)
+{
+	return dect_phy_mac_cluster_beacon_channel_get(
+		dect_phy_mac_cluster_beacon_period_index_get(time));
+}
+
+/* Last Minute Scan (MAC spec ch. 5.1.2): own beacon TX subslots are measured 1 frame before
+ * the TX and announced RA subslots at least 0.5 frames before the announcing beacon. In addition,
+ * the result has to be handled before the beacon TX is given to the modem.
+ * Returns how many frames before the beacon frame the LMS of a region ending at end_subslot
+ * can be done, -1 if not possible. With avoid_ra_frames, frames with RACH RX are skipped.
+ */
+static int dect_phy_mac_cluster_beacon_lms_frames_back_get(
+	const struct dect_phy_mac_beacon_start_params *params, uint32_t end_subslot,
+	uint64_t min_margin_mdm_ticks, bool avoid_ra_frames)
+{
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	int frames_in_period = params->period_ms / DECT_RADIO_FRAME_DURATION_MS;
+	uint64_t margin_mdm_ticks =
+		dect_phy_ctrl_modem_latency_for_next_op_get(true) +
+		US_TO_MODEM_TICKS(current_settings->scheduler.scheduling_delay_us);
+	uint64_t needed_mdm_ticks =
+		(end_subslot * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS) +
+		MAX(margin_mdm_ticks, min_margin_mdm_ticks);
+	int frames_back = MAX(1, (int)DIV_ROUND_UP(needed_mdm_ticks,
+						   DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS));
+
+	for (; frames_back < frames_in_period && frames_back <= INT8_MAX; frames_back++) {
+		bool ra_frame = false;
+
+		for (int i = 0; avoid_ra_frames && i < params->ra_resource_count; i++) {
+			if (dect_phy_mac_cluster_beacon_ra_in_frame(
+				    &params->ra_resources[i], frames_in_period - frames_back)) {
+				ra_frame = true;
+				break;
+			}
+		}
+		if (!ra_frame) {
+			return frames_back;
+		}
+	}
+	return -1;
+}
+
+/**************************************************************************************************/
+
 
+/* Encodes a single SDU (and frees it). Start of its payload is given in payload_ptr_out. */
+static uint8_t *dect_phy_mac_cluster_beacon_sdu_encode(uint8_t *target_ptr,
+						       dect_phy_mac_sdu_t *sdu,
+						       uint8_t **payload_ptr_out)
+{
+	sys_dlist_t sdu_list;
+
+	sys_dlist_init(&sdu_list);
+	sys_dlist_append(&sdu_list, &sdu->dnode);
+
+	*payload_ptr_out = target_ptr + dect_phy_mac_pdu_mux_header_length_get(&sdu->mux_header);
+	return dect_phy_mac_pdu_sdus_encode(target_ptr, &sdu_list);
+}
 
 static int dect_phy_mac_cluster_beacon_encode(struct dect_phy_mac_beacon_start_params *params,
 					     uint8_t **target_ptr,
-					     union nrf_modem_dect_phy_hdr *out_phy_header)
+					     union nrf_modem_dect_phy_hdr *out_phy_header,
+					     struct dect_phy_mac_cluster_beacon_template *template_out)
 {
 	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
 
 	if (current_settings == NULL || params == NULL || target_ptr == NULL ||
-	    *target_ptr == NULL || out_phy_header == NULL) {
+	    *target_ptr == NULL || out_phy_header == NULL || template_out == NULL) {
 		return -EINVAL;
 	}
+	uint8_t *pdu_start_ptr = *target_ptr;
+	uint8_t *sdu_payload_ptr;
+
+	memset(template_out, 0, sizeof(*template_out));
 
 	/* ---------- PHY header (type1) ---------- */
 	uint8_t phy_tx_power = dect_common_utils_dbm_to_phy_tx_power(params->tx_power_dbm);
@@ -131,9 +357,19 @@ static int dect_phy_mac_cluster_beacon_encode(struct dect_phy_mac_beacon_start_p
 		.transmitter_id = current_settings->common.transmitter_id,
 	};
 
-	/* ---------- SDU list ---------- */
-	sys_dlist_t sdu_list;
-	sys_dlist_init(&sdu_list);
+	uint8_t *pdu_ptr = *target_ptr;
+
+	pdu_ptr = dect_phy_mac_pdu_type_header_encode(&type_header, pdu_ptr);
+	if (pdu_ptr == NULL) {
+		return -EINVAL;
+	}
+
+	pdu_ptr = dect_phy_mac_pdu_common_header_encode(&common_header, pdu_ptr);
+	if (pdu_ptr == NULL) {
+		return -EINVAL;
+	}
+
+	/* ---------- SDUs: encoded one by one to get offsets of the mutable fields ---------- */
 
 	/* Cluster Beacon SDU */
 	dect_phy_mac_sdu_t *cluster_beacon_sdu = k_calloc(1, sizeof(*cluster_beacon_sdu));
@@ -144,53 +380,96 @@ static int dect_phy_mac_cluster_beacon_encode(struct dect_phy_mac_beacon_start_p
 	cluster_beacon_sdu->mux_header.mac_ext = DECT_PHY_MAC_EXT_8BIT_LEN;
 	cluster_beacon_sdu->mux_header.ie_type = DECT_PHY_MAC_IE_TYPE_CLUSTER_BEACON;
 	cluster_beacon_sdu->mux_header.payload_length = 5;
+	if (params->hop_channel_count) {
+		/* Always included when hopping to keep the layout for patching */
+		cluster_beacon_sdu->mux_header.payload_length += 2;
+	}
 
 	cluster_beacon_sdu->message_type = DECT_PHY_MAC_MESSAGE_TYPE_CLUSTER_BEACON;
 	cluster_beacon_sdu->message.cluster_beacon.system_frame_number = beacon_data.next_sfn;
 	cluster_beacon_sdu->message.cluster_beacon.tx_pwr_bit = 1;
 	cluster_beacon_sdu->message.cluster_beacon.pwr_const_bit = 0;
 	cluster_beacon_sdu->message.cluster_beacon.frame_offset_bit = 0;
-	cluster_beacon_sdu->message.cluster_beacon.next_channel_bit = 0;
+	cluster_beacon_sdu->message.cluster_beacon.next_channel_bit =
+		(params->hop_channel_count) ? 1 : 0;
+	cluster_beacon_sdu->message.cluster_beacon.next_cluster_channel =
+		dect_phy_mac_cluster_beacon_channel_get(1);
 	cluster_beacon_sdu->message.cluster_beacon.time_to_next = 0;
 	cluster_beacon_sdu->message.cluster_beacon.nw_beacon_period = DECT_PHY_MAC_NW_BEACON_PERIOD_50MS;
-	cluster_beacon_sdu->message.cluster_beacon.cluster_beacon_period = DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_2000MS;
+	cluster_beacon_sdu->message.cluster_beacon.cluster_beacon_period = beacon_data.period;
 	cluster_beacon_sdu->message.cluster_beacon.count_to_trigger = 0;
 	cluster_beacon_sdu->message.cluster_beacon.relative_quality = 0;
 	cluster_beacon_sdu->message.cluster_beacon.min_quality = 0;
 	cluster_beacon_sdu->message.cluster_beacon.max_phy_tx_power =
 		dect_common_utils_dbm_to_phy_tx_power(19);
 
-	sys_dlist_append(&sdu_list, &cluster_beacon_sdu->dnode);
+	/* Save beacon content before the SDU is freed by encoding */
+	beacon_data.last_cluster_beacon_msg = cluster_beacon_sdu->message.cluster_beacon;
 
-	/* Random Access Resource IE SDU */
-	dect_phy_mac_sdu_t *ra_ie_sdu = k_calloc(1, sizeof(*ra_ie_sdu));
-	if (!ra_ie_sdu) {
-		hs_sdu_list_free_all(&sdu_list);
-		return -ENOMEM;
+	pdu_ptr = dect_phy_mac_cluster_beacon_sdu_encode(pdu_ptr, cluster_beacon_sdu,
+							 &sdu_payload_ptr);
+
+	/* SFN is the 1st byte of the payload and time_to_next the last 4, if included.
+	 * Next channel is just before time_to_next.
+	 */
+	template_out->sfn_offset = sdu_payload_ptr - pdu_start_ptr;
+	if (beacon_data.last_cluster_beacon_msg.time_to_next_next) {
+		template_out->time_to_next_offset = (pdu_ptr - 4) - pdu_start_ptr;
 	}
+	if (beacon_data.last_cluster_beacon_msg.next_channel_bit) {
+		template_out->next_channel_offset =
+			(pdu_ptr - 2 -
+			 (beacon_data.last_cluster_beacon_msg.time_to_next_next ? 4 : 0)) -
+			pdu_start_ptr;
+	}
+
+	/* Random Access Resource IE SDUs */
+	for (int i = 0; i < params->ra_resource_count; i++) {
+		struct dect_phy_mac_beacon_ra_resource *ra = &params->ra_resources[i];
+		dect_phy_mac_sdu_t *ra_ie_sdu = k_calloc(1, sizeof(*ra_ie_sdu));
+		dect_phy_mac_random_access_resource_ie_t *rach_ie;
+
+		if (!ra_ie_sdu) {
+			return -ENOMEM;
+		}
+		rach_ie = &ra_ie_sdu->message.rach_ie;
+
+		ra_ie_sdu->mux_header.mac_ext = DECT_PHY_MAC_EXT_8BIT_LEN;
+		ra_ie_sdu->mux_header.ie_type = DECT_PHY_MAC_IE_TYPE_RANDOM_ACCESS_RESOURCE_IE;
+		ra_ie_sdu->mux_header.payload_length = DECT_PHY_MAC_RANDOM_ACCESS_RES_IE_MIN_LEN;
+
+		ra_ie_sdu->message_type = DECT_PHY_MAC_MESSAGE_RANDOM_ACCESS_RESOURCE_IE;
+		rach_ie->channel_included = false;
+		rach_ie->channel2_included = false;
+		rach_ie->sfn_included = false;
+		rach_ie->length_type = DECT_PHY_HEADER_PKT_LENGTH_TYPE_SLOTS;
+		rach_ie->length = ra->length_slots;
+		rach_ie->start_subslot = ra->start_subslot;
+		rach_ie->max_rach_length_type = DECT_PHY_HEADER_PKT_LENGTH_TYPE_SLOTS;
+		rach_ie->max_rach_length = 4;
+		rach_ie->dect_delay = 1;
+		rach_ie->response_win = 10;
+		if (ra->repetition) {
+			rach_ie->repeat = DECT_PHY_MAC_RA_REPEAT_TYPE_FRAMES;
+			rach_ie->repetition = ra->repetition;
+			rach_ie->validity = ra->validity;
+			ra_ie_sdu->mux_header.payload_length += 2;
+		} else {
+			rach_ie->repeat = DECT_PHY_MAC_RA_REPEAT_TYPE_SINGLE;
+		}
+		rach_ie->cw_min_sig = 0;
+		rach_ie->cw_max_sig = 7;
+
+		beacon_data.last_rach_ies[i] = *rach_ie;
 
-	ra_ie_sdu->mux_header.mac_ext = DECT_PHY_MAC_EXT_8BIT_LEN;
-	ra_ie_sdu->mux_header.ie_type = DECT_PHY_MAC_IE_TYPE_RANDOM_ACCESS_RESOURCE_IE;
-	ra_ie_sdu->mux_header.payload_length = 7;
-
-	ra_ie_sdu->message_type = DECT_PHY_MAC_MESSAGE_RANDOM_ACCESS_RESOURCE_IE;
-	ra_ie_sdu->message.rach_ie.channel_included = false;
-	ra_ie_sdu->message.rach_ie.channel2_included = false;
-	ra_ie_sdu->message.rach_ie.sfn_included = false;
-	ra_ie_sdu->message.rach_ie.length_type = DECT_PHY_HEADER_PKT_LENGTH_TYPE_SLOTS;
-	ra_ie_sdu->message.rach_ie.length = DECT_PHY_MAC_CLUSTER_BEACON_RA_LENGTH_SLOTS;
-	ra_ie_sdu->message.rach_ie.start_subslot = DECT_PHY_MAC_CLUSTER_BEACON_RA_START_SUBSLOT;
-	ra_ie_sdu->message.rach_ie.max_rach_length_type = DECT_PHY_HEADER_PKT_LENGTH_TYPE_SLOTS;
-	ra_ie_sdu->message.rach_ie.max_rach_length = 4;
-	ra_ie_sdu->message.rach_ie.dect_delay = 1;
-	ra_ie_sdu->message.rach_ie.response_win = 10;
-	ra_ie_sdu->message.rach_ie.validity = DECT_PHY_MAC_CLUSTER_BEACON_RA_VALIDITY;
-	ra_ie_sdu->message.rach_ie.repeat = DECT_PHY_MAC_RA_REPEAT_TYPE_FRAMES;
-	ra_ie_sdu->message.rach_ie.repetition = DECT_PHY_MAC_CLUSTER_BEACON_RA_REPETITION;
-	ra_ie_sdu->message.rach_ie.cw_min_sig = 0;
-	ra_ie_sdu->message.rach_ie.cw_max_sig = 7;
-
-	sys_dlist_append(&sdu_list, &ra_ie_sdu->dnode);
+		pdu_ptr = dect_phy_mac_cluster_beacon_sdu_encode(pdu_ptr, ra_ie_sdu,
+								 &sdu_payload_ptr);
+
+		/* Validity follows repetition after the 5 fixed bytes, when repeated */
+		if (template_out->ra_validity_offset == 0 && ra->repetition) {
+			template_out->ra_validity_offset = (sdu_payload_ptr + 6) - pdu_start_ptr;
+		}
+	}
 
 	/* ================= HS_DECT: advertise scheduling mode ================= */
 	{
@@ -209,45 +488,24 @@ static int dect_phy_mac_cluster_beacon_encode(struct dect_phy_mac_beacon_start_p
 			mode_sdu->message.common_msg.data_length = sizeof(payload);
 			memcpy(mode_sdu->message.common_msg.data, payload, sizeof(payload));
 
-			sys_dlist_append(&sdu_list, &mode_sdu->dnode);
+			pdu_ptr = dect_phy_mac_cluster_beacon_sdu_encode(pdu_ptr, mode_sdu,
+									 &sdu_payload_ptr);
+			template_out->hs_sched_mode_offset = (sdu_payload_ptr + 1) - pdu_start_ptr;
 		}
 	}
 	/* ===================================================================== */
 
-	/* ---------- Encode MAC PDU ---------- */
-	uint8_t *pdu_ptr = *target_ptr;
-
-	pdu_ptr = dect_phy_mac_pdu_type_header_encode(&type_header, pdu_ptr);
-	if (pdu_ptr == NULL) {
-		hs_sdu_list_free_all(&sdu_list);
-		return -EINVAL;
-	}
-
-	pdu_ptr = dect_phy_mac_pdu_common_header_encode(&common_header, pdu_ptr);
-	if (pdu_ptr == NULL) {
-		hs_sdu_list_free_all(&sdu_list);
-		return -EINVAL;
-	}
-
-	pdu_ptr = dect_phy_mac_pdu_sdus_encode(pdu_ptr, &sdu_list);
-	if (pdu_ptr == NULL) {
-		hs_sdu_list_free_all(&sdu_list);
-		return -EINVAL;
-	}
-
 	/* ---------- Calculate lengths & padding (SAFE) ---------- */
 	uint16_t encoded_pdu_length = (uint16_t)(pdu_ptr - *target_ptr);
 
 	header.packet_length = dect_common_utils_phy_packet_length_calculate(
 		encoded_pdu_length, header.packet_length_type, header.df_mcs);
 	if ((int)header.packet_length <= 0) {
-		hs_sdu_list_free_all(&sdu_list);
 		return -EINVAL;
 	}
 
 	int16_t total_byte_count = dect_common_utils_slots_in_bytes(header.packet_length, header.df_mcs);
 	if (total_byte_count <= 0) {
-		hs_sdu_list_free_all(&sdu_list);
 		return -EINVAL;
 	}
 
@@ -255,11 +513,14 @@ static int dect_phy_mac_cluster_beacon_encode(struct dect_phy_mac_beacon_start_p
 	if (padding_need < 0) {
 		desh_error("(%s): Beacon PDU too long: enc=%u bytes, slots=%d -> max=%d bytes",
 			   __func__, encoded_pdu_length, header.packet_length, total_byte_count);
-		hs_sdu_list_free_all(&sdu_list);
 		return -EMSGSIZE;
 	}
 
 	if (padding_need > 0) {
+		sys_dlist_t sdu_list;
+
+		sys_dlist_init(&sdu_list);
+
 		int err = dect_phy_mac_pdu_sdu_list_add_padding(&pdu_ptr, &sdu_list, padding_need);
 		if (err) {
 			desh_warn("(%s): Failed to add padding: err %d (continue)", __func__, err);
@@ -274,19 +535,13 @@ static int dect_phy_mac_cluster_beacon_encode(struct dect_phy_mac_beacon_start_p
 	memcpy(&phy_header.type_1, &header, sizeof(phy_header.type_1));
 	memcpy(out_phy_header, &phy_header, sizeof(*out_phy_header));
 
-	/* Save last beacon content (for debug) */
-	beacon_data.last_cluster_beacon_msg = cluster_beacon_sdu->message.cluster_beacon;
-	beacon_data.last_rach_ie = ra_ie_sdu->message.rach_ie;
-
-	/* Free SDU nodes */
-	hs_sdu_list_free_all(&sdu_list);
-
 	return header.packet_length;
 }
 
 
 void dect_phy_mac_ctrl_lms_rssi_scan_data_init(int beacon_tx_slot_count)
 {
+	struct dect_phy_mac_beacon_start_params *params = &beacon_data.start_params;
 	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
 
 	memset(&lms_rssi_scan_data, 0, sizeof(lms_rssi_scan_data));
@@ -301,26 +556,186 @@ void dect_phy_mac_ctrl_lms_rssi_scan_data_init(int beacon_tx_slot_count)
 		lms_rssi_scan_data.cluster_beacon_reserved_symbols_in_frame[i] = true;
 	}
 
-	int beacon_ra_start_symbols = (DECT_PHY_MAC_CLUSTER_BEACON_RA_START_SUBSLOT *
-				       DECT_PHY_MAC_CLUSTER_BEACON_RA_LENGTH_SLOTS) - 1;
-	int beacon_ra_end_symbols =
-		beacon_ra_start_symbols +
-		(DECT_PHY_MAC_CLUSTER_BEACON_RA_LENGTH_SLOTS * DECT_RADIO_SLOT_SYMBOL_COUNT);
+	for (int ra_index = 0; ra_index < params->ra_resource_count; ra_index++) {
+		struct dect_phy_mac_beacon_ra_resource *ra = &params->ra_resources[ra_index];
+		int beacon_ra_start_symbols = ra->start_subslot * DECT_RADIO_SUBSLOT_SYMBOL_COUNT;
+		int beacon_ra_end_symbols =
+			beacon_ra_start_symbols + (ra->length_slots * DECT_RADIO_SLOT_SYMBOL_COUNT);
+
+		for (int i = beacon_ra_start_symbols;
+		     i < beacon_ra_end_symbols && i < DECT_RADIO_FRAME_SYMBOL_COUNT; i++) {
+			lms_rssi_scan_data.cluster_ra_reserved_symbols_in_frame[i] = true;
+		}
+	}
+}
+
+/* Symbol within a frame, frames being aligned with the beacon frames */
+static int dect_phy_mac_cluster_beacon_symbol_in_frame_get(uint64_t time)
+{
+	uint64_t frame_offset;
+
+	if (time >= beacon_data.first_frame_time) {
+		frame_offset = (time - beacon_data.first_frame_time) %
+			       DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS;
+	} else {
+		frame_offset = (DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS -
+				((beacon_data.first_frame_time - time) %
+				 DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS)) %
+			       DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS;
+	}
+	return frame_offset / NRF_MODEM_DECT_SYMBOL_DURATION;
+}
+
+/* From the latest LMS results. measured_out is false if some symbols are not measured. */
+static bool dect_phy_mac_cluster_beacon_lms_slots_busy(int start_slot, int length_slots,
+						       bool *measured_out)
+{
+	int start_symbol = start_slot * DECT_RADIO_SLOT_SYMBOL_COUNT;
+	int end_symbol = MIN(start_symbol + (length_slots * DECT_RADIO_SLOT_SYMBOL_COUNT),
+			     DECT_RADIO_FRAME_SYMBOL_COUNT);
+
+	*measured_out = true;
+	for (int i = start_symbol; i < end_symbol; i++) {
+		enum dect_phy_rssi_scan_data_result_verdict verdict =
+			lms_rssi_scan_data.scan_result_symbols_in_frame[i];
+
+		if (verdict == DECT_PHY_RSSI_SCAN_VERDICT_BUSY) {
+			return true;
+		} else if (verdict == DECT_PHY_RSSI_SCAN_VERDICT_UNKNOWN) {
+			*measured_out = false;
+		}
+	}
+	return false;
+}
+
+/* Another place within a frame for a busy RA resource, not overlapping with the beacon TX or with
+ * other RA resources. Slots measured as not busy by the LMS are preferred.
+ */
+static int dect_phy_mac_cluster_beacon_ra_relocation_start_subslot_get(
+	const struct dect_phy_mac_beacon_start_params *params, int ra_index)
+{
+	const struct dect_phy_mac_beacon_ra_resource *ra = &params->ra_resources[ra_index];
+	int unmeasured_start_slot = -1;
+
+	for (int start_slot = beacon_data.slot_count;
+	     (start_slot + ra->length_slots) <= DECT_RADIO_FRAME_SLOT_COUNT; start_slot++) {
+		bool overlapping = false;
+		bool measured;
+
+		for (int i = 0; i < params->ra_resource_count && !overlapping; i++) {
+			/* Including the busy one itself */
+			int other_start_slot = params->ra_resources[i].start_subslot /
+					       DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT;
+
+			overlapping = start_slot <
+					      (other_start_slot +
+					       params->ra_resources[i].length_slots) &&
+				      other_start_slot < (start_slot + ra->length_slots);
+		}
+		if (overlapping ||
+		    dect_phy_mac_cluster_beacon_lms_slots_busy(start_slot, ra->length_slots,
+							       &measured)) {
+			continue;
+		}
+		if (measured) {
+			return start_slot * DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT;
+		} else if (unmeasured_start_slot < 0) {
+			unmeasured_start_slot = start_slot;
+		}
+	}
+	return (unmeasured_start_slot < 0)
+		       ? -ENOENT
+		       : (unmeasured_start_slot * DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT);
+}
+
+static bool dect_phy_mac_cluster_beacon_channel_in_use(
+	const struct dect_phy_mac_beacon_start_params *params, uint16_t channel)
+{
+	if (channel == params->beacon_channel) {
+		return true;
+	}
+	for (int i = 0; i < params->hop_channel_count; i++) {
+		if (channel == params->hop_channels[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Next channel for the cell from the latest RSSI scan results: free ones first and none of
+ * the ones already used by the cell.
+ */
+static int dect_phy_mac_cluster_beacon_relocation_channel_get(
+	const struct dect_phy_mac_beacon_start_params *params)
+{
+	struct dect_phy_rssi_scan_channel_results results;
+
+	if (dect_phy_scan_rssi_channel_results_get(&results)) {
+		return -EBUSY;
+	}
+	for (int i = 0; i < results.free_channels_count; i++) {
+		if (!dect_phy_mac_cluster_beacon_channel_in_use(params,
+								results.free_channels[i])) {
+			return results.free_channels[i];
+		}
+	}
+	for (int i = 0; i < results.possible_channels_count; i++) {
+		if (!dect_phy_mac_cluster_beacon_channel_in_use(params,
+								results.possible_channels[i])) {
+			return results.possible_channels[i];
+		}
+	}
+	return -ENOENT;
+}
+
+/* Replaces the busy channel of the cell. When hopping, only the busy hop channel. */
+static int dect_phy_mac_cluster_beacon_relocation_channel_set(
+	struct dect_phy_mac_beacon_start_params *params, uint16_t busy_channel)
+{
+	int channel = dect_phy_mac_cluster_beacon_relocation_channel_get(params);
 
-	for (int i = beacon_ra_start_symbols;
-	     i < beacon_ra_end_symbols && i < DECT_RADIO_FRAME_SYMBOL_COUNT; i++) {
-		lms_rssi_scan_data.cluster_ra_reserved_symbols_in_frame[i] = true;
+	if (channel <= 0) {
+		return -ENOENT;
+	}
+	if (params->hop_channel_count == 0) {
+		params->beacon_channel = channel;
+		return 0;
 	}
+	for (int i = 0; i < params->hop_channel_count; i++) {
+		if (params->hop_channels[i] == busy_channel) {
+			params->hop_channels[i] = channel;
+			params->beacon_channel = params->hop_channels[0];
+			return 0;
+		}
+	}
+	return -ENOENT;
 }
 
 void dect_phy_mac_ctrl_cluster_beacon_phy_api_direct_rssi_cb(
 	const struct nrf_modem_dect_phy_rssi_event *p_meas_results)
 {
-	/* Handle Last Minute Scan results. This assumes that start time was frame start. */
+	struct dect_phy_mac_beacon_start_params relocated_params;
+	enum dect_phy_mac_ctrl_beacon_stop_cause cause;
 	bool busy_in_beacon_tx = false;
-	bool busy_in_rach = false;
+	int busy_ra_index = -1;
+	int first_symbol;
+	int last_symbol;
+	int ret;
+
+	if (!beacon_data.running || beacon_data.relocation_pending) {
+		return;
+	}
+
+	/* Handle Last Minute Scan results. LMS ops are at the same subslots as the measured
+	 * resources but in an earlier frame.
+	 */
+	first_symbol = dect_phy_mac_cluster_beacon_symbol_in_frame_get(
+		p_meas_results->meas_start_time);
+	last_symbol = MIN(first_symbol + p_meas_results->meas_len, DECT_RADIO_FRAME_SYMBOL_COUNT);
 
-	for (int i = 0; i < p_meas_results->meas_len && i < DECT_RADIO_FRAME_SYMBOL_COUNT; i++) {
+	for (int i = 0; i < p_meas_results->meas_len &&
+			(first_symbol + i) < DECT_RADIO_FRAME_SYMBOL_COUNT; i++) {
+		int symbol = first_symbol + i;
 		int8_t curr_meas = p_meas_results->meas[i];
 		enum dect_phy_rssi_scan_data_result_verdict current_verdict;
 
@@ -332,32 +747,99 @@ void dect_phy_mac_ctrl_cluster_beacon_phy_api_direct_rssi_cb(
 			} else {
 				current_verdict = DECT_PHY_RSSI_SCAN_VERDICT_POSSIBLE;
 			}
-			lms_rssi_scan_data.scan_result_symbols_in_frame[i] = current_verdict;
-
-			if (current_verdict == DECT_PHY_RSSI_SCAN_VERDICT_BUSY) {
-				if (lms_rssi_scan_data
-					.cluster_beacon_reserved_symbols_in_frame[i]) {
-					busy_in_beacon_tx = true;
-				} else if (lms_rssi_scan_data
-						.cluster_ra_reserved_symbols_in_frame[i]) {
-					busy_in_rach = true;
-				}
+			lms_rssi_scan_data.scan_result_symbols_in_frame[symbol] = current_verdict;
+
+			if (current_verdict == DECT_PHY_RSSI_SCAN_VERDICT_BUSY &&
+			    lms_rssi_scan_data.cluster_beacon_reserved_symbols_in_frame[symbol]) {
+				busy_in_beacon_tx = true;
 			}
 		}
 	}
 
-	/* As a consequence of the LMS, we are simply stopping beacon if detecting BUSY in
-	 * beacon TX or in RACH subslots.
+	for (int i = 0; !busy_in_beacon_tx && i < beacon_data.start_params.ra_resource_count;
+	     i++) {
+		struct dect_phy_mac_beacon_ra_resource *ra =
+			&beacon_data.start_params.ra_resources[i];
+		int ra_first_symbol = ra->start_subslot * DECT_RADIO_SUBSLOT_SYMBOL_COUNT;
+		bool measured;
+
+		/* Only from this measurement: when hopping, earlier ones were on other channels */
+		if (ra_first_symbol < first_symbol || ra_first_symbol >= last_symbol) {
+			continue;
+		}
+		if (dect_phy_mac_cluster_beacon_lms_slots_busy(
+			    ra->start_subslot / DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT,
+			    ra->length_slots, &measured)) {
+			busy_ra_index = i;
+			break;
+		}
+	}
+	if (!busy_in_beacon_tx && busy_ra_index < 0) {
+		return;
+	}
+
+	/* Instead of stopping, relocate: a busy RA resource to other subslots and if that is not
+	 * possible or the beacon TX is busy, the whole cell to another channel. When hopping, only
+	 * the measured hop channel is replaced.
+	 * Beacon is stopped only if neither is possible.
 	 */
+	relocated_params = beacon_data.start_params;
+	ret = -ENOENT;
 	if (busy_in_beacon_tx) {
 		/* Remove beacon tx ASAP */
 		dect_phy_api_scheduler_th_list_item_remove_dealloc_by_phy_op_handle(
 			DECT_PHY_MAC_BEACON_TX_HANDLE);
-		dect_phy_mac_ctrl_cluster_beacon_stop(
-			DECT_PHY_MAC_CTRL_BEACON_STOP_CAUSE_LMS_BEACON_TX);
-	} else  if (busy_in_rach) {
-		dect_phy_mac_ctrl_cluster_beacon_stop(
-			DECT_PHY_MAC_CTRL_BEACON_STOP_CAUSE_LMS_RACH);
+		cause = DECT_PHY_MAC_CTRL_BEACON_STOP_CAUSE_LMS_BEACON_TX;
+	} else {
+		cause = DECT_PHY_MAC_CTRL_BEACON_STOP_CAUSE_LMS_RACH;
+		ret = dect_phy_mac_cluster_beacon_ra_relocation_start_subslot_get(
+			&relocated_params, busy_ra_index);
+		if (ret >= 0) {
+			relocated_params.ra_resources[busy_ra_index].start_subslot = ret;
+		}
+	}
+	if (ret < 0) {
+		ret = dect_phy_mac_cluster_beacon_relocation_channel_set(&relocated_params,
+									 p_meas_results->carrier);
+		if (ret) {
+			dect_phy_mac_ctrl_cluster_beacon_stop(cause);
+			return;
+		}
+	}
+	beacon_data.relocation_pending = true;
+	dect_phy_mac_ctrl_cluster_beacon_relocate(&relocated_params, cause);
+}
+
+static void dect_phy_mac_cluster_beacon_update(uint64_t frame_time)
+{
+	struct dect_phy_mac_cluster_beacon_template *template = &beacon_data.template;
+	uint32_t start_cycles = k_cycle_get_32();
+
+	beacon_data.next_sfn++;
+	template->sched_payload[template->sfn_offset] = beacon_data.next_sfn;
+	beacon_data.encoded_cluster_beacon_pdu[template->sfn_offset] = beacon_data.next_sfn;
+
+	if (template->next_channel_offset) {
+		/* Next beacon to its channel and announcing the one after that */
+		uint32_t next_index = dect_phy_mac_cluster_beacon_period_index_get(frame_time) + 1;
+		uint16_t next_channel = dect_phy_mac_cluster_beacon_channel_get(next_index + 1);
+		uint8_t channel_hi = (next_channel >> 8) & DECT_COMMON_UTILS_BIT_MASK_5BIT;
+		uint8_t channel_lo = next_channel & 0xFF;
+
+		dect_phy_api_scheduler_list_item_channel_update_by_phy_op_handle_range(
+			DECT_PHY_MAC_BEACON_TX_HANDLE, DECT_PHY_MAC_BEACON_TX_HANDLE,
+			dect_phy_mac_cluster_beacon_channel_get(next_index));
+
+		template->sched_payload[template->next_channel_offset] = channel_hi;
+		template->sched_payload[template->next_channel_offset + 1] = channel_lo;
+		beacon_data.encoded_cluster_beacon_pdu[template->next_channel_offset] = channel_hi;
+		beacon_data.encoded_cluster_beacon_pdu[template->next_channel_offset + 1] =
+			channel_lo;
+	}
+
+	beacon_data.update_cycles_last = k_cycle_get_32() - start_cycles;
+	if (beacon_data.update_cycles_last > beacon_data.update_cycles_max) {
+		beacon_data.update_cycles_max = beacon_data.update_cycles_last;
 	}
 }
 
@@ -367,6 +849,33 @@ static void dect_phy_mac_cluster_beacon_to_mdm_cb(
 	if (params->status == NRF_MODEM_DECT_PHY_SUCCESS) {
 		beacon_data.last_tx_frame_time = frame_time;
 	}
+
+	/* In scheduler thread with the beacon item still in the list: patch SFN and next channel
+	 * for the next interval in place.
+	 */
+	if (beacon_data.running && beacon_data.template.sched_payload) {
+		dect_phy_mac_cluster_beacon_update(frame_time);
+	}
+}
+
+static void dect_phy_mac_cluster_beacon_lms_to_mdm_cb(
+	struct dect_phy_common_op_completed_params *params, uint64_t frame_time)
+{
+	int frames_back = (params->handle == DECT_PHY_MAC_BEACON_LMS_RSSI_SCAN_HANDLE)
+				  ? beacon_data.lms_beacon_frames_back
+				  : beacon_data.lms_ra_frames_back;
+	uint64_t next_beacon_frame_time =
+		frame_time + MS_TO_MODEM_TICKS((uint64_t)beacon_data.lms_interval_ms) +
+		(frames_back * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS);
+
+	if (!beacon_data.running || !dect_phy_mac_cluster_beacon_hopping()) {
+		return;
+	}
+
+	/* Measuring the channel of the beacon period it is done for */
+	dect_phy_api_scheduler_list_item_channel_update_by_phy_op_handle_range(
+		params->handle, params->handle,
+		dect_phy_mac_cluster_beacon_channel_at_time_get(next_beacon_frame_time));
 }
 
 uint64_t dect_phy_mac_cluster_beacon_last_tx_frame_time_get(void)
@@ -374,6 +883,65 @@ uint64_t dect_phy_mac_cluster_beacon_last_tx_frame_time_get(void)
 	return beacon_data.last_tx_frame_time;
 }
 
+uint32_t dect_phy_mac_cluster_beacon_period_ms_get(void)
+{
+	return beacon_data.running ? beacon_data.start_params.period_ms : 0;
+}
+
+static int dect_phy_mac_cluster_beacon_lms_item_add(uint32_t handle, uint64_t beacon_frame_time,
+						    int frames_back, uint8_t start_subslot,
+						    uint8_t length_subslots)
+{
+	struct dect_phy_mac_beacon_start_params *params = &beacon_data.start_params;
+	struct dect_phy_api_scheduler_list_item_config *rssi_list_item_conf;
+	struct dect_phy_api_scheduler_list_item *rssi_list_item =
+		dect_phy_api_scheduler_list_item_alloc_rssi_element(&rssi_list_item_conf);
+	uint64_t frame_time =
+		beacon_frame_time - (frames_back * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS);
+
+	if (!rssi_list_item) {
+		desh_error("(%s): dect_phy_api_scheduler_list_item_alloc_rssi_element failed: "
+			   "No memory for LMS", (__func__));
+		return -ENOMEM;
+	}
+	if (frame_time < (dect_app_modem_time_now() + (SECONDS_TO_MODEM_TICKS(1) / 2))) {
+		/* Before the 2nd beacon then */
+		frame_time += MS_TO_MODEM_TICKS((uint64_t)params->period_ms);
+	}
+	rssi_list_item->phy_op_handle = handle;
+
+	rssi_list_item_conf->channel = dect_phy_mac_cluster_beacon_channel_at_time_get(
+		frame_time + (frames_back * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS));
+	rssi_list_item_conf->cb_op_to_mdm = dect_phy_mac_cluster_beacon_lms_to_mdm_cb;
+	rssi_list_item_conf->frame_time = frame_time;
+	rssi_list_item_conf->subslot_used = true;
+	rssi_list_item_conf->start_subslot = start_subslot;
+	rssi_list_item_conf->length_subslots = length_subslots;
+
+	/* Let it run in intervals in a scheduler */
+	rssi_list_item_conf->interval_mdm_ticks =
+		MS_TO_MODEM_TICKS((uint64_t)beacon_data.lms_interval_ms);
+	rssi_list_item_conf->rssi.rssi_op_params.start_time =
+		frame_time + (start_subslot * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
+	rssi_list_item_conf->rssi.rssi_op_params.handle = rssi_list_item->phy_op_handle;
+	rssi_list_item_conf->rssi.rssi_op_params.carrier = rssi_list_item_conf->channel;
+	rssi_list_item_conf->rssi.rssi_op_params.duration = length_subslots;
+	rssi_list_item_conf->rssi.rssi_op_params.reporting_interval =
+		NRF_MODEM_DECT_PHY_RSSI_INTERVAL_24_SLOTS;
+
+	/* Add RSSI measurement operation to scheduler list */
+	if (!dect_phy_api_scheduler_list_item_add(rssi_list_item)) {
+		desh_error("(%s): dect_phy_api_scheduler_list_item_add failed for RSSI "
+			   "measurement (handle %d) -- continue",
+			   (__func__), handle);
+		dect_phy_api_scheduler_list_item_dealloc(rssi_list_item);
+		return -EBUSY;
+	}
+	return 0;
+}
+
+static void dect_phy_mac_cluster_beacon_scheduler_list_items_remove(void);
+
 int dect_phy_mac_cluster_beacon_tx_start(struct dect_phy_mac_beacon_start_params *params)
 {
 
@@ -382,24 +950,58 @@ int dect_phy_mac_cluster_beacon_tx_start(struct dect_phy_mac_beacon_start_params
 		return -EINVAL;
 	}
 	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
-	uint32_t interval_mdm_ticks = MS_TO_MODEM_TICKS(DECT_PHY_MAC_CLUSTER_BEACON_INTERVAL_MS);
+	struct dect_phy_mac_beacon_start_params resolved_params = *params;
+	dect_phy_mac_cluster_beacon_period_t period;
+	uint32_t interval_mdm_ticks;
 	uint8_t encoded_beacon_pdu[DECT_DATA_MAX_LEN];
 	union nrf_modem_dect_phy_hdr phy_header;
 	uint8_t slot_count = 0;
 	uint8_t *pdu_ptr = encoded_beacon_pdu;
 	int ret;
 
+	ret = dect_phy_mac_cluster_beacon_params_resolve(&resolved_params, &period);
+	if (ret) {
+		return ret;
+	}
+	params = &beacon_data.start_params;
+
 	memset(encoded_beacon_pdu, 0, DECT_DATA_MAX_LEN);
 	memset(&beacon_data, 0, sizeof(struct dect_phy_mac_cluster_beacon_data));
+	dect_phy_mac_cluster_beacon_assoc_reset();
+	beacon_data.start_params = resolved_params;
+	beacon_data.period = period;
+
+	interval_mdm_ticks = MS_TO_MODEM_TICKS((uint64_t)params->period_ms);
 
 	/* Encode cluster beacon */
-	ret = dect_phy_mac_cluster_beacon_encode(params, &pdu_ptr, &phy_header);
+	ret = dect_phy_mac_cluster_beacon_encode(params, &pdu_ptr, &phy_header,
+						 &beacon_data.template);
 	if (ret < 0) {
 		desh_error("(%s): Failed to encode beacon", __func__);
 		return ret;
 	}
 	slot_count = ret + 1;
-	beacon_data.start_params = *params;
+	beacon_data.slot_count = slot_count;
+
+	for (int i = 0; i < params->ra_resource_count; i++) {
+		if ((params->ra_resources[i].start_subslot /
+		     DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT) < slot_count) {
+			desh_error("(%s): RA resource #%d overlaps with beacon TX (%d slots)",
+				   __func__, i, slot_count);
+			return -EINVAL;
+		}
+	}
+
+	/* Validated and allocated before any scheduler list items are added for LMS */
+	struct dect_phy_api_scheduler_list_item_config *sched_list_item_conf;
+	struct dect_phy_api_scheduler_list_item *sched_list_item =
+		dect_phy_api_scheduler_list_item_alloc_tx_element(&sched_list_item_conf);
+
+	if (!sched_list_item) {
+		desh_error("(%s): dect_phy_api_scheduler_list_item_alloc_tx_element failed: No "
+			   "memory to TX a beacon", (__func__));
+		return -ENOMEM;
+	}
 
 	dect_phy_mac_ctrl_lms_rssi_scan_data_init(slot_count);
 
@@ -411,57 +1013,49 @@ int dect_phy_mac_cluster_beacon_tx_start(struct dect_phy_mac_beacon_start_params
 	first_possible_tx = time_now + (SECONDS_TO_MODEM_TICKS(1));
 	start_time = first_possible_tx;
 
-	/* Schedule Last Minute Scannings (LMS) before beacon TX and
-	 * announcing random access resources.
-	 * Due to scheduling delays and lack of stopping of a scheduled TX operation in phy api.
-	 * LMS is done 2 frames before beacon TX but all slots at that frame are covered where
-	 * we are TX/RA.
-	 * Note: this is not exactly compliant with the LMS in MAC spec (which requires
-	 * the scan to be 1 and/or 0.5 frames before resources being announced or own transmission).
+	/* Schedule Last Minute Scannings (LMS) for the beacon TX and for the announced random
+	 * access resources: short RSSI measurements over the same subslots in an earlier frame.
+	 * With short beacon periods, LMS is done in a multiple of beacon period to keep
+	 * the load bounded.
 	 */
-	struct dect_phy_api_scheduler_list_item_config *rssi_list_item_conf;
-	struct dect_phy_api_scheduler_list_item *rssi_list_item =
-		dect_phy_api_scheduler_list_item_alloc_rssi_element(&rssi_list_item_conf);
+	uint8_t ra_start_subslot = DECT_RADIO_FRAME_SUBSLOT_COUNT;
+	uint8_t ra_end_subslot = 0;
 
-	if (!rssi_list_item) {
-		desh_error("(%s): dect_phy_api_scheduler_list_item_alloc_tx_element failed: No "
-			   "memory to TX a beacon");
-		return -ENOMEM;
-	}
-	rssi_list_item->phy_op_handle = DECT_PHY_MAC_BEACON_LMS_RSSI_SCAN_HANDLE;
-
-	rssi_list_item_conf->channel = params->beacon_channel;
-	rssi_list_item_conf->frame_time =
-		start_time - (2 * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS);
-	rssi_list_item_conf->start_slot = 0;
-
-	/* Let it run in intervals in a scheduler */
-	rssi_list_item_conf->interval_mdm_ticks = interval_mdm_ticks;
-	rssi_list_item_conf->rssi.rssi_op_params.start_time = rssi_list_item_conf->frame_time;
-	rssi_list_item_conf->rssi.rssi_op_params.handle = rssi_list_item->phy_op_handle;
-	rssi_list_item_conf->rssi.rssi_op_params.carrier = rssi_list_item_conf->channel;
-	rssi_list_item_conf->rssi.rssi_op_params.duration = DECT_RADIO_FRAME_SUBSLOT_COUNT;
-	rssi_list_item_conf->rssi.rssi_op_params.reporting_interval =
-		NRF_MODEM_DECT_PHY_RSSI_INTERVAL_24_SLOTS;
+	for (int i = 0; i < params->ra_resource_count; i++) {
+		struct dect_phy_mac_beacon_ra_resource *ra = &params->ra_resources[i];
 
-	/* Add RSSI measurement operation to scheduler list */
-	if (!dect_phy_api_scheduler_list_item_add(rssi_list_item)) {
-		desh_error("(%s): dect_phy_api_scheduler_list_item_add failed for RSSI "
-			   "measurement -- continue",
-			(__func__));
-		dect_phy_api_scheduler_list_item_dealloc(rssi_list_item);
+		ra_start_subslot = MIN(ra_start_subslot, ra->start_subslot);
+		ra_end_subslot = MAX(ra_end_subslot,
+				     ra->start_subslot + (ra->length_slots *
+							  DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT));
+	}
+	beacon_data.first_frame_time = start_time;
+	beacon_data.lms_interval_ms =
+		params->period_ms *
+		DIV_ROUND_UP(DECT_PHY_MAC_CLUSTER_BEACON_LMS_INTERVAL_MIN_MS, params->period_ms);
+	beacon_data.lms_beacon_frames_back = dect_phy_mac_cluster_beacon_lms_frames_back_get(
+		params, slot_count * DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT, 0, false);
+	beacon_data.lms_ra_frames_back = dect_phy_mac_cluster_beacon_lms_frames_back_get(
+		params, ra_end_subslot, DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS / 2, true);
+
+	if (beacon_data.lms_beacon_frames_back > 0) {
+		dect_phy_mac_cluster_beacon_lms_item_add(
+			DECT_PHY_MAC_BEACON_LMS_RSSI_SCAN_HANDLE, start_time,
+			beacon_data.lms_beacon_frames_back, 0,
+			slot_count * DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT);
+	}
+	if (beacon_data.lms_ra_frames_back > 0) {
+		dect_phy_mac_cluster_beacon_lms_item_add(
+			DECT_PHY_MAC_BEACON_LMS_RA_RSSI_SCAN_HANDLE, start_time,
+			beacon_data.lms_ra_frames_back, ra_start_subslot,
+			ra_end_subslot - ra_start_subslot);
+	}
+	if (beacon_data.lms_beacon_frames_back < 0 || beacon_data.lms_ra_frames_back < 0) {
+		desh_warn("(%s): No frame for all LMS in a beacon period of %d ms",
+			  (__func__), params->period_ms);
 	}
 
-	struct dect_phy_api_scheduler_list_item_config *sched_list_item_conf;
-	struct dect_phy_api_scheduler_list_item *sched_list_item =
-		dect_phy_api_scheduler_list_item_alloc_tx_element(&sched_list_item_conf);
 	uint64_t beacon_frame_time = start_time;
-
-	if (!sched_list_item) {
-		desh_error("(%s): dect_phy_api_scheduler_list_item_alloc_tx_element failed: No "
-			   "memory to TX a beacon");
-		return -ENOMEM;
-	}
 	uint16_t encoded_pdu_length = pdu_ptr - encoded_beacon_pdu;
 
 	sched_list_item_conf->address_info.network_id = current_settings->common.network_id;
@@ -505,79 +1099,45 @@ int dect_phy_mac_cluster_beacon_tx_start(struct dect_phy_mac_beacon_start_params
 	if (!dect_phy_api_scheduler_list_item_add(sched_list_item)) {
 		desh_error("(%s): dect_phy_api_scheduler_list_item_add failed\n", (__func__));
 		dect_phy_api_scheduler_list_item_dealloc(sched_list_item);
+		dect_phy_mac_cluster_beacon_scheduler_list_items_remove();
 		return -EBUSY;
 	}
+	beacon_data.template.sched_payload = sched_list_item->sched_config.tx.encoded_payload_pdu;
 
-	/* Schedule RACH RXes. Note: no specific LMS for all of these, ie. not strictly
+	/* RACH RX. Note: no specific LMS for all of these, ie. not strictly
 	 * as mac spec intended. However, LBT shall be used and is used in desh when sending
 	 * to random access resource.
+	 * RX operations for the RA windows are given directly to modem, chained and armed ahead
+	 * in time by the RACH RX engine instead of scheduler list items per RA frame.
 	 */
-	uint32_t rach_handle = DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START;
-	uint64_t rach_frame_time = beacon_frame_time;
-
-	uint64_t last_valid_rach_rx_frame_time =
-		rach_frame_time + (DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS *
-				   DECT_PHY_MAC_CLUSTER_BEACON_RA_VALIDITY);
-
-	while (rach_frame_time <= last_valid_rach_rx_frame_time) {
-		struct dect_phy_api_scheduler_list_item_config *rach_list_item_conf;
-		struct dect_phy_api_scheduler_list_item *rach_list_item =
-			dect_phy_api_scheduler_list_item_alloc_rx_element(&rach_list_item_conf);
-
-		if (!rach_list_item) {
-			break;
-		}
-
-		rach_list_item_conf->cb_op_completed = NULL;
-
-		rach_list_item_conf->channel = params->beacon_channel;
-		rach_list_item_conf->frame_time = rach_frame_time;
-		rach_list_item_conf->interval_mdm_ticks = interval_mdm_ticks;
-
-		rach_list_item_conf->start_slot = (DECT_PHY_MAC_CLUSTER_BEACON_RA_START_SUBSLOT /
-						   DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT);
-		rach_list_item_conf->length_slots = DECT_PHY_MAC_CLUSTER_BEACON_RA_LENGTH_SLOTS;
-		rach_list_item_conf->length_subslots = 0;
-
-		rach_list_item_conf->rx.mode = NRF_MODEM_DECT_PHY_RX_MODE_CONTINUOUS;
-		rach_list_item_conf->rx.expected_rssi_level =
-			current_settings->rx.expected_rssi_level;
-		rach_list_item_conf->rx.duration =
-			0; /* length_slots used instead duration variable */
-		rach_list_item_conf->rx.network_id = current_settings->common.network_id;
-
-		/* Only receive the ones destinated to this beacon: */
-		rach_list_item_conf->rx.filter.is_short_network_id_used = true;
-		rach_list_item_conf->rx.filter.short_network_id =
-			(uint8_t)(current_settings->common.network_id & 0xFF);
-		rach_list_item_conf->rx.filter.receiver_identity =
-			current_settings->common.short_rd_id;
-
-		rach_list_item->priority = DECT_PRIORITY2_RX;
-		rach_list_item->phy_op_handle = rach_handle;
-
-		if (!dect_phy_api_scheduler_list_item_add(rach_list_item)) {
-			desh_error("(%s): dect_phy_api_scheduler_list_item_add for RACH failed",
-				   (__func__));
-			ret = -EBUSY;
-			dect_phy_api_scheduler_list_item_dealloc(rach_list_item);
-			break;
-		}
+	struct dect_phy_mac_ft_rach_rx_params rach_rx_params = {
+		.first_frame_time = beacon_frame_time,
+		.period_ms = params->period_ms,
+		.ra_resource_count = params->ra_resource_count,
+		.network_id = current_settings->common.network_id,
+		.receiver_identity = current_settings->common.short_rd_id,
+		.expected_rssi_level = current_settings->rx.expected_rssi_level,
+		.channel_get = dect_phy_mac_cluster_beacon_channel_at_time_get,
+	};
 
-		rach_frame_time = rach_frame_time + (DECT_PHY_MAC_CLUSTER_BEACON_RA_REPETITION *
-						     DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS);
-		rach_handle++;
-		if (rach_handle > DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_END) {
-			rach_handle = DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START;
-		}
+	memcpy(rach_rx_params.ra_resources, params->ra_resources,
+	       sizeof(rach_rx_params.ra_resources));
+	ret = dect_phy_mac_ft_rach_rx_start(&rach_rx_params);
+	if (ret) {
+		desh_error("(%s): cannot start RACH RX: %d", (__func__), ret);
 	}
 
 	beacon_data.running = true;
 
 	desh_print("Scheduled beacon TX: "
 		   "interval %dms, tx pwr %d dbm, channel %d, payload PDU byte count: %d",
-		   DECT_PHY_MAC_CLUSTER_BEACON_INTERVAL_MS, params->tx_power_dbm,
-		   params->beacon_channel, encoded_pdu_length);
+		   params->period_ms, params->tx_power_dbm, params->beacon_channel,
+		   encoded_pdu_length);
+	desh_print("  RA resources: %d", params->ra_resource_count);
+	if (params->hop_channel_count) {
+		desh_print("  Channel hopping: %d channels, dwell %d beacon periods",
+			   params->hop_channel_count, params->hop_dwell);
+	}
 
 	return 0;
 }
@@ -586,16 +1146,19 @@ static void dect_phy_mac_cluster_beacon_scheduler_list_items_remove(void)
 {
 	dect_phy_api_scheduler_list_item_remove_dealloc_by_phy_op_handle(
 		DECT_PHY_MAC_BEACON_LMS_RSSI_SCAN_HANDLE);
+	dect_phy_api_scheduler_list_item_remove_dealloc_by_phy_op_handle(
+		DECT_PHY_MAC_BEACON_LMS_RA_RSSI_SCAN_HANDLE);
 	dect_phy_api_scheduler_list_item_remove_dealloc_by_phy_op_handle(
 		DECT_PHY_MAC_BEACON_TX_HANDLE);
-	dect_phy_api_scheduler_list_item_remove_dealloc_by_phy_op_handle_range(
-		DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START, DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_END);
+	dect_phy_mac_ft_rach_rx_stop();
 }
 
 void dect_phy_mac_cluster_beacon_tx_stop(void)
 {
-	dect_phy_mac_cluster_beacon_scheduler_list_items_remove();
 	beacon_data.running = false;
+	dect_phy_mac_cluster_beacon_scheduler_list_items_remove();
+	dect_phy_mac_cluster_beacon_assoc_reset();
+	beacon_data.template.sched_payload = NULL;
 }
 
 bool dect_phy_mac_cluster_beacon_is_running(void)
@@ -603,37 +1166,166 @@ bool dect_phy_mac_cluster_beacon_is_running(void)
 	return beacon_data.running;
 }
 
-void dect_phy_mac_cluster_beacon_update(void)
+/**************************************************************************************************/
+
+/* Association requests are queued and responded in bursts from the ctrl work queue, at most
+ * one burst of DECT_PHY_MAC_CLUSTER_BEACON_ASSOC_BURST_MAX responses per frame. Each response
+ * goes to the earliest free DL subslots within the response window of its request.
+ * A repeated request from a PT that is still queued replaces the queued one.
+ */
+struct dect_phy_mac_cluster_beacon_assoc_req {
+	bool accept;
+	uint32_t pt_long_rd_id;
+	uint16_t pt_short_rd_id;
+	uint16_t seq_nbr;
+	uint16_t rx_channel;
+	int16_t rx_pwr_dbm;
+	uint8_t rx_mcs;
+	uint64_t req_start_time;
+	uint64_t req_end_time;
+};
+
+struct dect_phy_mac_cluster_beacon_assoc_metrics {
+	uint32_t req_count;
+	uint32_t coalesced_count;
+	uint32_t queue_full_count;
+	uint32_t expired_count; /* No free DL subslots within the response window */
+	uint32_t resp_count;
+	uint32_t reject_count;
+	uint32_t tx_failed_count;
+	uint32_t burst_count;
+	uint16_t burst_size_max;
+	uint16_t queue_depth_max;
+	uint64_t resp_delay_sum_mdm_ticks; /* From request start to response start */
+	uint64_t resp_delay_max_mdm_ticks;
+};
+
+static struct dect_phy_mac_cluster_beacon_assoc_data {
+	struct dect_phy_mac_cluster_beacon_assoc_req
+		queue[DECT_PHY_MAC_CLUSTER_BEACON_ASSOC_QUEUE_SIZE];
+	uint16_t queue_count;
+
+	/* End of the last scheduled response including the modem gap between operations */
+	uint64_t dl_next_free_time;
+
+	/* Responses rotate over the RA response TX handles */
+	uint16_t resp_handle_next;
+
+	struct dect_phy_mac_cluster_beacon_assoc_metrics metrics;
+
+	struct k_work_delayable burst_work;
+} assoc_data;
+
+K_MUTEX_DEFINE(assoc_mutex);
+
+/* Announced DECT delay 1: response window opens 0.5 frames from the start of the request.
+ * PT listens from 3 subslots after its request for 2 frames (dect_phy_mac_client.c).
+ */
+static uint64_t dect_phy_mac_cluster_beacon_assoc_resp_earliest_get(
+	const struct dect_phy_mac_cluster_beacon_assoc_req *req)
 {
-	uint8_t *pdu_ptr = beacon_data.encoded_cluster_beacon_pdu;
-	union nrf_modem_dect_phy_hdr phy_header;
+	return MAX(req->req_start_time + (DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS / 2),
+		   req->req_end_time + (3 * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS));
+}
 
-	if (!beacon_data.running) {
-		return;
-	}
+static uint64_t dect_phy_mac_cluster_beacon_assoc_resp_deadline_get(
+	const struct dect_phy_mac_cluster_beacon_assoc_req *req)
+{
+	return req->req_end_time + (3 * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS) +
+	       (2 * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS);
+}
 
-	beacon_data.next_sfn++;
+static bool dect_phy_mac_cluster_beacon_dl_overlaps(uint64_t start, uint64_t end,
+						    uint64_t busy_start, uint64_t busy_end,
+						    uint64_t gap)
+{
+	return start < (busy_end + gap) && busy_start < (end + gap);
+}
 
-	/* Re-encode cluster beacon */
-	int ret = dect_phy_mac_cluster_beacon_encode(&beacon_data.start_params, &pdu_ptr,
-						     &phy_header);
-	if (ret < 0) {
-		desh_error("(%s): Failed to re-encode beacon", __func__);
-		return;
+/* End (+gap) of the first own beacon TX, RA window or their LMS overlapping with [start, end),
+ * 0 if none. LMS frames are taken as busy in every beacon period.
+ */
+static uint64_t dect_phy_mac_cluster_beacon_dl_busy_until(uint64_t start, uint64_t end,
+							  uint64_t gap)
+{
+	const struct dect_phy_mac_beacon_start_params *params = &beacon_data.start_params;
+	const uint64_t frame_len = DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS;
+	const uint64_t slot_len = DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS;
+	const uint64_t subslot_len = DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS;
+	uint32_t frames_in_period = params->period_ms / DECT_RADIO_FRAME_DURATION_MS;
+	uint32_t lms_beacon_frame_index = frames_in_period - beacon_data.lms_beacon_frames_back;
+	uint32_t lms_ra_frame_index = frames_in_period - beacon_data.lms_ra_frames_back;
+	uint64_t frame_number = (start - beacon_data.first_frame_time) / frame_len;
+
+	/* Responses are shorter than a frame: only this and the next frame are to be checked */
+	for (uint64_t f = frame_number; f <= (frame_number + 1); f++) {
+		uint64_t frame_start = beacon_data.first_frame_time + (f * frame_len);
+		uint32_t frame_index = f % frames_in_period;
+		bool lms_ra_frame =
+			beacon_data.lms_ra_frames_back > 0 && frame_index == lms_ra_frame_index;
+		uint64_t busy_start, busy_end;
+
+		if (frame_index == 0 || (beacon_data.lms_beacon_frames_back > 0 &&
+					 frame_index == lms_beacon_frame_index)) {
+			busy_start = frame_start;
+			busy_end = frame_start + (beacon_data.slot_count * slot_len);
+			if (dect_phy_mac_cluster_beacon_dl_overlaps(start, end, busy_start,
+								    busy_end, gap)) {
+				return busy_end + gap;
+			}
+		}
+		for (int i = 0; i < params->ra_resource_count; i++) {
+			const struct dect_phy_mac_beacon_ra_resource *ra = &params->ra_resources[i];
+
+			if (!lms_ra_frame &&
+			    !dect_phy_mac_cluster_beacon_ra_in_frame(ra, frame_index)) {
+				continue;
+			}
+			busy_start = frame_start + (ra->start_subslot * subslot_len);
+			busy_end = busy_start + (ra->length_slots * slot_len);
+			if (dect_phy_mac_cluster_beacon_dl_overlaps(start, end, busy_start,
+								    busy_end, gap)) {
+				return busy_end + gap;
+			}
+		}
 	}
+	return 0;
+}
 
-	uint16_t encoded_pdu_length = pdu_ptr - beacon_data.encoded_cluster_beacon_pdu;
+/* Earliest subslot aligned start at or after 'earliest' for a DL TX of 'length' ending by
+ * 'deadline'. Returns 0 if none.
+ */
+static uint64_t dect_phy_mac_cluster_beacon_dl_subslots_alloc(uint64_t earliest, uint64_t length,
+							      uint64_t deadline)
+{
+	uint64_t gap = dect_phy_ctrl_modem_latency_min_margin_between_ops_get();
+	uint64_t start = MAX(MAX(earliest, assoc_data.dl_next_free_time),
+			     beacon_data.first_frame_time);
+	uint64_t busy_until;
 
-	beacon_data.encoded_cluster_beacon_pdu_len = encoded_pdu_length;
-	dect_phy_api_scheduler_list_item_pdu_payload_update_by_phy_handle(
-		DECT_PHY_MAC_BEACON_TX_HANDLE, beacon_data.encoded_cluster_beacon_pdu,
-		beacon_data.encoded_cluster_beacon_pdu_len);
+	while (true) {
+		uint64_t offset = (start - beacon_data.first_frame_time) %
+				  DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS;
+
+		if (offset) {
+			start += DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS - offset;
+		}
+		if ((start + length) > deadline) {
+			return 0;
+		}
+		busy_until = dect_phy_mac_cluster_beacon_dl_busy_until(start, start + length, gap);
+		if (!busy_until) {
+			break;
+		}
+		start = busy_until;
+	}
+	assoc_data.dl_next_free_time = start + length + gap;
+	return start;
 }
 
 static int dect_phy_mac_cluster_beacon_association_resp_pdu_encode(
-	struct dect_phy_commmon_op_pdc_rcv_params *rcv_params,
-	dect_phy_mac_common_header_t *common_header,
-	dect_phy_mac_association_req_t *association_req, uint8_t **target_ptr, /* In/Out */
+	const struct dect_phy_mac_cluster_beacon_assoc_req *req,
+	uint8_t **target_ptr, /* In/Out */
 	union nrf_modem_dect_phy_hdr *out_phy_header)
 {
 	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
@@ -644,12 +1336,10 @@ static int dect_phy_mac_cluster_beacon_association_resp_pdu_encode(
 		.short_network_id = (uint8_t)(current_settings->common.network_id & 0xFF),
 		.transmitter_identity_hi = (uint8_t)(current_settings->common.short_rd_id >> 8),
 		.transmitter_identity_lo = (uint8_t)(current_settings->common.short_rd_id & 0xFF),
-		.df_mcs = rcv_params->rx_mcs,
-		.transmit_power = dect_common_utils_dbm_to_phy_tx_power(rcv_params->rx_pwr_dbm),
-		.receiver_identity_hi =
-			(uint8_t)(rcv_params->last_received_pcc_transmitter_short_rd_id >> 8),
-		.receiver_identity_lo =
-			(uint8_t)(rcv_params->last_received_pcc_transmitter_short_rd_id & 0xFF),
+		.df_mcs = req->rx_mcs,
+		.transmit_power = dect_common_utils_dbm_to_phy_tx_power(req->rx_pwr_dbm),
+		.receiver_identity_hi = (uint8_t)(req->pt_short_rd_id >> 8),
+		.receiver_identity_lo = (uint8_t)(req->pt_short_rd_id & 0xFF),
 		.feedback.format1.format = 0,
 	};
 	dect_phy_mac_type_header_t type_header_resp = {
@@ -660,107 +1350,101 @@ static int dect_phy_mac_cluster_beacon_association_resp_pdu_encode(
 	dect_phy_mac_common_header_t common_header_resp = {
 		.type = DECT_PHY_MAC_HEADER_TYPE_UNICAST,
 		.reset = 1,
-		.seq_nbr = common_header->seq_nbr,
-		.nw_id = current_settings->common.network_id,
+		.seq_nbr = req->seq_nbr,
+		.nw_id = ((current_settings->common.network_id >> 8) &
+			  DECT_COMMON_UTILS_BIT_MASK_24BIT), /* 24bit MSB */
 		.transmitter_id = current_settings->common.transmitter_id,
-		.receiver_id = common_header->transmitter_id,
+		.receiver_id = req->pt_long_rd_id,
 	};
+	dect_phy_mac_sdu_t *resp_sdu;
 	uint8_t *pdu_ptr = *target_ptr;
+	sys_dlist_t sdu_list;
+	sys_dlist_t padding_list;
 
 	pdu_ptr = dect_phy_mac_pdu_type_header_encode(&type_header_resp, pdu_ptr);
 	pdu_ptr = dect_phy_mac_pdu_common_header_encode(&common_header_resp, pdu_ptr);
 
-	sys_dlist_t sdu_list;
-	dect_phy_mac_sdu_t *data_sdu_list_item =
-		(dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
-	if (data_sdu_list_item == NULL) {
+	sys_dlist_init(&sdu_list);
+
+	/* Association response: we are dummy beacon and accepting everything, unless rejected
+	 * due to a scheduling mode mismatch. Rejection has ack_bit 0.
+	 * SDUs are freed by dect_phy_mac_pdu_sdus_encode().
+	 */
+	resp_sdu = (dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
+	if (resp_sdu == NULL) {
 		return -ENOMEM;
 	}
-	uint16_t payload_data_len = DECT_PHY_MAC_ASSOCIATION_RESP_MIN_LEN;
-	dect_phy_mac_mux_header_t mux_header1 = {
-		.mac_ext = DECT_PHY_MAC_EXT_8BIT_LEN,
-		.ie_type = DECT_PHY_MAC_IE_TYPE_ASSOCIATION_RESP,
-		.payload_length = payload_data_len,
-	};
-
-	/* Encode association response: we are dummy beacon and accepting everything  */
-	dect_phy_mac_association_resp_t association_resp = {
-		.ack_bit = 1,
-		.group_bit = 0,
-		.harq_conf_bit = 0, /* HARQ config accepted as in a request */
-		.flow_count = 7,    /* 0b111: all flows accepted as in request */
-	};
-
-	data_sdu_list_item->mux_header = mux_header1;
-	data_sdu_list_item->message_type = DECT_PHY_MAC_MESSAGE_TYPE_ASSOCIATION_RESP;
-	data_sdu_list_item->message.association_resp = association_resp;
+	resp_sdu->mux_header.mac_ext = DECT_PHY_MAC_EXT_8BIT_LEN;
+	resp_sdu->mux_header.ie_type = DECT_PHY_MAC_IE_TYPE_ASSOCIATION_RESP;
+	resp_sdu->mux_header.payload_length = DECT_PHY_MAC_ASSOCIATION_RESP_MIN_LEN;
+	resp_sdu->message_type = DECT_PHY_MAC_MESSAGE_TYPE_ASSOCIATION_RESP;
+	resp_sdu->message.association_resp.ack_bit = req->accept;
+	resp_sdu->message.association_resp.group_bit = 0;
+	resp_sdu->message.association_resp.harq_conf_bit = 0; /* HARQ config as in a request */
+	/* 0b111: all flows accepted as in request */
+	resp_sdu->message.association_resp.flow_count = req->accept ? 7 : 0;
+	sys_dlist_append(&sdu_list, &resp_sdu->dnode);
 
-	sys_dlist_init(&sdu_list);
-	sys_dlist_append(&sdu_list, &data_sdu_list_item->dnode);
-		/* HS_DECT: In fixed scheduling mode, add an EXTENSION IE telling PT its assigned index
-	 * and (optionally) the slot map.
-		*/
-		if (current_settings->mac_sched.mode == DECT_MAC_SCHED_FIXED) {
-
-			/* Assign PT index at FT based on PT long rd id */
-			int pt_idx = dect_phy_mac_ft_assoc_add_or_update(
-				common_header->transmitter_id, /* PT long rd id */
-				(uint16_t)rcv_params->last_received_pcc_transmitter_short_rd_id,
-				(int8_t)rcv_params->rx_pwr_dbm,
-				rcv_params->time);
-
-			if (pt_idx < 0) {
-				/* FT full: you can also choose to reject association here.
-				* For now, still respond ACK but without assignment IE.
-				*/
-				desh_warn("FT assoc table full, cannot assign PT index (err %d)", pt_idx);
-			} else {
-				/* Build Extension IE payload */
-				uint8_t payload[32];
-				uint8_t *w = payload;
-
-				*w++ = HS_DECT_IE_VER;   /* IE version */
-				*w++ = 1;              /* mode: 1=fixed, 0=random */
-				*w++ = (uint8_t)pt_idx; /* assigned PT index (1..max_pts) */
-				*w++ = (uint8_t)current_settings->mac_sched.max_pts;
-				*w++ = (uint8_t)current_settings->mac_sched.superframe_len; /* interpret as slots/frame */
-
-				/* slot map (PT1..PTmax): start/end */
-				for (int i = 0; i < current_settings->mac_sched.max_pts; i++) {
-					*w++ = (uint8_t)current_settings->mac_sched.pt_slots[i].start_subslot;
-					*w++ = (uint8_t)current_settings->mac_sched.pt_slots[i].end_subslot;
-				}
-
-				uint16_t ext_len = (uint16_t)(w - payload);
-
-				dect_phy_mac_sdu_t *ext_sdu =
-					(dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
-				if (ext_sdu != NULL) {
-					ext_sdu->mux_header.mac_ext = DECT_PHY_MAC_EXT_16BIT_LEN;
-					ext_sdu->mux_header.ie_type = DECT_PHY_MAC_IE_TYPE_EXTENSION;
-					ext_sdu->mux_header.ie_ext = HS_DECT_IE_EXT_TYPE_SCHED_ASSIGN;
-					ext_sdu->mux_header.payload_length = ext_len;
-
-					ext_sdu->message_type = DECT_PHY_MAC_MESSAGE_ESCAPE;
-					ext_sdu->message.common_msg.data_length = ext_len;
-					memcpy(ext_sdu->message.common_msg.data, payload, ext_len);
-
-					sys_dlist_append(&sdu_list, &ext_sdu->dnode);
-				}
+	/* HS_DECT: In fixed scheduling mode, add an EXTENSION IE telling PT its assigned index
+	 * and the slot map.
+	 */
+	if (req->accept && current_settings->mac_sched.mode == DECT_MAC_SCHED_FIXED) {
+		/* Assign PT index at FT based on PT long rd id */
+		int pt_idx = dect_phy_mac_ft_assoc_add_or_update(
+			req->pt_long_rd_id, req->pt_short_rd_id, (int8_t)req->rx_pwr_dbm,
+			req->req_start_time);
+
+		if (pt_idx < 0) {
+			/* FT full: still respond ACK but without assignment IE */
+			desh_warn("FT assoc table full, cannot assign PT index (err %d)", pt_idx);
+		} else {
+			struct dect_mac_sched_settings *sched = &current_settings->mac_sched;
+			dect_phy_mac_sdu_t *ext_sdu =
+				(dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
+			uint8_t *w;
+			uint16_t ext_len;
+
+			if (ext_sdu == NULL) {
+				hs_sdu_list_free_all(&sdu_list);
+				return -ENOMEM;
+			}
+			w = ext_sdu->message.common_msg.data;
+			*w++ = HS_DECT_IE_VER;	/* IE version */
+			*w++ = 1;		/* mode: 1=fixed, 0=random */
+			*w++ = (uint8_t)pt_idx; /* assigned PT index (1..max_pts) */
+			*w++ = (uint8_t)sched->max_pts;
+			*w++ = (uint8_t)sched->superframe_len; /* interpret as slots/frame */
+
+			/* slot map (PT1..PTmax): start/end */
+			for (int i = 0; i < sched->max_pts; i++) {
+				*w++ = (uint8_t)sched->pt_slots[i].start_subslot;
+				*w++ = (uint8_t)sched->pt_slots[i].end_subslot;
 			}
+			ext_len = (uint16_t)(w - ext_sdu->message.common_msg.data);
+
+			ext_sdu->mux_header.mac_ext = DECT_PHY_MAC_EXT_16BIT_LEN;
+			ext_sdu->mux_header.ie_type = DECT_PHY_MAC_IE_TYPE_EXTENSION;
+			ext_sdu->mux_header.ie_ext = HS_DECT_IE_EXT_TYPE_SCHED_ASSIGN;
+			ext_sdu->mux_header.payload_length = ext_len;
+			ext_sdu->message_type = DECT_PHY_MAC_MESSAGE_ESCAPE;
+			ext_sdu->message.common_msg.data_length = ext_len;
+			sys_dlist_append(&sdu_list, &ext_sdu->dnode);
 		}
+	}
 
 	pdu_ptr = dect_phy_mac_pdu_sdus_encode(pdu_ptr, &sdu_list);
 
 	/* Length so far  */
 	uint16_t encoded_pdu_length = pdu_ptr - *target_ptr;
 
-	header.packet_length = dect_common_utils_phy_packet_length_calculate(
+	int packet_length = dect_common_utils_phy_packet_length_calculate(
 		encoded_pdu_length, header.packet_length_type, header.df_mcs);
-	if (header.packet_length < 0) {
+
+	if (packet_length < 0) {
 		printk("(%s): Phy pkt len calculation failed\n", (__func__));
 		return -EINVAL;
 	}
+	header.packet_length = packet_length;
 	int16_t total_byte_count =
 		dect_common_utils_slots_in_bytes(header.packet_length, header.df_mcs);
 
@@ -768,91 +1452,285 @@ static int dect_phy_mac_cluster_beacon_association_resp_pdu_encode(
 		printk("Unsupported slot/mcs combination\n");
 		return -EINVAL;
 	}
-	/* Fill padding if needed */
+
+	/* Fill padding if needed: padding SDU alone is encoded after the ones above */
 	int16_t padding_need = total_byte_count - encoded_pdu_length;
-	int err = dect_phy_mac_pdu_sdu_list_add_padding(&pdu_ptr, &sdu_list, padding_need);
+	int err;
 
+	sys_dlist_init(&padding_list);
+	err = dect_phy_mac_pdu_sdu_list_add_padding(&pdu_ptr, &padding_list, padding_need);
 	if (err) {
 		desh_warn("(%s): Failed to add padding: err %d (continue)", __func__, err);
 	}
+	hs_sdu_list_free_all(&padding_list);
 
 	*target_ptr = pdu_ptr;
 
-	union nrf_modem_dect_phy_hdr phy_header;
-
-	memcpy(out_phy_header, &header, sizeof(phy_header.type_2));
-	hs_sdu_list_free_all(&sdu_list);
+	memcpy(out_phy_header, &header, sizeof(out_phy_header->type_2));
 	return header.packet_length;
 }
 
-void dect_phy_mac_cluster_beacon_association_req_handle(
-	struct dect_phy_commmon_op_pdc_rcv_params *rcv_params,
-	dect_phy_mac_common_header_t *common_header,
-	dect_phy_mac_association_req_t *association_req)
+/* Encoded and given to modem without assoc_mutex: taken only for the DL allocation and the
+ * metrics.
+ */
+static int dect_phy_mac_cluster_beacon_assoc_resp_send(
+	const struct dect_phy_mac_cluster_beacon_assoc_req *req, uint64_t first_possible_tx,
+	uint32_t handle)
 {
-	if (!beacon_data.running) {
-		printk("Beacon not running and received Association Req from %u (0x%04x)\n",
-		       common_header->transmitter_id, common_header->transmitter_id);
-		return;
-	}
-
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	struct dect_phy_mac_cluster_beacon_assoc_metrics *metrics = &assoc_data.metrics;
+	struct nrf_modem_dect_phy_tx_params tx_op; /* We need to bypass scheduler */
 	union nrf_modem_dect_phy_hdr phy_header;
+	uint8_t encoded[DECT_DATA_MAX_LEN];
+	uint8_t *pdu_ptr = encoded;
+	uint64_t resp_start_time;
+	uint64_t resp_delay;
 	int ret;
-	uint8_t slot_count = 0;
-	uint8_t encoded_data_to_send2[DECT_DATA_MAX_LEN];
-	uint8_t *pdu_ptr = encoded_data_to_send2;
-
-	memset(encoded_data_to_send2, 0, DECT_DATA_MAX_LEN);
 
-	/* Encode response PDU to be sent */
-	ret = dect_phy_mac_cluster_beacon_association_resp_pdu_encode(
-		rcv_params, common_header, association_req, &pdu_ptr, &phy_header);
+	memset(encoded, 0, sizeof(encoded));
+	ret = dect_phy_mac_cluster_beacon_association_resp_pdu_encode(req, &pdu_ptr, &phy_header);
 	if (ret < 0) {
-		return;
+		k_mutex_lock(&assoc_mutex, K_FOREVER);
+		metrics->tx_failed_count++;
+		k_mutex_unlock(&assoc_mutex);
+		return ret;
 	}
-	slot_count = ret + 1;
-	uint16_t encoded_pdu_length = pdu_ptr - encoded_data_to_send2;
-
-	/* Schedule association response*/
-	uint64_t req_received = rcv_params->time;
-	uint64_t req_len = (rcv_params->last_received_pcc_phy_len_type ==
-			    DECT_PHY_HEADER_PKT_LENGTH_TYPE_SLOTS)
-				   ? (rcv_params->last_received_pcc_phy_len *
-				      DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS)
-				   : (rcv_params->last_received_pcc_phy_len *
-				      DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
 
-	/* Note: we are not sending response right after 0.5 frames as in DECT-2020
-	 * when dect_delay set. We are adding request len more time for scheduling. That
-	 * is in specs as MAC spec says: "When RD transmits Random Access resources withs
-	 * Physical Layer Control Field: Type 2, Header Format: 001 and expects MAC PDU as
-	 * a response, the RD should consider the response window as a length of one frame.
+	/* Note: not necessarily right after 0.5 frames from the request as in DECT-2020.
+	 * MAC spec says: "When RD transmits Random Access resources withs Physical Layer Control
+	 * Field: Type 2, Header Format: 001 and expects MAC PDU as a response, the RD should
+	 * consider the response window as a length of one frame.
 	 */
-	uint64_t resp_start_time =
-		req_received + req_len + (DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS / 2);
-
-	struct nrf_modem_dect_phy_tx_params tx_op; /* We need toi bypass scheduler */
-	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	k_mutex_lock(&assoc_mutex, K_FOREVER);
+	resp_start_time = dect_phy_mac_cluster_beacon_dl_subslots_alloc(
+		MAX(dect_phy_mac_cluster_beacon_assoc_resp_earliest_get(req), first_possible_tx),
+		(ret + 1) * DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS,
+		dect_phy_mac_cluster_beacon_assoc_resp_deadline_get(req));
+	if (!resp_start_time) {
+		metrics->expired_count++;
+		k_mutex_unlock(&assoc_mutex);
+		return -ETIME;
+	}
+	k_mutex_unlock(&assoc_mutex);
 
 	tx_op.bs_cqi = NRF_MODEM_DECT_PHY_BS_CQI_NOT_USED;
-	tx_op.carrier = beacon_data.start_params.beacon_channel;
-	tx_op.data_size = encoded_pdu_length;
-	tx_op.data = encoded_data_to_send2;
+	/* Response on the channel of the request: when hopping, the cell can move meanwhile */
+	tx_op.carrier = (req->rx_channel) ? req->rx_channel
+					  : dect_phy_mac_cluster_beacon_channel_at_time_get(
+						    req->req_start_time);
+	tx_op.data_size = pdu_ptr - encoded;
+	tx_op.data = encoded;
 	tx_op.lbt_period = NRF_MODEM_DECT_LBT_PERIOD_MIN;
 	tx_op.lbt_rssi_threshold_max = current_settings->rssi_scan.busy_threshold;
 	tx_op.network_id = current_settings->common.network_id;
 	tx_op.phy_header = &phy_header;
 	tx_op.phy_type = DECT_PHY_HEADER_TYPE2;
-	tx_op.handle = DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE;
+	tx_op.handle = handle;
 	tx_op.start_time = resp_start_time;
 	ret = nrf_modem_dect_phy_tx(&tx_op);
 	if (ret) {
 		printk("(%s): nrf_modem_dect_phy_tx failed %d (handle %d)\n", (__func__), ret,
 		       tx_op.handle);
+		k_mutex_lock(&assoc_mutex, K_FOREVER);
+		metrics->tx_failed_count++;
+		k_mutex_unlock(&assoc_mutex);
+		return ret;
+	}
+
+	if (req->accept) {
+		(void)dect_phy_mac_ft_assoc_tx_update(req->pt_long_rd_id, tx_op.data_size);
 	}
+	resp_delay = resp_start_time - req->req_start_time;
+
+	k_mutex_lock(&assoc_mutex, K_FOREVER);
+	if (req->accept) {
+		metrics->resp_count++;
+	} else {
+		metrics->reject_count++;
+	}
+	metrics->resp_delay_sum_mdm_ticks += resp_delay;
+	metrics->resp_delay_max_mdm_ticks = MAX(metrics->resp_delay_max_mdm_ticks, resp_delay);
+	k_mutex_unlock(&assoc_mutex);
+	return 0;
+}
+
+#define DECT_PHY_MAC_CLUSTER_BEACON_RA_RESP_TX_HANDLE_COUNT                                    \
+	(DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_END - DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_START + 1)
+
+BUILD_ASSERT(DECT_PHY_MAC_CLUSTER_BEACON_ASSOC_BURST_MAX <=
+	     DECT_PHY_MAC_CLUSTER_BEACON_RA_RESP_TX_HANDLE_COUNT,
+	     "Not enough RA response TX handles for a burst");
+
+static void dect_phy_mac_cluster_beacon_assoc_burst_worker(struct k_work *work_item)
+{
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	struct dect_phy_mac_cluster_beacon_assoc_metrics *metrics = &assoc_data.metrics;
+	struct dect_phy_mac_cluster_beacon_assoc_req
+		burst[DECT_PHY_MAC_CLUSTER_BEACON_ASSOC_BURST_MAX];
+	uint16_t burst_size;
+	uint16_t handle_idx;
+	uint64_t first_possible_tx;
+
+	/* Burst is taken out of the queue, responses are encoded and sent without the lock */
+	k_mutex_lock(&assoc_mutex, K_FOREVER);
+	if (!beacon_data.running || assoc_data.queue_count == 0) {
+		k_mutex_unlock(&assoc_mutex);
+		return;
+	}
+	burst_size = MIN(assoc_data.queue_count, DECT_PHY_MAC_CLUSTER_BEACON_ASSOC_BURST_MAX);
+	memcpy(burst, &assoc_data.queue[0], burst_size * sizeof(burst[0]));
+	assoc_data.queue_count -= burst_size;
+	memmove(&assoc_data.queue[0], &assoc_data.queue[burst_size],
+		assoc_data.queue_count * sizeof(assoc_data.queue[0]));
+
+	handle_idx = assoc_data.resp_handle_next;
+	assoc_data.resp_handle_next = (handle_idx + burst_size) %
+				      DECT_PHY_MAC_CLUSTER_BEACON_RA_RESP_TX_HANDLE_COUNT;
+
+	metrics->burst_count++;
+	metrics->burst_size_max = MAX(metrics->burst_size_max, burst_size);
+
+	if (assoc_data.queue_count) {
+		/* Next burst in a next frame */
+		k_work_schedule_for_queue(&dect_phy_ctrl_work_q, &assoc_data.burst_work,
+					  K_MSEC(DECT_RADIO_FRAME_DURATION_MS));
+	}
+	k_mutex_unlock(&assoc_mutex);
+
+	first_possible_tx =
+		dect_app_modem_time_now() + dect_phy_ctrl_modem_latency_for_next_op_get(true) +
+		US_TO_MODEM_TICKS(current_settings->scheduler.scheduling_delay_us);
+
+	/* Queue is in arrival order, i.e. also in the order of response deadlines */
+	for (int i = 0; i < burst_size; i++) {
+		(void)dect_phy_mac_cluster_beacon_assoc_resp_send(
+			&burst[i], first_possible_tx,
+			DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_START +
+				((handle_idx + i) % DECT_PHY_MAC_CLUSTER_BEACON_RA_RESP_TX_HANDLE_COUNT));
+	}
+}
+
+static void dect_phy_mac_cluster_beacon_assoc_req_enqueue(
+	struct dect_phy_commmon_op_pdc_rcv_params *rcv_params,
+	dect_phy_mac_common_header_t *common_header, bool accept)
+{
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	struct dect_phy_mac_cluster_beacon_assoc_metrics *metrics = &assoc_data.metrics;
+	uint64_t req_len = (rcv_params->last_received_pcc_phy_len_type ==
+			    DECT_PHY_HEADER_PKT_LENGTH_TYPE_SLOTS)
+				   ? (rcv_params->last_received_pcc_phy_len *
+				      DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS)
+				   : (rcv_params->last_received_pcc_phy_len *
+				      DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
+	struct dect_phy_mac_cluster_beacon_assoc_req req = {
+		.accept = accept,
+		.pt_long_rd_id = common_header->transmitter_id,
+		.pt_short_rd_id = rcv_params->last_received_pcc_transmitter_short_rd_id,
+		.seq_nbr = common_header->seq_nbr,
+		.rx_channel = rcv_params->rx_channel,
+		.rx_pwr_dbm = rcv_params->rx_pwr_dbm,
+		.rx_mcs = rcv_params->rx_mcs,
+		.req_start_time = rcv_params->time,
+		.req_end_time = rcv_params->time + req_len,
+	};
+	uint64_t burst_time;
+	uint64_t time_now;
+
+	k_mutex_lock(&assoc_mutex, K_FOREVER);
+	metrics->req_count++;
+	for (int i = 0; i < assoc_data.queue_count; i++) {
+		if (assoc_data.queue[i].pt_long_rd_id == req.pt_long_rd_id) {
+			/* Retransmitted request: respond to the latest one. The old one is
+			 * removed and the new one appended to keep the deadline order.
+			 */
+			assoc_data.queue_count--;
+			memmove(&assoc_data.queue[i], &assoc_data.queue[i + 1],
+				(assoc_data.queue_count - i) * sizeof(assoc_data.queue[0]));
+			metrics->coalesced_count++;
+			break;
+		}
+	}
+	if (assoc_data.queue_count >= DECT_PHY_MAC_CLUSTER_BEACON_ASSOC_QUEUE_SIZE) {
+		metrics->queue_full_count++;
+		k_mutex_unlock(&assoc_mutex);
+		desh_warn("(%s): association request queue full, request from %u dropped",
+			  (__func__), req.pt_long_rd_id);
+		return;
+	}
+	assoc_data.queue[assoc_data.queue_count++] = req;
+	metrics->queue_depth_max = MAX(metrics->queue_depth_max, assoc_data.queue_count);
+
+	/* Burst as late as the earliest response still can be done, collecting the requests
+	 * received meanwhile. Pending burst is not moved.
+	 */
+	time_now = dect_app_modem_time_now();
+	burst_time = dect_phy_mac_cluster_beacon_assoc_resp_earliest_get(&assoc_data.queue[0]) -
+		     dect_phy_ctrl_modem_latency_for_next_op_get(true) -
+		     US_TO_MODEM_TICKS(current_settings->scheduler.scheduling_delay_us);
+	k_work_schedule_for_queue(
+		&dect_phy_ctrl_work_q, &assoc_data.burst_work,
+		(burst_time > time_now) ? K_MSEC((uint32_t)MODEM_TICKS_TO_MS(burst_time - time_now))
+					: K_NO_WAIT);
+	k_mutex_unlock(&assoc_mutex);
 }
-/* In case of association request with ack_bit=0 or other need to reject association, we can send an association response with ack_bit=0. */
 
+static void dect_phy_mac_cluster_beacon_assoc_reset(void)
+{
+	k_mutex_lock(&assoc_mutex, K_FOREVER);
+	(void)k_work_cancel_delayable(&assoc_data.burst_work);
+	assoc_data.queue_count = 0;
+	assoc_data.dl_next_free_time = 0;
+	memset(&assoc_data.metrics, 0, sizeof(assoc_data.metrics));
+	k_mutex_unlock(&assoc_mutex);
+}
+
+static void dect_phy_mac_cluster_beacon_assoc_status_print(void)
+{
+	struct dect_phy_mac_cluster_beacon_assoc_metrics metrics;
+	uint32_t handled_count;
+
+	k_mutex_lock(&assoc_mutex, K_FOREVER);
+	metrics = assoc_data.metrics;
+	k_mutex_unlock(&assoc_mutex);
+
+	handled_count = metrics.resp_count + metrics.reject_count;
+	desh_print("  Association requests:");
+	desh_print("    Received:                    %u", metrics.req_count);
+	desh_print("      coalesced to a queued one: %u", metrics.coalesced_count);
+	desh_print("      dropped, queue full:       %u", metrics.queue_full_count);
+	desh_print("    Responses sent:              %u", metrics.resp_count);
+	desh_print("    Rejects sent:                %u", metrics.reject_count);
+	desh_print("    Expired, no free DL slots:   %u", metrics.expired_count);
+	desh_print("    TX failed:                   %u", metrics.tx_failed_count);
+	desh_print("    Bursts:                      %u, max %u responses",
+		   metrics.burst_count, metrics.burst_size_max);
+	desh_print("    Max queue depth:             %u", metrics.queue_depth_max);
+	if (handled_count) {
+		uint64_t delay_avg_mdm_ticks = metrics.resp_delay_sum_mdm_ticks / handled_count;
+
+		desh_print("    Request to response:         avg %llu us, max %llu us",
+			   (delay_avg_mdm_ticks * 1000) / NRF_MODEM_DECT_MODEM_TIME_TICK_RATE_KHZ,
+			   (metrics.resp_delay_max_mdm_ticks * 1000) /
+				   NRF_MODEM_DECT_MODEM_TIME_TICK_RATE_KHZ);
+	}
+}
+
+void dect_phy_mac_cluster_beacon_association_req_handle(
+	struct dect_phy_commmon_op_pdc_rcv_params *rcv_params,
+	dect_phy_mac_common_header_t *common_header,
+	dect_phy_mac_association_req_t *association_req)
+{
+	if (!beacon_data.running) {
+		printk("Beacon not running and received Association Req from %u (0x%04x)\n",
+		       common_header->transmitter_id, common_header->transmitter_id);
+		return;
+	}
+	dect_phy_mac_cluster_beacon_assoc_req_enqueue(rcv_params, common_header, true);
+}
+
+/* In case of association request with ack_bit=0 or other need to reject association,
+ * we can send an association response with ack_bit=0.
+ */
 void dect_phy_mac_cluster_beacon_association_reject_send(
 	struct dect_phy_commmon_op_pdc_rcv_params *rcv_params,
 	dect_phy_mac_common_header_t *common_header)
@@ -860,17 +1738,25 @@ void dect_phy_mac_cluster_beacon_association_reject_send(
 	if (!beacon_data.running) {
 		return;
 	}
+	dect_phy_mac_cluster_beacon_assoc_req_enqueue(rcv_params, common_header, false);
+}
 
-	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+int dect_phy_mac_cluster_beacon_association_release_send(
+	uint32_t pt_long_rd_id, uint16_t pt_short_rd_id,
+	dect_phy_mac_association_rel_cause_t rel_cause)
+{
+	if (!beacon_data.running) {
+		return -EACCES;
+	}
 
-	/* Build a minimal Association Response with ack_bit=0 */
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
 	union nrf_modem_dect_phy_hdr phy_header;
 	uint8_t encoded[DECT_DATA_MAX_LEN];
 	uint8_t *pdu_ptr = encoded;
 
 	memset(encoded, 0, sizeof(encoded));
 
-	/* PHY header same style as normal association resp */
+	/* Most robust MCS: PT might be at the cell edge */
 	struct dect_phy_header_type2_format1_t header = {
 		.packet_length = 1,
 		.packet_length_type = DECT_PHY_HEADER_PKT_LENGTH_TYPE_SLOTS,
@@ -878,110 +1764,165 @@ void dect_phy_mac_cluster_beacon_association_reject_send(
 		.short_network_id = (uint8_t)(current_settings->common.network_id & 0xFF),
 		.transmitter_identity_hi = (uint8_t)(current_settings->common.short_rd_id >> 8),
 		.transmitter_identity_lo = (uint8_t)(current_settings->common.short_rd_id & 0xFF),
-		.df_mcs = rcv_params->rx_mcs,
-		.transmit_power = dect_common_utils_dbm_to_phy_tx_power(rcv_params->rx_pwr_dbm),
-		.receiver_identity_hi =
-			(uint8_t)(rcv_params->last_received_pcc_transmitter_short_rd_id >> 8),
-		.receiver_identity_lo =
-			(uint8_t)(rcv_params->last_received_pcc_transmitter_short_rd_id & 0xFF),
+		.df_mcs = 0,
+		.transmit_power = dect_common_utils_dbm_to_phy_tx_power(
+			beacon_data.start_params.tx_power_dbm),
+		.receiver_identity_hi = (uint8_t)(pt_short_rd_id >> 8),
+		.receiver_identity_lo = (uint8_t)(pt_short_rd_id & 0xFF),
 		.feedback.format1.format = 0,
 	};
-
-	dect_phy_mac_type_header_t type_header_resp = {
+	dect_phy_mac_type_header_t type_header = {
 		.version = 0,
 		.security = 0,
 		.type = DECT_PHY_MAC_HEADER_TYPE_UNICAST,
 	};
-
-	dect_phy_mac_common_header_t common_header_resp = {
+	dect_phy_mac_common_header_t common_header = {
 		.type = DECT_PHY_MAC_HEADER_TYPE_UNICAST,
 		.reset = 1,
-		.seq_nbr = common_header->seq_nbr,
-		.nw_id = current_settings->common.network_id,
+		.seq_nbr = 0,
+		.nw_id = ((current_settings->common.network_id >> 8) &
+			  DECT_COMMON_UTILS_BIT_MASK_24BIT), /* 24bit MSB */
 		.transmitter_id = current_settings->common.transmitter_id,
-		.receiver_id = common_header->transmitter_id,
+		.receiver_id = pt_long_rd_id,
 	};
 
-	pdu_ptr = dect_phy_mac_pdu_type_header_encode(&type_header_resp, pdu_ptr);
-	pdu_ptr = dect_phy_mac_pdu_common_header_encode(&common_header_resp, pdu_ptr);
+	pdu_ptr = dect_phy_mac_pdu_type_header_encode(&type_header, pdu_ptr);
+	pdu_ptr = dect_phy_mac_pdu_common_header_encode(&common_header, pdu_ptr);
 
 	sys_dlist_t sdu_list;
-	sys_dlist_init(&sdu_list);
 
-	dect_phy_mac_sdu_t *resp_sdu =
-		(dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
-	if (resp_sdu == NULL) {
-		return;
-	}
-
-	resp_sdu->mux_header.mac_ext = DECT_PHY_MAC_EXT_8BIT_LEN;
-	resp_sdu->mux_header.ie_type = DECT_PHY_MAC_IE_TYPE_ASSOCIATION_RESP;
-	resp_sdu->mux_header.payload_length = DECT_PHY_MAC_ASSOCIATION_RESP_MIN_LEN;
+	sys_dlist_init(&sdu_list);
 
-	/* ACK=0 => reject */
-	resp_sdu->message_type = DECT_PHY_MAC_MESSAGE_TYPE_ASSOCIATION_RESP;
-	resp_sdu->message.association_resp.ack_bit = 0;
-	resp_sdu->message.association_resp.group_bit = 0;
-	resp_sdu->message.association_resp.harq_conf_bit = 0;
-	resp_sdu->message.association_resp.flow_count = 0;
+	dect_phy_mac_sdu_t *rel_sdu = (dect_phy_mac_sdu_t *)k_calloc(1, sizeof(dect_phy_mac_sdu_t));
 
-	sys_dlist_append(&sdu_list, &resp_sdu->dnode);
+	if (rel_sdu == NULL) {
+		return -ENOMEM;
+	}
+	rel_sdu->mux_header.mac_ext = DECT_PHY_MAC_EXT_8BIT_LEN;
+	rel_sdu->mux_header.ie_type = DECT_PHY_MAC_IE_TYPE_ASSOCIATION_REL;
+	rel_sdu->mux_header.payload_length = DECT_PHY_MAC_ASSOCIATION_REL_LEN;
+	rel_sdu->message_type = DECT_PHY_MAC_MESSAGE_TYPE_ASSOCIATION_REL;
+	rel_sdu->message.association_rel.rel_cause = rel_cause;
 
+	sys_dlist_append(&sdu_list, &rel_sdu->dnode);
 	pdu_ptr = dect_phy_mac_pdu_sdus_encode(pdu_ptr, &sdu_list);
 
 	uint16_t encoded_len = pdu_ptr - encoded;
 
-	header.packet_length = dect_common_utils_phy_packet_length_calculate(
+	int packet_length = dect_common_utils_phy_packet_length_calculate(
 		encoded_len, header.packet_length_type, header.df_mcs);
-	if ((int)header.packet_length < 0) {
-		return;
-	}
 
+	if (packet_length < 0) {
+		return -EINVAL;
+	}
+	header.packet_length = packet_length;
 	memcpy(&phy_header.type_2, &header, sizeof(phy_header.type_2));
 
-	/* Schedule response similarly to normal association response */
-	uint64_t req_received = rcv_params->time;
-	uint64_t req_len = (rcv_params->last_received_pcc_phy_len_type ==
-			    DECT_PHY_HEADER_PKT_LENGTH_TYPE_SLOTS)
-				   ? (rcv_params->last_received_pcc_phy_len *
-				      DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS)
-				   : (rcv_params->last_received_pcc_phy_len *
-				      DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
+	/* Send in a next beacon frame between the beacon and the RA window: associated PTs
+	 * are listening around our beacons in their background scan.
+	 */
+	uint32_t beacon_interval_mdm_ticks =
+		MS_TO_MODEM_TICKS((uint64_t)beacon_data.start_params.period_ms);
+	uint64_t first_possible_tx =
+		dect_app_modem_time_now() + dect_phy_ctrl_modem_latency_for_next_op_get(true) +
+		US_TO_MODEM_TICKS(current_settings->scheduler.scheduling_delay_us);
+	uint64_t tx_frame_time = dect_phy_mac_rach_opp_next_beacon_frame_get(
+		beacon_data.last_tx_frame_time, beacon_interval_mdm_ticks, first_possible_tx);
 
-	uint64_t resp_start_time =
-		req_received + req_len + (DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS / 2);
+	struct dect_phy_api_scheduler_list_item_config *sched_list_item_conf;
+	struct dect_phy_api_scheduler_list_item *sched_list_item =
+		dect_phy_api_scheduler_list_item_alloc_tx_element(&sched_list_item_conf);
 
-	struct nrf_modem_dect_phy_tx_params tx_op;
+	if (!sched_list_item) {
+		desh_error("(%s): dect_phy_api_scheduler_list_item_alloc_tx_element failed: No "
+			   "memory to TX an association release", (__func__));
+		return -ENOMEM;
+	}
+	sched_list_item_conf->address_info.network_id = current_settings->common.network_id;
+	sched_list_item_conf->address_info.transmitter_long_rd_id =
+		current_settings->common.transmitter_id;
+	sched_list_item_conf->address_info.receiver_long_rd_id = pt_long_rd_id;
 
-	tx_op.bs_cqi = NRF_MODEM_DECT_PHY_BS_CQI_NOT_USED;
-	tx_op.carrier = beacon_data.start_params.beacon_channel;
-	tx_op.data_size = encoded_len;
-	tx_op.data = encoded;
-	tx_op.lbt_period = NRF_MODEM_DECT_LBT_PERIOD_MIN;
-	tx_op.lbt_rssi_threshold_max = current_settings->rssi_scan.busy_threshold;
-	tx_op.network_id = current_settings->common.network_id;
-	tx_op.phy_header = &phy_header;
-	tx_op.phy_type = DECT_PHY_HEADER_TYPE2;
-	tx_op.handle = DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE;
-	tx_op.start_time = resp_start_time;
+	sched_list_item_conf->cb_op_completed = NULL;
 
-	(void)nrf_modem_dect_phy_tx(&tx_op);
-}
+	sched_list_item_conf->channel =
+		dect_phy_mac_cluster_beacon_channel_at_time_get(tx_frame_time);
+	sched_list_item_conf->frame_time = tx_frame_time;
+	sched_list_item_conf->start_slot =
+		MAX((beacon_data.start_params.ra_resources[0].start_subslot /
+		     DECT_RADIO_FRAME_SUBSLOT_COUNT_IN_SLOT) - 2, 0);
 
+	sched_list_item_conf->interval_mdm_ticks = 0;
+	sched_list_item_conf->length_slots = header.packet_length + 1;
+	sched_list_item_conf->length_subslots = 0;
+
+	sched_list_item_conf->tx.phy_lbt_period = NRF_MODEM_DECT_LBT_PERIOD_MIN;
+	sched_list_item_conf->tx.phy_lbt_rssi_threshold_max =
+		current_settings->rssi_scan.busy_threshold;
+	sched_list_item_conf->tx.harq_feedback_requested = false;
+
+	sched_list_item->sched_config.tx.encoded_payload_pdu_size = encoded_len;
+	memcpy(sched_list_item->sched_config.tx.encoded_payload_pdu, encoded, encoded_len);
+
+	sched_list_item->sched_config.tx.header_type = DECT_PHY_HEADER_TYPE2;
+	memcpy(&sched_list_item->sched_config.tx.phy_header.type_2, &phy_header.type_2,
+	       sizeof(phy_header.type_2));
+
+	sched_list_item->priority = DECT_PRIORITY1_TX;
+	sched_list_item->phy_op_handle = DECT_PHY_MAC_BEACON_ASSOCIATION_REL_TX_HANDLE;
+
+	if (!dect_phy_api_scheduler_list_item_add(sched_list_item)) {
+		desh_error("(%s): dect_phy_api_scheduler_list_item_add failed", (__func__));
+		dect_phy_api_scheduler_list_item_dealloc(sched_list_item);
+		return -EBUSY;
+	}
+	return 0;
+}
 
 void dect_phy_mac_cluster_beacon_status_print(void)
 {
 	desh_print("Cluster beacon status:");
 	desh_print("  Beacon running: %s", beacon_data.running ? "yes" : "no");
 	if (beacon_data.running) {
-		desh_print("  Beacon channel:                %d",
-			   beacon_data.start_params.beacon_channel);
+		if (dect_phy_mac_cluster_beacon_hopping()) {
+			uint64_t time_now = dect_app_modem_time_now();
+
+			desh_print("  Beacon channel:                %d (hopping)",
+				   dect_phy_mac_cluster_beacon_channel_at_time_get(time_now));
+			for (int i = 0; i < beacon_data.start_params.hop_channel_count; i++) {
+				desh_print("  Hop channel #%d:                %d", i,
+					   beacon_data.start_params.hop_channels[i]);
+			}
+			desh_print("  Hop dwell:                     %d beacon periods",
+				   beacon_data.start_params.hop_dwell);
+		} else {
+			desh_print("  Beacon channel:                %d",
+				   beacon_data.start_params.beacon_channel);
+		}
 		desh_print("  Beacon tx power:               %d dBm",
 			   beacon_data.start_params.tx_power_dbm);
 		desh_print("  Beacon interval:               %d ms",
-			   DECT_PHY_MAC_CLUSTER_BEACON_INTERVAL_MS);
+			   beacon_data.start_params.period_ms);
+		for (int i = 0; i < beacon_data.start_params.ra_resource_count; i++) {
+			struct dect_phy_mac_beacon_ra_resource *ra =
+				&beacon_data.start_params.ra_resources[i];
+
+			desh_print("  RA resource #%d:                start subslot %d, "
+				   "length %d slots, repetition %d, validity %d",
+				   i, ra->start_subslot, ra->length_slots, ra->repetition,
+				   ra->validity);
+		}
+		dect_phy_mac_ft_rach_rx_status_print();
+		dect_phy_mac_cluster_beacon_assoc_status_print();
+		desh_print("  LMS interval:                  %d ms", beacon_data.lms_interval_ms);
+		desh_print("  LMS for beacon TX:             %d frames before",
+			   beacon_data.lms_beacon_frames_back);
+		desh_print("  LMS for RA:                    %d frames before",
+			   beacon_data.lms_ra_frames_back);
 		desh_print("  Beacon payload PDU byte count: %d",
 			   beacon_data.encoded_cluster_beacon_pdu_len);
+		desh_print("  Beacon update CPU cycles:      last %u, max %u",
+			   beacon_data.update_cycles_last, beacon_data.update_cycles_max);
 	}
 }
 
@@ -1019,3 +1960,13 @@ int64_t dect_phy_mac_cluster_beacon_rcv_time_shift_calculate(
 	}
 	return diff_out;
 }
+
+static int dect_phy_mac_cluster_beacon_init(void)
+{
+	k_work_init_delayable(&assoc_data.burst_work,
+			      dect_phy_mac_cluster_beacon_assoc_burst_worker);
+
+	return 0;
+}
+
+SYS_INIT(dect_phy_mac_cluster_beacon_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
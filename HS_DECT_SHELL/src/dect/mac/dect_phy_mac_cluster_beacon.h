@@ -11,27 +11,28 @@
 #include "dect_phy_mac_common.h"
 #include "dect_phy_mac_pdu.h"
 
-#define DECT_PHY_MAC_CLUSTER_BEACON_INTERVAL_MS (2000)
+#define DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_DEFAULT_MS (2000)
 
-/* Defines for Random Access Resource IE */
+/* Defaults for Random Access Resource IE */
 
 #define DECT_PHY_MAC_CLUSTER_BEACON_RA_START_SUBSLOT (12) /* Only even numbers */
 #define DECT_PHY_MAC_CLUSTER_BEACON_RA_LENGTH_SLOTS  (10)
 
-/* 'Validity' is random access allocation length in frames */
-#define DECT_PHY_MAC_CLUSTER_BEACON_RA_VALIDITY                                                    \
-	((DECT_PHY_MAC_CLUSTER_BEACON_INTERVAL_MS / DECT_RADIO_FRAME_DURATION_MS) / 2)
-
-/* 'repetition' in every 2nd frame */
+/* 'repetition' in every 2nd frame, 'validity' is then half of the beacon period */
 #define DECT_PHY_MAC_CLUSTER_BEACON_RA_REPETITION (2)
 
+/* With short beacon periods, LMS is not done for every beacon but at most once in this */
+#define DECT_PHY_MAC_CLUSTER_BEACON_LMS_INTERVAL_MIN_MS (1000)
+
+/* Queued association requests and max responses given to modem in a burst per frame */
+#define DECT_PHY_MAC_CLUSTER_BEACON_ASSOC_QUEUE_SIZE (32)
+#define DECT_PHY_MAC_CLUSTER_BEACON_ASSOC_BURST_MAX  (8)
+
 /******************************************************************************/
 
 int dect_phy_mac_cluster_beacon_tx_start(struct dect_phy_mac_beacon_start_params *params);
 void dect_phy_mac_cluster_beacon_tx_stop(void);
 
-void dect_phy_mac_cluster_beacon_update(void);
-
 void dect_phy_mac_cluster_beacon_status_print(void);
 
 void dect_phy_mac_ctrl_cluster_beacon_phy_api_direct_rssi_cb(
@@ -41,8 +42,19 @@ bool dect_phy_mac_cluster_beacon_is_running(void);
 
 uint64_t dect_phy_mac_cluster_beacon_last_tx_frame_time_get(void);
 
+/* Period of the running beacon, 0 if not running */
+uint32_t dect_phy_mac_cluster_beacon_period_ms_get(void);
+
+/* Channel of the cell at a given modem time, follows channel hopping */
+uint16_t dect_phy_mac_cluster_beacon_channel_at_time_get(uint64_t time);
+
+/* Is frame_index (from the beacon frame) within a beacon period a RA frame of the resource */
+bool dect_phy_mac_cluster_beacon_ra_in_frame(const struct dect_phy_mac_beacon_ra_resource *ra,
+					     uint32_t frame_index);
+
 /******************************************************************************/
 
+/* Requests are queued and responded in bursts, see dect_phy_mac_cluster_beacon.c */
 void dect_phy_mac_cluster_beacon_association_req_handle(
 	struct dect_phy_commmon_op_pdc_rcv_params *rcv_params,
 	dect_phy_mac_common_header_t *common_header,
@@ -52,6 +64,11 @@ void dect_phy_mac_cluster_beacon_association_reject_send(
 	struct dect_phy_commmon_op_pdc_rcv_params *rcv_params,
 	dect_phy_mac_common_header_t *common_header);
 
+/* Unsolicited Association Release to an associated PT, e.g. due to inactivity */
+int dect_phy_mac_cluster_beacon_association_release_send(
+	uint32_t pt_long_rd_id, uint16_t pt_short_rd_id,
+	dect_phy_mac_association_rel_cause_t rel_cause);
+
 
 /******************************************************************************/
 
@@ -21,9 +21,33 @@
 
 /******************************************************************************/
 
+#define DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT 4
+
+struct dect_phy_mac_beacon_ra_resource {
+	uint8_t start_subslot; /* Only even numbers */
+	uint8_t length_slots;
+	uint8_t repetition;    /* In frames, 0: single allocation in a beacon period */
+	uint8_t validity;      /* In frames from the beacon frame */
+};
+
+#define DECT_PHY_MAC_BEACON_HOP_CHANNEL_MAX_COUNT 8
+
 struct dect_phy_mac_beacon_start_params {
 	uint16_t beacon_channel;
 	int8_t tx_power_dbm;
+
+	uint32_t period_ms; /* 0: default */
+
+	/* 0: default RA resource */
+	uint8_t ra_resource_count;
+	struct dect_phy_mac_beacon_ra_resource ra_resources[DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT];
+
+	/* Channel hopping: cell moves to the next channel of the set after hop_dwell beacons.
+	 * 0: single channel, i.e. beacon_channel. Otherwise, beacon_channel is ignored.
+	 */
+	uint8_t hop_channel_count;
+	uint16_t hop_channels[DECT_PHY_MAC_BEACON_HOP_CHANNEL_MAX_COUNT];
+	uint16_t hop_dwell; /* In beacon periods, 0: default (1) */
 };
 
 struct dect_phy_mac_beacon_scan_params {
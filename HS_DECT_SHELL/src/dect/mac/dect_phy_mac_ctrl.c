@@ -36,6 +36,7 @@
 #include "dect_phy_mac_ctrl.h"
 #include "dect_phy_mac_pdu.h"
 #include "dect_phy_mac_ft_assoc.h"
+#include "dect_phy_mac_ft_rach_rx.h"
 #include "dect_phy_mac_sched_fixed.h"
 
 
@@ -44,6 +45,7 @@ extern struct k_sem rssi_scan_sema;
 
 static struct dect_phy_mac_ctrl_data {
 	bool beacon_tx_on_going;
+	uint32_t beacon_relocation_count;
 
 	/* Callbacks from dect_phy_ctrl */
 	struct dect_phy_ctrl_ext_callbacks ext_cmd;
@@ -61,6 +63,13 @@ struct dect_phy_mac_ctrl_beacon_stopper_data {
 };
 static struct dect_phy_mac_ctrl_beacon_stopper_data beacon_stopper_work_data;
 
+struct dect_phy_mac_ctrl_beacon_relocator_data {
+	struct k_work work;
+	struct dect_phy_mac_beacon_start_params cmd_params;
+	enum dect_phy_mac_ctrl_beacon_stop_cause cause;
+};
+static struct dect_phy_mac_ctrl_beacon_relocator_data beacon_relocator_work_data;
+
 static void dect_phy_mac_ctrl_beacon_start_work_handler(struct k_work *work_item)
 {
 	struct dect_phy_mac_ctrl_beacon_starter_data *data =
@@ -103,19 +112,25 @@ static void dect_phy_mac_ctrl_beacon_start_work_handler(struct k_work *work_item
 		desh_error("(%s): No response for RSSI scan or RSSI scan failed.", (__func__));
 		return;
 	}
-	chosen_channel = dect_phy_ctrl_rssi_scan_results_print_and_best_channel_get(false);
-	if (chosen_channel <= 0) {
-		sprintf(started_string, "No channel found for beacon.");
-		goto err_exit;
-	}
+	struct dect_phy_mac_beacon_start_params start_params = data->cmd_params;
 
-	sprintf(started_string, "Channel %d was chosen for the beacon.", chosen_channel);
+	chosen_channel = dect_phy_ctrl_rssi_scan_results_print_and_best_channel_get(false);
+	if (start_params.hop_channel_count) {
+		/* Channels given, scan results are for relocation */
+		sprintf(started_string, "Hopping over %d channels, starting from channel %d.",
+			start_params.hop_channel_count, start_params.hop_channels[0]);
+	} else {
+		if (chosen_channel <= 0) {
+			sprintf(started_string, "No channel found for beacon.");
+			goto err_exit;
+		}
 
-	struct dect_phy_mac_beacon_start_params start_params = data->cmd_params;
+		sprintf(started_string, "Channel %d was chosen for the beacon.", chosen_channel);
 
-	__ASSERT_NO_MSG(chosen_channel != 0);
+		__ASSERT_NO_MSG(chosen_channel != 0);
 
-	start_params.beacon_channel = chosen_channel;
+		start_params.beacon_channel = chosen_channel;
+	}
 
 	ret = dect_phy_mac_cluster_beacon_tx_start(&start_params);
 	if (ret) {
@@ -123,6 +138,7 @@ static void dect_phy_mac_ctrl_beacon_start_work_handler(struct k_work *work_item
 		goto err_exit;
 	} else {
 		mac_data.beacon_tx_on_going = true;
+		mac_data.beacon_relocation_count = 0;
 		desh_print("%s", started_string);
 		desh_print("Beacon TX started.");
 #if defined(CONFIG_DK_LIBRARY)
@@ -202,6 +218,55 @@ void dect_phy_mac_ctrl_cluster_beacon_stop(enum dect_phy_mac_ctrl_beacon_stop_ca
 	k_work_submit_to_queue(&dect_phy_ctrl_work_q, &beacon_stopper_work_data.work);
 }
 
+static void dect_phy_mac_ctrl_beacon_relocate_work_handler(struct k_work *work_item)
+{
+	struct dect_phy_mac_ctrl_beacon_relocator_data *data =
+		CONTAINER_OF(work_item, struct dect_phy_mac_ctrl_beacon_relocator_data, work);
+	char tmp_str[128] = {0};
+	int ret;
+
+	if (!mac_data.beacon_tx_on_going) {
+		/* Stopped meanwhile */
+		return;
+	}
+	dect_phy_mac_cluster_beacon_tx_stop();
+	ret = dect_phy_mac_cluster_beacon_tx_start(&data->cmd_params);
+	if (ret) {
+		desh_error("Beacon relocation failed: err %d", ret);
+		beacon_stopper_work_data.cause = data->cause;
+		dect_phy_mac_ctrl_beacon_stop_work_handler(&beacon_stopper_work_data.work);
+		return;
+	}
+	mac_data.beacon_relocation_count++;
+	if (data->cmd_params.hop_channel_count) {
+		char channels_str[64] = {0};
+		int len = 0;
+
+		for (int i = 0; i < data->cmd_params.hop_channel_count; i++) {
+			len += snprintf(channels_str + len, sizeof(channels_str) - len, "%s%d",
+					(i) ? "," : "", data->cmd_params.hop_channels[i]);
+		}
+		desh_warn("Beacon relocated (#%d), cause: %s. Hop channels %s.",
+			  mac_data.beacon_relocation_count,
+			  dect_phy_mac_ctrl_beacon_stop_cause_to_string(data->cause, tmp_str),
+			  channels_str);
+		return;
+	}
+	desh_warn("Beacon relocated (#%d), cause: %s. Channel %d.",
+		  mac_data.beacon_relocation_count,
+		  dect_phy_mac_ctrl_beacon_stop_cause_to_string(data->cause, tmp_str),
+		  data->cmd_params.beacon_channel);
+}
+
+void dect_phy_mac_ctrl_cluster_beacon_relocate(
+	const struct dect_phy_mac_beacon_start_params *params,
+	enum dect_phy_mac_ctrl_beacon_stop_cause cause)
+{
+	beacon_relocator_work_data.cmd_params = *params;
+	beacon_relocator_work_data.cause = cause;
+	k_work_submit_to_queue(&dect_phy_ctrl_work_q, &beacon_relocator_work_data.work);
+}
+
 /**************************************************************************************************/
 
 int dect_phy_mac_ctrl_beacon_scan_start(struct dect_phy_mac_beacon_scan_params *params)
@@ -242,19 +307,22 @@ int dect_phy_mac_ctrl_beacon_scan_start(struct dect_phy_mac_beacon_scan_params *
 
 int dect_phy_mac_ctrl_associate(struct dect_phy_mac_associate_params *params)
 {
-	struct dect_phy_mac_nbr_info_list_item *scan_info =
-		dect_phy_mac_nbr_info_get_by_long_rd_id(params->target_long_rd_id);
+	struct dect_phy_mac_nbr_info_list_item *scan_info;
+	int was_pinned;
 	int ret;
 
-	if (!scan_info) {
+	/* Pinned before taking the item: it is kept in place for the association */
+	was_pinned = dect_phy_mac_nbr_info_pin_set(params->target_long_rd_id, true);
+	if (was_pinned < 0) {
 		desh_error("Beacon with long RD ID %u has not been seen in scan results",
 			   params->target_long_rd_id);
 		return -EINVAL;
 	}
+	scan_info = dect_phy_mac_nbr_info_get_by_long_rd_id(params->target_long_rd_id);
 
 	ret = dect_phy_ctrl_ext_command_start(mac_data.ext_cmd);
 	if (ret) {
-		return ret;
+		goto unpin;
 	}
 
 	enum nrf_modem_dect_phy_radio_mode radio_mode;
@@ -275,8 +343,15 @@ int dect_phy_mac_ctrl_associate(struct dect_phy_mac_associate_params *params)
 	if (ret) {
 		desh_error("Cannot start client_associate: %d", ret);
 		(void)dect_phy_ctrl_ext_command_stop();
+		goto unpin;
 	}
 
+	return 0;
+
+unpin:
+	if (!was_pinned) {
+		(void)dect_phy_mac_nbr_info_pin_set(params->target_long_rd_id, false);
+	}
 	return ret;
 }
 
@@ -284,11 +359,11 @@ int dect_phy_mac_ctrl_associate(struct dect_phy_mac_associate_params *params)
 
 int dect_phy_mac_ctrl_dissociate(struct dect_phy_mac_associate_params *params)
 {
-	struct dect_phy_mac_nbr_info_list_item *scan_info =
-		dect_phy_mac_nbr_info_get_by_long_rd_id(params->target_long_rd_id);
+	struct dect_phy_mac_nbr_info_list_item scan_info;
 	int ret;
 
-	if (!scan_info) {
+	/* A copy: the item is not pinned and can be reused by a new neighbor meanwhile */
+	if (!dect_phy_mac_nbr_info_copy_by_long_rd_id(params->target_long_rd_id, &scan_info)) {
 		desh_error("Beacon with long RD ID %u has not been seen in scan results",
 			   params->target_long_rd_id);
 		return -EINVAL;
@@ -313,7 +388,7 @@ int dect_phy_mac_ctrl_dissociate(struct dect_phy_mac_associate_params *params)
 				tmp_str);
 	}
 
-	ret = dect_phy_mac_client_dissociate(scan_info, params);
+	ret = dect_phy_mac_client_dissociate(&scan_info, params);
 	if (ret) {
 		desh_error("Cannot start client_dissociate: %d", ret);
 		(void)dect_phy_ctrl_ext_command_stop();
@@ -326,11 +401,11 @@ int dect_phy_mac_ctrl_dissociate(struct dect_phy_mac_associate_params *params)
 
 int dect_phy_mac_ctrl_rach_tx_start(struct dect_phy_mac_rach_tx_params *params)
 {
-	struct dect_phy_mac_nbr_info_list_item *scan_info =
-		dect_phy_mac_nbr_info_get_by_long_rd_id(params->target_long_rd_id);
+	struct dect_phy_mac_nbr_info_list_item scan_info;
 	int ret;
 
-	if (!scan_info) {
+	/* A copy: the item is not pinned and can be reused by a new neighbor meanwhile */
+	if (!dect_phy_mac_nbr_info_copy_by_long_rd_id(params->target_long_rd_id, &scan_info)) {
 		desh_error("Beacon with long RD ID %u has not been seen in scan results",
 			   params->target_long_rd_id);
 		return -EINVAL;
@@ -355,7 +430,7 @@ int dect_phy_mac_ctrl_rach_tx_start(struct dect_phy_mac_rach_tx_params *params)
 				tmp_str);
 	}
 
-	ret = dect_phy_mac_client_rach_tx_start(scan_info, params);
+	ret = dect_phy_mac_client_rach_tx_start(&scan_info, params);
 	if (ret) {
 		desh_error("Cannot start client_rach_tx: %d", ret);
 		(void)dect_phy_ctrl_ext_command_stop();
@@ -383,15 +458,54 @@ static inline bool hs_is_fixed_ft(void)
 
 /**************************************************************************************************/
 
+/* HARQ feedback from an associated PT into its FT link stats. Both type 2 header formats
+ * (000 with and 001 without a HARQ process of its own) can carry it.
+ */
+static void dect_phy_mac_ctrl_th_phy_api_pcc_rx_cb(
+	struct dect_phy_common_op_pcc_rcv_params *params)
+{
+	struct dect_phy_header_type2_format0_t *header_format0 = (void *)&(params->phy_header);
+	struct dect_phy_header_type2_format1_t *header_format1 = (void *)&(params->phy_header);
+	dect_phy_feedback_t *feedback;
+	uint32_t pt_long_rd_id;
+
+	if (params->pcc_status.header_status != NRF_MODEM_DECT_PHY_HDR_STATUS_VALID ||
+	    params->pcc_status.phy_type != DECT_PHY_HEADER_TYPE2) {
+		return;
+	}
+	if (header_format1->format == DECT_PHY_HEADER_FORMAT_001) {
+		feedback = &header_format1->feedback;
+	} else if (header_format0->format == DECT_PHY_HEADER_FORMAT_000) {
+		feedback = &header_format0->feedback;
+	} else {
+		return;
+	}
+	if (feedback->format1.format != 1) {
+		return;
+	}
+	if (dect_phy_mac_ft_assoc_by_short_rd_id_get(params->transmitter_short_rd_id, NULL,
+						     &pt_long_rd_id)) {
+		return;
+	}
+	(void)dect_phy_mac_ft_assoc_harq_update(pt_long_rd_id,
+						feedback->format1.transmission_feedback0);
+}
+
 static void dect_phy_mac_ctrl_th_phy_api_direct_pdc_rx_cb(
 	struct dect_phy_commmon_op_pdc_rcv_params *params)
 {
+	if (DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_IN_RANGE(params->rx_status.handle)) {
+		dect_phy_mac_ft_rach_rx_pdc_received(params->rx_status.handle);
+	}
 	dect_phy_mac_direct_pdc_handle(params);
 }
 
 void dect_phy_mac_ctrl_th_phy_api_mdm_op_complete_cb(
 	struct dect_phy_common_op_completed_params *params)
 {
+	if (DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_IN_RANGE(params->handle)) {
+		dect_phy_mac_ft_rach_rx_op_completed(params);
+	}
 	if (params->status != NRF_MODEM_DECT_PHY_SUCCESS) {
 		char tmp_str[128] = {0};
 
@@ -415,7 +529,12 @@ void dect_phy_mac_ctrl_th_phy_api_mdm_op_complete_cb(
 			}
 		} else if (params->handle == DECT_PHY_MAC_CLIENT_ASSOCIATED_BG_SCAN) {
 			desh_warn("%s: client associated bg scan failed: %s", __func__, tmp_str);
-		} else if (params->handle == DECT_PHY_MAC_BEACON_LMS_RSSI_SCAN_HANDLE) {
+		} else if (params->handle == DECT_PHY_MAC_CLIENT_KEEP_ALIVE_TX_HANDLE) {
+			desh_warn("%s: cannot TX keep alive: %s", __func__, tmp_str);
+		} else if (params->handle == DECT_PHY_MAC_CLIENT_UL_TX_HANDLE) {
+			desh_warn("%s: cannot TX UL data: %s", __func__, tmp_str);
+		} else if (params->handle == DECT_PHY_MAC_BEACON_LMS_RSSI_SCAN_HANDLE ||
+			   params->handle == DECT_PHY_MAC_BEACON_LMS_RA_RSSI_SCAN_HANDLE) {
 			desh_warn("%s: cannot start LMS RSSI scan: %s", __func__, tmp_str);
 		} else if (DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_IN_RANGE(params->handle)) {
 			desh_warn("%s: cannot start RA RX: %s, handle %d",
@@ -432,10 +551,12 @@ void dect_phy_mac_ctrl_th_phy_api_mdm_op_complete_cb(
 			desh_print("TX for Association Request completed.");
 		} else if (params->handle == DECT_PHY_MAC_CLIENT_ASSOCIATION_RX_HANDLE) {
 			desh_print("RX for Association Response completed.");
-		} else if (params->handle == DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE) {
+		} else if (DECT_PHY_MAC_BEACON_RA_RESP_TX_HANDLE_IN_RANGE(params->handle)) {
 			desh_print("Beacon TX for Association Resp completed.");
 		} else if (params->handle == DECT_PHY_MAC_CLIENT_ASSOCIATION_REL_TX_HANDLE) {
 			desh_print("TX for Association Release completed.");
+		} else if (params->handle == DECT_PHY_MAC_BEACON_ASSOCIATION_REL_TX_HANDLE) {
+			desh_print("Beacon TX for Association Release completed.");
 		}
 	}
 
@@ -446,11 +567,6 @@ specific_handles:
 	    params->handle == DECT_PHY_MAC_CLIENT_ASSOCIATION_REL_TX_HANDLE)) {
 		dect_phy_ctrl_ext_command_stop();
 	}
-
-	/* In any case, let's update SFN for a next round in a scheduler */
-	if (params->handle == DECT_PHY_MAC_BEACON_TX_HANDLE) {
-		dect_phy_mac_cluster_beacon_update();
-	}
 }
 
 /**************************************************************************************************/
@@ -461,7 +577,7 @@ static int dect_phy_mac_ctrl_init(void)
 
 	/* Register for modem and other needed callbacks served by dect_phy_ctrl */
 	mac_data.ext_cmd.direct_pcc_rcv_cb = NULL; /* No HARQ support */
-	mac_data.ext_cmd.pcc_rcv_cb = NULL;
+	mac_data.ext_cmd.pcc_rcv_cb = dect_phy_mac_ctrl_th_phy_api_pcc_rx_cb;
 	mac_data.ext_cmd.direct_pdc_rcv_cb = NULL;
 	mac_data.ext_cmd.pdc_rcv_cb = NULL;
 	mac_data.ext_cmd.op_complete_cb = dect_phy_mac_ctrl_th_phy_api_mdm_op_complete_cb;
@@ -470,6 +586,8 @@ static int dect_phy_mac_ctrl_init(void)
 
 	k_work_init(&beacon_starter_work_data.work, dect_phy_mac_ctrl_beacon_start_work_handler);
 	k_work_init(&beacon_stopper_work_data.work, dect_phy_mac_ctrl_beacon_stop_work_handler);
+	k_work_init(&beacon_relocator_work_data.work,
+		    dect_phy_mac_ctrl_beacon_relocate_work_handler);
 
 	return 0;
 }
@@ -21,6 +21,11 @@ enum dect_phy_mac_ctrl_beacon_stop_cause {
 
 int dect_phy_mac_ctrl_cluster_beacon_start(struct dect_phy_mac_beacon_start_params *params);
 void dect_phy_mac_ctrl_cluster_beacon_stop(enum dect_phy_mac_ctrl_beacon_stop_cause cause);
+
+/* Restarts the running beacon with changed params, e.g. due to LMS. Stops if that fails. */
+void dect_phy_mac_ctrl_cluster_beacon_relocate(
+	const struct dect_phy_mac_beacon_start_params *params,
+	enum dect_phy_mac_ctrl_beacon_stop_cause cause);
 int dect_phy_mac_ctrl_beacon_scan_start(struct dect_phy_mac_beacon_scan_params *params);
 int dect_phy_mac_ctrl_rach_tx_start(struct dect_phy_mac_rach_tx_params *params);
 int dect_phy_mac_ctrl_rach_tx_stop(void);
@@ -2,31 +2,238 @@
 #include <string.h>
 
 #include "desh_print.h"
+#include "dect_common.h"
+#include "dect_phy_common.h"
+#include "dect_app_time.h"
 #include "dect_common_settings.h"
+#include "dect_phy_mac_pdu.h"
+#include "dect_phy_mac_cluster_beacon.h"
+#include "dect_phy_mac_timer.h"
 #include "dect_phy_mac_ft_assoc.h"
 
+BUILD_ASSERT(DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE < UINT8_MAX, "PT index is 8bit");
+
+#define FT_ASSOC_IDX_NONE	 UINT8_MAX
+#define FT_ASSOC_HASH_BUCKETS	 DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE
+#define FT_ASSOC_FREE_WORD_COUNT ((DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE + 31) / 32)
+
+/* RSSI EWMA weight of a new sample: 1/8 */
+#define FT_ASSOC_RSSI_EWMA_SHIFT 3
+
+/* Table slot index + 1 is the PT index. Entry info is written only with g_tab_lock held and
+ * inside seq increments (odd seq: write ongoing), so it can be read without the lock.
+ */
 struct ft_assoc_entry {
-	bool used;
-	uint32_t pt_long_rd_id;
-	uint16_t pt_short_rd_id;
-	int8_t last_rssi;
-	uint64_t last_seen_bb;
+	atomic_t seq;
+	struct dect_phy_mac_ft_assoc_pt_info info;
+
+	uint8_t long_hash_next;
+	uint8_t short_hash_next;
+
+	/* Armed while used, re-armed lazily from last_seen_bb on expiry */
+	struct dect_phy_mac_timer inactivity_timer;
 };
 
-static struct ft_assoc_entry g_tab[DECT_MAX_PTS];
+static struct ft_assoc_entry g_tab[DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE];
+
+static uint8_t g_long_hash_heads[FT_ASSOC_HASH_BUCKETS];
+static uint8_t g_short_hash_heads[FT_ASSOC_HASH_BUCKETS];
+
+/* Bit set: slot is free */
+static uint32_t g_free_bitmap[FT_ASSOC_FREE_WORD_COUNT];
+static int g_count;
 
-/* ISR-safe lock */
+/* ISR-safe lock for writers */
 static struct k_spinlock g_tab_lock;
 
 static int tab_limit_get(void)
 {
 	struct dect_phy_settings *s = dect_common_settings_ref_get();
+
+	if (s->mac_sched.mode != DECT_MAC_SCHED_FIXED) {
+		return DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE;
+	}
+
+	/* Fixed scheduling: bound by the configured slot table */
 	int lim = (s->mac_sched.max_pts > 0) ? s->mac_sched.max_pts : 1;
 
-	if (lim > DECT_MAX_PTS) {
-		lim = DECT_MAX_PTS;
+	lim = MIN(lim, DECT_MAX_PTS);
+	return MIN(lim, DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE);
+}
+
+static inline uint8_t long_hash(uint32_t pt_long_rd_id)
+{
+	return ((pt_long_rd_id * 2654435761U) >> 16) % FT_ASSOC_HASH_BUCKETS;
+}
+
+static inline uint8_t short_hash(uint16_t pt_short_rd_id)
+{
+	return ((pt_short_rd_id * 40503U) >> 8) % FT_ASSOC_HASH_BUCKETS;
+}
+
+static inline void entry_write_begin(struct ft_assoc_entry *e)
+{
+	(void)atomic_inc(&e->seq);
+}
+
+static inline void entry_write_end(struct ft_assoc_entry *e)
+{
+	(void)atomic_inc(&e->seq);
+}
+
+/* All below with g_tab_lock held */
+
+static void tab_init_locked(void)
+{
+	for (int i = 0; i < DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE; i++) {
+		dect_phy_mac_timer_stop(&g_tab[i].inactivity_timer);
+		entry_write_begin(&g_tab[i]);
+		memset(&g_tab[i].info, 0, sizeof(g_tab[i].info));
+		entry_write_end(&g_tab[i]);
+		g_tab[i].long_hash_next = FT_ASSOC_IDX_NONE;
+		g_tab[i].short_hash_next = FT_ASSOC_IDX_NONE;
+	}
+	memset(g_long_hash_heads, FT_ASSOC_IDX_NONE, sizeof(g_long_hash_heads));
+	memset(g_short_hash_heads, FT_ASSOC_IDX_NONE, sizeof(g_short_hash_heads));
+	memset(g_free_bitmap, 0, sizeof(g_free_bitmap));
+	for (int i = 0; i < DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE; i++) {
+		g_free_bitmap[i / 32] |= BIT(i % 32);
+	}
+	g_count = 0;
+}
+
+static uint8_t find_by_long_locked(uint32_t pt_long_rd_id)
+{
+	uint8_t idx = g_long_hash_heads[long_hash(pt_long_rd_id)];
+
+	while (idx != FT_ASSOC_IDX_NONE && g_tab[idx].info.pt_long_rd_id != pt_long_rd_id) {
+		idx = g_tab[idx].long_hash_next;
+	}
+	return idx;
+}
+
+static uint8_t find_by_short_locked(uint16_t pt_short_rd_id)
+{
+	uint8_t idx = g_short_hash_heads[short_hash(pt_short_rd_id)];
+
+	while (idx != FT_ASSOC_IDX_NONE && g_tab[idx].info.pt_short_rd_id != pt_short_rd_id) {
+		idx = g_tab[idx].short_hash_next;
 	}
-	return lim;
+	return idx;
+}
+
+static void chain_unlink_locked(uint8_t *head, uint8_t idx, bool short_chain)
+{
+	uint8_t *link = head;
+
+	while (*link != FT_ASSOC_IDX_NONE) {
+		uint8_t *next = short_chain ? &g_tab[*link].short_hash_next
+					    : &g_tab[*link].long_hash_next;
+
+		if (*link == idx) {
+			*link = *next;
+			return;
+		}
+		link = next;
+	}
+}
+
+static void short_link_locked(uint8_t idx)
+{
+	uint8_t *head = &g_short_hash_heads[short_hash(g_tab[idx].info.pt_short_rd_id)];
+
+	g_tab[idx].short_hash_next = *head;
+	*head = idx;
+}
+
+/* Lowest free slot below lim, so that PT indexes are always within max_pts */
+static uint8_t free_slot_alloc_locked(int lim)
+{
+	for (int w = 0; w < FT_ASSOC_FREE_WORD_COUNT && w * 32 < lim; w++) {
+		uint32_t bits = g_free_bitmap[w];
+
+		if ((lim - w * 32) < 32) {
+			bits &= BIT(lim - w * 32) - 1;
+		}
+		if (bits) {
+			int i = w * 32 + find_lsb_set(bits) - 1;
+
+			g_free_bitmap[w] &= ~BIT(i % 32);
+			return (uint8_t)i;
+		}
+	}
+	return FT_ASSOC_IDX_NONE;
+}
+
+static void entry_remove_locked(uint8_t idx)
+{
+	struct ft_assoc_entry *e = &g_tab[idx];
+
+	chain_unlink_locked(&g_long_hash_heads[long_hash(e->info.pt_long_rd_id)], idx, false);
+	chain_unlink_locked(&g_short_hash_heads[short_hash(e->info.pt_short_rd_id)], idx, true);
+	dect_phy_mac_timer_stop(&e->inactivity_timer);
+
+	entry_write_begin(e);
+	memset(&e->info, 0, sizeof(e->info));
+	entry_write_end(e);
+
+	g_free_bitmap[idx / 32] |= BIT(idx % 32);
+	g_count--;
+}
+
+static void entry_rssi_update_locked(struct ft_assoc_entry *e, int8_t rssi, uint64_t t_bb)
+{
+	int16_t rssi_q4 = (int16_t)rssi * 16;
+
+	if (e->info.last_seen_bb == 0) {
+		e->info.rssi_ewma_q4 = rssi_q4;
+	} else {
+		e->info.rssi_ewma_q4 +=
+			(rssi_q4 - e->info.rssi_ewma_q4) / (1 << FT_ASSOC_RSSI_EWMA_SHIFT);
+	}
+	e->info.last_rssi = rssi;
+	e->info.last_seen_bb = t_bb;
+}
+
+/**************************************************************************************************/
+
+static void ft_assoc_inactivity_timer_cb(struct dect_phy_mac_timer *timer)
+{
+	struct ft_assoc_entry *e = CONTAINER_OF(timer, struct ft_assoc_entry, inactivity_timer);
+	uint64_t timeout_mdm_ticks =
+		SECONDS_TO_MODEM_TICKS(DECT_PHY_MAC_FT_ASSOC_INACTIVITY_TIMEOUT_SEC);
+	uint64_t time_now = dect_app_modem_time_now();
+	uint64_t idle_mdm_ticks;
+	uint32_t pt_long_rd_id;
+	uint16_t pt_short_rd_id;
+	uint8_t pt_index;
+
+	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
+
+	if (!e->info.used) {
+		k_spin_unlock(&g_tab_lock, key);
+		return;
+	}
+
+	idle_mdm_ticks = (time_now > e->info.last_seen_bb) ? (time_now - e->info.last_seen_bb) : 0;
+	if (idle_mdm_ticks < timeout_mdm_ticks) {
+		dect_phy_mac_timer_start(
+			timer, (uint32_t)MODEM_TICKS_TO_MS(timeout_mdm_ticks - idle_mdm_ticks));
+		k_spin_unlock(&g_tab_lock, key);
+		return;
+	}
+
+	pt_long_rd_id = e->info.pt_long_rd_id;
+	pt_short_rd_id = e->info.pt_short_rd_id;
+	pt_index = e->info.pt_index;
+	entry_remove_locked(e - g_tab);
+	k_spin_unlock(&g_tab_lock, key);
+
+	desh_warn("FT: PT%d long RD ID %u inactive for %d secs -> released", pt_index,
+		  pt_long_rd_id, DECT_PHY_MAC_FT_ASSOC_INACTIVITY_TIMEOUT_SEC);
+
+	(void)dect_phy_mac_cluster_beacon_association_release_send(
+		pt_long_rd_id, pt_short_rd_id, DECT_PHY_MAC_ASSOCIATION_REL_CAUSE_LONG_INACTIVITY);
 }
 
 int dect_phy_mac_ft_assoc_add_or_update(uint32_t pt_long_rd_id,
@@ -37,60 +244,75 @@ int dect_phy_mac_ft_assoc_add_or_update(uint32_t pt_long_rd_id,
 	if (pt_long_rd_id == 0) {
 		return -EINVAL;
 	}
-	int assoc_count = dect_phy_mac_ft_assoc_count_get();
-	struct dect_phy_settings *s = dect_common_settings_ref_get();
-
-	if (assoc_count >= s->mac_sched.max_pts) {
-		desh_warn("FT: association rejected, max PTs reached (%d)",
-				s->mac_sched.max_pts);
-		return -ENOMEM;
-	}
 
 	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
-
+	struct ft_assoc_entry *e;
+	uint8_t idx = find_by_long_locked(pt_long_rd_id);
 	int lim = tab_limit_get();
 
-	/* update if exists */
-	for (int i = 0; i < lim; i++) {
-		if (g_tab[i].used && g_tab[i].pt_long_rd_id == pt_long_rd_id) {
-			g_tab[i].pt_short_rd_id = pt_short_rd_id;
-			g_tab[i].last_rssi = rssi;
-			g_tab[i].last_seen_bb = t_bb;
-			k_spin_unlock(&g_tab_lock, key);
-			return (i + 1); /* PT index = slot in table + 1 */
+	if (idx != FT_ASSOC_IDX_NONE) {
+		/* update if exists */
+		e = &g_tab[idx];
+		bool short_changed = (e->info.pt_short_rd_id != pt_short_rd_id);
+
+		if (short_changed) {
+			chain_unlink_locked(&g_short_hash_heads[short_hash(e->info.pt_short_rd_id)],
+					    idx, true);
+		}
+		entry_write_begin(e);
+		e->info.pt_short_rd_id = pt_short_rd_id;
+		entry_rssi_update_locked(e, rssi, t_bb);
+		entry_write_end(e);
+		if (short_changed) {
+			short_link_locked(idx);
 		}
+		k_spin_unlock(&g_tab_lock, key);
+		return (idx + 1); /* PT index = slot in table + 1 */
 	}
 
-	/* insert to first free slot => assigns PT index */
-	for (int i = 0; i < lim; i++) {
-		if (!g_tab[i].used) {
-			g_tab[i].used = true;
-			g_tab[i].pt_long_rd_id = pt_long_rd_id;
-			g_tab[i].pt_short_rd_id = pt_short_rd_id;
-			g_tab[i].last_rssi = rssi;
-			g_tab[i].last_seen_bb = t_bb;
-			k_spin_unlock(&g_tab_lock, key);
-			return (i + 1);
-		}
+	if (g_count >= lim) {
+		k_spin_unlock(&g_tab_lock, key);
+		desh_warn("FT: association rejected, max PTs reached (%d)", lim);
+		return -ENOMEM;
+	}
+
+	/* insert to lowest free slot => assigns PT index */
+	idx = free_slot_alloc_locked(lim);
+	if (idx == FT_ASSOC_IDX_NONE) {
+		k_spin_unlock(&g_tab_lock, key);
+		return -ENOMEM; /* FT full */
 	}
+	e = &g_tab[idx];
+
+	entry_write_begin(e);
+	memset(&e->info, 0, sizeof(e->info));
+	e->info.used = true;
+	e->info.pt_index = idx + 1;
+	e->info.pt_long_rd_id = pt_long_rd_id;
+	e->info.pt_short_rd_id = pt_short_rd_id;
+	e->info.associated_bb = t_bb;
+	entry_rssi_update_locked(e, rssi, t_bb);
+	entry_write_end(e);
+
+	uint8_t *head = &g_long_hash_heads[long_hash(pt_long_rd_id)];
+
+	e->long_hash_next = *head;
+	*head = idx;
+	short_link_locked(idx);
+	g_count++;
+
+	/* Not touched on every RX: expiry checks last_seen_bb and re-arms if needed */
+	dect_phy_mac_timer_start(&e->inactivity_timer,
+				 DECT_PHY_MAC_FT_ASSOC_INACTIVITY_TIMEOUT_SEC * 1000);
 
 	k_spin_unlock(&g_tab_lock, key);
-	return -ENOMEM; /* FT full */
+	return (idx + 1);
 }
 
 bool dect_phy_mac_ft_assoc_is_associated(uint32_t pt_long_rd_id)
 {
-	bool ok = false;
-
 	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
-
-	int lim = tab_limit_get();
-	for (int i = 0; i < lim; i++) {
-		if (g_tab[i].used && g_tab[i].pt_long_rd_id == pt_long_rd_id) {
-			ok = true;
-			break;
-		}
-	}
+	bool ok = (find_by_long_locked(pt_long_rd_id) != FT_ASSOC_IDX_NONE);
 
 	k_spin_unlock(&g_tab_lock, key);
 	return ok;
@@ -103,33 +325,140 @@ int dect_phy_mac_ft_assoc_pt_index_get(uint32_t pt_long_rd_id, uint8_t *pt_index
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
+	uint8_t idx = find_by_long_locked(pt_long_rd_id);
 
-	int lim = tab_limit_get();
-	for (int i = 0; i < lim; i++) {
-		if (g_tab[i].used && g_tab[i].pt_long_rd_id == pt_long_rd_id) {
-			*pt_index_out = (uint8_t)(i + 1);
-			k_spin_unlock(&g_tab_lock, key);
-			return 0;
-		}
+	k_spin_unlock(&g_tab_lock, key);
+	if (idx == FT_ASSOC_IDX_NONE) {
+		return -ENOENT;
+	}
+	*pt_index_out = idx + 1;
+	return 0;
+}
+
+int dect_phy_mac_ft_assoc_by_short_rd_id_get(uint16_t pt_short_rd_id, uint8_t *pt_index_out,
+					     uint32_t *pt_long_rd_id_out)
+{
+	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
+	uint8_t idx = find_by_short_locked(pt_short_rd_id);
+
+	if (idx == FT_ASSOC_IDX_NONE) {
+		k_spin_unlock(&g_tab_lock, key);
+		return -ENOENT;
+	}
+	if (pt_index_out) {
+		*pt_index_out = idx + 1;
+	}
+	if (pt_long_rd_id_out) {
+		*pt_long_rd_id_out = g_tab[idx].info.pt_long_rd_id;
+	}
+	k_spin_unlock(&g_tab_lock, key);
+	return 0;
+}
+
+int dect_phy_mac_ft_assoc_rx_update(uint32_t pt_long_rd_id, int8_t rssi, uint64_t t_bb,
+				    uint32_t byte_count)
+{
+	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
+	uint8_t idx = find_by_long_locked(pt_long_rd_id);
+
+	if (idx == FT_ASSOC_IDX_NONE) {
+		k_spin_unlock(&g_tab_lock, key);
+		return -ENOENT;
 	}
 
+	struct ft_assoc_entry *e = &g_tab[idx];
+
+	entry_write_begin(e);
+	entry_rssi_update_locked(e, rssi, t_bb);
+	e->info.rx_packet_count++;
+	e->info.rx_byte_count += byte_count;
+	entry_write_end(e);
+
 	k_spin_unlock(&g_tab_lock, key);
-	return -ENOENT;
+	return 0;
+}
+
+int dect_phy_mac_ft_assoc_tx_update(uint32_t pt_long_rd_id, uint32_t byte_count)
+{
+	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
+	uint8_t idx = find_by_long_locked(pt_long_rd_id);
+
+	if (idx == FT_ASSOC_IDX_NONE) {
+		k_spin_unlock(&g_tab_lock, key);
+		return -ENOENT;
+	}
+
+	struct ft_assoc_entry *e = &g_tab[idx];
+
+	entry_write_begin(e);
+	e->info.tx_packet_count++;
+	e->info.tx_byte_count += byte_count;
+	entry_write_end(e);
+
+	k_spin_unlock(&g_tab_lock, key);
+	return 0;
+}
+
+int dect_phy_mac_ft_assoc_harq_update(uint32_t pt_long_rd_id, bool ack)
+{
+	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
+	uint8_t idx = find_by_long_locked(pt_long_rd_id);
+
+	if (idx == FT_ASSOC_IDX_NONE) {
+		k_spin_unlock(&g_tab_lock, key);
+		return -ENOENT;
+	}
+
+	struct ft_assoc_entry *e = &g_tab[idx];
+
+	entry_write_begin(e);
+	if (ack) {
+		e->info.harq_ack_count++;
+	} else {
+		e->info.harq_nack_count++;
+	}
+	entry_write_end(e);
+
+	k_spin_unlock(&g_tab_lock, key);
+	return 0;
+}
+
+int dect_phy_mac_ft_assoc_pt_info_get(uint8_t pt_index,
+				      struct dect_phy_mac_ft_assoc_pt_info *info_out)
+{
+	if (!info_out || pt_index == 0 || pt_index > DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE) {
+		return -EINVAL;
+	}
+
+	struct ft_assoc_entry *e = &g_tab[pt_index - 1];
+	atomic_val_t seq;
+
+	/* Writers hold a spinlock, i.e. cannot be preempted by us: retry until consistent */
+	do {
+		seq = atomic_get(&e->seq);
+		if (seq & 1) {
+			continue;
+		}
+		*info_out = e->info;
+	} while ((seq & 1) || atomic_get(&e->seq) != seq);
+
+	return info_out->used ? 0 : -ENOENT;
 }
 
 void dect_phy_mac_ft_assoc_clear_all(void)
 {
 	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
-	memset(g_tab, 0, sizeof(g_tab));
+
+	tab_init_locked();
 	k_spin_unlock(&g_tab_lock, key);
 
 	/* Called from shell context -> safe to print */
 	desh_print("FT assoc table cleared.");
 }
 
-/// @brief 
-/// @param pt_long_rd_id 
-/// @return 
+/// @brief
+/// @param pt_long_rd_id
+/// @return
 int dect_phy_mac_ft_assoc_remove(uint32_t pt_long_rd_id)
 {
 	if (pt_long_rd_id == 0) {
@@ -137,32 +466,22 @@ int dect_phy_mac_ft_assoc_remove(uint32_t pt_long_rd_id)
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
+	uint8_t idx = find_by_long_locked(pt_long_rd_id);
 
-	int lim = tab_limit_get();
-	for (int i = 0; i < lim; i++) {
-		if (g_tab[i].used && g_tab[i].pt_long_rd_id == pt_long_rd_id) {
-			memset(&g_tab[i], 0, sizeof(g_tab[i]));
-			k_spin_unlock(&g_tab_lock, key);
-			return 0;
-		}
+	if (idx == FT_ASSOC_IDX_NONE) {
+		k_spin_unlock(&g_tab_lock, key);
+		return -ENOENT;
 	}
+	entry_remove_locked(idx);
 
 	k_spin_unlock(&g_tab_lock, key);
-	return -ENOENT;
+	return 0;
 }
 
 int dect_phy_mac_ft_assoc_count_get(void)
 {
-	int cnt = 0;
-
 	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
-
-	int lim = tab_limit_get();
-	for (int i = 0; i < lim; i++) {
-		if (g_tab[i].used) {
-			cnt++;
-		}
-	}
+	int cnt = g_count;
 
 	k_spin_unlock(&g_tab_lock, key);
 	return cnt;
@@ -172,14 +491,14 @@ int dect_phy_mac_ft_assoc_count_get(void)
 void dect_phy_mac_ft_assoc_status_print(void)
 {
 	struct dect_phy_settings *s = dect_common_settings_ref_get();
+	struct dect_phy_mac_ft_assoc_pt_info info;
 
-	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
-
-	int lim = tab_limit_get();
-	desh_print("FT assoc table (max=%d):", lim);
+	desh_print("FT assoc table (max=%d, used=%d):", tab_limit_get(),
+		   dect_phy_mac_ft_assoc_count_get());
 
-	for (int i = 0; i < lim; i++) {
-		if (!g_tab[i].used) {
+	/* Printing from snapshots: no lock held while printing */
+	for (int i = 0; i < DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE; i++) {
+		if (dect_phy_mac_ft_assoc_pt_info_get(i + 1, &info)) {
 			continue;
 		}
 
@@ -189,14 +508,33 @@ void dect_phy_mac_ft_assoc_status_print(void)
 			es = s->mac_sched.pt_slots[i].end_subslot;
 		}
 
-		desh_print("  PT%d long=%u short=%u rssi=%d last_seen_bb=%llu slots=%u:%u",
-			   i + 1,
-			   g_tab[i].pt_long_rd_id,
-			   g_tab[i].pt_short_rd_id,
-			   g_tab[i].last_rssi,
-			   (unsigned long long)g_tab[i].last_seen_bb,
+		desh_print("  PT%d long=%u short=%u rssi=%d (avg %d) last_seen_bb=%llu slots=%u:%u",
+			   info.pt_index,
+			   info.pt_long_rd_id,
+			   info.pt_short_rd_id,
+			   info.last_rssi,
+			   info.rssi_ewma_q4 / 16,
+			   (unsigned long long)info.last_seen_bb,
 			   ss, es);
+		desh_print("      rx %u pkts / %llu bytes, tx %u pkts / %llu bytes, "
+			   "harq ack %u nack %u",
+			   info.rx_packet_count, (unsigned long long)info.rx_byte_count,
+			   info.tx_packet_count, (unsigned long long)info.tx_byte_count,
+			   info.harq_ack_count, info.harq_nack_count);
+	}
+}
+
+static int dect_phy_mac_ft_assoc_init(void)
+{
+	for (int i = 0; i < DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE; i++) {
+		dect_phy_mac_timer_init(&g_tab[i].inactivity_timer, ft_assoc_inactivity_timer_cb);
 	}
 
+	k_spinlock_key_t key = k_spin_lock(&g_tab_lock);
+
+	tab_init_locked();
 	k_spin_unlock(&g_tab_lock, key);
+	return 0;
 }
+
+SYS_INIT(dect_phy_mac_ft_assoc_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -3,6 +3,36 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#define DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE CONFIG_DESH_DECT_PHY_MAC_FT_ASSOC_TABLE_SIZE
+
+/* PT that has not been heard for this long is released (LONG_INACTIVITY) and its slot freed.
+ * Covers a few missed PT keep alives (DECT_PHY_MAC_CLIENT_KEEP_ALIVE_INTERVAL_SEC).
+ */
+#define DECT_PHY_MAC_FT_ASSOC_INACTIVITY_TIMEOUT_SEC (35)
+
+/* Per-PT entry, including running link stats. Read through a seqlock snapshot. */
+struct dect_phy_mac_ft_assoc_pt_info {
+	bool used;
+	uint8_t pt_index; /* 1..max_pts */
+
+	uint32_t pt_long_rd_id;
+	uint16_t pt_short_rd_id;
+
+	int8_t last_rssi;
+	int16_t rssi_ewma_q4; /* dBm in Q4 fixed point, i.e. dBm * 16 */
+
+	uint64_t associated_bb;
+	uint64_t last_seen_bb;
+
+	uint32_t rx_packet_count;
+	uint64_t rx_byte_count;
+	uint32_t tx_packet_count;
+	uint64_t tx_byte_count;
+
+	uint32_t harq_ack_count;
+	uint32_t harq_nack_count;
+};
+
 /* Add/update PT entry. Returns PT index (1..max_pts) on success, negative errno on failure. */
 int dect_phy_mac_ft_assoc_add_or_update(uint32_t pt_long_rd_id,
 				       uint16_t pt_short_rd_id,
@@ -14,6 +44,20 @@ bool dect_phy_mac_ft_assoc_is_associated(uint32_t pt_long_rd_id);
 /* Get assigned PT index (1..max_pts). */
 int dect_phy_mac_ft_assoc_pt_index_get(uint32_t pt_long_rd_id, uint8_t *pt_index_out);
 
+/* Get assigned PT index (1..max_pts) and long RD ID by PT short RD ID. */
+int dect_phy_mac_ft_assoc_by_short_rd_id_get(uint16_t pt_short_rd_id, uint8_t *pt_index_out,
+					     uint32_t *pt_long_rd_id_out);
+
+/* Link stats updates for an associated PT. Return -ENOENT if PT is not associated. */
+int dect_phy_mac_ft_assoc_rx_update(uint32_t pt_long_rd_id, int8_t rssi, uint64_t t_bb,
+				    uint32_t byte_count);
+int dect_phy_mac_ft_assoc_tx_update(uint32_t pt_long_rd_id, uint32_t byte_count);
+int dect_phy_mac_ft_assoc_harq_update(uint32_t pt_long_rd_id, bool ack);
+
+/* Lock-free consistent snapshot of PT entry by PT index (1..table size). */
+int dect_phy_mac_ft_assoc_pt_info_get(uint8_t pt_index,
+				      struct dect_phy_mac_ft_assoc_pt_info *info_out);
+
 /* Remove one PT from the FT table. */
 int dect_phy_mac_ft_assoc_remove(uint32_t pt_long_rd_id);
 
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <nrf_modem_dect_phy.h>
+
+#include "desh_print.h"
+
+#include "dect_common.h"
+#include "dect_phy_common.h"
+#include "dect_common_settings.h"
+#include "dect_app_time.h"
+
+#include "dect_phy_api_scheduler.h"
+#include "dect_phy_common_rx.h"
+#include "dect_phy_ctrl.h"
+#include "dect_phy_shell.h"
+
+#include "dect_phy_mac_cluster_beacon.h"
+#include "dect_phy_mac_ft_rach_rx.h"
+
+BUILD_ASSERT((2 * DECT_PHY_MAC_FT_RACH_RX_HANDLE_COUNT) <=
+		     (DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_END -
+		      DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START + 1),
+	     "RACH RX handle blocks do not fit to the RACH RX handle range");
+BUILD_ASSERT(DECT_PHY_MAC_FT_RACH_RX_PIPELINE_DEPTH < DECT_PHY_MAC_FT_RACH_RX_HANDLE_COUNT,
+	     "Handles of the operations in modem must be unique");
+
+extern struct k_work_q dect_phy_ctrl_work_q;
+
+struct dect_phy_mac_ft_rach_rx_window {
+	uint64_t start_time;
+	uint64_t end_time;
+	uint16_t channel;
+};
+
+struct dect_phy_mac_ft_rach_rx_metrics {
+	uint32_t window_count;	      /* RA windows taken from the schedule */
+	uint32_t window_merged_count; /* ...of which merged to the previous RX op */
+	uint32_t window_missed_count; /* ...of which too late to arm */
+	uint32_t window_suspended_count;
+	uint32_t op_armed_count;
+	uint32_t op_failed_count;
+	uint64_t arm_lead_min_mdm_ticks;
+	atomic_t pdc_count;
+};
+
+static struct dect_phy_mac_ft_rach_rx_data {
+	bool running;
+	struct dect_phy_mac_ft_rach_rx_params params; /* RA resources by start subslot */
+
+	uint64_t period_mdm_ticks;
+	uint32_t frames_in_period;
+
+	/* Cursor of the next RA window */
+	uint32_t next_period_index;
+	uint32_t next_frame_index;
+	uint8_t next_ra_index;
+
+	/* Window taken from the schedule but not yet armed */
+	bool pending_window_valid;
+	struct dect_phy_mac_ft_rach_rx_window pending_window;
+
+	uint32_t handle_base;
+	uint32_t next_handle;
+	uint8_t ops_in_modem;
+
+	struct dect_phy_mac_ft_rach_rx_metrics metrics;
+
+	struct k_work_delayable arm_work;
+} rach_rx_data;
+
+K_MUTEX_DEFINE(rach_rx_mutex);
+
+/**************************************************************************************************/
+
+static bool dect_phy_mac_ft_rach_rx_handle_is_own(uint32_t handle)
+{
+	return handle >= rach_rx_data.handle_base &&
+	       handle < (rach_rx_data.handle_base + DECT_PHY_MAC_FT_RACH_RX_HANDLE_COUNT);
+}
+
+/* Next RA window in time order from the schedule of the RA resources */
+static void dect_phy_mac_ft_rach_rx_window_get(struct dect_phy_mac_ft_rach_rx_window *window_out)
+{
+	const struct dect_phy_mac_ft_rach_rx_params *params = &rach_rx_data.params;
+
+	if (rach_rx_data.pending_window_valid) {
+		*window_out = rach_rx_data.pending_window;
+		rach_rx_data.pending_window_valid = false;
+		return;
+	}
+
+	/* All resources have the beacon frame as a RA frame, i.e. found within a period */
+	while (true) {
+		for (; rach_rx_data.next_ra_index < params->ra_resource_count;
+		     rach_rx_data.next_ra_index++) {
+			const struct dect_phy_mac_beacon_ra_resource *ra =
+				&params->ra_resources[rach_rx_data.next_ra_index];
+
+			if (!dect_phy_mac_cluster_beacon_ra_in_frame(
+				    ra, rach_rx_data.next_frame_index)) {
+				continue;
+			}
+			window_out->start_time =
+				params->first_frame_time +
+				(rach_rx_data.next_period_index * rach_rx_data.period_mdm_ticks) +
+				((uint64_t)rach_rx_data.next_frame_index *
+				 DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS) +
+				(ra->start_subslot * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
+			window_out->end_time =
+				window_out->start_time +
+				(ra->length_slots * DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS);
+			window_out->channel = params->channel_get(window_out->start_time);
+
+			rach_rx_data.next_ra_index++;
+			rach_rx_data.metrics.window_count++;
+			return;
+		}
+		rach_rx_data.next_ra_index = 0;
+		rach_rx_data.next_frame_index++;
+		if (rach_rx_data.next_frame_index >= rach_rx_data.frames_in_period) {
+			rach_rx_data.next_frame_index = 0;
+			rach_rx_data.next_period_index++;
+		}
+	}
+}
+
+static void
+dect_phy_mac_ft_rach_rx_window_unget(const struct dect_phy_mac_ft_rach_rx_window *window)
+{
+	rach_rx_data.pending_window = *window;
+	rach_rx_data.pending_window_valid = true;
+}
+
+/* Start of our 1st beacon TX after the given time */
+static uint64_t dect_phy_mac_ft_rach_rx_next_beacon_tx_get(uint64_t time)
+{
+	uint64_t first_frame_time = rach_rx_data.params.first_frame_time;
+
+	if (time < first_frame_time) {
+		return first_frame_time;
+	}
+	return first_frame_time +
+	       (((time - first_frame_time) / rach_rx_data.period_mdm_ticks) + 1) *
+		       rach_rx_data.period_mdm_ticks;
+}
+
+static int dect_phy_mac_ft_rach_rx_op_arm(const struct dect_phy_mac_ft_rach_rx_window *window)
+{
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	struct nrf_modem_dect_phy_rx_params rx_op = {
+		.rssi_interval = NRF_MODEM_DECT_PHY_RSSI_INTERVAL_OFF,
+		.link_id = NRF_MODEM_DECT_PHY_LINK_UNSPECIFIED,
+		.mode = NRF_MODEM_DECT_PHY_RX_MODE_CONTINUOUS,
+		.network_id = rach_rx_data.params.network_id,
+		.rssi_level = rach_rx_data.params.expected_rssi_level,
+		.carrier = window->channel,
+		.start_time = window->start_time,
+		.duration = window->end_time - window->start_time,
+		.handle = rach_rx_data.next_handle,
+	};
+	int ret;
+
+	/* Only receive the ones destinated to this beacon: */
+	rx_op.filter.is_short_network_id_used = true;
+	rx_op.filter.short_network_id = (uint8_t)(current_settings->common.network_id & 0xFF);
+	rx_op.filter.receiver_identity = rach_rx_data.params.receiver_identity;
+
+	ret = dect_phy_common_rx_op(&rx_op);
+	if (ret) {
+		return ret;
+	}
+	rach_rx_data.next_handle++;
+	if (!dect_phy_mac_ft_rach_rx_handle_is_own(rach_rx_data.next_handle)) {
+		rach_rx_data.next_handle = rach_rx_data.handle_base;
+	}
+	return 0;
+}
+
+static void dect_phy_mac_ft_rach_rx_arm_worker(struct k_work *work_item)
+{
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	struct dect_phy_mac_ft_rach_rx_window window, next_window;
+	uint64_t merge_gap_mdm_ticks = dect_phy_ctrl_modem_latency_min_margin_between_ops_get();
+	uint64_t lead_mdm_ticks =
+		dect_phy_ctrl_modem_latency_for_next_op_get(false) +
+		US_TO_MODEM_TICKS(current_settings->scheduler.scheduling_delay_us);
+	uint64_t arm_ahead_mdm_ticks =
+		lead_mdm_ticks + MS_TO_MODEM_TICKS((uint64_t)DECT_PHY_MAC_FT_RACH_RX_ARM_AHEAD_MS);
+	uint64_t merge_end_max, time_now;
+
+	k_mutex_lock(&rach_rx_mutex, K_FOREVER);
+	while (rach_rx_data.running &&
+	       rach_rx_data.ops_in_modem < DECT_PHY_MAC_FT_RACH_RX_PIPELINE_DEPTH) {
+		time_now = dect_app_modem_time_now();
+		dect_phy_mac_ft_rach_rx_window_get(&window);
+
+		if (window.start_time < (time_now + lead_mdm_ticks)) {
+			rach_rx_data.metrics.window_missed_count++;
+			continue;
+		}
+		if ((window.start_time - time_now) > arm_ahead_mdm_ticks) {
+			/* Not yet, come back when it is time to arm */
+			dect_phy_mac_ft_rach_rx_window_unget(&window);
+			k_work_reschedule_for_queue(
+				&dect_phy_ctrl_work_q, &rach_rx_data.arm_work,
+				K_MSEC((uint32_t)MODEM_TICKS_TO_MS(window.start_time - time_now -
+								   arm_ahead_mdm_ticks)));
+			break;
+		}
+		if (dect_phy_api_scheduler_is_suspended()) {
+			rach_rx_data.metrics.window_suspended_count++;
+			continue;
+		}
+
+		/* Chain: RX kept on over gaps that are too short for separate operations, but
+		 * for a limited time and not over our next beacon TX.
+		 */
+		merge_end_max = dect_phy_mac_ft_rach_rx_next_beacon_tx_get(window.start_time) -
+				DECT_PHY_TX_RX_SCHEDULING_OFFSET_MDM_TICKS;
+		merge_end_max = MIN(merge_end_max,
+				    window.start_time +
+					    MS_TO_MODEM_TICKS(
+						    (uint64_t)DECT_PHY_MAC_FT_RACH_RX_MERGED_MAX_MS));
+		while (true) {
+			dect_phy_mac_ft_rach_rx_window_get(&next_window);
+			if (next_window.channel != window.channel ||
+			    next_window.start_time > (window.end_time + merge_gap_mdm_ticks) ||
+			    next_window.end_time > merge_end_max) {
+				dect_phy_mac_ft_rach_rx_window_unget(&next_window);
+				break;
+			}
+			window.end_time = MAX(window.end_time, next_window.end_time);
+			rach_rx_data.metrics.window_merged_count++;
+		}
+
+		if (dect_phy_mac_ft_rach_rx_op_arm(&window)) {
+			rach_rx_data.metrics.op_failed_count++;
+			continue;
+		}
+		rach_rx_data.ops_in_modem++;
+		rach_rx_data.metrics.op_armed_count++;
+		rach_rx_data.metrics.arm_lead_min_mdm_ticks =
+			MIN(rach_rx_data.metrics.arm_lead_min_mdm_ticks,
+			    window.start_time - time_now);
+	}
+	k_mutex_unlock(&rach_rx_mutex);
+}
+
+/**************************************************************************************************/
+
+int dect_phy_mac_ft_rach_rx_start(const struct dect_phy_mac_ft_rach_rx_params *params)
+{
+	struct dect_phy_mac_ft_rach_rx_params *own_params;
+
+	if (params->ra_resource_count == 0 ||
+	    params->ra_resource_count > DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT ||
+	    params->period_ms < DECT_RADIO_FRAME_DURATION_MS || params->channel_get == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&rach_rx_mutex, K_FOREVER);
+	if (rach_rx_data.running) {
+		k_mutex_unlock(&rach_rx_mutex);
+		return -EALREADY;
+	}
+	own_params = &rach_rx_data.params;
+	*own_params = *params;
+
+	/* Windows within a frame in time order */
+	for (int i = 1; i < own_params->ra_resource_count; i++) {
+		struct dect_phy_mac_beacon_ra_resource ra = own_params->ra_resources[i];
+		int j = i - 1;
+
+		while (j >= 0 && own_params->ra_resources[j].start_subslot > ra.start_subslot) {
+			own_params->ra_resources[j + 1] = own_params->ra_resources[j];
+			j--;
+		}
+		own_params->ra_resources[j + 1] = ra;
+	}
+
+	rach_rx_data.period_mdm_ticks = MS_TO_MODEM_TICKS((uint64_t)params->period_ms);
+	rach_rx_data.frames_in_period = params->period_ms / DECT_RADIO_FRAME_DURATION_MS;
+	rach_rx_data.next_period_index = 0;
+	rach_rx_data.next_frame_index = 0;
+	rach_rx_data.next_ra_index = 0;
+	rach_rx_data.pending_window_valid = false;
+	rach_rx_data.ops_in_modem = 0;
+
+	rach_rx_data.handle_base =
+		(rach_rx_data.handle_base == DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START)
+			? (DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START +
+			   DECT_PHY_MAC_FT_RACH_RX_HANDLE_COUNT)
+			: DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START;
+	rach_rx_data.next_handle = rach_rx_data.handle_base;
+
+	memset(&rach_rx_data.metrics, 0, sizeof(rach_rx_data.metrics));
+	rach_rx_data.metrics.arm_lead_min_mdm_ticks = UINT64_MAX;
+
+	rach_rx_data.running = true;
+	k_mutex_unlock(&rach_rx_mutex);
+
+	k_work_reschedule_for_queue(&dect_phy_ctrl_work_q, &rach_rx_data.arm_work, K_NO_WAIT);
+
+	return 0;
+}
+
+void dect_phy_mac_ft_rach_rx_stop(void)
+{
+	k_mutex_lock(&rach_rx_mutex, K_FOREVER);
+	if (!rach_rx_data.running) {
+		k_mutex_unlock(&rach_rx_mutex);
+		return;
+	}
+	rach_rx_data.running = false;
+	(void)k_work_cancel_delayable(&rach_rx_data.arm_work);
+
+	for (int i = 0; i < DECT_PHY_MAC_FT_RACH_RX_HANDLE_COUNT; i++) {
+		(void)nrf_modem_dect_phy_cancel(rach_rx_data.handle_base + i);
+	}
+	k_mutex_unlock(&rach_rx_mutex);
+}
+
+void dect_phy_mac_ft_rach_rx_op_completed(struct dect_phy_common_op_completed_params *params)
+{
+	k_mutex_lock(&rach_rx_mutex, K_FOREVER);
+	if (!rach_rx_data.running || !dect_phy_mac_ft_rach_rx_handle_is_own(params->handle)) {
+		/* From a stopped one */
+		k_mutex_unlock(&rach_rx_mutex);
+		return;
+	}
+	if (rach_rx_data.ops_in_modem > 0) {
+		rach_rx_data.ops_in_modem--;
+	}
+	if (params->status != NRF_MODEM_DECT_PHY_SUCCESS) {
+		rach_rx_data.metrics.op_failed_count++;
+	}
+	k_mutex_unlock(&rach_rx_mutex);
+
+	/* Refill the pipeline */
+	k_work_reschedule_for_queue(&dect_phy_ctrl_work_q, &rach_rx_data.arm_work, K_NO_WAIT);
+}
+
+void dect_phy_mac_ft_rach_rx_pdc_received(uint32_t handle)
+{
+	if (rach_rx_data.running && dect_phy_mac_ft_rach_rx_handle_is_own(handle)) {
+		atomic_inc(&rach_rx_data.metrics.pdc_count);
+	}
+}
+
+void dect_phy_mac_ft_rach_rx_status_print(void)
+{
+	struct dect_phy_mac_ft_rach_rx_metrics metrics;
+	uint32_t not_received_count;
+	bool running;
+
+	k_mutex_lock(&rach_rx_mutex, K_FOREVER);
+	metrics = rach_rx_data.metrics;
+	running = rach_rx_data.running;
+	k_mutex_unlock(&rach_rx_mutex);
+
+	desh_print("  RACH RX:");
+	desh_print("    Running:                     %s", running ? "yes" : "no");
+	if (!running) {
+		return;
+	}
+	not_received_count = metrics.window_missed_count + metrics.window_suspended_count;
+	desh_print("    RA windows:                  %u", metrics.window_count);
+	desh_print("      merged to a previous op:   %u", metrics.window_merged_count);
+	desh_print("      missed, too late to arm:   %u", metrics.window_missed_count);
+	desh_print("      skipped, suspended:        %u", metrics.window_suspended_count);
+	if (metrics.window_count) {
+		desh_print("      not received:              %u.%02u%%",
+			   (not_received_count * 100) / metrics.window_count,
+			   ((not_received_count * 10000) / metrics.window_count) % 100);
+	}
+	desh_print("    RX ops armed:                %u", metrics.op_armed_count);
+	desh_print("    RX ops failed:               %u", metrics.op_failed_count);
+	if (metrics.op_armed_count) {
+		desh_print("    Min arm lead:                %llu us",
+			   (metrics.arm_lead_min_mdm_ticks * 1000) /
+				   NRF_MODEM_DECT_MODEM_TIME_TICK_RATE_KHZ);
+	}
+	desh_print("    PDCs received:               %ld", (long)atomic_get(&metrics.pdc_count));
+}
+
+static int dect_phy_mac_ft_rach_rx_init(void)
+{
+	memset(&rach_rx_data, 0, sizeof(rach_rx_data));
+	k_work_init_delayable(&rach_rx_data.arm_work, dect_phy_mac_ft_rach_rx_arm_worker);
+
+	return 0;
+}
+
+SYS_INIT(dect_phy_mac_ft_rach_rx_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
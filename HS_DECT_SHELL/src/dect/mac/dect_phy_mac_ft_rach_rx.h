@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DECT_PHY_MAC_FT_RACH_RX_H
+#define DECT_PHY_MAC_FT_RACH_RX_H
+
+#include <zephyr/kernel.h>
+
+#include "dect_phy_common.h"
+#include "dect_phy_mac_common.h"
+
+/* FT RACH RX engine: receives on all announced random access resources of the cluster beacon
+ * with RX operations given directly to modem, i.e. not through the scheduler list.
+ * Operations are chained back to back (windows closer than the minimum modem gap between
+ * operations are merged into one) and each is armed once its start is within modem latency
+ * and scheduling delay plus DECT_PHY_MAC_FT_RACH_RX_ARM_AHEAD_MS.
+ */
+
+/* Max RX operations given to modem at a time */
+#define DECT_PHY_MAC_FT_RACH_RX_PIPELINE_DEPTH 4
+
+/* Handles are rotated within a block of these from DECT_PHY_MAC_BEACON_RX_RACH_HANDLE_START.
+ * Two blocks are used in turns for consecutive starts so that late completions of a stopped
+ * engine are not mixed with the new ones.
+ */
+#define DECT_PHY_MAC_FT_RACH_RX_HANDLE_COUNT 8
+
+#define DECT_PHY_MAC_FT_RACH_RX_ARM_AHEAD_MS 20
+
+/* Max duration of an RX operation of merged windows. Merging also stops before our next
+ * beacon TX.
+ */
+#define DECT_PHY_MAC_FT_RACH_RX_MERGED_MAX_MS 40
+
+/* Channel of the cell at a given modem time */
+typedef uint16_t (*dect_phy_mac_ft_rach_rx_channel_get_cb_t)(uint64_t time);
+
+struct dect_phy_mac_ft_rach_rx_params {
+	uint64_t first_frame_time; /* Frame of the 1st beacon */
+	uint32_t period_ms;
+
+	uint8_t ra_resource_count;
+	struct dect_phy_mac_beacon_ra_resource
+		ra_resources[DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT];
+
+	uint32_t network_id;
+	uint16_t receiver_identity; /* Own short RD ID */
+	int32_t expected_rssi_level;
+
+	dect_phy_mac_ft_rach_rx_channel_get_cb_t channel_get;
+};
+
+int dect_phy_mac_ft_rach_rx_start(const struct dect_phy_mac_ft_rach_rx_params *params);
+void dect_phy_mac_ft_rach_rx_stop(void);
+
+/* From modem operation completion for handles in the RACH RX range */
+void dect_phy_mac_ft_rach_rx_op_completed(struct dect_phy_common_op_completed_params *params);
+
+/* From a received PDC on a RACH RX handle, called in modem callback context */
+void dect_phy_mac_ft_rach_rx_pdc_received(uint32_t handle);
+
+void dect_phy_mac_ft_rach_rx_status_print(void);
+
+#endif /* DECT_PHY_MAC_FT_RACH_RX_H */
@@ -19,55 +19,290 @@
 #include "dect_phy_mac_nbr_bg_scan.h"
 #include "dect_phy_mac_nbr.h"
 
-struct dect_phy_mac_nbr_info_list_item nbrs[DECT_PHY_MAC_MAX_NEIGBORS] = {0};
+BUILD_ASSERT(DECT_PHY_MAC_NBR_TABLE_SIZE < UINT16_MAX, "Neighbor table index is 16bit");
+
+#define DECT_PHY_MAC_NBR_IDX_NONE UINT16_MAX
+
+#define DECT_PHY_MAC_NBR_HASH_BUCKET_COUNT    DECT_PHY_MAC_NBR_TABLE_SIZE
+#define DECT_PHY_MAC_NBR_CHANNEL_BUCKET_COUNT 16
+
+/* How many of the least recently heard neighbors are compared by RSSI when evicting */
+#define DECT_PHY_MAC_NBR_EVICTION_CANDIDATE_COUNT 4
+
+/* Table entries are never moved: item pointers given out stay in place. All the indexes
+ * are intrusive 16bit links:
+ *  - hash_next: chain of the long RD ID hash bucket, or free list when not reserved
+ *  - ch_prev/ch_next: chain of the channel bucket
+ *  - lru_prev/lru_next: LRU list, head is the most recently heard
+ */
+struct dect_phy_mac_nbr_table_entry {
+	struct dect_phy_mac_nbr_info_list_item info;
+
+	bool pinned;
+
+	uint16_t hash_next;
+	uint16_t ch_prev;
+	uint16_t ch_next;
+	uint16_t lru_prev;
+	uint16_t lru_next;
+};
+
+static struct dect_phy_mac_nbr_table {
+	struct dect_phy_mac_nbr_table_entry entries[DECT_PHY_MAC_NBR_TABLE_SIZE];
+
+	uint16_t hash_heads[DECT_PHY_MAC_NBR_HASH_BUCKET_COUNT];
+	uint16_t ch_heads[DECT_PHY_MAC_NBR_CHANNEL_BUCKET_COUNT];
+
+	uint16_t lru_head;
+	uint16_t lru_tail;
+	uint16_t free_head;
+	uint16_t count;
+
+	uint32_t evicted_count;
+	uint32_t aged_out_count;
+	uint32_t dropped_count;
+} nbr_table;
 
 K_MUTEX_DEFINE(nbr_list_mutex);
 
+/**************************************************************************************************/
+
+static inline uint16_t dect_phy_mac_nbr_hash(uint32_t long_rd_id)
+{
+	/* Knuth multiplicative hash: RD IDs are often sequential */
+	return ((long_rd_id * 2654435761U) >> 16) % DECT_PHY_MAC_NBR_HASH_BUCKET_COUNT;
+}
+
+static inline uint16_t dect_phy_mac_nbr_ch_bucket(uint16_t channel)
+{
+	return channel % DECT_PHY_MAC_NBR_CHANNEL_BUCKET_COUNT;
+}
+
+static void dect_phy_mac_nbr_table_init(void)
+{
+	for (int i = 0; i < DECT_PHY_MAC_NBR_HASH_BUCKET_COUNT; i++) {
+		nbr_table.hash_heads[i] = DECT_PHY_MAC_NBR_IDX_NONE;
+	}
+	for (int i = 0; i < DECT_PHY_MAC_NBR_CHANNEL_BUCKET_COUNT; i++) {
+		nbr_table.ch_heads[i] = DECT_PHY_MAC_NBR_IDX_NONE;
+	}
+	for (int i = 0; i < DECT_PHY_MAC_NBR_TABLE_SIZE; i++) {
+		memset(&nbr_table.entries[i], 0, sizeof(struct dect_phy_mac_nbr_table_entry));
+		nbr_table.entries[i].hash_next =
+			(i + 1 < DECT_PHY_MAC_NBR_TABLE_SIZE) ? i + 1 : DECT_PHY_MAC_NBR_IDX_NONE;
+	}
+	nbr_table.free_head = 0;
+	nbr_table.lru_head = DECT_PHY_MAC_NBR_IDX_NONE;
+	nbr_table.lru_tail = DECT_PHY_MAC_NBR_IDX_NONE;
+	nbr_table.count = 0;
+}
+
+static uint16_t dect_phy_mac_nbr_find(uint32_t long_rd_id)
+{
+	uint16_t idx = nbr_table.hash_heads[dect_phy_mac_nbr_hash(long_rd_id)];
+
+	while (idx != DECT_PHY_MAC_NBR_IDX_NONE) {
+		if (nbr_table.entries[idx].info.long_rd_id == long_rd_id) {
+			return idx;
+		}
+		idx = nbr_table.entries[idx].hash_next;
+	}
+	return DECT_PHY_MAC_NBR_IDX_NONE;
+}
+
+static void dect_phy_mac_nbr_hash_unlink(uint16_t idx)
+{
+	uint16_t *link = &nbr_table.hash_heads[
+		dect_phy_mac_nbr_hash(nbr_table.entries[idx].info.long_rd_id)];
+
+	while (*link != DECT_PHY_MAC_NBR_IDX_NONE) {
+		if (*link == idx) {
+			*link = nbr_table.entries[idx].hash_next;
+			return;
+		}
+		link = &nbr_table.entries[*link].hash_next;
+	}
+}
+
+static void dect_phy_mac_nbr_ch_link(uint16_t idx)
+{
+	struct dect_phy_mac_nbr_table_entry *entry = &nbr_table.entries[idx];
+	uint16_t *head = &nbr_table.ch_heads[dect_phy_mac_nbr_ch_bucket(entry->info.channel)];
+
+	entry->ch_prev = DECT_PHY_MAC_NBR_IDX_NONE;
+	entry->ch_next = *head;
+	if (*head != DECT_PHY_MAC_NBR_IDX_NONE) {
+		nbr_table.entries[*head].ch_prev = idx;
+	}
+	*head = idx;
+}
+
+static void dect_phy_mac_nbr_ch_unlink(uint16_t idx)
+{
+	struct dect_phy_mac_nbr_table_entry *entry = &nbr_table.entries[idx];
+
+	if (entry->ch_prev != DECT_PHY_MAC_NBR_IDX_NONE) {
+		nbr_table.entries[entry->ch_prev].ch_next = entry->ch_next;
+	} else {
+		nbr_table.ch_heads[dect_phy_mac_nbr_ch_bucket(entry->info.channel)] =
+			entry->ch_next;
+	}
+	if (entry->ch_next != DECT_PHY_MAC_NBR_IDX_NONE) {
+		nbr_table.entries[entry->ch_next].ch_prev = entry->ch_prev;
+	}
+}
+
+static void dect_phy_mac_nbr_lru_push_front(uint16_t idx)
+{
+	struct dect_phy_mac_nbr_table_entry *entry = &nbr_table.entries[idx];
+
+	entry->lru_prev = DECT_PHY_MAC_NBR_IDX_NONE;
+	entry->lru_next = nbr_table.lru_head;
+	if (nbr_table.lru_head != DECT_PHY_MAC_NBR_IDX_NONE) {
+		nbr_table.entries[nbr_table.lru_head].lru_prev = idx;
+	} else {
+		nbr_table.lru_tail = idx;
+	}
+	nbr_table.lru_head = idx;
+}
+
+static void dect_phy_mac_nbr_lru_unlink(uint16_t idx)
+{
+	struct dect_phy_mac_nbr_table_entry *entry = &nbr_table.entries[idx];
+
+	if (entry->lru_prev != DECT_PHY_MAC_NBR_IDX_NONE) {
+		nbr_table.entries[entry->lru_prev].lru_next = entry->lru_next;
+	} else {
+		nbr_table.lru_head = entry->lru_next;
+	}
+	if (entry->lru_next != DECT_PHY_MAC_NBR_IDX_NONE) {
+		nbr_table.entries[entry->lru_next].lru_prev = entry->lru_prev;
+	} else {
+		nbr_table.lru_tail = entry->lru_prev;
+	}
+}
+
+static void dect_phy_mac_nbr_entry_remove(uint16_t idx)
+{
+	struct dect_phy_mac_nbr_table_entry *entry = &nbr_table.entries[idx];
+
+	dect_phy_mac_nbr_hash_unlink(idx);
+	dect_phy_mac_nbr_ch_unlink(idx);
+	dect_phy_mac_nbr_lru_unlink(idx);
+
+	entry->info.reserved = false;
+	entry->pinned = false;
+	entry->hash_next = nbr_table.free_head;
+	nbr_table.free_head = idx;
+	nbr_table.count--;
+}
+
+static uint16_t dect_phy_mac_nbr_entry_alloc(void)
+{
+	uint16_t idx = nbr_table.free_head;
+
+	if (idx != DECT_PHY_MAC_NBR_IDX_NONE) {
+		nbr_table.free_head = nbr_table.entries[idx].hash_next;
+	}
+	return idx;
+}
+
+static bool dect_phy_mac_nbr_is_stale(struct dect_phy_mac_nbr_table_entry *entry,
+				      uint64_t time_now)
+{
+	return (time_now > entry->info.time_rcvd_mdm_ticks &&
+		(time_now - entry->info.time_rcvd_mdm_ticks) >
+			MS_TO_MODEM_TICKS((uint64_t)DECT_PHY_MAC_NBR_STALE_TIME_MS));
+}
+
+/* LRU is in the order of reception, i.e. only the stale tail needs to be walked. */
+static void dect_phy_mac_nbr_aging_run(uint64_t time_now)
+{
+	uint16_t idx = nbr_table.lru_tail;
+
+	while (idx != DECT_PHY_MAC_NBR_IDX_NONE &&
+	       dect_phy_mac_nbr_is_stale(&nbr_table.entries[idx], time_now)) {
+		uint16_t prev_idx = nbr_table.entries[idx].lru_prev;
+
+		if (!nbr_table.entries[idx].pinned) {
+			dect_phy_mac_nbr_entry_remove(idx);
+			nbr_table.aged_out_count++;
+		}
+		idx = prev_idx;
+	}
+}
+
+/* Evict the weakest of the least recently heard non-pinned neighbors */
+static bool dect_phy_mac_nbr_evict(void)
+{
+	uint16_t idx = nbr_table.lru_tail;
+	uint16_t victim_idx = DECT_PHY_MAC_NBR_IDX_NONE;
+	int candidates = 0;
+
+	while (idx != DECT_PHY_MAC_NBR_IDX_NONE &&
+	       candidates < DECT_PHY_MAC_NBR_EVICTION_CANDIDATE_COUNT) {
+		struct dect_phy_mac_nbr_table_entry *entry = &nbr_table.entries[idx];
+
+		if (!entry->pinned) {
+			if (victim_idx == DECT_PHY_MAC_NBR_IDX_NONE ||
+			    entry->info.rssi_dbm < nbr_table.entries[victim_idx].info.rssi_dbm) {
+				victim_idx = idx;
+			}
+			candidates++;
+		}
+		idx = entry->lru_prev;
+	}
+	if (victim_idx == DECT_PHY_MAC_NBR_IDX_NONE) {
+		return false;
+	}
+	dect_phy_mac_nbr_entry_remove(victim_idx);
+	nbr_table.evicted_count++;
+
+	return true;
+}
+
+/**************************************************************************************************/
+
 struct dect_phy_mac_nbr_info_list_item *dect_phy_mac_nbr_info_get_by_long_rd_id(uint32_t long_rd_id)
 {
 	struct dect_phy_mac_nbr_info_list_item *found_nbr = NULL;
+	uint16_t idx;
 
 	k_mutex_lock(&nbr_list_mutex, K_FOREVER);
-	for (int i = 0; i < DECT_PHY_MAC_MAX_NEIGBORS; i++) {
-		if (nbrs[i].reserved && nbrs[i].long_rd_id == long_rd_id) {
-			found_nbr = &nbrs[i];
-			goto exit;
-		}
+	idx = dect_phy_mac_nbr_find(long_rd_id);
+	if (idx != DECT_PHY_MAC_NBR_IDX_NONE) {
+		found_nbr = &nbr_table.entries[idx].info;
 	}
-exit:
 	k_mutex_unlock(&nbr_list_mutex);
 	return found_nbr;
 }
 
-static bool dect_phy_mac_nbr_info_store(struct dect_phy_mac_nbr_info_list_item list_item)
+bool dect_phy_mac_nbr_info_copy_by_long_rd_id(uint32_t long_rd_id,
+					      struct dect_phy_mac_nbr_info_list_item *nbr_out)
 {
-	bool stored = false;
+	bool found = false;
+	uint16_t idx;
 
 	k_mutex_lock(&nbr_list_mutex, K_FOREVER);
-	for (int i = 0; i < DECT_PHY_MAC_MAX_NEIGBORS; i++) {
-		if (!nbrs[i].reserved) {
-			nbrs[i] = list_item;
-			nbrs[i].reserved = true;
-			stored = true;
-			goto exit;
-		}
+	idx = dect_phy_mac_nbr_find(long_rd_id);
+	if (idx != DECT_PHY_MAC_NBR_IDX_NONE) {
+		*nbr_out = nbr_table.entries[idx].info;
+		found = true;
 	}
-exit:
 	k_mutex_unlock(&nbr_list_mutex);
-	return stored;
+	return found;
 }
 
 bool dect_phy_mac_nbr_info_remove_by_long_rd_id(uint32_t long_rd_id)
 {
 	bool removed = false;
+	uint16_t idx;
 
 	k_mutex_lock(&nbr_list_mutex, K_FOREVER);
-	for (int i = 0; i < DECT_PHY_MAC_MAX_NEIGBORS; i++) {
-		if (nbrs[i].long_rd_id == long_rd_id) {
-			nbrs[i].reserved = false;
-			removed = true;
-			break;
-		}
+	idx = dect_phy_mac_nbr_find(long_rd_id);
+	if (idx != DECT_PHY_MAC_NBR_IDX_NONE) {
+		dect_phy_mac_nbr_entry_remove(idx);
+		removed = true;
 	}
 	k_mutex_unlock(&nbr_list_mutex);
 	return removed;
@@ -75,26 +310,81 @@ bool dect_phy_mac_nbr_info_remove_by_long_rd_id(uint32_t long_rd_id)
 
 void dect_phy_mac_nbr_info_clear_all(void)
 {
+	uint16_t idx;
+
 	k_mutex_lock(&nbr_list_mutex, K_FOREVER);
-	memset(nbrs, 0, DECT_PHY_MAC_MAX_NEIGBORS * sizeof(struct dect_phy_mac_nbr_info_list_item));
+
+	/* Pinned ones are in use by associations: keep them */
+	idx = nbr_table.lru_head;
+	while (idx != DECT_PHY_MAC_NBR_IDX_NONE) {
+		uint16_t next_idx = nbr_table.entries[idx].lru_next;
+
+		if (!nbr_table.entries[idx].pinned) {
+			dect_phy_mac_nbr_entry_remove(idx);
+		}
+		idx = next_idx;
+	}
+	nbr_table.evicted_count = 0;
+	nbr_table.aged_out_count = 0;
+	nbr_table.dropped_count = 0;
 	k_mutex_unlock(&nbr_list_mutex);
 }
 
+int dect_phy_mac_nbr_info_pin_set(uint32_t long_rd_id, bool pinned)
+{
+	int ret = 0;
+	uint16_t idx;
+
+	k_mutex_lock(&nbr_list_mutex, K_FOREVER);
+	idx = dect_phy_mac_nbr_find(long_rd_id);
+	if (idx == DECT_PHY_MAC_NBR_IDX_NONE) {
+		ret = -ENOENT;
+	} else {
+		ret = nbr_table.entries[idx].pinned ? 1 : 0;
+		nbr_table.entries[idx].pinned = pinned;
+	}
+	k_mutex_unlock(&nbr_list_mutex);
+	return ret;
+}
+
 bool dect_phy_mac_nbr_info_store_n_update(uint64_t const *rcv_time, uint16_t channel,
 					  uint32_t nw_id_24msb, uint8_t nw_id_8lsb,
 					  uint32_t long_rd_id, uint16_t short_rd_id,
 					  dect_phy_mac_cluster_beacon_t *beacon_msg,
 					  dect_phy_mac_random_access_resource_ie_t *ra_ie,
-					  bool print_update)
+					  int16_t rssi_dbm, bool print_update)
 {
 	bool done = true;
 	struct dect_phy_mac_nbr_info_list_item *nbr_ptr;
+	uint16_t idx;
 
-	nbr_ptr = dect_phy_mac_nbr_info_get_by_long_rd_id(long_rd_id);
+	/* Background scan is updated only after nbr_list_mutex has been released */
+	bool bg_scan_update = false;
+	int64_t time_shift_mdm_ticks = 0;
+	bool next_channel_update = false;
+	uint16_t next_channel = 0;
 
-	if (!nbr_ptr) {
-		/* Insert as a new one if there is room */
-		struct dect_phy_mac_nbr_info_list_item nbr_info = {
+	k_mutex_lock(&nbr_list_mutex, K_FOREVER);
+
+	idx = dect_phy_mac_nbr_find(long_rd_id);
+	if (idx == DECT_PHY_MAC_NBR_IDX_NONE) {
+		/* Insert as a new one: make room by aging and, if still full, by evicting */
+		dect_phy_mac_nbr_aging_run(*rcv_time);
+
+		idx = dect_phy_mac_nbr_entry_alloc();
+		if (idx == DECT_PHY_MAC_NBR_IDX_NONE && dect_phy_mac_nbr_evict()) {
+			idx = dect_phy_mac_nbr_entry_alloc();
+		}
+		if (idx == DECT_PHY_MAC_NBR_IDX_NONE) {
+			nbr_table.dropped_count++;
+			desh_error("%s: cannot store scanning nbr result for long rd id %u",
+				   (__func__), long_rd_id);
+			done = false;
+			goto exit;
+		}
+		nbr_ptr = &nbr_table.entries[idx].info;
+		*nbr_ptr = (struct dect_phy_mac_nbr_info_list_item){
+			.reserved = true,
 			.channel = channel,
 			.time_rcvd_mdm_ticks = *rcv_time,
 			.long_rd_id = long_rd_id,
@@ -105,27 +395,35 @@ bool dect_phy_mac_nbr_info_store_n_update(uint64_t const *rcv_time, uint16_t cha
 			.beacon_msg = *beacon_msg,
 			.ra_ie = *ra_ie,
 			.time_rcvd_shift_mdm_ticks = 0,
+			.rssi_dbm = rssi_dbm,
 		};
+		nbr_table.entries[idx].pinned = false;
 
-		if (!dect_phy_mac_nbr_info_store(nbr_info)) {
-			desh_error("%s: cannot store scanning nbr result for long rd id %u",
-				   (__func__), long_rd_id);
-			done = false;
-		} else {
-			desh_print("Neighbor with long rd id %u (0x%08x), short rd id %u (0x%04x), "
-				   "channel %d, stored to nbr list.",
-				   long_rd_id, long_rd_id, short_rd_id, short_rd_id, channel);
-		}
+		uint16_t bucket = dect_phy_mac_nbr_hash(long_rd_id);
+
+		nbr_table.entries[idx].hash_next = nbr_table.hash_heads[bucket];
+		nbr_table.hash_heads[bucket] = idx;
+		dect_phy_mac_nbr_ch_link(idx);
+		dect_phy_mac_nbr_lru_push_front(idx);
+		nbr_table.count++;
+
+		desh_print("Neighbor with long rd id %u (0x%08x), short rd id %u (0x%04x), "
+			   "channel %d, stored to nbr list.",
+			   long_rd_id, long_rd_id, short_rd_id, short_rd_id, channel);
 	} else {
 		/* Already existing beacon: update */
-		int64_t time_shift_mdm_ticks =
+		nbr_ptr = &nbr_table.entries[idx].info;
+
+		time_shift_mdm_ticks =
 			dect_phy_mac_cluster_beacon_rcv_time_shift_calculate(
 				nbr_ptr->beacon_msg.cluster_beacon_period,
 				nbr_ptr->time_rcvd_mdm_ticks,
 				*rcv_time);
 
-		if (channel) {
+		if (channel && channel != nbr_ptr->channel) {
+			dect_phy_mac_nbr_ch_unlink(idx);
 			nbr_ptr->channel = channel;
+			dect_phy_mac_nbr_ch_link(idx);
 		}
 		nbr_ptr->short_rd_id = short_rd_id;
 		nbr_ptr->nw_id_24msb = nw_id_24msb;
@@ -133,10 +431,18 @@ bool dect_phy_mac_nbr_info_store_n_update(uint64_t const *rcv_time, uint16_t cha
 		nbr_ptr->nw_id_32bit = ((nw_id_24msb << 8) | nw_id_8lsb);
 		nbr_ptr->time_rcvd_mdm_ticks = *rcv_time;
 		nbr_ptr->time_rcvd_shift_mdm_ticks = time_shift_mdm_ticks;
-		dect_phy_mac_nbr_bg_scan_rcv_time_shift_update(
-			long_rd_id, *rcv_time, time_shift_mdm_ticks);
+		nbr_ptr->rssi_dbm = rssi_dbm;
 		nbr_ptr->beacon_msg = *beacon_msg;
 		nbr_ptr->ra_ie = *ra_ie; /* Note: storing only one RA IE */
+		bg_scan_update = true;
+		if (beacon_msg->next_channel_bit) {
+			/* Hopping cell: follow to the announced channel */
+			next_channel_update = true;
+			next_channel = beacon_msg->next_cluster_channel;
+		}
+
+		dect_phy_mac_nbr_lru_unlink(idx);
+		dect_phy_mac_nbr_lru_push_front(idx);
 
 		if (print_update) {
 			desh_print("Neighbor with long rd id %u (0x%08x), short rd id %u (0x%04x), "
@@ -147,36 +453,63 @@ bool dect_phy_mac_nbr_info_store_n_update(uint64_t const *rcv_time, uint16_t cha
 				nbr_ptr->time_rcvd_mdm_ticks, time_shift_mdm_ticks);
 		}
 	}
+exit:
 	k_mutex_unlock(&nbr_list_mutex);
+
+	if (bg_scan_update) {
+		dect_phy_mac_nbr_bg_scan_rcv_time_shift_update(long_rd_id, *rcv_time,
+							       time_shift_mdm_ticks);
+		if (next_channel_update) {
+			dect_phy_mac_nbr_bg_scan_next_channel_update(long_rd_id, next_channel);
+		}
+	}
 	return done;
 }
 
 void dect_phy_mac_nbr_status_print(void)
 {
 	uint64_t time_now = dect_app_modem_time_now();
+	uint16_t idx;
+	int i = 0;
 
 	k_mutex_lock(&nbr_list_mutex, K_FOREVER);
+	dect_phy_mac_nbr_aging_run(time_now);
+
 	desh_print("Neighbor list status:");
-	for (int i = 0; i < DECT_PHY_MAC_MAX_NEIGBORS; i++) {
-		if (nbrs[i].reserved == true) {
-			int64_t time_from_last_received_ms = MODEM_TICKS_TO_MS(
-					time_now - nbrs[i].time_rcvd_mdm_ticks);
-
-			desh_print("  Neighbor %d:", i + 1);
-			desh_print("   network ID (24bit MSB): %u (0x%06x)", nbrs[i].nw_id_24msb,
-				   nbrs[i].nw_id_24msb);
-			desh_print("   network ID (8bit LSB):  %u (0x%02x)", nbrs[i].nw_id_8lsb,
-				   nbrs[i].nw_id_8lsb);
-			desh_print("   network ID (32bit):     %u (0x%06x)", nbrs[i].nw_id_32bit,
-				   nbrs[i].nw_id_32bit);
-			desh_print("   long RD ID:             %u", nbrs[i].long_rd_id);
-			desh_print("   short RD ID:            %u", nbrs[i].short_rd_id);
-			desh_print("   channel:                %u", nbrs[i].channel);
-			desh_print("   Last seen:              %d msecs ago",
-				time_from_last_received_ms);
-			dect_phy_mac_nbr_bg_scan_status_print_for_target_long_rd_id(
-				nbrs[i].long_rd_id);
+	desh_print("  %d/%d stored, evicted %u, aged out %u, dropped %u",
+		   nbr_table.count, DECT_PHY_MAC_NBR_TABLE_SIZE, nbr_table.evicted_count,
+		   nbr_table.aged_out_count, nbr_table.dropped_count);
+
+	/* Most recently heard first */
+	idx = nbr_table.lru_head;
+	while (idx != DECT_PHY_MAC_NBR_IDX_NONE) {
+		struct dect_phy_mac_nbr_info_list_item *nbr = &nbr_table.entries[idx].info;
+		int64_t time_from_last_received_ms =
+			MODEM_TICKS_TO_MS(time_now - nbr->time_rcvd_mdm_ticks);
+
+		desh_print("  Neighbor %d:", ++i);
+		desh_print("   network ID (24bit MSB): %u (0x%06x)", nbr->nw_id_24msb,
+			   nbr->nw_id_24msb);
+		desh_print("   network ID (8bit LSB):  %u (0x%02x)", nbr->nw_id_8lsb,
+			   nbr->nw_id_8lsb);
+		desh_print("   network ID (32bit):     %u (0x%06x)", nbr->nw_id_32bit,
+			   nbr->nw_id_32bit);
+		desh_print("   long RD ID:             %u", nbr->long_rd_id);
+		desh_print("   short RD ID:            %u", nbr->short_rd_id);
+		desh_print("   channel:                %u", nbr->channel);
+		if (nbr->beacon_msg.next_channel_bit) {
+			desh_print("   next channel:           %u",
+				   nbr->beacon_msg.next_cluster_channel);
+		}
+		desh_print("   RSSI:                   %d dBm", nbr->rssi_dbm);
+		desh_print("   Last seen:              %d msecs ago",
+			time_from_last_received_ms);
+		if (nbr_table.entries[idx].pinned) {
+			desh_print("   In use by an association");
 		}
+		dect_phy_mac_nbr_bg_scan_status_print_for_target_long_rd_id(nbr->long_rd_id);
+
+		idx = nbr_table.entries[idx].lru_next;
 	}
 	k_mutex_unlock(&nbr_list_mutex);
 }
@@ -184,15 +517,41 @@ void dect_phy_mac_nbr_status_print(void)
 bool dect_phy_mac_nbr_is_in_channel(uint16_t channel)
 {
 	bool return_value = false;
+	uint16_t idx;
 
 	k_mutex_lock(&nbr_list_mutex, K_FOREVER);
-	for (int i = 0; i < DECT_PHY_MAC_MAX_NEIGBORS; i++) {
-		if (nbrs[i].reserved == true && channel == nbrs[i].channel) {
+	idx = nbr_table.ch_heads[dect_phy_mac_nbr_ch_bucket(channel)];
+	while (idx != DECT_PHY_MAC_NBR_IDX_NONE) {
+		if (nbr_table.entries[idx].info.channel == channel) {
 			return_value = true;
 			break;
 		}
+		idx = nbr_table.entries[idx].ch_next;
 	}
 
 	k_mutex_unlock(&nbr_list_mutex);
 	return return_value;
 }
+
+uint16_t dect_phy_mac_nbr_channel_at_time_get(const struct dect_phy_mac_nbr_info_list_item *nbr,
+					      uint64_t time)
+{
+	uint64_t beacon_interval_mdm_ticks = MS_TO_MODEM_TICKS(
+		(uint64_t)dect_phy_mac_pdu_cluster_beacon_period_in_ms(
+			nbr->beacon_msg.cluster_beacon_period));
+
+	if (nbr->beacon_msg.next_channel_bit && nbr->beacon_msg.next_cluster_channel &&
+	    time >= (nbr->time_rcvd_mdm_ticks + beacon_interval_mdm_ticks)) {
+		return nbr->beacon_msg.next_cluster_channel;
+	}
+	return nbr->channel;
+}
+
+static int dect_phy_mac_nbr_init(void)
+{
+	dect_phy_mac_nbr_table_init();
+
+	return 0;
+}
+
+SYS_INIT(dect_phy_mac_nbr_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -11,8 +11,15 @@
 
 #include "dect_phy_mac_pdu.h"
 
+/* Max amount of simultaneous associations / background scans */
 #define DECT_PHY_MAC_MAX_NEIGBORS 16
 
+/* Capacity of the neighbor table, i.e. how many FTs are remembered from beacons */
+#define DECT_PHY_MAC_NBR_TABLE_SIZE CONFIG_DESH_DECT_PHY_MAC_NBR_TABLE_SIZE
+
+/* Non-pinned neighbors not heard within this are aged out from the table */
+#define DECT_PHY_MAC_NBR_STALE_TIME_MS (CONFIG_DESH_DECT_PHY_MAC_NBR_STALE_TIME_SEC * 1000)
+
 /* Populated from cluster beacons & */
 struct dect_phy_mac_nbr_info_list_item {
 	bool reserved;
@@ -29,13 +36,22 @@ struct dect_phy_mac_nbr_info_list_item {
 	uint64_t time_rcvd_mdm_ticks;
 	int64_t time_rcvd_shift_mdm_ticks;
 
+	int16_t rssi_dbm; /* From the last received beacon, used as eviction quality */
+
 	dect_phy_mac_cluster_beacon_t beacon_msg;
 	dect_phy_mac_random_access_resource_ie_t ra_ie; /* Supporting only one RA IE */
 };
 
+/* Returned item can be evicted and reused by a later store of a new neighbor unless it is
+ * pinned. Use dect_phy_mac_nbr_info_copy_by_long_rd_id() when it is not.
+ */
 struct dect_phy_mac_nbr_info_list_item *
 dect_phy_mac_nbr_info_get_by_long_rd_id(uint32_t long_rd_id);
 
+/* Copies the item, taken under the nbr table lock. Returns false if not found. */
+bool dect_phy_mac_nbr_info_copy_by_long_rd_id(uint32_t long_rd_id,
+					      struct dect_phy_mac_nbr_info_list_item *nbr_out);
+
 bool dect_phy_mac_nbr_info_remove_by_long_rd_id(uint32_t long_rd_id);
 void dect_phy_mac_nbr_info_clear_all(void);
 
@@ -44,10 +60,22 @@ bool dect_phy_mac_nbr_info_store_n_update(uint64_t const *rcv_time, uint16_t cha
 					  uint32_t long_rd_id, uint16_t short_rd_id,
 					  dect_phy_mac_cluster_beacon_t *beacon_msg,
 					  dect_phy_mac_random_access_resource_ie_t *ra_ie,
-					  bool print_update);
+					  int16_t rssi_dbm, bool print_update);
+
+/* Pinned neighbors are never aged out nor evicted, i.e. returned item pointers stay valid.
+ * Used for the targets of ongoing associations.
+ * Returns the previous pin state (0/1) or -ENOENT if not found.
+ */
+int dect_phy_mac_nbr_info_pin_set(uint32_t long_rd_id, bool pinned);
 
 bool dect_phy_mac_nbr_is_in_channel(uint16_t channel);
 
+/* Channel of the cell at a given time: from the next beacon onwards, the Next Cluster Channel
+ * announced in the last received beacon, if any.
+ */
+uint16_t dect_phy_mac_nbr_channel_at_time_get(const struct dect_phy_mac_nbr_info_list_item *nbr,
+					      uint64_t time);
+
 void dect_phy_mac_nbr_status_print(void);
 
 #endif /* DECT_PHY_MAC_NBR_H */
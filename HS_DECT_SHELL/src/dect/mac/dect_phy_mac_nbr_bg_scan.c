@@ -26,6 +26,7 @@
 #include "dect_phy_ctrl.h"
 #include "dect_phy_mac_nbr.h"
 #include "dect_phy_mac_nbr_bg_scan.h"
+#include "dect_phy_mac_rach_opp.h"
 
 struct dect_phy_mac_nbr_bg_scan_metrics_data {
 	uint32_t scan_started_ok_count;
@@ -33,6 +34,7 @@ struct dect_phy_mac_nbr_bg_scan_metrics_data {
 	uint32_t scan_info_updated_count;
 	uint32_t scan_info_time_shift_updated_count;
 	int64_t scan_info_time_shift_last_value;
+	uint32_t scan_info_channel_updated_count;
 };
 
 struct dect_phy_mac_nbr_bg_scan_data {
@@ -41,6 +43,7 @@ struct dect_phy_mac_nbr_bg_scan_data {
 	struct dect_phy_mac_nbr_bg_scan_metrics_data metrics;
 
 	uint64_t last_updated_rcv_time_mdm_ticks;
+	uint16_t channel;
 };
 
 static struct dect_phy_mac_nbr_bg_scan_data nbr_bg_scan_data[DECT_PHY_MAC_MAX_NEIGBORS];
@@ -151,10 +154,8 @@ static int dect_phy_mac_nbr_bg_scan_schedule(struct dect_phy_mac_nbr_bg_scan_par
 		goto err_exit;
 	}
 
-	next_beacon_frame_start = beacon_received;
-	while (next_beacon_frame_start < first_possible_rx) {
-		next_beacon_frame_start += beacon_interval_mdm_ticks;
-	}
+	next_beacon_frame_start = dect_phy_mac_rach_opp_next_beacon_frame_get(
+		beacon_received, beacon_interval_mdm_ticks, first_possible_rx);
 
 	sche_list_item->phy_op_handle = params->phy_op_handle;
 	sche_list_item->silent_fail = true;
@@ -177,12 +178,18 @@ static int dect_phy_mac_nbr_bg_scan_schedule(struct dect_phy_mac_nbr_bg_scan_par
 	sche_list_item_conf->length_subslots = 0;
 	sche_list_item_conf->start_slot = 0;
 
-	sche_list_item_conf->channel = params->target_nbr->channel;
+	sche_list_item_conf->channel =
+		dect_phy_mac_nbr_channel_at_time_get(params->target_nbr, next_beacon_frame_start);
 
-	/* Note: this is not exactly compliant with the MAC spec (which requires for every beacon
-	 * in release 1.x
-	 */
-	sche_list_item_conf->interval_mdm_ticks = beacon_interval_mdm_ticks * 10;
+	if (params->target_nbr->beacon_msg.next_channel_bit) {
+		/* Hopping cell: only the channel of the next beacon is known, follow every one */
+		sche_list_item_conf->interval_mdm_ticks = beacon_interval_mdm_ticks;
+	} else {
+		/* Note: this is not exactly compliant with the MAC spec (which requires for
+		 * every beacon in release 1.x
+		 */
+		sche_list_item_conf->interval_mdm_ticks = beacon_interval_mdm_ticks * 10;
+	}
 
 	sche_list_item_conf->cb_op_completed = dect_phy_mac_nbr_bg_scan_scheduler_op_completed_cb;
 	sche_list_item_conf->cb_op_to_mdm = dect_phy_mac_nbr_bg_scan_scheduler_op_to_mdm_cb;
@@ -220,6 +227,7 @@ int dect_phy_mac_nbr_bg_scan_start(struct dect_phy_mac_nbr_bg_scan_params *param
 		free_bg_scan_data_slot->running = true;
 		free_bg_scan_data_slot->params = *params;
 		free_bg_scan_data_slot->last_updated_rcv_time_mdm_ticks = 0;
+		free_bg_scan_data_slot->channel = 0; /* As scheduled */
 		memset(&free_bg_scan_data_slot->metrics, 0,
 		       sizeof(free_bg_scan_data_slot->metrics));
 	}
@@ -276,6 +284,22 @@ void dect_phy_mac_nbr_bg_scan_rcv_time_shift_update(uint32_t nbr_long_rd_id, uin
 	}
 }
 
+void dect_phy_mac_nbr_bg_scan_next_channel_update(uint32_t nbr_long_rd_id, uint16_t next_channel)
+{
+	struct dect_phy_mac_nbr_bg_scan_data *bg_scan_data =
+		dect_mac_nbr_bg_scan_list_item_by_nbr_long_rd_id_get(nbr_long_rd_id);
+
+	if (!bg_scan_data || next_channel == 0 || bg_scan_data->channel == next_channel) {
+		return;
+	}
+	/* RX for the received beacon is already given to modem, i.e. this is for the next one */
+	dect_phy_api_scheduler_list_item_channel_update_by_phy_op_handle_range(
+		bg_scan_data->params.phy_op_handle, bg_scan_data->params.phy_op_handle,
+		next_channel);
+	bg_scan_data->channel = next_channel;
+	bg_scan_data->metrics.scan_info_channel_updated_count++;
+}
+
 void dect_phy_mac_nbr_bg_scan_status_print_for_target_long_rd_id(uint32_t long_rd_id)
 {
 	struct dect_phy_mac_nbr_bg_scan_data *bg_scan_data =
@@ -313,4 +337,6 @@ void dect_phy_mac_nbr_bg_scan_status_print_for_target_long_rd_id(uint32_t long_r
 		bg_scan_data->metrics.scan_info_time_shift_updated_count);
 	desh_print("       Scan info time shift last value:    %lld",
 		bg_scan_data->metrics.scan_info_time_shift_last_value);
+	desh_print("       Scan info channel updated count:    %u",
+		bg_scan_data->metrics.scan_info_channel_updated_count);
 }
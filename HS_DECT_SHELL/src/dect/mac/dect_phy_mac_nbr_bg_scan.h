@@ -44,6 +44,9 @@ int dect_phy_mac_nbr_bg_scan_stop(uint32_t op_handle);
 void dect_phy_mac_nbr_bg_scan_rcv_time_shift_update(uint32_t nbr_long_rd_id, uint64_t time_rcvd,
 						    int64_t time_shift_mdm_ticks);
 
+/* Hopping cell: channel for the next beacon RX */
+void dect_phy_mac_nbr_bg_scan_next_channel_update(uint32_t nbr_long_rd_id, uint16_t next_channel);
+
 void dect_phy_mac_nbr_bg_scan_status_print_for_target_long_rd_id(uint32_t long_rd_id);
 
 /******************************************************************************/
@@ -493,10 +493,13 @@ bool dect_phy_mac_pdu_mux_header_decode(uint8_t *header_ptr, uint32_t data_len,
 		mux_header_out->mac_ext = mac_ext;
 	} else if (mac_ext == DECT_PHY_MAC_EXT_16BIT_LEN) {
 		/* Option 'e' and 'f': variable size MAC SDU with 16bit length */
-		if (data_len < 3) {
+		header_size = 3;
+		if (mux_header_out->ie_type == DECT_PHY_MAC_IE_TYPE_EXTENSION) {
+			header_size++;
+		}
+		if (data_len < header_size) {
 			return false;
 		}
-		header_size = 2;
 		mux_header_out->ie_ext = 0;
 		mux_header_out->payload_length = dect_common_utils_16bit_be_read(&p_ptr);
 		if (mux_header_out->ie_type == DECT_PHY_MAC_IE_TYPE_EXTENSION) {
@@ -525,7 +528,7 @@ uint8_t *dect_phy_mac_mux_header_header_encode(dect_phy_mac_mux_header_t *mux_he
 		uint8_t len_bit = (mux_header_in->payload_length) ? 1 : 0;
 
 		*target_ptr++ |= ((len_bit << 5) |
-				  (mux_header_in->ie_type & DECT_COMMON_UTILS_BIT_MASK_2BIT));
+				  (mux_header_in->ie_type & DECT_COMMON_UTILS_BIT_MASK_5BIT));
 	} else {
 		if (mux_header_in->mac_ext == DECT_PHY_MAC_EXT_NO_LENGTH) {
 			return target_ptr;
@@ -561,9 +564,10 @@ uint8_t dect_phy_mac_pdu_mux_header_length_get(dect_phy_mac_mux_header_t *header
 		length = 2;
 		if (header_ptr->mac_ext == DECT_PHY_MAC_EXT_16BIT_LEN) {
 			length++;
-		}
-		if (header_ptr->ie_type == DECT_PHY_MAC_IE_TYPE_EXTENSION) {
-			length++;
+			/* IE extension byte is only encoded with 16bit length */
+			if (header_ptr->ie_type == DECT_PHY_MAC_IE_TYPE_EXTENSION) {
+				length++;
+			}
 		}
 	}
 	return length;
@@ -675,7 +679,10 @@ dect_phy_mac_pdu_sdu_cluster_beacon_encode(const dect_phy_mac_cluster_beacon_t *
 		*target_ptr++ = cluster_beacon_in->frame_offset;
 	}
 	if (cluster_beacon_in->next_channel_bit) {
-		*target_ptr++ = cluster_beacon_in->next_cluster_channel;
+		/* 13 bits, as decoded */
+		*target_ptr++ = (cluster_beacon_in->next_cluster_channel >> 8) &
+				DECT_COMMON_UTILS_BIT_MASK_5BIT;
+		*target_ptr++ = cluster_beacon_in->next_cluster_channel & 0xFF;
 	}
 	if (cluster_beacon_in->time_to_next_next) {
 		target_ptr = dect_common_utils_32bit_be_write(target_ptr,
@@ -1048,6 +1055,9 @@ uint8_t *dect_phy_mac_pdu_sdus_encode(uint8_t *target_ptr, sys_dlist_t *sdu_inpu
 				target_ptr = dect_phy_mac_pdu_sdu_association_rel_encode(
 					&sdu_list_item->message.association_rel, target_ptr);
 				break;
+			case DECT_PHY_MAC_MESSAGE_TYPE_KEEP_ALIVE:
+				/* Only the MUX header */
+				break;
 			case DECT_PHY_MAC_MESSAGE_RANDOM_ACCESS_RESOURCE_IE:
 				/* Encode the RACH IE */
 				target_ptr = dect_phy_mac_pdu_sdu_random_access_resource_encode(
@@ -1107,6 +1117,26 @@ bool dect_phy_mac_pdu_sdus_decode(uint8_t *payload_ptr, uint32_t payload_len, sy
 
 		sdu_list_item->mux_header = mux_header;
 
+		if (mux_header.mac_ext == DECT_PHY_MAC_EXT_SHORT_IE) {
+			/* Short IE types are from a different number space (MAC spec:
+			 * Tables 6.3.4-3 and 6.3.4-4) and have at most 1 byte of payload.
+			 */
+			if (mux_header.ie_type == DECT_PHY_MAC_IE_TYPE_0BYTE_KEEP_ALIVE_IE &&
+			    mux_header.payload_length == 0) {
+				sdu_list_item->message_type = DECT_PHY_MAC_MESSAGE_TYPE_KEEP_ALIVE;
+			} else if (mux_header.ie_type == DECT_PHY_MAC_IE_TYPE_0BYTE_PADDING) {
+				sdu_list_item->message_type = DECT_PHY_MAC_MESSAGE_PADDING;
+			} else {
+				sdu_list_item->message_type = DECT_PHY_MAC_MESSAGE_TYPE_NONE;
+			}
+			sdu_list_item->message.common_msg.data_length = mux_header.payload_length;
+			if (mux_header.payload_length) {
+				memcpy(sdu_list_item->message.common_msg.data,
+				       mux_header.payload_ptr, mux_header.payload_length);
+			}
+			goto sdu_decoded;
+		}
+
 		switch (sdu_list_item->mux_header.ie_type) {
 		/* Only supported types */
 		case DECT_PHY_MAC_IE_TYPE_USER_PLANE_DATA_FLOW1:
@@ -1116,7 +1146,16 @@ bool dect_phy_mac_pdu_sdus_decode(uint8_t *payload_ptr, uint32_t payload_len, sy
 		case DECT_PHY_MAC_IE_TYPE_HIGHER_LAYER_SIGNALING_FLOW1:
 		case DECT_PHY_MAC_IE_TYPE_HIGHER_LAYER_SIGNALING_FLOW2: {
 			uint8_t *sdu_ptr = (uint8_t *)mux_header.payload_ptr;
-			uint8_t dlc_ie_type = *sdu_ptr++ >> 4; /* DLC spec: ch. 5.3.2 */
+			uint8_t dlc_ie_type;
+
+			if (mux_header.payload_length <
+			    DECT_PHY_MAC_DLC_IE_TYPE_SERV_0_WITHOUT_ROUTING_LEN) {
+				printk("Too short DLC SDU\n");
+				sdu_list_item->message_type = DECT_PHY_MAC_MESSAGE_TYPE_NONE;
+				sdu_list_item->message.common_msg.data_length = 0;
+				break;
+			}
+			dlc_ie_type = *sdu_ptr++ >> 4; /* DLC spec: ch. 5.3.2 */
 
 			if (dlc_ie_type != DECT_PHY_MAC_DLC_IE_TYPE_SERV_0_WITHOUT_ROUTING) {
 				printk("Unsupported DLC IE type\n");
@@ -1241,6 +1280,7 @@ bool dect_phy_mac_pdu_sdus_decode(uint8_t *payload_ptr, uint32_t payload_len, sy
 			break;
 		}
 
+sdu_decoded:
 		sys_dlist_append(sdu_list, &sdu_list_item->dnode);
 
 		sdu_ptr += dect_phy_mac_pdu_mux_header_length_get(&mux_header);
@@ -1305,6 +1345,19 @@ int dect_phy_mac_pdu_cluster_beacon_period_in_ms(dect_phy_mac_cluster_beacon_per
 	}
 }
 
+int dect_phy_mac_pdu_cluster_beacon_period_from_ms(uint32_t period_ms,
+						   dect_phy_mac_cluster_beacon_period_t *period_out)
+{
+	for (int i = DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_10MS;
+	     i <= DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_32000MS; i++) {
+		if (dect_phy_mac_pdu_cluster_beacon_period_in_ms(i) == period_ms) {
+			*period_out = (dect_phy_mac_cluster_beacon_period_t)i;
+			return 0;
+		}
+	}
+	return -EINVAL;
+}
+
 /**************************************************************************************************/
 
 const char *
@@ -165,6 +165,7 @@ typedef enum {
 	DECT_PHY_MAC_MESSAGE_TYPE_ASSOCIATION_REQ,
 	DECT_PHY_MAC_MESSAGE_TYPE_ASSOCIATION_RESP,
 	DECT_PHY_MAC_MESSAGE_TYPE_ASSOCIATION_REL,
+	DECT_PHY_MAC_MESSAGE_TYPE_KEEP_ALIVE, /* Short IE without payload */
 
 	DECT_PHY_MAC_MESSAGE_RANDOM_ACCESS_RESOURCE_IE,
 	DECT_PHY_MAC_MESSAGE_ESCAPE,
@@ -460,6 +461,8 @@ uint8_t *dect_phy_mac_pdu_sdus_encode(uint8_t *target_ptr, sys_dlist_t *sdu_inpu
 
 int dect_phy_mac_pdu_nw_beacon_period_in_ms(dect_phy_mac_nw_beacon_period_t period);
 int dect_phy_mac_pdu_cluster_beacon_period_in_ms(dect_phy_mac_cluster_beacon_period_t period);
+int dect_phy_mac_pdu_cluster_beacon_period_from_ms(uint32_t period_ms,
+						   dect_phy_mac_cluster_beacon_period_t *period_out);
 const char *
 dect_phy_mac_pdu_cluster_beacon_repeat_string_get(dect_phy_mac_rach_repeat_type_t repeat);
 const char *dect_phy_mac_pdu_association_req_setup_cause_string_get(
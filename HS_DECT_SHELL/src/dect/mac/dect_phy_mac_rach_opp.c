@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "dect_common.h"
+#include "dect_phy_common.h"
+
+#include "dect_phy_mac_pdu.h"
+#include "dect_phy_mac_nbr.h"
+#include "dect_phy_mac_cluster_beacon.h"
+#include "dect_phy_mac_rach_opp.h"
+
+/**************************************************************************************************/
+
+static bool dect_phy_mac_rach_opp_is_busy(const struct dect_phy_mac_rach_opp_busy *busy,
+					  uint64_t time)
+{
+	uint64_t offset;
+
+	if (busy->start_mdm_ticks == 0) {
+		return false;
+	}
+	if (busy->interval_mdm_ticks == 0) {
+		return time >= busy->start_mdm_ticks &&
+		       time <= busy->start_mdm_ticks + busy->length_mdm_ticks;
+	}
+
+	/* Offset of time from the latest busy window start at or before it */
+	if (time >= busy->start_mdm_ticks) {
+		offset = (time - busy->start_mdm_ticks) % busy->interval_mdm_ticks;
+	} else {
+		offset = (busy->start_mdm_ticks - time) % busy->interval_mdm_ticks;
+		if (offset) {
+			offset = busy->interval_mdm_ticks - offset;
+		}
+	}
+	return offset <= busy->length_mdm_ticks;
+}
+
+/**************************************************************************************************/
+
+uint64_t dect_phy_mac_rach_opp_next_beacon_frame_get(uint64_t beacon_rcvd_mdm_ticks,
+						     uint64_t beacon_interval_mdm_ticks,
+						     uint64_t not_before)
+{
+	if (not_before <= beacon_rcvd_mdm_ticks || beacon_interval_mdm_ticks == 0) {
+		return beacon_rcvd_mdm_ticks;
+	}
+	return beacon_rcvd_mdm_ticks +
+	       DIV_ROUND_UP(not_before - beacon_rcvd_mdm_ticks, beacon_interval_mdm_ticks) *
+		       beacon_interval_mdm_ticks;
+}
+
+int dect_phy_mac_rach_opp_params_from_nbr(struct dect_phy_mac_nbr_info_list_item *target_nbr,
+					  bool skip_first_ra,
+					  struct dect_phy_mac_rach_opp_params *params_out)
+{
+	dect_phy_mac_random_access_resource_ie_t *ra_ie = &target_nbr->ra_ie;
+	int32_t beacon_interval_ms = dect_phy_mac_pdu_cluster_beacon_period_in_ms(
+		target_nbr->beacon_msg.cluster_beacon_period);
+
+	if (beacon_interval_ms <= 0) {
+		return -EINVAL;
+	}
+	memset(params_out, 0, sizeof(*params_out));
+
+	params_out->beacon_rcvd_mdm_ticks = target_nbr->time_rcvd_mdm_ticks;
+	params_out->beacon_interval_mdm_ticks = MS_TO_MODEM_TICKS((uint64_t)beacon_interval_ms);
+	params_out->skip_first_ra = skip_first_ra;
+
+	/* To get RX really on target: delay TX by 2 subslots */
+	params_out->ra_offset_mdm_ticks =
+		(ra_ie->start_subslot + 2) * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS;
+
+	if (ra_ie->repeat == DECT_PHY_MAC_RA_REPEAT_TYPE_FRAMES) {
+		params_out->ra_interval_mdm_ticks =
+			ra_ie->repetition * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS;
+	} else if (ra_ie->repeat == DECT_PHY_MAC_RA_REPEAT_TYPE_SUBSLOTS) {
+		params_out->ra_interval_mdm_ticks =
+			ra_ie->repetition * DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS;
+	}
+	if (params_out->ra_interval_mdm_ticks) {
+		/* RA allocation is valid for 'validity' frames from the beacon frame */
+		uint64_t ra_end = ra_ie->validity * DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS;
+
+		if (ra_end > params_out->ra_offset_mdm_ticks) {
+			params_out->ra_window_mdm_ticks = ra_end - params_out->ra_offset_mdm_ticks;
+		}
+	} else {
+		/* Single RA per beacon period */
+		params_out->ra_interval_mdm_ticks = params_out->beacon_interval_mdm_ticks;
+	}
+
+	if (dect_phy_mac_cluster_beacon_is_running()) {
+		params_out->busy.start_mdm_ticks =
+			dect_phy_mac_cluster_beacon_last_tx_frame_time_get();
+		params_out->busy.interval_mdm_ticks =
+			MS_TO_MODEM_TICKS((uint64_t)dect_phy_mac_cluster_beacon_period_ms_get());
+		params_out->busy.length_mdm_ticks = DECT_RADIO_FRAME_DURATION_IN_MODEM_TICKS / 2;
+	}
+	return 0;
+}
+
+void dect_phy_mac_rach_opp_iter_init(struct dect_phy_mac_rach_opp_iter *iter,
+				     const struct dect_phy_mac_rach_opp_params *params,
+				     uint64_t not_before)
+{
+	uint64_t beacon_interval = params->beacon_interval_mdm_ticks;
+	uint64_t ra_interval = params->ra_interval_mdm_ticks;
+	uint64_t last_ra_offset, first_ra_time, last_ra_time;
+	uint32_t first_ra_index;
+
+	iter->params = *params;
+	iter->period = 0;
+	iter->ra_index = 0;
+	iter->last_ra_index = 0;
+	iter->first_skip_pending = false;
+
+	if (beacon_interval == 0 || ra_interval == 0) {
+		return;
+	}
+
+	/* RAs of a period must not run into the next one */
+	last_ra_offset = params->ra_offset_mdm_ticks + params->ra_window_mdm_ticks;
+	if (last_ra_offset >= beacon_interval) {
+		last_ra_offset = beacon_interval - 1;
+	}
+	if (last_ra_offset > params->ra_offset_mdm_ticks) {
+		iter->last_ra_index = (last_ra_offset - params->ra_offset_mdm_ticks) / ra_interval;
+	}
+
+	if (params->skip_first_ra && iter->last_ra_index > 0) {
+		first_ra_index = 1;
+	} else {
+		first_ra_index = 0;
+		iter->first_skip_pending = params->skip_first_ra;
+	}
+
+	/* 1st period whose last RA is not before not_before */
+	last_ra_time = params->beacon_rcvd_mdm_ticks + params->ra_offset_mdm_ticks +
+		       (iter->last_ra_index * ra_interval);
+	if (not_before > last_ra_time) {
+		iter->period = DIV_ROUND_UP(not_before - last_ra_time, beacon_interval);
+
+		/* Single RA: the skip goes to the 1st period whose RA window is not over, even if
+		 * its RA is already gone.
+		 */
+		if (iter->first_skip_pending && last_ra_offset > params->ra_offset_mdm_ticks &&
+		    params->beacon_rcvd_mdm_ticks + ((iter->period - 1) * beacon_interval) +
+				    last_ra_offset >= not_before) {
+			iter->first_skip_pending = false;
+		}
+	}
+
+	/* ...and the 1st RA in it not before not_before */
+	first_ra_time = params->beacon_rcvd_mdm_ticks + (iter->period * beacon_interval) +
+			params->ra_offset_mdm_ticks;
+	iter->ra_index = first_ra_index;
+	if (not_before > first_ra_time + (first_ra_index * ra_interval)) {
+		iter->ra_index = DIV_ROUND_UP(not_before - first_ra_time, ra_interval);
+	}
+	__ASSERT_NO_MSG(iter->ra_index <= iter->last_ra_index);
+}
+
+uint64_t dect_phy_mac_rach_opp_iter_next(struct dect_phy_mac_rach_opp_iter *iter)
+{
+	struct dect_phy_mac_rach_opp_params *params = &iter->params;
+
+	if (params->beacon_interval_mdm_ticks == 0 || params->ra_interval_mdm_ticks == 0) {
+		return 0;
+	}
+
+	for (int skips = 0; skips < DECT_PHY_MAC_RACH_OPP_MAX_SKIPS; skips++) {
+		uint64_t ra_time = params->beacon_rcvd_mdm_ticks +
+				   (iter->period * params->beacon_interval_mdm_ticks) +
+				   params->ra_offset_mdm_ticks +
+				   (iter->ra_index * params->ra_interval_mdm_ticks);
+
+		if (iter->ra_index < iter->last_ra_index) {
+			iter->ra_index++;
+		} else {
+			iter->period++;
+			iter->ra_index = (params->skip_first_ra && iter->last_ra_index > 0) ? 1 : 0;
+		}
+
+		if (iter->first_skip_pending) {
+			iter->first_skip_pending = false;
+			continue;
+		}
+		if (dect_phy_mac_rach_opp_is_busy(&params->busy, ra_time)) {
+			continue;
+		}
+		return ra_time;
+	}
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DECT_PHY_MAC_RACH_OPP_H
+#define DECT_PHY_MAC_RACH_OPP_H
+
+#include <zephyr/kernel.h>
+#include "dect_phy_mac_nbr.h"
+
+/* Random access opportunities of a target FT, computed in closed form from its last received
+ * beacon and RA IE. Beacon period p starts at beacon_rcvd + p * beacon_interval and has RAs at
+ * period start + ra_offset + k * ra_interval, for k in 0..(ra_window / ra_interval).
+ */
+
+/* Max number of excluded RAs skipped in a row before giving up */
+#define DECT_PHY_MAC_RACH_OPP_MAX_SKIPS 64
+
+struct dect_phy_mac_rach_opp_busy {
+	uint64_t start_mdm_ticks; /* 0: not in use */
+	uint64_t interval_mdm_ticks;
+	uint64_t length_mdm_ticks;
+};
+
+struct dect_phy_mac_rach_opp_params {
+	uint64_t beacon_rcvd_mdm_ticks;
+	uint64_t beacon_interval_mdm_ticks;
+
+	uint64_t ra_offset_mdm_ticks; /* From beacon frame start to the 1st RA */
+	uint64_t ra_interval_mdm_ticks;
+	uint64_t ra_window_mdm_ticks; /* From the 1st to the last RA in a period */
+
+	/* Skip the 1st RA of each period, e.g. due to an associated bg scan at the beacon.
+	 * With a single RA per period only the 1st opportunity of the iterator is skipped.
+	 */
+	bool skip_first_ra;
+
+	/* Periodic window in which our own TX is going on, e.g. own cluster beacon */
+	struct dect_phy_mac_rach_opp_busy busy;
+};
+
+struct dect_phy_mac_rach_opp_iter {
+	struct dect_phy_mac_rach_opp_params params;
+
+	uint64_t period; /* Index of beacon period from beacon_rcvd */
+	uint32_t ra_index; /* Index of RA within the period */
+	uint32_t last_ra_index;
+	bool first_skip_pending;
+};
+
+/******************************************************************************/
+
+/* 1st beacon frame start at or after not_before */
+uint64_t dect_phy_mac_rach_opp_next_beacon_frame_get(uint64_t beacon_rcvd_mdm_ticks,
+						     uint64_t beacon_interval_mdm_ticks,
+						     uint64_t not_before);
+
+/* RA timing of target_nbr. Busy window is set from own cluster beacon, if running.
+ * Returns -EINVAL if target has no valid beacon period.
+ */
+int dect_phy_mac_rach_opp_params_from_nbr(struct dect_phy_mac_nbr_info_list_item *target_nbr,
+					  bool skip_first_ra,
+					  struct dect_phy_mac_rach_opp_params *params_out);
+
+void dect_phy_mac_rach_opp_iter_init(struct dect_phy_mac_rach_opp_iter *iter,
+				     const struct dect_phy_mac_rach_opp_params *params,
+				     uint64_t not_before);
+
+/* Next RA opportunity in time order. Returns 0 if there is none. */
+uint64_t dect_phy_mac_rach_opp_iter_next(struct dect_phy_mac_rach_opp_iter *iter);
+
+#endif /* DECT_PHY_MAC_RACH_OPP_H */
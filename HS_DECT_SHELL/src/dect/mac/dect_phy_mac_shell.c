@@ -6,6 +6,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -248,10 +249,30 @@ static const char dect_phy_mac_beacon_start_cmd_usage_str[] =
 	"                              Default: 0, i.e. automatic selection of\n"
 	"                              free/possible channel on a set band.\n"
 	"  -p, --tx_pwr <dbm>,         Set beacon broadcast power (dBm), default: -16.\n"
-	"                              [-40,-30,-20,-16,-12,-8,-4,0,4,7,10,13,16,19,21,23]\n";
+	"                              [-40,-30,-20,-16,-12,-8,-4,0,4,7,10,13,16,19,21,23]\n"
+	"  -i, --period <msecs>,       Cluster beacon period.\n"
+	"                              [10,50,100,500,1000,1500,2000,4000,8000,16000,32000]\n"
+	"                              Default: 2000.\n"
+	"  -r, --ra <start_subslot>,<length_slots>,<repetition>,<validity>\n"
+	"                              Random access resource announced in a beacon.\n"
+	"                              Can be given max 4 times, resources shall not overlap.\n"
+	"                              Start subslot only even numbers, repetition and\n"
+	"                              validity in frames, repetition 0: single RA per\n"
+	"                              beacon period. Default: 12,10,2,<half of the period>.\n"
+	"                              Example for fast association on a dense cell:\n"
+	"                              -i 50 -r 12,10,1,5 -r 34,6,1,5\n"
+	"  -H, --hop <ch1>,<ch2>[,...],  Channel hopping over a given channel set (max 8).\n"
+	"                              Next channel is announced in a beacon and the cell,\n"
+	"                              i.e. beacon TX and RA, moves to it after dwell time.\n"
+	"                              Given -c is ignored.\n"
+	"  -d, --hop_dwell <count>,    Beacon periods on each hop channel. Default: 1.\n";
 
 /* Specifying the expected options (both long and short): */
 static struct option long_options_beacon_start[] = {{"tx_pwr", required_argument, 0, 'p'},
+						    {"period", required_argument, 0, 'i'},
+						    {"ra", required_argument, 0, 'r'},
+						    {"hop", required_argument, 0, 'H'},
+						    {"hop_dwell", required_argument, 0, 'd'},
 						    {0, 0, 0, 0}};
 
 static int dect_phy_mac_beacon_start_cmd(const struct shell *shell, size_t argc, char **argv)
@@ -287,7 +308,7 @@ static int dect_phy_mac_beacon_start_cmd(const struct shell *shell, size_t argc,
 			return -EPERM;
 		}
 		/* In FIXED mode, only FT can start beacon, but it can still be started in RANDOM mode as well (legacy behavior). */
-	while ((opt = getopt_long(argc, argv, "p:c:h", long_options_beacon_start,
+	while ((opt = getopt_long(argc, argv, "p:c:i:r:H:d:h", long_options_beacon_start,
 				  &long_index)) != -1) {
 		switch (opt) {
 		case 'c': {
@@ -298,6 +319,78 @@ static int dect_phy_mac_beacon_start_cmd(const struct shell *shell, size_t argc,
 			params.tx_power_dbm = atoi(optarg);
 			break;
 		}
+		case 'i': {
+			dect_phy_mac_cluster_beacon_period_t period;
+
+			params.period_ms = atoi(optarg);
+			if (dect_phy_mac_pdu_cluster_beacon_period_from_ms(params.period_ms,
+									   &period)) {
+				desh_error("Unsupported cluster beacon period: %s", optarg);
+				goto show_usage;
+			}
+			break;
+		}
+		case 'r': {
+			struct dect_phy_mac_beacon_ra_resource *ra;
+			unsigned int start_subslot, length_slots, repetition, validity;
+
+			if (params.ra_resource_count >= DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT) {
+				desh_error("Max %d RA resources",
+					   DECT_PHY_MAC_BEACON_RA_RESOURCE_MAX_COUNT);
+				goto show_usage;
+			}
+			if (sscanf(optarg, "%u,%u,%u,%u", &start_subslot, &length_slots,
+				   &repetition, &validity) != 4 ||
+			    start_subslot > UINT8_MAX || length_slots > UINT8_MAX ||
+			    repetition > UINT8_MAX || validity > UINT8_MAX) {
+				desh_error("Invalid RA resource: %s", optarg);
+				goto show_usage;
+			}
+			ra = &params.ra_resources[params.ra_resource_count++];
+			ra->start_subslot = start_subslot;
+			ra->length_slots = length_slots;
+			ra->repetition = repetition;
+			ra->validity = validity;
+			break;
+		}
+		case 'H': {
+			char *ptr = optarg;
+			char *end;
+			unsigned long channel;
+
+			params.hop_channel_count = 0;
+			while (*ptr) {
+				channel = strtoul(ptr, &end, 10);
+				if (end == ptr || channel == 0 || channel > UINT16_MAX ||
+				    (*end != ',' && *end != '\0')) {
+					desh_error("Invalid hop channel set: %s", optarg);
+					goto show_usage;
+				}
+				if (params.hop_channel_count >=
+				    DECT_PHY_MAC_BEACON_HOP_CHANNEL_MAX_COUNT) {
+					desh_error("Max %d hop channels",
+						   DECT_PHY_MAC_BEACON_HOP_CHANNEL_MAX_COUNT);
+					goto show_usage;
+				}
+				params.hop_channels[params.hop_channel_count++] = channel;
+				ptr = (*end == ',') ? end + 1 : end;
+			}
+			if (params.hop_channel_count < 2) {
+				desh_error("At least 2 hop channels needed: %s", optarg);
+				goto show_usage;
+			}
+			break;
+		}
+		case 'd': {
+			int dwell = atoi(optarg);
+
+			if (dwell <= 0 || dwell > UINT16_MAX) {
+				desh_error("Invalid hop dwell: %s", optarg);
+				goto show_usage;
+			}
+			params.hop_dwell = dwell;
+			break;
+		}
 		case 'h':
 			goto show_usage;
 		case '?':
@@ -319,6 +412,20 @@ static int dect_phy_mac_beacon_start_cmd(const struct shell *shell, size_t argc,
 			   current_settings->common.band_nbr);
 		goto show_usage;
 	}
+	for (int i = 0; i < params.hop_channel_count; i++) {
+		if (!dect_common_utils_channel_is_supported(current_settings->common.band_nbr,
+							    params.hop_channels[i], true)) {
+			desh_error("Hop channel %d is not supported at band #%d",
+				   params.hop_channels[i], current_settings->common.band_nbr);
+			goto show_usage;
+		}
+		for (int j = 0; j < i; j++) {
+			if (params.hop_channels[j] == params.hop_channels[i]) {
+				desh_error("Hop channel %d given twice", params.hop_channels[i]);
+				goto show_usage;
+			}
+		}
+	}
 
 	ret = dect_phy_mac_ctrl_cluster_beacon_start(&params);
 	if (ret) {
@@ -687,6 +794,109 @@ show_usage:
 	desh_print_no_format(dect_phy_mac_rach_tx_cmd_usage_str);
 	return 0;
 }
+
+/**************************************************************************************************/
+
+static const char dect_phy_mac_ul_tx_cmd_usage_str[] =
+	"Usage: dect mac ul_tx -t <long_rd_id> -d <data> [<options>]\n"
+	"Queue data to an associated FT. Queued data is aggregated into RACH PDUs\n"
+	"sent back-to-back in the FT's random access resource.\n"
+	"Options:\n"
+	"  -t, --long_rd_id <id>,  Target long rd id of an associated FT.\n"
+	"  -d, --data <data_str>,  Data to be sent.\n"
+	"  -c, --count <integer>,  Queue the data this many times. Default: 1.\n"
+	"See \"dect mac status\" for UL queue stats.\n";
+
+static struct option long_options_ul_tx[] = {{"long_rd_id", required_argument, 0, 't'},
+					     {"data", required_argument, 0, 'd'},
+					     {"count", required_argument, 0, 'c'},
+					     {0, 0, 0, 0}};
+
+static int dect_phy_mac_ul_tx_cmd(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t target_long_rd_id = 0;
+	char *data_str = NULL;
+	int count = 1;
+	int queued = 0;
+	int ret = 0;
+	int long_index = 0;
+	int opt;
+
+	int err = mac_shell_guard_role(shell, DECT_MAC_ROLE_PT);
+
+	if (err) {
+		return err;
+	}
+	if (argc < 2) {
+		goto show_usage;
+	}
+
+	optreset = 1;
+	optind = 1;
+
+	while ((opt = getopt_long(argc, argv, "t:d:c:h", long_options_ul_tx, &long_index)) !=
+	       -1) {
+		switch (opt) {
+		case 't': {
+			target_long_rd_id = shell_strtoul(optarg, 10, &ret);
+			if (ret) {
+				desh_error("Give decent tx id (> 0)");
+				return -EINVAL;
+			}
+			break;
+		}
+		case 'd': {
+			if (strlen(optarg) > DECT_PHY_MAC_CLIENT_UL_SDU_MAX_LEN) {
+				desh_error("UL data (%s) too long.", optarg);
+				return -EINVAL;
+			}
+			data_str = optarg;
+			break;
+		}
+		case 'c': {
+			count = atoi(optarg);
+			if (count <= 0) {
+				desh_error("The count must be positive.");
+				return -EINVAL;
+			}
+			break;
+		}
+		case 'h':
+			goto show_usage;
+		case '?':
+		default:
+			desh_error("Unknown option (%s). See usage:", argv[optind - 1]);
+			goto show_usage;
+		}
+	}
+	if (optind < argc) {
+		desh_error("Arguments without '-' not supported: %s", argv[argc - 1]);
+		goto show_usage;
+	}
+	if (target_long_rd_id == 0 || data_str == NULL) {
+		desh_error("Both target and data are needed.");
+		goto show_usage;
+	}
+
+	for (queued = 0; queued < count; queued++) {
+		ret = dect_phy_mac_client_ul_sdu_enqueue(target_long_rd_id, (uint8_t *)data_str,
+							 strlen(data_str));
+		if (ret) {
+			break;
+		}
+	}
+	if (ret) {
+		desh_error("Queued %d/%d to FT %u, err %d", queued, count, target_long_rd_id,
+			   ret);
+	} else {
+		desh_print("Queued %d SDUs to FT %u.", queued, target_long_rd_id);
+	}
+	return 0;
+
+show_usage:
+	desh_print_no_format(dect_phy_mac_ul_tx_cmd_usage_str);
+	return 0;
+}
 /************************************************Group Seched**************************************************/
 static int dect_phy_mac_ft_assoc_status_cmd(const struct shell *shell, size_t argc, char **argv)
 {
@@ -724,7 +934,7 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	SHELL_CMD_ARG(status, NULL, "Usage options: dect mac status", dect_phy_mac_status_cmd, 1,
 		      0),
 	SHELL_CMD_ARG(beacon_start, NULL, "Usage options: dect mac beacon_start -h",
-		      dect_phy_mac_beacon_start_cmd, 1, 6),
+		      dect_phy_mac_beacon_start_cmd, 1, 18),
 	SHELL_CMD_ARG(beacon_stop, NULL, "Usage: dect mac beacon_stop",
 		      dect_phy_mac_beacon_stop_cmd, 1, 0),
 	SHELL_CMD_ARG(beacon_scan, NULL, "Usage options: dect mac beacon_scan -h",
@@ -735,6 +945,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		      dect_phy_mac_dissociate_cmd, 1, 6),
 	SHELL_CMD_ARG(rach_tx, NULL, "Usage options: dect mac rach_tx -h",
 		      dect_phy_mac_rach_tx_cmd, 1, 11),
+	SHELL_CMD_ARG(ul_tx, NULL, "Usage options: dect mac ul_tx -h",
+		      dect_phy_mac_ul_tx_cmd, 1, 7),
 	SHELL_CMD_ARG(ft_assoc_status, NULL, "Usage: dect mac ft_assoc_status",
 	      dect_phy_mac_ft_assoc_status_cmd, 1, 0),
 	SHELL_CMD_ARG(ft_assoc_clear, NULL, "Usage: dect mac ft_assoc_clear",
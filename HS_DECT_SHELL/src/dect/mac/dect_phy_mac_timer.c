@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+
+#include "dect_phy_mac_timer.h"
+
+BUILD_ASSERT((DECT_PHY_MAC_TIMER_WHEEL_LEN & (DECT_PHY_MAC_TIMER_WHEEL_LEN - 1)) == 0,
+	     "Wheel length must be a power of 2");
+
+extern struct k_work_q dect_phy_ctrl_work_q;
+
+/* Timer is put to slot (expiry_tick % wheel len). Timers that are more than one revolution
+ * ahead stay in their slot and are skipped until their expiry tick is reached.
+ */
+static struct dect_phy_mac_timer_wheel_data {
+	sys_dlist_t slots[DECT_PHY_MAC_TIMER_WHEEL_LEN];
+
+	uint32_t processed_tick; /* Last tick that has been fully expired */
+	uint32_t running_count;
+
+	struct k_spinlock lock;
+	struct k_work_delayable tick_work;
+} wheel_data;
+
+/**************************************************************************************************/
+
+static inline uint32_t dect_phy_mac_timer_now_tick(void)
+{
+	return (uint32_t)(k_uptime_get() / DECT_PHY_MAC_TIMER_TICK_MS);
+}
+
+static inline bool dect_phy_mac_timer_tick_reached(uint32_t tick, uint32_t now_tick)
+{
+	return (int32_t)(tick - now_tick) <= 0;
+}
+
+static void dect_phy_mac_timer_tick_work_schedule(void)
+{
+	uint32_t to_next_tick_ms =
+		DECT_PHY_MAC_TIMER_TICK_MS - (k_uptime_get() % DECT_PHY_MAC_TIMER_TICK_MS);
+
+	/* No-op if already scheduled */
+	k_work_schedule_for_queue(&dect_phy_ctrl_work_q, &wheel_data.tick_work,
+				  K_MSEC(to_next_tick_ms));
+}
+
+/* With lock held */
+static struct dect_phy_mac_timer *dect_phy_mac_timer_expired_get_locked(uint32_t tick)
+{
+	sys_dlist_t *slot = &wheel_data.slots[tick & (DECT_PHY_MAC_TIMER_WHEEL_LEN - 1)];
+	struct dect_phy_mac_timer *timer;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(slot, timer, node) {
+		if (dect_phy_mac_timer_tick_reached(timer->expiry_tick, tick)) {
+			sys_dlist_remove(&timer->node);
+			wheel_data.running_count--;
+			return timer;
+		}
+	}
+	return NULL;
+}
+
+static void dect_phy_mac_timer_tick_worker(struct k_work *work_item)
+{
+	uint32_t now_tick = dect_phy_mac_timer_now_tick();
+	struct dect_phy_mac_timer *timer;
+	k_spinlock_key_t key;
+	bool running;
+
+	/* Catch up all ticks since the last run. Expired timers are taken one at a time and
+	 * the callback is called without the lock, so it can (re)start or stop timers.
+	 */
+	while (true) {
+		key = k_spin_lock(&wheel_data.lock);
+		if (dect_phy_mac_timer_tick_reached(now_tick, wheel_data.processed_tick)) {
+			k_spin_unlock(&wheel_data.lock, key);
+			break;
+		}
+		timer = dect_phy_mac_timer_expired_get_locked(wheel_data.processed_tick + 1);
+		if (timer == NULL) {
+			wheel_data.processed_tick++;
+		}
+		k_spin_unlock(&wheel_data.lock, key);
+
+		if (timer != NULL) {
+			timer->expiry_fn(timer);
+		}
+	}
+
+	key = k_spin_lock(&wheel_data.lock);
+	running = (wheel_data.running_count > 0);
+	k_spin_unlock(&wheel_data.lock, key);
+
+	if (running) {
+		dect_phy_mac_timer_tick_work_schedule();
+	}
+}
+
+/**************************************************************************************************/
+
+void dect_phy_mac_timer_init(struct dect_phy_mac_timer *timer,
+			     dect_phy_mac_timer_expiry_fn_t expiry_fn)
+{
+	sys_dnode_init(&timer->node);
+	timer->expiry_tick = 0;
+	timer->expiry_fn = expiry_fn;
+}
+
+void dect_phy_mac_timer_start(struct dect_phy_mac_timer *timer, uint32_t timeout_ms)
+{
+	uint32_t ticks = DIV_ROUND_UP(timeout_ms, DECT_PHY_MAC_TIMER_TICK_MS);
+	uint32_t now_tick = dect_phy_mac_timer_now_tick();
+	k_spinlock_key_t key;
+
+	__ASSERT_NO_MSG(timer->expiry_fn != NULL);
+
+	if (ticks == 0) {
+		ticks = 1;
+	}
+
+	key = k_spin_lock(&wheel_data.lock);
+	if (sys_dnode_is_linked(&timer->node)) {
+		sys_dlist_remove(&timer->node);
+		wheel_data.running_count--;
+	}
+	if (wheel_data.running_count == 0) {
+		/* Wheel has been idle: nothing to catch up */
+		wheel_data.processed_tick = now_tick;
+	}
+	timer->expiry_tick = now_tick + ticks;
+	sys_dlist_append(&wheel_data.slots[timer->expiry_tick & (DECT_PHY_MAC_TIMER_WHEEL_LEN - 1)],
+			 &timer->node);
+	wheel_data.running_count++;
+	k_spin_unlock(&wheel_data.lock, key);
+
+	dect_phy_mac_timer_tick_work_schedule();
+}
+
+void dect_phy_mac_timer_stop(struct dect_phy_mac_timer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&wheel_data.lock);
+
+	if (sys_dnode_is_linked(&timer->node)) {
+		sys_dlist_remove(&timer->node);
+		wheel_data.running_count--;
+	}
+	k_spin_unlock(&wheel_data.lock, key);
+
+	/* Tick work is left as is: it goes idle by itself when nothing is running */
+}
+
+bool dect_phy_mac_timer_is_running(struct dect_phy_mac_timer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&wheel_data.lock);
+	bool running = sys_dnode_is_linked(&timer->node);
+
+	k_spin_unlock(&wheel_data.lock, key);
+	return running;
+}
+
+static int dect_phy_mac_timer_wheel_init(void)
+{
+	for (int i = 0; i < DECT_PHY_MAC_TIMER_WHEEL_LEN; i++) {
+		sys_dlist_init(&wheel_data.slots[i]);
+	}
+	wheel_data.processed_tick = 0;
+	wheel_data.running_count = 0;
+	k_work_init_delayable(&wheel_data.tick_work, dect_phy_mac_timer_tick_worker);
+
+	return 0;
+}
+
+SYS_INIT(dect_phy_mac_timer_wheel_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef DECT_PHY_MAC_TIMER_H
+#define DECT_PHY_MAC_TIMER_H
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+
+/* MAC timer wheel: all MAC protocol timers (association response wait, keep-alive,
+ * inactivity) share one wheel that is ticked by a single delayable work in the
+ * dect_phy_ctrl_work_q. The work is armed only while there are running timers.
+ */
+#define DECT_PHY_MAC_TIMER_TICK_MS   100
+#define DECT_PHY_MAC_TIMER_WHEEL_LEN 64 /* Power of 2 */
+
+struct dect_phy_mac_timer;
+
+/* Called in dect_phy_ctrl_work_q context. Timer can be restarted from the callback. */
+typedef void (*dect_phy_mac_timer_expiry_fn_t)(struct dect_phy_mac_timer *timer);
+
+struct dect_phy_mac_timer {
+	sys_dnode_t node;
+	uint32_t expiry_tick;
+	dect_phy_mac_timer_expiry_fn_t expiry_fn;
+};
+
+/******************************************************************************/
+
+void dect_phy_mac_timer_init(struct dect_phy_mac_timer *timer,
+			     dect_phy_mac_timer_expiry_fn_t expiry_fn);
+
+/* (Re)start: a running timer is moved to the new expiry. Resolution is one wheel tick. */
+void dect_phy_mac_timer_start(struct dect_phy_mac_timer *timer, uint32_t timeout_ms);
+
+void dect_phy_mac_timer_stop(struct dect_phy_mac_timer *timer);
+
+bool dect_phy_mac_timer_is_running(struct dect_phy_mac_timer *timer);
+
+#endif /* DECT_PHY_MAC_TIMER_H */
@@ -23,6 +23,7 @@
 #include "dect_phy_api_scheduler.h"
 
 #include "dect_common_settings.h"
+#include "dect_common_seq_window.h"
 #include "dect_phy_ctrl.h"
 
 #include "dect_phy_perf_pdu.h"
@@ -33,16 +34,26 @@ BUILD_ASSERT((sizeof(dect_phy_perf_pdu_t) == DECT_DATA_MAX_LEN),
 
 #define DECT_PHY_PERF_HARQ_TX_PROCESS_COUNT	   8
 #define DECT_PHY_PERF_HARQ_TX_PROCESS_TIMEOUT_SECS 2
-#define DECT_PHY_PERF_CLIENT_TX_WINDOW_COUNT	   7
+
+#define DECT_PHY_PERF_SERVER_SESSION_COUNT 8
+#define DECT_PHY_PERF_MCS_HISTOGRAM_LEN	   16 /* df_mcs is 4 bits */
+
+#define DECT_PHY_PERF_MDM_TICKS_TO_US(ticks)                                                     \
+	((uint32_t)(((uint64_t)(ticks) * 1000) / NRF_MODEM_DECT_MODEM_TIME_TICK_RATE_KHZ))
 
 /**************************************************************************************************/
 struct dect_phy_perf_harq_tx_process_info {
 	bool process_in_use;
 	bool usable;
 	bool next_new_data_ind; /* Toggle */
+	bool rtx_pending; /* NACKed or TX failed: waiting for a TX slot */
 	uint8_t process_nbr;
+	uint8_t redundancy_version;
+	uint8_t rtx_count;
 	uint16_t seq_nbr;
-	uint32_t phy_op_handle;
+	uint32_t tx_time_stamp;
+	uint32_t phy_op_handle; /* Latest TX */
+	uint32_t feedback_rx_handle;
 	uint64_t time_when_reserved;
 };
 
@@ -50,6 +61,8 @@ struct dect_phy_perf_tx_metrics {
 	uint32_t tx_total_data_amount;
 	uint32_t tx_total_pkt_count;
 	uint32_t tx_harq_timeout_count;
+	uint32_t tx_harq_rtx_count;
+	uint32_t tx_harq_rtx_exhausted_count;
 };
 
 struct dect_phy_perf_rx_metrics {
@@ -62,7 +75,6 @@ struct dect_phy_perf_rx_metrics {
 	int64_t rx_last_data_received;
 	int64_t rx_last_pcc_received;
 	uint8_t rx_last_pcc_phy_pwr;
-	uint16_t rx_last_seq_nbr;
 	uint16_t rx_last_tx_id;
 	uint16_t rx_last_tx_id_from_pcc;
 
@@ -90,8 +102,7 @@ struct dect_phy_perf_rx_metrics {
 struct dect_phy_perf_client_data {
 	bool tx_results_from_server_requested;
 	int64_t tx_last_scheduled_mdm_op_start_time_mdm_ticks;
-	uint16_t tx_last_round_starting_handle;
-	uint16_t tx_harq_feedback_rx_last_round_middle_handle;
+	uint8_t tx_in_flight_count; /* TX operations scheduled but not completed */
 	uint16_t tx_last_seq_nbr;
 	uint16_t tx_data_len;
 	uint8_t tx_data[DECT_DATA_MAX_LEN]; /* max data size in bytes when MCS4 + 4 slots */
@@ -104,9 +115,26 @@ struct dect_phy_perf_client_data {
 	struct nrf_modem_dect_phy_rx_params rx_op; /* For HARQ receiving feedback */
 };
 
+/* Server side RX tracking per client (transmitter id) */
+struct dect_phy_perf_rx_session {
+	bool in_use;
+	uint16_t tx_id;
+	struct dect_common_seq_window rx_window;
+
+	uint32_t total_data_amount;
+	uint32_t total_pkt_count;
+	int64_t first_data_received;
+	int64_t last_data_received;
+
+	uint32_t mcs_histogram[DECT_PHY_PERF_MCS_HISTOGRAM_LEN];
+};
+
 struct dect_phy_perf_server_data {
 	bool rx_results_sent;
 
+	struct dect_phy_perf_rx_session rx_sessions[DECT_PHY_PERF_SERVER_SESSION_COUNT];
+	uint32_t rx_session_table_full_count;
+
 	/* HARQ data */
 	/* For sending HARQ feedback for RX data when requested by the client in a header */
 	struct dect_phy_common_harq_feedback_data harq_feedback_data;
@@ -199,6 +227,51 @@ static void dect_phy_perf_data_rx_metrics_init(void)
 
 /**************************************************************************************************/
 
+static struct dect_phy_perf_rx_session *dect_phy_perf_server_session_get(uint16_t tx_id)
+{
+	for (int i = 0; i < DECT_PHY_PERF_SERVER_SESSION_COUNT; i++) {
+		if (perf_data.server_data.rx_sessions[i].in_use &&
+		    perf_data.server_data.rx_sessions[i].tx_id == tx_id) {
+			return &perf_data.server_data.rx_sessions[i];
+		}
+	}
+	return NULL;
+}
+
+static struct dect_phy_perf_rx_session *dect_phy_perf_server_session_get_or_add(uint16_t tx_id)
+{
+	struct dect_phy_perf_rx_session *session = dect_phy_perf_server_session_get(tx_id);
+
+	if (session) {
+		return session;
+	}
+	for (int i = 0; i < DECT_PHY_PERF_SERVER_SESSION_COUNT; i++) {
+		session = &perf_data.server_data.rx_sessions[i];
+		if (!session->in_use) {
+			memset(session, 0, sizeof(*session));
+			session->in_use = true;
+			session->tx_id = tx_id;
+			dect_common_seq_window_init(&session->rx_window);
+			return session;
+		}
+	}
+	return NULL;
+}
+
+static int dect_phy_perf_server_session_count_get(void)
+{
+	int count = 0;
+
+	for (int i = 0; i < DECT_PHY_PERF_SERVER_SESSION_COUNT; i++) {
+		if (perf_data.server_data.rx_sessions[i].in_use) {
+			count++;
+		}
+	}
+	return count;
+}
+
+/**************************************************************************************************/
+
 static void dect_phy_perf_prefill_server_rx_harq_feedback_data(void)
 {
 	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
@@ -311,7 +384,7 @@ static void dect_phy_perf_harq_tx_process_table_init(uint8_t tx_harq_process_max
 		perf_data.client_data.tx_harq_processes[i].next_new_data_ind = true;
 		/* perf_data.client_data.tx_harq_processes[i].time_when_reserved = 0; */
 		/* perf_data.client_data.tx_harq_processes[i].usable = false; */
-		if (i < tx_harq_process_max_nbr) {
+		if (i <= tx_harq_process_max_nbr) {
 			perf_data.client_data.tx_harq_processes[i].usable = true;
 		}
 	}
@@ -321,6 +394,9 @@ static void dect_phy_perf_harq_tx_process_release(uint8_t process_nbr)
 {
 	__ASSERT_NO_MSG(process_nbr < DECT_PHY_PERF_HARQ_TX_PROCESS_COUNT);
 	perf_data.client_data.tx_harq_processes[process_nbr].process_in_use = false;
+	perf_data.client_data.tx_harq_processes[process_nbr].rtx_pending = false;
+	perf_data.client_data.tx_harq_processes[process_nbr].redundancy_version = 0;
+	perf_data.client_data.tx_harq_processes[process_nbr].rtx_count = 0;
 	perf_data.client_data.tx_harq_processes[process_nbr].time_when_reserved = 0;
 }
 
@@ -387,21 +463,50 @@ dect_phy_perf_harq_tx_process_get_by_process_nbr(uint8_t process_nbr)
 	return &perf_data.client_data.tx_harq_processes[process_nbr];
 }
 
-static uint8_t dect_phy_perf_current_free_harq_tx_process_count_get(void)
+static struct dect_phy_perf_harq_tx_process_info *
+dect_phy_perf_harq_tx_process_rtx_pending_get(void)
 {
-	uint8_t count = 0;
-	int i = 0;
+	for (int i = 0; i < DECT_PHY_PERF_HARQ_TX_PROCESS_COUNT; i++) {
+		if (perf_data.client_data.tx_harq_processes[i].process_in_use &&
+		    perf_data.client_data.tx_harq_processes[i].rtx_pending) {
+			return &perf_data.client_data.tx_harq_processes[i];
+		}
+	}
+	return NULL;
+}
 
-	/* 1st cleanup old ones */
-	dect_phy_perf_harq_tx_process_cleanup();
+static struct dect_phy_perf_harq_tx_process_info *
+dect_phy_perf_harq_tx_process_get_by_handle(uint32_t handle)
+{
+	for (int i = 0; i < DECT_PHY_PERF_HARQ_TX_PROCESS_COUNT; i++) {
+		struct dect_phy_perf_harq_tx_process_info *harq_pinfo =
+			&perf_data.client_data.tx_harq_processes[i];
 
-	for (i = 0; i < DECT_PHY_PERF_HARQ_TX_PROCESS_COUNT; i++) {
-		if (!perf_data.client_data.tx_harq_processes[i].process_in_use &&
-		    perf_data.client_data.tx_harq_processes[i].usable) {
-			count++;
+		if (harq_pinfo->process_in_use && (harq_pinfo->phy_op_handle == handle ||
+						   harq_pinfo->feedback_rx_handle == handle)) {
+			return harq_pinfo;
 		}
 	}
-	return count;
+	return NULL;
+}
+
+/* Retransmit with the next redundancy version or give up */
+static void
+dect_phy_perf_harq_tx_process_nack_handle(struct dect_phy_perf_harq_tx_process_info *harq_pinfo)
+{
+	int8_t redundancy_version = dect_common_utils_harq_tx_next_redundancy_version_get(
+		harq_pinfo->redundancy_version);
+
+	if (redundancy_version < 0 ||
+	    harq_pinfo->rtx_count >= perf_data.cmd_params.client_harq_rtx_max) {
+		if (perf_data.cmd_params.client_harq_rtx_max) {
+			perf_data.tx_metrics.tx_harq_rtx_exhausted_count++;
+		}
+		dect_phy_perf_harq_tx_process_release(harq_pinfo->process_nbr);
+		return;
+	}
+	harq_pinfo->redundancy_version = redundancy_version;
+	harq_pinfo->rtx_pending = true;
 }
 
 /**************************************************************************************************/
@@ -603,6 +708,39 @@ static void dect_phy_perf_mdm_capability_get_cb(
 
 /**************************************************************************************************/
 
+/* Version byte + low 32 bits of the scheduled TX time at the payload start,
+ * for server side jitter
+ */
+static void dect_phy_perf_client_tx_time_stamp(uint32_t tx_time)
+{
+	uint8_t *p_payload =
+		perf_data.client_data.tx_data + DECT_PHY_PERF_TX_DATA_PDU_LEN_WITHOUT_PAYLOAD;
+
+	if (perf_data.client_data.tx_data_len >=
+	    DECT_PHY_PERF_TX_DATA_PDU_LEN_WITHOUT_PAYLOAD +
+		    DECT_PHY_PERF_TX_DATA_PAYLOAD_TX_TIME_LEN) {
+		*p_payload++ = DECT_PHY_PERF_TX_DATA_PAYLOAD_TX_TIME_VER;
+		dect_common_utils_32bit_be_write(p_payload, tx_time);
+	}
+}
+
+/* One TX iteration: actual TX + (with HARQ) HARQ feedback delay + HARQ feedback RX + gap */
+static uint64_t dect_phy_perf_client_tx_iteration_mdm_ticks_get(void)
+{
+	struct dect_phy_perf_params *params = &(perf_data.cmd_params);
+	uint64_t iteration_mdm_ticks =
+		(params->slot_count * DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS) +
+		params->slot_gap_count_in_mdm_ticks;
+
+	if (params->use_harq) {
+		iteration_mdm_ticks += (params->client_harq_feedback_rx_delay_subslot_count *
+					DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS) +
+				       (params->client_harq_feedback_rx_subslot_count *
+					DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
+	}
+	return iteration_mdm_ticks;
+}
+
 static void dect_phy_perf_client_tx_with_harq(uint64_t first_possible_tx)
 {
 	struct dect_phy_perf_params *params = &(perf_data.cmd_params);
@@ -610,6 +748,7 @@ static void dect_phy_perf_client_tx_with_harq(uint64_t first_possible_tx)
 	struct nrf_modem_dect_phy_tx_rx_params tx_rx_param;
 	uint8_t *encoded_data_to_send = perf_data.client_data.tx_data;
 	uint8_t *seq_nbr_ptr = encoded_data_to_send + DECT_PHY_PERF_PDU_HEADER_LEN;
+	uint64_t iteration_mdm_ticks = dect_phy_perf_client_tx_iteration_mdm_ticks_get();
 	uint64_t next_tx_time = first_possible_tx;
 	uint8_t tx_count = 0;
 	uint8_t tx_window;
@@ -617,50 +756,51 @@ static void dect_phy_perf_client_tx_with_harq(uint64_t first_possible_tx)
 	struct nrf_modem_dect_phy_rx_params *rx_op_ptr;
 	int ret;
 
+	if (perf_data.client_data.tx_in_flight_count >= params->client_tx_window_count) {
+		return;
+	}
+	tx_window = params->client_tx_window_count - perf_data.client_data.tx_in_flight_count;
+
 	tx_rx_param.tx = perf_data.client_data.tx_op;
 	tx_rx_param.rx = perf_data.client_data.rx_op;
 
 	tx_op_ptr = &tx_rx_param.tx;
 	rx_op_ptr = &tx_rx_param.rx;
 
-	tx_window = dect_phy_perf_current_free_harq_tx_process_count_get();
-	if (!tx_window) {
-		k_timer_start(&harq_tx_window_timer, K_SECONDS(2), K_NO_WAIT);
-		if (params->debugs) {
-			desh_warn("PERF with HARQ: no TX window");
-		}
-		return;
-	}
-
-	if (tx_op_ptr->handle > DECT_PHY_PERF_TX_HANDLE_END) {
-		tx_op_ptr->handle = DECT_PHY_PERF_TX_HANDLE_START;
-	}
-	if (rx_op_ptr->handle > DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_END) {
-		rx_op_ptr->handle = DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_START;
-	}
-
-	perf_data.client_data.tx_last_round_starting_handle = tx_op_ptr->handle;
 	while (tx_count < tx_window) {
+		bool rtx = true;
+
 		if (tx_op_ptr->handle > DECT_PHY_PERF_TX_HANDLE_END) {
 			tx_op_ptr->handle = DECT_PHY_PERF_TX_HANDLE_START;
 		}
 		if (rx_op_ptr->handle > DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_END) {
 			rx_op_ptr->handle = DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_START;
 		}
-		if (!dect_phy_perf_harq_tx_process_reserve(&harq_process_data)) {
-			desh_error("(%s): cannot reserve HARQ TX process", (__func__));
-			break;
+
+		/* Retransmissions first, then new data */
+		harq_process_data = dect_phy_perf_harq_tx_process_rtx_pending_get();
+		if (harq_process_data == NULL) {
+			if (!dect_phy_perf_harq_tx_process_reserve(&harq_process_data)) {
+				/* All processes are waiting for HARQ feedback */
+				break;
+			}
+			rtx = false;
+			harq_process_data->seq_nbr = perf_data.client_data.tx_last_seq_nbr;
+			harq_process_data->tx_time_stamp = (uint32_t)next_tx_time;
 		}
 		struct dect_phy_header_type2_format0_t *header =
 			(struct dect_phy_header_type2_format0_t *)tx_op_ptr->phy_header;
 
 		__ASSERT_NO_MSG(harq_process_data != NULL);
 
-		header->df_redundancy_version = 0;
+		header->df_redundancy_version = harq_process_data->redundancy_version;
 		header->df_new_data_indication_toggle = harq_process_data->next_new_data_ind;
 		header->df_harq_process_number = harq_process_data->process_nbr;
 		header->feedback.format1.format = 0; /* No feedback */
-		harq_process_data->seq_nbr = perf_data.client_data.tx_last_seq_nbr;
+
+		/* Retransmission has to carry the same data as the initial one */
+		dect_common_utils_16bit_be_write(seq_nbr_ptr, harq_process_data->seq_nbr);
+		dect_phy_perf_client_tx_time_stamp(harq_process_data->tx_time_stamp);
 		tx_op_ptr->start_time = next_tx_time;
 
 		/* RX time is relative from TX end */
@@ -672,56 +812,70 @@ static void dect_phy_perf_client_tx_with_harq(uint64_t first_possible_tx)
 		if (ret) {
 			desh_error("(%s): nrf_modem_dect_phy_tx_rx failed %d (handle %d)\n",
 				   (__func__), ret, tx_op_ptr->handle);
+			if (!rtx) {
+				/* Not sent: new data indication as it was */
+				harq_process_data->next_new_data_ind =
+					!harq_process_data->next_new_data_ind;
+				dect_phy_perf_harq_tx_process_release(harq_process_data->process_nbr);
+			}
 			break;
 		}
+		harq_process_data->rtx_pending = false;
+		harq_process_data->phy_op_handle = tx_op_ptr->handle;
+		harq_process_data->feedback_rx_handle = rx_op_ptr->handle;
+		if (rtx) {
+			harq_process_data->rtx_count++;
+			perf_data.tx_metrics.tx_harq_rtx_count++;
+		} else {
+			perf_data.client_data.tx_last_seq_nbr++;
+		}
 		perf_data.client_data.tx_last_scheduled_mdm_op_start_time_mdm_ticks = next_tx_time;
+		perf_data.client_data.tx_in_flight_count++;
 
 		perf_data.tx_metrics.tx_total_data_amount += tx_op_ptr->data_size;
 		perf_data.tx_metrics.tx_total_pkt_count++;
 
-		/* Modify seq nbr for next round */
-		perf_data.client_data.tx_last_seq_nbr++;
 		tx_count++;
-		dect_common_utils_16bit_be_write(seq_nbr_ptr,
-						 perf_data.client_data.tx_last_seq_nbr);
 		tx_op_ptr->handle++;
 		rx_op_ptr->handle++;
-
-		/* One TX with HARQ iteration:
-		 * actual TX + HARQ feedback delay + HARQ feedback RX + gap
-		 */
-		next_tx_time +=
-			((params->slot_count * DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS) +
-			 (params->client_harq_feedback_rx_delay_subslot_count *
-			  DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS) +
-			 rx_op_ptr->duration + perf_data.cmd_params.slot_gap_count_in_mdm_ticks);
-	}
-	perf_data.client_data.tx_harq_feedback_rx_last_round_middle_handle =
-		(perf_data.client_data.tx_op.handle + (tx_op_ptr->handle - 1)) / 2;
+		next_tx_time += iteration_mdm_ticks;
+	}
 	perf_data.client_data.tx_op.handle = tx_op_ptr->handle;
 	perf_data.client_data.rx_op.handle = rx_op_ptr->handle;
+
+	if (perf_data.client_data.tx_in_flight_count == 0) {
+		/* Nothing on air to trigger a refill: retry when stuck processes have expired */
+		k_timer_start(&harq_tx_window_timer,
+			      K_SECONDS(DECT_PHY_PERF_HARQ_TX_PROCESS_TIMEOUT_SECS), K_NO_WAIT);
+		if (params->debugs) {
+			desh_warn("PERF with HARQ: no TX window");
+		}
+	}
 }
 
 static void dect_phy_perf_client_tx_no_harq(uint64_t first_possible_tx)
 {
+	struct dect_phy_perf_params *params = &(perf_data.cmd_params);
 	uint8_t *encoded_data_to_send = perf_data.client_data.tx_data;
 	uint8_t *seq_nbr_ptr = encoded_data_to_send + DECT_PHY_PERF_PDU_HEADER_LEN;
+	uint64_t iteration_mdm_ticks = dect_phy_perf_client_tx_iteration_mdm_ticks_get();
 	uint64_t next_tx_time = first_possible_tx;
 	uint8_t tx_count = 0;
-	uint8_t tx_window = DECT_PHY_PERF_CLIENT_TX_WINDOW_COUNT;
+	uint8_t tx_window;
 	int ret;
 
-	if (perf_data.client_data.tx_op.handle > DECT_PHY_PERF_TX_HANDLE_END) {
-		perf_data.client_data.tx_op.handle = DECT_PHY_PERF_TX_HANDLE_START;
+	if (perf_data.client_data.tx_in_flight_count >= params->client_tx_window_count) {
+		return;
 	}
+	tx_window = params->client_tx_window_count - perf_data.client_data.tx_in_flight_count;
 
-	perf_data.client_data.tx_last_round_starting_handle = perf_data.client_data.tx_op.handle;
 	while (tx_count < tx_window) {
 		if (perf_data.client_data.tx_op.handle > DECT_PHY_PERF_TX_HANDLE_END) {
 			perf_data.client_data.tx_op.handle = DECT_PHY_PERF_TX_HANDLE_START;
 		}
 
 		perf_data.client_data.tx_op.start_time = next_tx_time;
+		dect_phy_perf_client_tx_time_stamp((uint32_t)next_tx_time);
 		ret = nrf_modem_dect_phy_tx(&perf_data.client_data.tx_op);
 		if (ret) {
 			desh_error("(%s): nrf_modem_dect_phy_transmit failed %d (handle %d)\n",
@@ -729,6 +883,7 @@ static void dect_phy_perf_client_tx_no_harq(uint64_t first_possible_tx)
 			break;
 		}
 		perf_data.client_data.tx_last_scheduled_mdm_op_start_time_mdm_ticks = next_tx_time;
+		perf_data.client_data.tx_in_flight_count++;
 
 		perf_data.tx_metrics.tx_total_data_amount += perf_data.client_data.tx_op.data_size;
 		perf_data.tx_metrics.tx_total_pkt_count++;
@@ -739,9 +894,7 @@ static void dect_phy_perf_client_tx_no_harq(uint64_t first_possible_tx)
 		dect_common_utils_16bit_be_write(seq_nbr_ptr,
 						 perf_data.client_data.tx_last_seq_nbr);
 		perf_data.client_data.tx_op.handle++;
-		next_tx_time += ((perf_data.cmd_params.slot_count *
-				  DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS) +
-				 perf_data.cmd_params.slot_gap_count_in_mdm_ticks);
+		next_tx_time += iteration_mdm_ticks;
 	}
 }
 
@@ -756,6 +909,30 @@ static void dect_phy_perf_client_tx(uint64_t first_possible_tx)
 	}
 }
 
+/* Top up the TX pipeline to the TX window, continuing the grid of already scheduled TXs */
+static void dect_phy_perf_client_tx_pipeline_fill(void)
+{
+	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
+	uint64_t first_possible_tx =
+		dect_app_modem_time_now() +
+		US_TO_MODEM_TICKS(current_settings->scheduler.scheduling_delay_us);
+	uint64_t iteration_mdm_ticks = dect_phy_perf_client_tx_iteration_mdm_ticks_get();
+	uint64_t next_possible_tx =
+		perf_data.client_data.tx_last_scheduled_mdm_op_start_time_mdm_ticks +
+		iteration_mdm_ticks;
+
+	if (!perf_data.perf_ongoing || perf_data.client_data.tx_results_from_server_requested) {
+		return;
+	}
+	if (next_possible_tx < first_possible_tx) {
+		/* Pipeline has drained */
+		next_possible_tx +=
+			DIV_ROUND_UP(first_possible_tx - next_possible_tx, iteration_mdm_ticks) *
+			iteration_mdm_ticks;
+	}
+	dect_phy_perf_client_tx(next_possible_tx);
+}
+
 static void dect_phy_perf_cmd_done(void)
 {
 	if (!perf_data.perf_ongoing) {
@@ -1077,6 +1254,10 @@ dect_phy_perf_client_report_local_results_and_req_srv_results(int64_t *elapsed_t
 			   perf_data.rx_metrics.harq_nack_rx_count);
 		desh_print("  HARQ reset NACK receive count:           %d",
 			   perf_data.rx_metrics.harq_reset_nack_rx_count);
+		desh_print("  HARQ retransmission count:               %d",
+			   perf_data.tx_metrics.tx_harq_rtx_count);
+		desh_print("  HARQ retransmissions exhausted count:    %d",
+			   perf_data.tx_metrics.tx_harq_rtx_exhausted_count);
 		desh_print("  PCC CRC error count (HARQ feedback RX):  %d",
 			   perf_data.rx_metrics.rx_pcc_crc_error_count);
 		desh_print("  PDC CRC error count (HARQ feedback RX):  %d",
@@ -1102,7 +1283,7 @@ dect_phy_perf_client_report_local_results_and_req_srv_results(int64_t *elapsed_t
 	return ret;
 }
 
-static int dect_phy_perf_server_results_tx(char *result_str)
+static int dect_phy_perf_server_results_tx(uint16_t receiver_tx_id, char *result_str)
 {
 	struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
 	struct dect_phy_perf_params *params = &(perf_data.cmd_params);
@@ -1117,8 +1298,8 @@ static int dect_phy_perf_server_results_tx(char *result_str)
 		.df_mcs = 1,
 		.transmit_power = dect_phy_ctrl_utils_mdm_next_supported_phy_tx_power_get(
 			perf_data.rx_metrics.rx_last_pcc_phy_pwr, params->channel),
-		.receiver_identity_hi = (uint8_t)(perf_data.rx_metrics.rx_last_tx_id >> 8),
-		.receiver_identity_lo = (uint8_t)(perf_data.rx_metrics.rx_last_tx_id & 0xFF),
+		.receiver_identity_hi = (uint8_t)(receiver_tx_id >> 8),
+		.receiver_identity_lo = (uint8_t)(receiver_tx_id & 0xFF),
 		.feedback.format1.format = 0,
 	};
 	union nrf_modem_dect_phy_hdr phy_header;
@@ -1173,64 +1354,186 @@ static int dect_phy_perf_server_results_tx(char *result_str)
 	return ret;
 }
 
-static void dect_phy_perf_server_report_local_and_tx_results(void)
-{
-
-	if (!perf_data.rx_metrics.rx_total_data_amount) {
-		desh_warn("No perf data received on server side.");
-	}
+#define DECT_PHY_PERF_RESULTS_STR_APPEND(_str, ...)                                              \
+	snprintf((_str) + strlen(_str), DECT_PHY_PERF_RESULTS_DATA_MAX_LEN - strlen(_str),         \
+		 __VA_ARGS__)
 
-	int64_t elapsed_time_ms = perf_data.rx_metrics.rx_last_data_received -
-				  perf_data.rx_metrics.rx_1st_data_received;
-	double perf = dect_phy_perf_calculate_throughput(perf_data.rx_metrics.rx_total_data_amount,
+static void dect_phy_perf_server_session_results_str_build(
+	struct dect_phy_perf_rx_session *session, char *results_str)
+{
+	int64_t elapsed_time_ms = session->last_data_received - session->first_data_received;
+	double perf = dect_phy_perf_calculate_throughput(session->total_data_amount,
 							 elapsed_time_ms);
-	char results_str[DECT_PHY_PERF_RESULTS_DATA_MAX_LEN];
 
-	memset(results_str, 0, sizeof(results_str));
-
-	sprintf(results_str, "perf server rx operation from tx id %d:\n",
-		perf_data.rx_metrics.rx_last_tx_id);
-	sprintf(results_str + strlen(results_str), "  total amount of data:   %d bytes\n",
-		perf_data.rx_metrics.rx_total_data_amount);
-	sprintf(results_str + strlen(results_str), "  packet count:           %d\n",
-		perf_data.rx_metrics.rx_total_pkt_count);
-	sprintf(results_str + strlen(results_str), "  elapsed time:           %.2f secs\n",
-		(double)elapsed_time_ms / 1000);
-	sprintf(results_str + strlen(results_str), "  data rates:             %.2f kbits/secs\n",
-		(perf / 1000));
-	sprintf(results_str + strlen(results_str), "  rx restarted count:     %d\n",
-		perf_data.rx_metrics.rx_restarted_count);
+	memset(results_str, 0, DECT_PHY_PERF_RESULTS_DATA_MAX_LEN);
+
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "perf server rx operation from tx id %d:\n",
+					 session->tx_id);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  total amount of data:   %d bytes\n",
+					 session->total_data_amount);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  packet count:           %d\n",
+					 session->total_pkt_count);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  elapsed time:           %.2f secs\n",
+					 (double)elapsed_time_ms / 1000);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str,
+					 "  data rates:             %.2f kbits/secs\n",
+					 (elapsed_time_ms > 0) ? (perf / 1000) : 0.0);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  rx restarted count:     %d\n",
+					 perf_data.rx_metrics.rx_restarted_count);
 	if (perf_data.tx_metrics.tx_total_data_amount) {
-		sprintf(results_str + strlen(results_str), "  HARQ feedback tx bytes: %d\n",
-			perf_data.tx_metrics.tx_total_data_amount);
-	}
-	sprintf(results_str + strlen(results_str), "  PCC CRC errors: %d\n",
-		perf_data.rx_metrics.rx_pcc_crc_error_count);
-	sprintf(results_str + strlen(results_str), "  PDC CRC errors: %d\n",
-		perf_data.rx_metrics.rx_pdc_crc_error_count);
-	sprintf(results_str + strlen(results_str), "  out of seqs:    %d\n",
-		perf_data.rx_metrics.rx_out_of_seq_count);
-	sprintf(results_str + strlen(results_str), "  PCC RX: MCS:    %d\n",
-		perf_data.rx_metrics.rx_testing_mcs);
-	sprintf(results_str + strlen(results_str), "  PCC RX: RSSI: min:  %d, max: %ddBm\n",
-		perf_data.rx_metrics.rx_rssi_low_level, perf_data.rx_metrics.rx_rssi_high_level);
-	sprintf(results_str + strlen(results_str), "  PCC RX: TX pwr: min %d, max %d dBm\n",
+		DECT_PHY_PERF_RESULTS_STR_APPEND(results_str,
+						 "  HARQ feedback tx bytes: %d\n",
+						 perf_data.tx_metrics.tx_total_data_amount);
+	}
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  PCC CRC errors: %d\n",
+					 perf_data.rx_metrics.rx_pcc_crc_error_count);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  PDC CRC errors: %d\n",
+					 perf_data.rx_metrics.rx_pdc_crc_error_count);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(
+		results_str, "  lost: %u, duplicates: %u, reordered: %u, late: %u\n",
+		dect_common_seq_window_lost_count_get(&session->rx_window),
+		session->rx_window.duplicate_count, session->rx_window.reordered_count,
+		session->rx_window.late_count);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(
+		results_str, "  interarrival jitter:    %u usecs\n",
+		DECT_PHY_PERF_MDM_TICKS_TO_US(dect_common_seq_window_jitter_get(&session->rx_window)));
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  PCC RX: MCS histogram:");
+	for (int i = 0; i < DECT_PHY_PERF_MCS_HISTOGRAM_LEN; i++) {
+		if (session->mcs_histogram[i]) {
+			DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, " %d:%u", i,
+							 session->mcs_histogram[i]);
+		}
+	}
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "\n");
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  PCC RX: RSSI: min:  %d, max: %ddBm\n",
+					 perf_data.rx_metrics.rx_rssi_low_level,
+					 perf_data.rx_metrics.rx_rssi_high_level);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(
+		results_str, "  PCC RX: TX pwr: min %d, max %d dBm\n",
 		dect_common_utils_phy_tx_power_to_dbm(perf_data.rx_metrics.rx_phy_transmit_pwr_low),
 		dect_common_utils_phy_tx_power_to_dbm(
 			perf_data.rx_metrics.rx_phy_transmit_pwr_high));
-	sprintf(results_str + strlen(results_str), "  PCC RX: SNR: min:    %d, max: %d\n",
-		perf_data.rx_metrics.rx_snr_low, perf_data.rx_metrics.rx_snr_high);
+	DECT_PHY_PERF_RESULTS_STR_APPEND(results_str, "  PCC RX: SNR: min:    %d, max: %d\n",
+					 perf_data.rx_metrics.rx_snr_low,
+					 perf_data.rx_metrics.rx_snr_high);
+}
+
+/* Cell level summary over all sessions */
+static void dect_phy_perf_server_aggregate_print(void)
+{
+	uint32_t total_data_amount = 0, total_pkt_count = 0;
+	uint32_t lost_count = 0, duplicate_count = 0, reordered_count = 0;
+	int64_t first_data_received = 0, last_data_received = 0;
+	int session_count = 0;
+
+	for (int i = 0; i < DECT_PHY_PERF_SERVER_SESSION_COUNT; i++) {
+		struct dect_phy_perf_rx_session *session = &perf_data.server_data.rx_sessions[i];
+
+		if (!session->in_use) {
+			continue;
+		}
+		session_count++;
+		total_data_amount += session->total_data_amount;
+		total_pkt_count += session->total_pkt_count;
+		lost_count += dect_common_seq_window_lost_count_get(&session->rx_window);
+		duplicate_count += session->rx_window.duplicate_count;
+		reordered_count += session->rx_window.reordered_count;
+		if (first_data_received == 0 || session->first_data_received < first_data_received) {
+			first_data_received = session->first_data_received;
+		}
+		if (session->last_data_received > last_data_received) {
+			last_data_received = session->last_data_received;
+		}
+	}
+
+	int64_t elapsed_time_ms = last_data_received - first_data_received;
+	double perf = dect_phy_perf_calculate_throughput(total_data_amount, elapsed_time_ms);
+
+	desh_print("perf server aggregate over %d client(s):", session_count);
+	desh_print("  total amount of data:   %u bytes", total_data_amount);
+	desh_print("  packet count:           %u", total_pkt_count);
+	desh_print("  elapsed time:           %.2f secs", (double)elapsed_time_ms / 1000);
+	desh_print("  cell data rates:        %.2f kbits/secs",
+		   (elapsed_time_ms > 0) ? (perf / 1000) : 0.0);
+	desh_print("  lost: %u, duplicates: %u, reordered: %u", lost_count, duplicate_count,
+		   reordered_count);
+	if (perf_data.server_data.rx_session_table_full_count) {
+		desh_print("  not tracked packets (session table full): %u",
+			   perf_data.server_data.rx_session_table_full_count);
+	}
+}
+
+/* Report to a requesting client. Its session is closed after sending. */
+static void dect_phy_perf_server_report_to_requester(uint16_t requester_tx_id)
+{
+	struct dect_phy_perf_rx_session *session =
+		dect_phy_perf_server_session_get(requester_tx_id);
+	struct dect_phy_perf_rx_session no_data_session = {
+		.tx_id = requester_tx_id,
+	};
+	char results_str[DECT_PHY_PERF_RESULTS_DATA_MAX_LEN];
+
+	if (session == NULL) {
+		/* Seen only in a PCC: report zeros to it */
+		session = &no_data_session;
+	}
+	dect_phy_perf_server_session_results_str_build(session, results_str);
+	dect_phy_perf_server_aggregate_print();
 
 	desh_print("server: sending result response of total length: %d:\n\"%s\"\n",
 		   (strlen(results_str) + 1), results_str);
 
-	/* Send results to client: */
 	(void)nrf_modem_dect_phy_cancel(DECT_PHY_PERF_SERVER_RX_HANDLE);
-	if (dect_phy_perf_server_results_tx(results_str)) {
+	if (dect_phy_perf_server_results_tx(requester_tx_id, results_str)) {
 		desh_error("Cannot start sending server results");
 	}
 
+	/* Clear results of the requester. Common metrics only when there are no others. */
+	session->in_use = false;
+	if (dect_phy_perf_server_session_count_get() == 0) {
+		dect_phy_perf_data_rx_metrics_init();
+	}
+}
+
+/* Report all sessions locally, e.g. when server is stopped */
+static void dect_phy_perf_server_report_local_and_tx_results(void)
+{
+	struct dect_phy_perf_rx_session *last_session = NULL;
+	char results_str[DECT_PHY_PERF_RESULTS_DATA_MAX_LEN];
+
+	if (!perf_data.rx_metrics.rx_total_data_amount) {
+		desh_warn("No perf data received on server side.");
+	}
+
+	for (int i = 0; i < DECT_PHY_PERF_SERVER_SESSION_COUNT; i++) {
+		struct dect_phy_perf_rx_session *session = &perf_data.server_data.rx_sessions[i];
+
+		if (!session->in_use) {
+			continue;
+		}
+		dect_phy_perf_server_session_results_str_build(session, results_str);
+		desh_print("%s", results_str);
+		if (session->tx_id == perf_data.rx_metrics.rx_last_tx_id) {
+			last_session = session;
+		}
+	}
+	dect_phy_perf_server_aggregate_print();
+
+	/* As before: send results to the last client that we have received from */
+	if (last_session) {
+		dect_phy_perf_server_session_results_str_build(last_session, results_str);
+		desh_print("server: sending result response to tx id %d",
+			   last_session->tx_id);
+
+		(void)nrf_modem_dect_phy_cancel(DECT_PHY_PERF_SERVER_RX_HANDLE);
+		if (dect_phy_perf_server_results_tx(last_session->tx_id, results_str)) {
+			desh_error("Cannot start sending server results");
+		}
+	}
+
 	/* Clear results */
+	memset(perf_data.server_data.rx_sessions, 0, sizeof(perf_data.server_data.rx_sessions));
+	perf_data.server_data.rx_session_table_full_count = 0;
 	dect_phy_perf_data_rx_metrics_init();
 }
 
@@ -1242,62 +1545,52 @@ void dect_phy_perf_mdm_op_completed(
 			int64_t time_orig_started = perf_data.time_started_ms;
 			int64_t elapsed_time_ms = k_uptime_delta(&time_orig_started);
 
-			if (!perf_data.perf_ongoing ||
-			    (elapsed_time_ms >= (perf_data.cmd_params.duration_secs * 1000))) {
-				(void)dect_phy_perf_client_report_local_results_and_req_srv_results(
-					&elapsed_time_ms);
-				return;
-			}
-			struct dect_phy_perf_params *params = &(perf_data.cmd_params);
-			uint32_t harq_mdm_ticks = 0;
-
-			if (params->use_harq) {
-				harq_mdm_ticks =
-					(params->client_harq_feedback_rx_delay_subslot_count *
-					 DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS) +
-					(params->client_harq_feedback_rx_subslot_count *
-					 DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
+			if (perf_data.client_data.tx_in_flight_count) {
+				perf_data.client_data.tx_in_flight_count--;
 			}
-
 			if (mdm_completed_params->status != NRF_MODEM_DECT_PHY_SUCCESS) {
 				/* TX was not done */
 				dect_phy_perf_tx_total_data_decrease();
 				perf_data.tx_metrics.tx_total_pkt_count--;
-			}
 
-			if (mdm_completed_params->handle ==
-				    perf_data.client_data.tx_last_round_starting_handle ||
-			    mdm_completed_params->handle ==
-				    perf_data.client_data
-					    .tx_harq_feedback_rx_last_round_middle_handle) {
-				struct dect_phy_settings *current_settings =
-					dect_common_settings_ref_get();
-				uint64_t time_now = dect_app_modem_time_now();
-				uint64_t first_possible_tx =
-					time_now +
-					(US_TO_MODEM_TICKS(
-						current_settings->scheduler.scheduling_delay_us));
-
-				/* One TX with HARQ iteration:
-				 * actual TX + HARQ feedback delay + HARQ feedback RX + gap
-				 */
-				uint64_t iteration_mdm_ticks =
-					harq_mdm_ticks +
-					((params->slot_count *
-					  DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS) +
-					 params->slot_gap_count_in_mdm_ticks);
-				uint64_t next_scheduled_tx =
-					perf_data.client_data
-						.tx_last_scheduled_mdm_op_start_time_mdm_ticks +
-					iteration_mdm_ticks;
-				uint64_t next_possible_tx = next_scheduled_tx;
-
-				while (next_possible_tx < first_possible_tx) {
-					next_possible_tx = next_possible_tx + iteration_mdm_ticks;
+				if (perf_data.cmd_params.use_harq) {
+					struct dect_phy_perf_harq_tx_process_info *harq_pinfo =
+						dect_phy_perf_harq_tx_process_get_by_handle(
+							mdm_completed_params->handle);
+
+					/* Send again with the same redundancy version */
+					if (harq_pinfo && !harq_pinfo->rtx_pending) {
+						if (harq_pinfo->rtx_count) {
+							harq_pinfo->rtx_count--;
+							perf_data.tx_metrics.tx_harq_rtx_count--;
+						}
+						harq_pinfo->rtx_pending = true;
+					}
 				}
-				dect_phy_perf_client_tx(next_possible_tx);
 			}
 
+			if (!perf_data.perf_ongoing ||
+			    (elapsed_time_ms >= (perf_data.cmd_params.duration_secs * 1000))) {
+				(void)dect_phy_perf_client_report_local_results_and_req_srv_results(
+					&elapsed_time_ms);
+				return;
+			}
+
+			/* Refill the pipeline right away */
+			dect_phy_perf_client_tx_pipeline_fill();
+		} else if (DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_IN_RANGE(
+				   mdm_completed_params->handle)) {
+			struct dect_phy_perf_harq_tx_process_info *harq_pinfo =
+				dect_phy_perf_harq_tx_process_get_by_handle(
+					mdm_completed_params->handle);
+
+			/* Still waiting for feedback after the RX: handle as a NACK */
+			if (harq_pinfo && !harq_pinfo->rtx_pending) {
+				perf_data.tx_metrics.tx_harq_timeout_count++;
+				dect_phy_perf_tx_total_data_decrease();
+				dect_phy_perf_harq_tx_process_nack_handle(harq_pinfo);
+				dect_phy_perf_client_tx_pipeline_fill();
+			}
 		} else if (mdm_completed_params->handle == DECT_PHY_PERF_SERVER_RX_HANDLE) {
 			/* Restart server in case of when max duration of RX operation elapses */
 			uint16_t secs_left = dect_phy_perf_time_secs_left();
@@ -1428,35 +1721,7 @@ static void dect_phy_perf_thread_fn(void)
 				break;
 			}
 
-			struct dect_phy_settings *current_settings = dect_common_settings_ref_get();
-			struct dect_phy_perf_params *params = &(perf_data.cmd_params);
-			uint64_t time_now = dect_app_modem_time_now();
-			uint32_t harq_mdm_ticks =
-				(params->client_harq_feedback_rx_delay_subslot_count *
-				 DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS) +
-				(params->client_harq_feedback_rx_subslot_count *
-				 DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS);
-			uint64_t first_possible_tx =
-				time_now +
-				(US_TO_MODEM_TICKS(
-					current_settings->scheduler.scheduling_delay_us));
-			/* One TX with HARQ iteration:
-			 * actual TX + HARQ feedback delay + RX for HARQ feedback + gap
-			 */
-			uint64_t iteration_mdm_ticks =
-				harq_mdm_ticks +
-				((params->slot_count * DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS) +
-				 params->slot_gap_count_in_mdm_ticks);
-			uint64_t next_scheduled_tx =
-				perf_data.client_data
-					.tx_last_scheduled_mdm_op_start_time_mdm_ticks +
-				iteration_mdm_ticks;
-			uint64_t next_possible_tx = next_scheduled_tx;
-
-			while (next_possible_tx < first_possible_tx) {
-				next_possible_tx = next_possible_tx + iteration_mdm_ticks;
-			}
-			dect_phy_perf_client_tx_with_harq(next_possible_tx);
+			dect_phy_perf_client_tx_pipeline_fill();
 			break;
 		}
 
@@ -1482,11 +1747,11 @@ static void dect_phy_perf_thread_fn(void)
 				} else if (params->handle == DECT_HARQ_FEEDBACK_TX_HANDLE) {
 					desh_error("%s: cannot TX HARQ feedback: %s", __func__,
 						   tmp_str);
-				} else if (params->handle ==
-					   DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_IN_RANGE(
+				} else if (DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_IN_RANGE(
 						   params->handle)) {
 					desh_error("%s: cannot RX for HARQ feedback: %s", __func__,
 						   tmp_str);
+					dect_phy_perf_mdm_op_completed(params);
 				} else {
 					desh_error(
 						"%s: operation (handle %d) failed with status: %s",
@@ -1497,14 +1762,19 @@ static void dect_phy_perf_thread_fn(void)
 				    params->handle == DECT_PHY_PERF_SERVER_RX_HANDLE ||
 				    params->handle == DECT_PHY_PERF_RESULTS_REQ_TX_HANDLE ||
 				    params->handle == DECT_PHY_PERF_RESULTS_RESP_TX_HANDLE ||
-				    params->handle == DECT_PHY_PERF_RESULTS_RESP_RX_HANDLE) {
+				    params->handle == DECT_PHY_PERF_RESULTS_RESP_RX_HANDLE ||
+				    DECT_PHY_PERF_HARQ_FEEDBACK_RX_HANDLE_IN_RANGE(params->handle)) {
 					dect_phy_perf_mdm_op_completed(params);
 				}
 			}
 			break;
 		}
 		case DECT_PHY_PERF_EVENT_SERVER_REPORT: {
-			dect_phy_perf_server_report_local_and_tx_results();
+			if (event.data) {
+				dect_phy_perf_server_report_to_requester(*((uint16_t *)event.data));
+			} else {
+				dect_phy_perf_server_report_local_and_tx_results();
+			}
 			break;
 		}
 		case DECT_PHY_PERF_EVENT_RX_PCC_CRC_ERROR: {
@@ -1590,22 +1860,23 @@ static void dect_phy_perf_thread_fn(void)
 						rcv_harq_process_nbr);
 
 				if (!(header->format == DECT_PHY_HEADER_FORMAT_001 &&
-				      harq_pinfo->process_in_use)) {
+				      harq_pinfo->process_in_use && !harq_pinfo->rtx_pending)) {
 					goto rx_pcc_debug;
 				}
 				if (header->feedback.format1.format == 1) {
 					if (header->feedback.format1.transmission_feedback0) {
 						/* ACK: clear the HARQ process resources */
 						perf_data.rx_metrics.harq_ack_rx_count++;
+						dect_phy_perf_harq_tx_process_release(
+							rcv_harq_process_nbr);
 					} else {
-						/* Handle NACK (with perf cmd we are
-						 * not retransmitting)
-						 */
-
+						/* NACK: retransmission adds the data back */
 						perf_data.rx_metrics.harq_nack_rx_count++;
 						dect_phy_perf_tx_total_data_decrease();
+						dect_phy_perf_harq_tx_process_nack_handle(harq_pinfo);
 					}
-					dect_phy_perf_harq_tx_process_release(rcv_harq_process_nbr);
+					/* Freed process or pending retransmission: refill */
+					dect_phy_perf_client_tx_pipeline_fill();
 				} else if (header->feedback.format6.format == 6) {
 					perf_data.rx_metrics.harq_reset_nack_rx_count++;
 					dect_phy_perf_tx_total_data_decrease();
@@ -1879,52 +2150,82 @@ static int dect_phy_perf_rx_pdc_data_handle(struct dect_phy_data_rcv_common_para
 		return -EBADMSG;
 	}
 	if (pdu.header.message_type == DECT_MAC_MESSAGE_TYPE_PERF_TX_DATA) {
+		struct dect_phy_perf_rx_session *session =
+			dect_phy_perf_server_session_get_or_add(pdu.header.transmitter_id);
+
 		perf_data.rx_metrics.rx_testing_mcs = perf_data.rx_metrics.rx_latest_mcs;
 		if (perf_data.rx_metrics.rx_total_data_amount == 0) {
 			perf_data.rx_metrics.rx_1st_data_received = k_uptime_get();
-			perf_data.rx_metrics.rx_last_seq_nbr = pdu.message.tx_data.seq_nbr;
-		} else {
-			if (pdu.message.tx_data.seq_nbr !=
-			    (perf_data.rx_metrics.rx_last_seq_nbr + 1)) {
-				struct dect_phy_perf_params *cmd_params = &(perf_data.cmd_params);
-
-				perf_data.rx_metrics.rx_out_of_seq_count++;
-				if (cmd_params->debugs) {
-					desh_warn("Out of seq in RX: rx_out_of_seq_count %d, "
-						  "pdu.seq_nbr %d, perf_data.rx_last_seq_nbr "
-						  "%d",
-						  perf_data.rx_metrics.rx_out_of_seq_count,
-						  pdu.message.tx_data.seq_nbr,
-						  perf_data.rx_metrics.rx_last_seq_nbr);
-				}
-			}
 		}
 		perf_data.rx_metrics.rx_total_data_amount += params->data_length;
 		perf_data.rx_metrics.rx_total_pkt_count++;
-		perf_data.rx_metrics.rx_last_seq_nbr = pdu.message.tx_data.seq_nbr;
 		perf_data.rx_metrics.rx_last_tx_id = pdu.header.transmitter_id;
 		perf_data.rx_metrics.rx_last_data_received = k_uptime_get();
+
+		if (session == NULL) {
+			perf_data.server_data.rx_session_table_full_count++;
+			return 0;
+		}
+		if (session->total_pkt_count == 0) {
+			session->first_data_received = k_uptime_get();
+		}
+
+		/* Client stamps version byte + its scheduled TX time at the payload start */
+		bool has_tx_time = pdu.message.tx_data.payload_length >=
+					   DECT_PHY_PERF_TX_DATA_PAYLOAD_TX_TIME_LEN &&
+				   pdu.message.tx_data.pdu_payload[0] ==
+					   DECT_PHY_PERF_TX_DATA_PAYLOAD_TX_TIME_VER;
+		const uint8_t *tx_time_ptr = pdu.message.tx_data.pdu_payload + 1;
+		uint32_t tx_time = has_tx_time ? dect_common_utils_32bit_be_read(&tx_time_ptr) : 0;
+		uint32_t prev_max_seq_nbr = session->rx_window.max_ext_seq;
+		enum dect_common_seq_window_class seq_class = dect_common_seq_window_update(
+			&session->rx_window, pdu.message.tx_data.seq_nbr, has_tx_time, tx_time,
+			(uint32_t)params->time);
+
+		if (seq_class != DECT_COMMON_SEQ_WINDOW_CLASS_NEW ||
+		    (session->total_pkt_count &&
+		     session->rx_window.max_ext_seq != prev_max_seq_nbr + 1)) {
+			perf_data.rx_metrics.rx_out_of_seq_count++;
+			if (perf_data.cmd_params.debugs) {
+				desh_warn("Out of seq in RX from tx id %d: pdu.seq_nbr %d (%s), "
+					  "previous max seq_nbr %u, lost %u",
+					  session->tx_id, pdu.message.tx_data.seq_nbr,
+					  dect_common_seq_window_class_to_string(seq_class),
+					  (uint16_t)prev_max_seq_nbr,
+					  dect_common_seq_window_lost_count_get(
+						  &session->rx_window));
+			}
+		}
+		if (seq_class == DECT_COMMON_SEQ_WINDOW_CLASS_DUPLICATE) {
+			return 0;
+		}
+		session->total_data_amount += params->data_length;
+		session->total_pkt_count++;
+		session->last_data_received = k_uptime_get();
+		session->mcs_histogram[perf_data.rx_metrics.rx_latest_mcs &
+				       (DECT_PHY_PERF_MCS_HISTOGRAM_LEN - 1)]++;
 	} else if (pdu.header.message_type == DECT_MAC_MESSAGE_TYPE_PERF_RESULTS_REQ) {
-		if (pdu.header.transmitter_id == perf_data.rx_metrics.rx_last_tx_id) {
-			desh_print("RESULT_REQ received from tx id %d", pdu.header.transmitter_id);
-			dect_phy_perf_msgq_non_data_op_add(DECT_PHY_PERF_EVENT_SERVER_REPORT);
-		} else if (pdu.header.transmitter_id ==
-				perf_data.rx_metrics.rx_last_tx_id_from_pcc) {
+		uint16_t requester_tx_id = pdu.header.transmitter_id;
+
+		if (dect_phy_perf_server_session_get(requester_tx_id) != NULL) {
+			desh_print("RESULT_REQ received from tx id %d", requester_tx_id);
+			dect_phy_perf_msgq_data_op_add(DECT_PHY_PERF_EVENT_SERVER_REPORT,
+						       &requester_tx_id, sizeof(requester_tx_id));
+		} else if (requester_tx_id == perf_data.rx_metrics.rx_last_tx_id_from_pcc) {
 			desh_warn("PERF_RESULTS_REQ received from tx id %d - but no perf "
 				  "data received from there.\n"
 				  "However, we have seen a PCC lastly from this tx id %d - "
 				  "so sending results to there.\n"
 				  "Please, check MCS and/or TX PWR on a client side.",
-				  pdu.header.transmitter_id,
+				  requester_tx_id,
 				  perf_data.rx_metrics.rx_last_tx_id_from_pcc);
-			perf_data.rx_metrics.rx_last_tx_id =
-				perf_data.rx_metrics.rx_last_tx_id_from_pcc;
-			dect_phy_perf_msgq_non_data_op_add(DECT_PHY_PERF_EVENT_SERVER_REPORT);
+			dect_phy_perf_msgq_data_op_add(DECT_PHY_PERF_EVENT_SERVER_REPORT,
+						       &requester_tx_id, sizeof(requester_tx_id));
 		} else {
 			desh_warn("PERF_RESULTS_REQ received from tx id %d - but no perf "
-				  "session with it (last seen tx id %d). "
+				  "session with it (%d sessions). "
 				  "Check MCS and/or TX PWR on a client side.",
-				  pdu.header.transmitter_id, perf_data.rx_metrics.rx_last_tx_id);
+				  requester_tx_id, dect_phy_perf_server_session_count_get());
 		}
 	} else if (pdu.header.message_type == DECT_MAC_MESSAGE_TYPE_PERF_RESULTS_RESP) {
 		desh_print("Server results received:");
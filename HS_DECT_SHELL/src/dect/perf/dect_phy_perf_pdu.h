@@ -30,6 +30,12 @@ typedef enum {
 	(DECT_DATA_MAX_LEN - DECT_PHY_PERF_TX_DATA_PDU_LEN_WITHOUT_PAYLOAD)
 #define DECT_PHY_PERF_RESULTS_REQ_LEN	    (DECT_PHY_PERF_PDU_COMMON_PART_LEN + sizeof(uint32_t))
 #define DECT_PHY_PERF_RESULTS_DATA_MAX_LEN 491
+
+/* TX data payload may start with a version byte followed by 32-bit BE TX time.
+ * The marker is outside of the '0'..'9' fill pattern of older clients.
+ */
+#define DECT_PHY_PERF_TX_DATA_PAYLOAD_TX_TIME_VER 0xA1
+#define DECT_PHY_PERF_TX_DATA_PAYLOAD_TX_TIME_LEN (sizeof(uint8_t) + sizeof(uint32_t))
 typedef struct {
 	char results_str[DECT_PHY_PERF_RESULTS_DATA_MAX_LEN];
 } dect_phy_perf_pdu_results_resp_data;
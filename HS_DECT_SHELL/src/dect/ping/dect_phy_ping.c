@@ -21,6 +21,8 @@
 #include "dect_phy_common_rx.h"
 #include "dect_common_settings.h"
 #include "dect_common_utils.h"
+#include "dect_common_seq_window.h"
+#include "dect_common_hdr_hist.h"
 
 #include "dect_phy_api_scheduler.h"
 #include "dect_phy_ctrl.h"
@@ -30,6 +32,9 @@
 
 K_SEM_DEFINE(ping_phy_api_init, 0, 1);
 
+#define DECT_PHY_PING_MDM_TICKS_TO_US(ticks)                                                     \
+	((uint32_t)(((uint64_t)(ticks) * 1000) / NRF_MODEM_DECT_MODEM_TIME_TICK_RATE_KHZ))
+
 /**************************************************************************************************/
 
 struct dect_phy_ping_rssi_scan_data {
@@ -66,6 +71,13 @@ struct dect_phy_ping_rx_metrics {
 	uint32_t rx_pdc_crc_error_count;
 	uint32_t rx_out_of_seq_count;
 	uint32_t rx_decode_error;
+	uint32_t rx_ping_timeout_count;
+
+	/* Server: ping reqs. Client: ping resps, jitter from RTTs. */
+	struct dect_common_seq_window rx_window;
+
+	/* Client: RTTs in usecs */
+	struct dect_common_hdr_hist rx_rtt_hist;
 
 	int8_t rx_rssi_high_level;
 	int8_t rx_rssi_low_level;
@@ -106,12 +118,23 @@ struct dect_phy_ping_harq_tx_process_info {
 	struct dect_phy_api_scheduler_list_item sche_list_item;
 };
 
+/* Ping request sent to modem, from scheduler thread to ping thread */
+struct dect_phy_ping_client_req_sent {
+	uint16_t seq_nbr;
+	uint64_t tx_time_mdm_ticks;
+};
+
+struct dect_phy_ping_client_outstanding_req {
+	bool in_use;
+	uint16_t seq_nbr;
+	uint64_t tx_time_mdm_ticks;
+};
+
 struct dect_phy_ping_client_data {
 	int64_t tx_ping_req_tx_scheduled_mdm_ticks;
 
 	bool tx_results_from_server_requested;
 	bool tx_scheduler_intervals_done;
-	bool tx_ping_resp_received;
 	int64_t tx_last_scheduled_mdm_op_start_time_mdm_ticks;
 	uint16_t tx_next_seq_nbr;
 	uint16_t tx_data_len;
@@ -120,6 +143,9 @@ struct dect_phy_ping_client_data {
 	union nrf_modem_dect_phy_hdr tx_phy_header;
 	struct nrf_modem_dect_phy_tx_params tx_op;
 	struct nrf_modem_dect_phy_rx_params rx_op; /* For ping resp */
+
+	/* Waiting for a response, up to cmd_params.outstanding_max in use */
+	struct dect_phy_ping_client_outstanding_req outstanding[DECT_PHY_PING_OUTSTANDING_MAX];
 };
 
 struct dect_phy_ping_server_data {
@@ -188,6 +214,8 @@ static void dect_phy_ping_data_reset(void)
 static void dect_phy_ping_rx_metrics_reset(struct dect_phy_ping_params *params)
 {
 	memset(&ping_data.rx_metrics, 0, sizeof(struct dect_phy_ping_rx_metrics));
+	dect_common_seq_window_init(&ping_data.rx_metrics.rx_window);
+	dect_common_hdr_hist_init(&ping_data.rx_metrics.rx_rtt_hist);
 
 	ping_data.rx_metrics.rx_rssi_high_level = -127;
 	ping_data.rx_metrics.rx_rssi_low_level = 1;
@@ -317,6 +345,21 @@ void dect_phy_ping_harq_store_tx_payload_data_scheduler_cb(
 	dect_phy_api_scheduler_list_item_mem_copy(ctrl_sche_list_item, in_sche_list_item);
 	dect_phy_api_scheduler_list_item_dealloc(in_sche_list_item);
 
+	/* The copy of a 1st TX was taken by the scheduler after
+	 * dect_phy_ping_client_tx_to_mdm_cb() had written the seq nbr of the next interval:
+	 * put back the one that was sent. Copies of reTXs are as sent.
+	 */
+	if (ctrl_sche_list_item->phy_op_handle == DECT_PHY_PING_CLIENT_TX_HANDLE &&
+	    ctrl_sche_list_item->sched_config.tx.encoded_payload_pdu_size >=
+	    (DECT_PHY_PING_PDU_HEADER_LEN + sizeof(uint16_t))) {
+		uint8_t *seq_nbr_ptr = ctrl_sche_list_item->sched_config.tx.encoded_payload_pdu +
+				       DECT_PHY_PING_PDU_HEADER_LEN;
+		const uint8_t *read_ptr = seq_nbr_ptr;
+		uint16_t seq_nbr = dect_common_utils_16bit_be_read(&read_ptr);
+
+		dect_common_utils_16bit_be_write(seq_nbr_ptr, seq_nbr - 1);
+	}
+
 	dect_phy_ping_msgq_data_op_add(DECT_PHY_PING_EVENT_HARQ_PAYLOAD_STORED, (void *)&harq_user,
 				       sizeof(enum dect_harq_user));
 }
@@ -375,6 +418,9 @@ void dect_phy_ping_harq_client_nak_handle(void)
 	new_sched_list_item_conf->cb_op_to_mdm_with_interval_count_completed = NULL;
 	new_sched_list_item_conf->cb_op_completed = NULL;
 
+	/* Not a new ping req: no seq nbr update */
+	new_sched_list_item_conf->cb_op_to_mdm = NULL;
+
 	struct dect_phy_header_type2_format0_t *header =
 		(void *)&(new_sched_list_item_conf->tx.phy_header);
 
@@ -762,6 +808,116 @@ static void dect_phy_ping_client_tx_complete_cb(
 	}
 }
 
+K_MSGQ_DEFINE(dect_phy_ping_client_req_sent_msgq, sizeof(struct dect_phy_ping_client_req_sent),
+	      DECT_PHY_PING_OUTSTANDING_MAX, 4);
+
+static bool dect_phy_ping_client_is_pipelined(void)
+{
+	return ping_data.cmd_params.outstanding_max > 1;
+}
+
+static void dect_phy_ping_client_tx_to_mdm_cb(
+	struct dect_phy_common_op_completed_params *params, uint64_t tx_frame_time)
+{
+	/* Called in scheduler thread when a ping req has been given to modem, i.e. before the
+	 * scheduler can give the next interval. Thus, seq nbr for that is updated here.
+	 * Note: this is before the scheduler copies the item for HARQ rtx, see
+	 * dect_phy_ping_harq_store_tx_payload_data_scheduler_cb().
+	 */
+	struct dect_phy_ping_client_req_sent req_sent = {
+		.seq_nbr = ping_data.client_data.tx_next_seq_nbr,
+		.tx_time_mdm_ticks = params->time,
+	};
+	uint8_t *encoded_data_to_send = ping_data.client_data.tx_data;
+	uint8_t *seq_nbr_ptr = encoded_data_to_send + DECT_PHY_PING_PDU_HEADER_LEN;
+
+	if (k_msgq_put(&dect_phy_ping_client_req_sent_msgq, &req_sent, K_NO_WAIT)) {
+		desh_warn("%s: cannot store sent ping req (seq_nbr %d)", __func__,
+			  req_sent.seq_nbr);
+	}
+
+	ping_data.client_data.tx_next_seq_nbr++;
+	dect_common_utils_16bit_be_write(seq_nbr_ptr, ping_data.client_data.tx_next_seq_nbr);
+	dect_phy_api_scheduler_list_item_pdu_payload_update_by_phy_handle(
+		DECT_PHY_PING_CLIENT_TX_HANDLE, encoded_data_to_send,
+		ping_data.client_data.tx_data_len);
+}
+
+static void dect_phy_ping_client_outstanding_timeout(
+	struct dect_phy_ping_client_outstanding_req *req)
+{
+	desh_warn("ping timeout for seq_nbr %d", req->seq_nbr);
+	req->in_use = false;
+	ping_data.rx_metrics.rx_ping_timeout_count++;
+}
+
+static void dect_phy_ping_client_outstanding_expire(uint64_t time_now)
+{
+	uint64_t timeout_mdm_ticks = MS_TO_MODEM_TICKS((uint64_t)ping_data.cmd_params.timeout_msecs);
+
+	for (int i = 0; i < ping_data.cmd_params.outstanding_max; i++) {
+		struct dect_phy_ping_client_outstanding_req *req =
+			&ping_data.client_data.outstanding[i];
+
+		if (req->in_use && time_now > req->tx_time_mdm_ticks &&
+		    (time_now - req->tx_time_mdm_ticks) > timeout_mdm_ticks) {
+			dect_phy_ping_client_outstanding_timeout(req);
+		}
+	}
+}
+
+static void dect_phy_ping_client_outstanding_flush(void)
+{
+	for (int i = 0; i < ping_data.cmd_params.outstanding_max; i++) {
+		if (ping_data.client_data.outstanding[i].in_use) {
+			dect_phy_ping_client_outstanding_timeout(&ping_data.client_data.outstanding[i]);
+		}
+	}
+}
+
+static void dect_phy_ping_client_outstanding_add(struct dect_phy_ping_client_req_sent *req_sent)
+{
+	struct dect_phy_ping_client_outstanding_req *oldest = NULL;
+	struct dect_phy_ping_client_outstanding_req *free_req = NULL;
+
+	dect_phy_ping_client_outstanding_expire(dect_app_modem_time_now());
+
+	for (int i = 0; i < ping_data.cmd_params.outstanding_max; i++) {
+		struct dect_phy_ping_client_outstanding_req *req =
+			&ping_data.client_data.outstanding[i];
+
+		if (!req->in_use) {
+			free_req = req;
+			break;
+		}
+		if (!oldest || req->tx_time_mdm_ticks < oldest->tx_time_mdm_ticks) {
+			oldest = req;
+		}
+	}
+	if (!free_req) {
+		/* All in use: the oldest one is given up */
+		dect_phy_ping_client_outstanding_timeout(oldest);
+		free_req = oldest;
+	}
+	free_req->in_use = true;
+	free_req->seq_nbr = req_sent->seq_nbr;
+	free_req->tx_time_mdm_ticks = req_sent->tx_time_mdm_ticks;
+}
+
+static struct dect_phy_ping_client_outstanding_req *
+dect_phy_ping_client_outstanding_find(uint16_t seq_nbr)
+{
+	for (int i = 0; i < ping_data.cmd_params.outstanding_max; i++) {
+		struct dect_phy_ping_client_outstanding_req *req =
+			&ping_data.client_data.outstanding[i];
+
+		if (req->in_use && req->seq_nbr == seq_nbr) {
+			return req;
+		}
+	}
+	return NULL;
+}
+
 static void dect_phy_ping_client_tx_schedule(uint64_t first_possible_tx)
 {
 	struct dect_phy_ping_params *cmd_params = &(ping_data.cmd_params);
@@ -797,10 +953,11 @@ static void dect_phy_ping_client_tx_schedule(uint64_t first_possible_tx)
 		sched_list_item_conf->tx.harq_feedback_requested = true;
 	}
 
+	sched_list_item_conf->cb_op_to_mdm = dect_phy_ping_client_tx_to_mdm_cb;
 	sched_list_item_conf->cb_op_completed = dect_phy_ping_client_tx_complete_cb;
 
 	sched_list_item_conf->interval_mdm_ticks =
-		SECONDS_TO_MODEM_TICKS(cmd_params->interval_secs);
+		MS_TO_MODEM_TICKS((uint64_t)cmd_params->interval_msecs);
 	sched_list_item_conf->interval_count_left = cmd_params->ping_count;
 	sched_list_item_conf->cb_op_to_mdm_with_interval_count_completed =
 		dect_phy_ping_client_tx_all_intervals_done;
@@ -839,7 +996,6 @@ static void dect_phy_ping_client_tx_schedule(uint64_t first_possible_tx)
 		sched_list_item->sched_config.tx.encoded_payload_pdu_size;
 	ping_data.client_data.tx_last_scheduled_mdm_op_start_time_mdm_ticks =
 		sched_list_item_conf->frame_time;
-	ping_data.client_data.tx_ping_resp_received = false;
 
 exit:
 }
@@ -922,13 +1078,13 @@ static int dect_phy_ping_client_start(void)
 	}
 
 	desh_print("Starting ping client on channel %d:\n"
-		   "  byte count per TX: %d, slots %d, interval %d secs,\n"
+		   "  byte count per TX: %d, slots %d, interval %d msecs,\n"
 		   "  mcs %d, LBT period %d, count %d, timeout %d msecs, HARQ: %s,\n"
-		   "  expected RSSI level on RX %d.",
-		   params->channel, ping_pdu_byte_count, params->slot_count, params->interval_secs,
+		   "  max outstanding %d, expected RSSI level on RX %d.",
+		   params->channel, ping_pdu_byte_count, params->slot_count, params->interval_msecs,
 		   params->tx_mcs, params->tx_lbt_period_symbols, params->ping_count,
 		   params->timeout_msecs, (params->use_harq) ? "yes" : "no",
-		   params->expected_rx_rssi_level);
+		   params->outstanding_max, params->expected_rx_rssi_level);
 
 	uint16_t ping_pdu_payload_byte_count =
 		ping_pdu_byte_count - DECT_PHY_PING_TX_DATA_PDU_LEN_WITHOUT_PAYLOAD;
@@ -985,7 +1141,21 @@ static int dect_phy_ping_client_start(void)
 		current_settings->common.transmitter_id;
 	ping_data.client_data.rx_op.carrier = params->channel;
 
-	ping_data.client_data.rx_op.duration = MS_TO_MODEM_TICKS(params->timeout_msecs);
+	/* RX for ping resp must end before the next ping req TX. Later responses to reqs still
+	 * outstanding are received on RX of the following intervals.
+	 */
+	int64_t rx_duration_max = MS_TO_MODEM_TICKS((uint64_t)params->interval_msecs) -
+				  (params->slot_count * DECT_RADIO_SLOT_DURATION_IN_MODEM_TICKS) -
+				  ping_data.client_data.rx_op.start_time -
+				  DECT_RADIO_SUBSLOT_DURATION_IN_MODEM_TICKS;
+
+	if (rx_duration_max <= 0) {
+		desh_error("Interval %d msecs too short for %d slots", params->interval_msecs,
+			   params->slot_count);
+		return -1;
+	}
+	ping_data.client_data.rx_op.duration =
+		MIN(MS_TO_MODEM_TICKS((uint64_t)params->timeout_msecs), (uint64_t)rx_duration_max);
 	ping_data.client_data.rx_op.mode = NRF_MODEM_DECT_PHY_RX_MODE_CONTINUOUS;
 	ping_data.client_data.rx_op.link_id = NRF_MODEM_DECT_PHY_LINK_UNSPECIFIED;
 	ping_data.client_data.rx_op.rssi_level = params->expected_rx_rssi_level;
@@ -997,6 +1167,9 @@ static int dect_phy_ping_client_start(void)
 		ping_data.client_data.rx_op.rssi_interval = NRF_MODEM_DECT_PHY_RSSI_INTERVAL_OFF;
 	}
 
+	memset(ping_data.client_data.outstanding, 0, sizeof(ping_data.client_data.outstanding));
+	k_msgq_purge(&dect_phy_ping_client_req_sent_msgq);
+
 	dect_phy_ping_client_tx_schedule(first_possible_tx);
 
 	return 0;
@@ -1162,6 +1335,7 @@ dect_phy_ping_client_report_local_results_and_req_server_results(int64_t *elapse
 		elapsed_time_ms = *elapsed_time_ms_ptr;
 	}
 	double elapsed_time_secs = elapsed_time_ms / 1000;
+	struct dect_common_hdr_hist *rtt_hist = &ping_data.rx_metrics.rx_rtt_hist;
 
 	/* Stop client ping tx and rx for ping_resp in a scheduler */
 	dect_phy_api_scheduler_list_item_remove_dealloc_by_phy_op_handle(
@@ -1169,6 +1343,9 @@ dect_phy_ping_client_report_local_results_and_req_server_results(int64_t *elapse
 	dect_phy_api_scheduler_list_item_remove_dealloc_by_phy_op_handle(
 		DECT_PHY_PING_CLIENT_RX_HANDLE);
 
+	/* No RX anymore for responses still outstanding */
+	dect_phy_ping_client_outstanding_flush();
+
 	desh_print("ping client operation completed:");
 	desh_print("  elapsed time:                            %.2f seconds", elapsed_time_secs);
 	desh_print("  tx: total amount of data sent:           %d bytes",
@@ -1183,6 +1360,26 @@ dect_phy_ping_client_report_local_results_and_req_server_results(int64_t *elapse
 		   ping_data.rx_metrics.rx_total_data_amount);
 	desh_print("  rx: out of sequence count:               %d",
 		   ping_data.rx_metrics.rx_out_of_seq_count);
+	desh_print("  rx: lost %u, duplicates %u, reordered %u, late %u",
+		   dect_common_seq_window_lost_count_get(&ping_data.rx_metrics.rx_window),
+		   ping_data.rx_metrics.rx_window.duplicate_count,
+		   ping_data.rx_metrics.rx_window.reordered_count,
+		   ping_data.rx_metrics.rx_window.late_count);
+	desh_print("  rx: ping timeout count:                  %d",
+		   ping_data.rx_metrics.rx_ping_timeout_count);
+	desh_print("  rx: RTT jitter:                          %.2f msec",
+		   MODEM_TICKS_TO_MS(
+			   dect_common_seq_window_jitter_get(&ping_data.rx_metrics.rx_window)));
+	if (rtt_hist->count) {
+		desh_print("  rx: RTT min %.2f, mean %.2f, max %.2f msec",
+			   rtt_hist->min / 1000.0, dect_common_hdr_hist_mean_get(rtt_hist) / 1000.0,
+			   rtt_hist->max / 1000.0);
+		desh_print("  rx: RTT p50 %.2f, p90 %.2f, p99 %.2f, p99.9 %.2f msec",
+			   dect_common_hdr_hist_percentile_get(rtt_hist, 500) / 1000.0,
+			   dect_common_hdr_hist_percentile_get(rtt_hist, 900) / 1000.0,
+			   dect_common_hdr_hist_percentile_get(rtt_hist, 990) / 1000.0,
+			   dect_common_hdr_hist_percentile_get(rtt_hist, 999) / 1000.0);
+	}
 	desh_print("  rx: PCC CRC error count:                 %d",
 		   ping_data.rx_metrics.rx_pcc_crc_error_count);
 	desh_print("  rx: PDC CRC error count:                 %d",
@@ -1426,6 +1623,12 @@ static void dect_phy_ping_server_report_local_and_tx_results(void)
 		ping_data.rx_metrics.rx_pdc_crc_error_count);
 	sprintf(results_str + strlen(results_str), "  rx: out of sequence count:  %d\n",
 		ping_data.rx_metrics.rx_out_of_seq_count);
+	sprintf(results_str + strlen(results_str),
+		"  rx: lost %u, duplicates %u, reordered %u, late %u\n",
+		dect_common_seq_window_lost_count_get(&ping_data.rx_metrics.rx_window),
+		ping_data.rx_metrics.rx_window.duplicate_count,
+		ping_data.rx_metrics.rx_window.reordered_count,
+		ping_data.rx_metrics.rx_window.late_count);
 	sprintf(results_str + strlen(results_str), "  rx: PDU decode error count: %d\n",
 		ping_data.rx_metrics.rx_decode_error);
 	sprintf(results_str + strlen(results_str), "  rx: min RSSI %d, max RSSI %d\n",
@@ -1465,19 +1668,26 @@ void dect_phy_ping_mdm_op_completed(
 {
 	if (ping_data.on_going) {
 		if (mdm_completed_params->handle == DECT_PHY_PING_CLIENT_TX_HANDLE) {
-			if (mdm_completed_params->status != NRF_MODEM_DECT_PHY_SUCCESS) {
+			struct dect_phy_ping_client_req_sent req_sent;
+
+			/* Completions come in the same order as reqs were sent to modem */
+			if (k_msgq_get(&dect_phy_ping_client_req_sent_msgq, &req_sent, K_NO_WAIT)) {
+				desh_warn("%s: no sent ping req for TX completion", __func__);
+			} else if (mdm_completed_params->status != NRF_MODEM_DECT_PHY_SUCCESS) {
 				/* TX was not done */
 				dect_phy_ping_client_data_tx_total_data_amount_decrease();
-				desh_print("ping tx failed.");
+				desh_print("ping tx failed (seq_nbr %d).", req_sent.seq_nbr);
 			} else {
-				desh_print("ping sent (seq_nbr %d).",
-					   ping_data.client_data.tx_next_seq_nbr);
+				dect_phy_ping_client_outstanding_add(&req_sent);
+				if (!dect_phy_ping_client_is_pipelined()) {
+					desh_print("ping sent (seq_nbr %d).", req_sent.seq_nbr);
+				}
 			}
 			/* We count both success and failures here */
 			ping_data.tx_metrics.tx_total_ping_req_count++;
 
-			/* Update header for new data ind toggle (only with HARQ) and
-			 * for seq nbr in ping PDU
+			/* Update header for new data ind toggle (only with HARQ).
+			 * Seq nbr in ping PDU has been updated when sent to modem.
 			 */
 			if (ping_data.cmd_params.use_harq) {
 				struct dect_phy_header_type2_format0_t *header =
@@ -1493,21 +1703,6 @@ void dect_phy_ping_mdm_op_completed(
 					&(ping_data.client_data.tx_phy_header),
 					DECT_PHY_HEADER_TYPE2);
 			}
-
-			uint8_t *encoded_data_to_send = ping_data.client_data.tx_data;
-			uint8_t *seq_nbr_ptr = encoded_data_to_send + DECT_PHY_PING_PDU_HEADER_LEN;
-
-			ping_data.client_data.tx_ping_resp_received = false;
-			ping_data.client_data.tx_next_seq_nbr++;
-			dect_common_utils_16bit_be_write(seq_nbr_ptr,
-							 ping_data.client_data.tx_next_seq_nbr);
-
-			if (!ping_data.client_data.tx_scheduler_intervals_done) {
-				/* Modify seq nbr for the next round */
-				dect_phy_api_scheduler_list_item_pdu_payload_update_by_phy_handle(
-					DECT_PHY_PING_CLIENT_TX_HANDLE, encoded_data_to_send,
-					ping_data.client_data.tx_data_len);
-			}
 		} else if (mdm_completed_params->handle == DECT_PHY_PING_SERVER_TX_HANDLE) {
 			if (mdm_completed_params->status != NRF_MODEM_DECT_PHY_SUCCESS) {
 				/* TX was not done */
@@ -1519,10 +1714,9 @@ void dect_phy_ping_mdm_op_completed(
 			}
 		} else if (mdm_completed_params->handle == DECT_PHY_PING_CLIENT_RX_HANDLE) {
 			dect_phy_ping_rssi_done_evt_send();
-			if (!ping_data.client_data.tx_ping_resp_received &&
-			    !harq_processes[DECT_HARQ_CLIENT].rtx_ongoing) {
-				desh_warn("ping timeout for seq_nbr %d",
-					  ping_data.client_data.tx_next_seq_nbr - 1);
+			if (!harq_processes[DECT_HARQ_CLIENT].rtx_ongoing) {
+				dect_phy_ping_client_outstanding_expire(
+					mdm_completed_params->time);
 			}
 			if (ping_data.client_data.tx_scheduler_intervals_done &&
 			    !harq_processes[DECT_HARQ_CLIENT].rtx_ongoing &&
@@ -1669,6 +1863,11 @@ static void dect_phy_ping_thread_fn(void)
 						   "status: %s",
 						   __func__, params->handle, tmp_str);
 				}
+			} else if (params->handle == DECT_PHY_PING_CLIENT_TX_HANDLE) {
+				struct dect_phy_ping_client_req_sent req_sent;
+
+				/* Keep sent reqs in sync with TX completions */
+				k_msgq_get(&dect_phy_ping_client_req_sent_msgq, &req_sent, K_NO_WAIT);
 			}
 			break;
 		}
@@ -2100,21 +2299,28 @@ static int dect_phy_ping_rx_pdc_data_handle(struct dect_phy_data_rcv_common_para
 	ping_data.rx_metrics.rx_pdu_expected_rssi = pdu.header.pwr_ctrl_expected_rssi_level_dbm;
 
 	if (pdu.header.message_type == DECT_MAC_MESSAGE_TYPE_PING_REQUEST) {
+		struct dect_common_seq_window *window = &ping_data.rx_metrics.rx_window;
+		uint32_t prev_max_seq_nbr = window->max_ext_seq;
+		uint16_t prev_seq_nbr = ping_data.server_data.rx_last_seq_nbr;
+		enum dect_common_seq_window_class seq_class;
+
 		dect_phy_ping_rssi_done_evt_send();
 		if (ping_data.rx_metrics.rx_total_data_amount == 0) {
 			ping_data.server_data.rx_1st_data_received = k_uptime_get();
-			ping_data.server_data.rx_last_seq_nbr = pdu.message.tx_data.seq_nbr;
-		} else {
-			if (pdu.message.tx_data.seq_nbr !=
-			    (ping_data.server_data.rx_last_seq_nbr + 1)) {
-				ping_data.rx_metrics.rx_out_of_seq_count++;
-				desh_warn("Out of seq in RX: rx_out_of_seq_count %d, "
-					  "pdu.seq_nbr %d, "
-					  "ping_data.server_data.rx_last_seq_nbr %d",
-					  ping_data.rx_metrics.rx_out_of_seq_count,
-					  pdu.message.tx_data.seq_nbr,
-					  ping_data.server_data.rx_last_seq_nbr);
-			}
+		}
+		seq_class = dect_common_seq_window_update(window, pdu.message.tx_data.seq_nbr,
+							  false, 0, 0);
+		if (seq_class != DECT_COMMON_SEQ_WINDOW_CLASS_NEW ||
+		    (prev_max_seq_nbr && window->max_ext_seq != prev_max_seq_nbr + 1)) {
+			ping_data.rx_metrics.rx_out_of_seq_count++;
+			desh_warn("Out of seq in RX: rx_out_of_seq_count %d, "
+				  "pdu.seq_nbr %d (%s), "
+				  "previous seq_nbr %d, lost %u",
+				  ping_data.rx_metrics.rx_out_of_seq_count,
+				  pdu.message.tx_data.seq_nbr,
+				  dect_common_seq_window_class_to_string(seq_class),
+				  prev_seq_nbr,
+				  dect_common_seq_window_lost_count_get(window));
 		}
 		ping_data.rx_metrics.rx_total_data_amount += params->data_length;
 		ping_data.rx_metrics.rx_total_ping_req_count++;
@@ -2144,29 +2350,32 @@ static int dect_phy_ping_rx_pdc_data_handle(struct dect_phy_data_rcv_common_para
 				&(ping_data.client_data.tx_phy_header), DECT_PHY_HEADER_TYPE2);
 		}
 
-		if (pdu.message.tx_data.seq_nbr == (ping_data.client_data.tx_next_seq_nbr - 1)) {
-			char tmp_str[128] = {0};
-
-			if (ping_data.client_data.tx_ping_req_tx_scheduled_mdm_ticks > 0) {
-				/* Calculate RTT */
-				int64_t rtt_ms = MODEM_TICKS_TO_MS(
-					params->time -
-					ping_data.client_data.tx_ping_req_tx_scheduled_mdm_ticks);
-
-				sprintf(tmp_str, "RTT: %d msec", (uint32_t)rtt_ms);
-			} else {
-				sprintf(tmp_str, "RTT: not known");
+		/* RTT is the transit time: jitter of it from the window */
+		struct dect_phy_ping_client_outstanding_req *req =
+			dect_phy_ping_client_outstanding_find(pdu.message.tx_data.seq_nbr);
+		uint64_t req_tx_time = (req) ? req->tx_time_mdm_ticks : 0;
+		enum dect_common_seq_window_class seq_class = dect_common_seq_window_update(
+			&ping_data.rx_metrics.rx_window, pdu.message.tx_data.seq_nbr, req != NULL,
+			(uint32_t)req_tx_time, (uint32_t)params->time);
+
+		if (seq_class == DECT_COMMON_SEQ_WINDOW_CLASS_DUPLICATE) {
+			desh_warn("duplicate ping response for seq_nbr %d",
+				  pdu.message.tx_data.seq_nbr);
+		} else if (req) {
+			uint64_t rtt_mdm_ticks = params->time - req_tx_time;
+
+			dect_common_hdr_hist_record(&ping_data.rx_metrics.rx_rtt_hist,
+						    DECT_PHY_PING_MDM_TICKS_TO_US(rtt_mdm_ticks));
+			req->in_use = false;
+
+			if (!dect_phy_ping_client_is_pipelined()) {
+				desh_print("ping response for seq_nbr %d (RTT: %d msec)",
+					   pdu.message.tx_data.seq_nbr,
+					   (uint32_t)MODEM_TICKS_TO_MS(rtt_mdm_ticks));
 			}
-
-			desh_print("ping response for seq_nbr %d (%s)", pdu.message.tx_data.seq_nbr,
-				   tmp_str);
-			ping_data.client_data.tx_ping_resp_received = true;
-
 		} else {
-			desh_warn("ping response for unexpected seq_nbr %d (expected: %d)",
-				  pdu.message.tx_data.seq_nbr,
-				  (ping_data.client_data.tx_next_seq_nbr - 1));
-			ping_data.client_data.tx_ping_req_tx_scheduled_mdm_ticks = -1;
+			desh_warn("ping response for unexpected seq_nbr %d (not outstanding)",
+				  pdu.message.tx_data.seq_nbr);
 			ping_data.rx_metrics.rx_out_of_seq_count++;
 		}
 		ping_data.rx_metrics.rx_total_data_amount += params->data_length;
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+#include <time.h>
+
+#include "desh_print.h"
+#include "dect_common.h"
+#include "dect_app_time.h"
+#include "dect_phy_common.h"
+#include "dect_phy_mac_pdu.h"
+#include "dect_phy_mac_cluster_beacon.h"
+#include "dect_phy_mac_nbr_bg_scan.h"
+#include "dect_phy_mac_nbr.h"
+
+/* Neighbor table host benchmark: insert, update (a received beacon of a known neighbor),
+ * lookup and channel lookup at 16, 128 and 1024 stored neighbors. Times are host time per
+ * operation. Random picks with a fixed seed, so that runs are comparable.
+ */
+#define NBR_BENCH_SEED		  0x5eed0026
+#define NBR_BENCH_ROUNDS	  100000
+#define NBR_BENCH_LONG_RD_ID_BASE 0x1000
+#define NBR_BENCH_CHANNEL_COUNT	  11
+
+BUILD_ASSERT(DECT_PHY_MAC_NBR_TABLE_SIZE >= 1024, "Table sized for the largest benchmark");
+
+extern struct k_mutex nbr_list_mutex;
+
+static uint32_t test_state;
+static uint64_t bench_modem_time;
+
+static uint32_t bg_scan_update_count;
+
+void desh_fprintf(enum desh_print_level print_level, const char *fmt, ...)
+{
+	ARG_UNUSED(print_level);
+	ARG_UNUSED(fmt);
+}
+
+uint64_t dect_app_modem_time_now(void)
+{
+	return bench_modem_time;
+}
+
+int64_t dect_phy_mac_cluster_beacon_rcv_time_shift_calculate(
+	dect_phy_mac_cluster_beacon_period_t interval, uint64_t last_rcv_time,
+	uint64_t now_rcv_time)
+{
+	return 0;
+}
+
+/* Background scan is updated after the neighbor table has been released */
+void dect_phy_mac_nbr_bg_scan_rcv_time_shift_update(uint32_t nbr_long_rd_id, uint64_t time_rcvd,
+						    int64_t time_shift_mdm_ticks)
+{
+	zassert_equal(nbr_list_mutex.lock_count, 0, "bg scan updated with nbr_list_mutex held");
+	bg_scan_update_count++;
+}
+
+void dect_phy_mac_nbr_bg_scan_next_channel_update(uint32_t nbr_long_rd_id, uint16_t next_channel)
+{
+	zassert_equal(nbr_list_mutex.lock_count, 0, "bg scan updated with nbr_list_mutex held");
+}
+
+void dect_phy_mac_nbr_bg_scan_status_print_for_target_long_rd_id(uint32_t long_rd_id)
+{
+}
+
+static uint32_t nbr_bench_rand(void)
+{
+	/* xorshift32 */
+	test_state ^= test_state << 13;
+	test_state ^= test_state >> 17;
+	test_state ^= test_state << 5;
+	return test_state;
+}
+
+static uint64_t nbr_bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * NSEC_PER_SEC) + ts.tv_nsec;
+}
+
+static uint16_t nbr_bench_channel(uint32_t nbr_idx)
+{
+	return 1657 + (2 * (nbr_idx % NBR_BENCH_CHANNEL_COUNT));
+}
+
+/* Beyond the table size stronger than all before: eviction must pick an earlier one */
+static int16_t nbr_bench_rssi(uint32_t nbr_idx)
+{
+	return (nbr_idx < DECT_PHY_MAC_NBR_TABLE_SIZE) ? -60 - (nbr_idx % 40) : -50;
+}
+
+static bool nbr_bench_store(uint32_t nbr_idx)
+{
+	uint32_t long_rd_id = NBR_BENCH_LONG_RD_ID_BASE + nbr_idx;
+	dect_phy_mac_cluster_beacon_t beacon_msg = {
+		.cluster_beacon_period = DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_100MS,
+		.next_channel_bit = (nbr_idx & 1),
+		.next_cluster_channel = nbr_bench_channel(nbr_idx + 1),
+	};
+	dect_phy_mac_random_access_resource_ie_t ra_ie = { 0 };
+
+	bench_modem_time++;
+	return dect_phy_mac_nbr_info_store_n_update(
+		&bench_modem_time, nbr_bench_channel(nbr_idx), 0x123456, 0x78, long_rd_id,
+		(uint16_t)long_rd_id, &beacon_msg, &ra_ie, nbr_bench_rssi(nbr_idx), false);
+}
+
+static void nbr_bench_run(uint32_t nbr_count)
+{
+	struct dect_phy_mac_nbr_info_list_item nbr;
+	uint64_t insert_ns, update_ns, lookup_ns, miss_ns, channel_ns;
+	uint64_t start_ns;
+
+	test_state = NBR_BENCH_SEED;
+	bench_modem_time = MS_TO_MODEM_TICKS((uint64_t)1000);
+	bg_scan_update_count = 0;
+	dect_phy_mac_nbr_info_clear_all();
+
+	start_ns = nbr_bench_now_ns();
+	for (uint32_t i = 0; i < nbr_count; i++) {
+		zassert_true(nbr_bench_store(i), "%u nbrs: insert %u failed", nbr_count, i);
+	}
+	insert_ns = nbr_bench_now_ns() - start_ns;
+
+	start_ns = nbr_bench_now_ns();
+	for (uint32_t i = 0; i < NBR_BENCH_ROUNDS; i++) {
+		zassert_true(nbr_bench_store(nbr_bench_rand() % nbr_count), "%u nbrs: update failed",
+			     nbr_count);
+	}
+	update_ns = nbr_bench_now_ns() - start_ns;
+	zassert_equal(bg_scan_update_count, NBR_BENCH_ROUNDS, "%u nbrs: bg scan updates %u",
+		      nbr_count, bg_scan_update_count);
+
+	start_ns = nbr_bench_now_ns();
+	for (uint32_t i = 0; i < NBR_BENCH_ROUNDS; i++) {
+		uint32_t long_rd_id = NBR_BENCH_LONG_RD_ID_BASE + (nbr_bench_rand() % nbr_count);
+
+		zassert_true(dect_phy_mac_nbr_info_copy_by_long_rd_id(long_rd_id, &nbr),
+			     "%u nbrs: %u not found", nbr_count, long_rd_id);
+		zassert_equal(nbr.long_rd_id, long_rd_id, "%u nbrs: %u copied as %u", nbr_count,
+			      long_rd_id, nbr.long_rd_id);
+	}
+	lookup_ns = nbr_bench_now_ns() - start_ns;
+
+	start_ns = nbr_bench_now_ns();
+	for (uint32_t i = 0; i < NBR_BENCH_ROUNDS; i++) {
+		uint32_t long_rd_id =
+			NBR_BENCH_LONG_RD_ID_BASE + nbr_count + (nbr_bench_rand() % 0x10000000);
+
+		zassert_false(dect_phy_mac_nbr_info_copy_by_long_rd_id(long_rd_id, &nbr),
+			      "%u nbrs: %u found", nbr_count, long_rd_id);
+	}
+	miss_ns = nbr_bench_now_ns() - start_ns;
+
+	start_ns = nbr_bench_now_ns();
+	for (uint32_t i = 0; i < NBR_BENCH_ROUNDS; i++) {
+		/* Odd channels of the band: every 2nd one is not in use */
+		uint16_t channel = 1657 + (nbr_bench_rand() % (2 * NBR_BENCH_CHANNEL_COUNT));
+
+		zassert_equal(dect_phy_mac_nbr_is_in_channel(channel),
+			      ((channel - 1657) % 2) == 0 &&
+				      (nbr_count >= NBR_BENCH_CHANNEL_COUNT ||
+				       (channel - 1657) / 2 < nbr_count),
+			      "%u nbrs: channel %u", nbr_count, channel);
+	}
+	channel_ns = nbr_bench_now_ns() - start_ns;
+
+	TC_PRINT("%4u nbrs: insert %llu ns, update %llu ns, lookup %llu ns, miss %llu ns, "
+		 "in channel %llu ns\n",
+		 nbr_count, (unsigned long long)(insert_ns / nbr_count),
+		 (unsigned long long)(update_ns / NBR_BENCH_ROUNDS),
+		 (unsigned long long)(lookup_ns / NBR_BENCH_ROUNDS),
+		 (unsigned long long)(miss_ns / NBR_BENCH_ROUNDS),
+		 (unsigned long long)(channel_ns / NBR_BENCH_ROUNDS));
+}
+
+ZTEST(mac_nbr_bench, test_16_nbrs)
+{
+	nbr_bench_run(16);
+}
+
+ZTEST(mac_nbr_bench, test_128_nbrs)
+{
+	nbr_bench_run(128);
+}
+
+ZTEST(mac_nbr_bench, test_1024_nbrs)
+{
+	nbr_bench_run(1024);
+}
+
+/* New neighbors into a full table evict old ones instead of being dropped */
+ZTEST(mac_nbr_bench, test_full_table_eviction)
+{
+	struct dect_phy_mac_nbr_info_list_item nbr;
+	uint64_t start_ns;
+
+	bench_modem_time = MS_TO_MODEM_TICKS((uint64_t)1000);
+	dect_phy_mac_nbr_info_clear_all();
+	for (uint32_t i = 0; i < DECT_PHY_MAC_NBR_TABLE_SIZE; i++) {
+		zassert_true(nbr_bench_store(i), "insert %u failed", i);
+	}
+
+	start_ns = nbr_bench_now_ns();
+	for (uint32_t i = DECT_PHY_MAC_NBR_TABLE_SIZE; i < 2 * DECT_PHY_MAC_NBR_TABLE_SIZE; i++) {
+		zassert_true(nbr_bench_store(i), "insert %u into a full table failed", i);
+	}
+	TC_PRINT("%4u nbrs: insert with eviction %llu ns\n", DECT_PHY_MAC_NBR_TABLE_SIZE,
+		 (unsigned long long)((nbr_bench_now_ns() - start_ns) /
+				      DECT_PHY_MAC_NBR_TABLE_SIZE));
+
+	for (uint32_t i = DECT_PHY_MAC_NBR_TABLE_SIZE; i < 2 * DECT_PHY_MAC_NBR_TABLE_SIZE; i++) {
+		zassert_true(dect_phy_mac_nbr_info_copy_by_long_rd_id(
+				     NBR_BENCH_LONG_RD_ID_BASE + i, &nbr),
+			     "newest %u not found", i);
+	}
+}
+
+ZTEST_SUITE(mac_nbr_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#include "dect_common.h"
+#include "dect_common_utils.h"
+#include "dect_phy_mac_pdu.h"
+
+/* Host fuzzing of the MAC SDU decoder with a fixed seed, so that failures are reproducible.
+ * Input is placed at the end of the buffer: with ASAN, any read past payload_len is caught.
+ */
+#define MAC_PDU_FUZZ_SEED	     0x2ec7a5e1
+#define MAC_PDU_FUZZ_RANDOM_ROUNDS   2000
+#define MAC_PDU_FUZZ_MUX_ROUNDS	     5000
+#define MAC_PDU_FUZZ_MUX_MAX_SDUS    8
+
+static uint32_t fuzz_state;
+static uint8_t fuzz_buf[DECT_DATA_MAX_LEN];
+
+static uint32_t mac_pdu_fuzz_rand(void)
+{
+	/* xorshift32 */
+	fuzz_state ^= fuzz_state << 13;
+	fuzz_state ^= fuzz_state >> 17;
+	fuzz_state ^= fuzz_state << 5;
+	return fuzz_state;
+}
+
+static void mac_pdu_fuzz_rand_fill(uint8_t *ptr, uint32_t len)
+{
+	for (uint32_t i = 0; i < len; i++) {
+		ptr[i] = (uint8_t)mac_pdu_fuzz_rand();
+	}
+}
+
+static void mac_pdu_fuzz_decode_and_free(uint32_t round, uint8_t *payload_ptr,
+					 uint32_t payload_len)
+{
+	sys_dlist_t sdu_list;
+	sys_dnode_t *node;
+
+	sys_dlist_init(&sdu_list);
+
+	/* Result does not matter, only that decoding stays in bounds */
+	(void)dect_phy_mac_pdu_sdus_decode(payload_ptr, payload_len, &sdu_list);
+
+	while ((node = sys_dlist_get(&sdu_list)) != NULL) {
+		dect_phy_mac_sdu_t *sdu = CONTAINER_OF(node, dect_phy_mac_sdu_t, dnode);
+
+		zassert_true(sdu->mux_header.payload_length <= payload_len,
+			     "round %u: SDU payload length %u > PDU payload length %u", round,
+			     sdu->mux_header.payload_length, payload_len);
+		if (sdu->message_type == DECT_PHY_MAC_MESSAGE_TYPE_DATA_SDU) {
+			zassert_true(sdu->message.data_sdu.data_length < payload_len,
+				     "round %u: data SDU length %u", round,
+				     sdu->message.data_sdu.data_length);
+		}
+		k_free(sdu);
+	}
+}
+
+ZTEST(mac_pdu_fuzz, test_random_buffers)
+{
+	fuzz_state = MAC_PDU_FUZZ_SEED;
+
+	for (uint32_t round = 0; round < MAC_PDU_FUZZ_RANDOM_ROUNDS; round++) {
+		uint32_t len = mac_pdu_fuzz_rand() % (sizeof(fuzz_buf) + 1);
+		uint8_t *payload_ptr = fuzz_buf + sizeof(fuzz_buf) - len;
+
+		mac_pdu_fuzz_rand_fill(payload_ptr, len);
+		mac_pdu_fuzz_decode_and_free(round, payload_ptr, len);
+	}
+}
+
+/* Random bytes are mostly rejected at the 1st MUX header. Here valid looking MUX headers of
+ * all IE types and MAC extensions are chained, with random lengths and payloads, to get into
+ * the IE decoders.
+ */
+ZTEST(mac_pdu_fuzz, test_random_mux_sdus)
+{
+	uint8_t pdu[DECT_DATA_MAX_LEN];
+
+	fuzz_state = MAC_PDU_FUZZ_SEED;
+
+	for (uint32_t round = 0; round < MAC_PDU_FUZZ_MUX_ROUNDS; round++) {
+		uint32_t sdu_count = 1 + mac_pdu_fuzz_rand() % MAC_PDU_FUZZ_MUX_MAX_SDUS;
+		uint8_t *ptr = pdu;
+		uint8_t *end_ptr = pdu + sizeof(pdu);
+
+		for (uint32_t i = 0; i < sdu_count && (end_ptr - ptr) > 4; i++) {
+			uint8_t mac_ext = mac_pdu_fuzz_rand() & DECT_COMMON_UTILS_BIT_MASK_2BIT;
+			uint8_t ie_type = mac_pdu_fuzz_rand() & DECT_COMMON_UTILS_BIT_MASK_6BIT;
+			uint32_t room = end_ptr - ptr - 4;
+			uint16_t len = mac_pdu_fuzz_rand() % MIN(room + 1, 64);
+
+			if (mac_ext == DECT_PHY_MAC_EXT_SHORT_IE) {
+				len = mac_pdu_fuzz_rand() & 1;
+				*ptr++ = (mac_ext << 6) | (len << 5) |
+					 (ie_type & DECT_COMMON_UTILS_BIT_MASK_5BIT);
+			} else {
+				*ptr++ = (mac_ext << 6) | ie_type;
+				if (mac_ext == DECT_PHY_MAC_EXT_8BIT_LEN) {
+					*ptr++ = len;
+				} else if (mac_ext == DECT_PHY_MAC_EXT_16BIT_LEN) {
+					*ptr++ = len >> 8;
+					*ptr++ = len & 0xff;
+					if (ie_type == DECT_PHY_MAC_IE_TYPE_EXTENSION) {
+						*ptr++ = (uint8_t)mac_pdu_fuzz_rand();
+					}
+				}
+			}
+			mac_pdu_fuzz_rand_fill(ptr, len);
+			ptr += len;
+		}
+
+		/* Sometimes cut the PDU in the middle of an SDU */
+		uint32_t len = ptr - pdu;
+
+		if (len && (mac_pdu_fuzz_rand() & 3) == 0) {
+			len = mac_pdu_fuzz_rand() % len;
+		}
+		memcpy(fuzz_buf + sizeof(fuzz_buf) - len, pdu, len);
+		mac_pdu_fuzz_decode_and_free(round, fuzz_buf + sizeof(fuzz_buf) - len, len);
+	}
+}
+
+ZTEST_SUITE(mac_pdu_fuzz, NULL, NULL, NULL, NULL, NULL);
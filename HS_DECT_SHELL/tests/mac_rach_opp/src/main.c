@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#include "dect_common.h"
+#include "dect_phy_common.h"
+#include "dect_phy_mac_pdu.h"
+#include "dect_phy_mac_nbr.h"
+#include "dect_phy_mac_cluster_beacon.h"
+#include "dect_phy_mac_rach_opp.h"
+
+/* Closed-form RACH opportunities vs. a brute-force reference stepping one beacon interval and
+ * one RA repetition at a time, as the client and bg scan did before. Random beacon/RA configs
+ * and start times with a fixed seed, so that failures are reproducible.
+ */
+#define RACH_OPP_TEST_SEED	   0x5eed0030
+#define RACH_OPP_TEST_ROUNDS	   20000
+#define RACH_OPP_TEST_OPP_COUNT	   16
+#define RACH_OPP_TEST_MAX_PERIODS  300
+
+static uint32_t test_state;
+
+/* Own cluster beacon, used by dect_phy_mac_rach_opp_params_from_nbr() for the busy window */
+static bool own_beacon_running;
+static uint64_t own_beacon_last_tx_frame_time;
+static uint32_t own_beacon_period_ms;
+
+bool dect_phy_mac_cluster_beacon_is_running(void)
+{
+	return own_beacon_running;
+}
+
+uint64_t dect_phy_mac_cluster_beacon_last_tx_frame_time_get(void)
+{
+	return own_beacon_last_tx_frame_time;
+}
+
+uint32_t dect_phy_mac_cluster_beacon_period_ms_get(void)
+{
+	return own_beacon_period_ms;
+}
+
+static uint32_t rach_opp_test_rand(void)
+{
+	/* xorshift32 */
+	test_state ^= test_state << 13;
+	test_state ^= test_state >> 17;
+	test_state ^= test_state << 5;
+	return test_state;
+}
+
+static uint64_t rach_opp_test_rand_range(uint64_t max)
+{
+	uint64_t value = ((uint64_t)rach_opp_test_rand() << 32) | rach_opp_test_rand();
+
+	return max ? value % max : 0;
+}
+
+/**************************************************************************************************/
+
+static uint64_t rach_opp_ref_next_beacon_frame_get(uint64_t beacon_rcvd, uint64_t interval,
+						   uint64_t not_before)
+{
+	uint64_t frame_start = beacon_rcvd;
+
+	while (frame_start < not_before) {
+		frame_start += interval;
+	}
+	return frame_start;
+}
+
+/* The old UL opportunity cache loop on the same parameters. Differences to the old loop by
+ * design: the RA window is clipped to the beacon interval, our own beacon window is given by
+ * the params and, as in the iterator, it gives up after DECT_PHY_MAC_RACH_OPP_MAX_SKIPS
+ * excluded RAs in a row.
+ */
+static uint32_t rach_opp_ref_get(const struct dect_phy_mac_rach_opp_params *params,
+				 uint64_t not_before, uint64_t *opps, uint32_t max_count)
+{
+	uint64_t beacon_interval = params->beacon_interval_mdm_ticks;
+	uint64_t ra_interval = params->ra_interval_mdm_ticks;
+	uint64_t ra_offset = params->ra_offset_mdm_ticks;
+	uint64_t ra_window = params->ra_window_mdm_ticks;
+	uint64_t busy_start = params->busy.start_mdm_ticks;
+	uint64_t beacon_frame_start = params->beacon_rcvd_mdm_ticks;
+	uint64_t ra_time;
+	uint32_t count = 0;
+	uint32_t skips = 0;
+
+	if (ra_offset + ra_window >= beacon_interval) {
+		ra_window = beacon_interval - 1 - ra_offset;
+	}
+
+	/* 1st beacon frame whose RA window is not yet over */
+	while (beacon_frame_start + ra_offset + ra_window < not_before) {
+		beacon_frame_start += beacon_interval;
+	}
+
+	ra_time = beacon_frame_start + ra_offset;
+	if (params->skip_first_ra) {
+		ra_time += ra_interval;
+	}
+	while (count < max_count && skips < DECT_PHY_MAC_RACH_OPP_MAX_SKIPS) {
+		if (ra_time > beacon_frame_start + ra_offset + ra_window) {
+			beacon_frame_start += beacon_interval;
+			ra_time = beacon_frame_start + ra_offset;
+			if (params->skip_first_ra && ra_window >= ra_interval) {
+				ra_time += ra_interval;
+			}
+			continue;
+		}
+		if (busy_start) {
+			while (busy_start + params->busy.interval_mdm_ticks <= ra_time) {
+				busy_start += params->busy.interval_mdm_ticks;
+			}
+		}
+		if (ra_time >= not_before) {
+			if (busy_start && ra_time >= busy_start &&
+			    ra_time <= busy_start + params->busy.length_mdm_ticks) {
+				skips++;
+			} else {
+				opps[count++] = ra_time;
+				skips = 0;
+			}
+		}
+		ra_time += ra_interval;
+	}
+	return count;
+}
+
+/**************************************************************************************************/
+
+static void rach_opp_test_nbr_fill(struct dect_phy_mac_nbr_info_list_item *nbr)
+{
+	static const dect_phy_mac_cluster_beacon_period_t periods[] = {
+		DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_10MS,   DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_50MS,
+		DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_100MS,  DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_500MS,
+		DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_1000MS, DECT_PHY_MAC_CLUSTER_BEACON_PERIOD_2000MS,
+	};
+	dect_phy_mac_random_access_resource_ie_t *ra_ie = &nbr->ra_ie;
+
+	memset(nbr, 0, sizeof(*nbr));
+	nbr->time_rcvd_mdm_ticks = 1 + rach_opp_test_rand_range(MS_TO_MODEM_TICKS((uint64_t)100000));
+	nbr->beacon_msg.cluster_beacon_period =
+		periods[rach_opp_test_rand() % ARRAY_SIZE(periods)];
+
+	ra_ie->repeat = rach_opp_test_rand() % DECT_PHY_MAC_RA_REPEAT_TYPE_RESERVED;
+	ra_ie->start_subslot = rach_opp_test_rand() % (DECT_RADIO_FRAME_SUBSLOT_COUNT - 2);
+	ra_ie->validity = 1 + rach_opp_test_rand() % 255;
+	if (ra_ie->repeat == DECT_PHY_MAC_RA_REPEAT_TYPE_FRAMES) {
+		ra_ie->repetition = 1 + rach_opp_test_rand() % 8;
+	} else if (ra_ie->repeat == DECT_PHY_MAC_RA_REPEAT_TYPE_SUBSLOTS) {
+		ra_ie->repetition = 1 + rach_opp_test_rand() % 48;
+	}
+
+	own_beacon_running = rach_opp_test_rand() & 1;
+	own_beacon_period_ms = (1 + rach_opp_test_rand() % 10) * 10;
+	own_beacon_last_tx_frame_time =
+		1 + rach_opp_test_rand_range(nbr->time_rcvd_mdm_ticks);
+}
+
+ZTEST(mac_rach_opp, test_next_beacon_frame)
+{
+	test_state = RACH_OPP_TEST_SEED;
+
+	for (uint32_t round = 0; round < RACH_OPP_TEST_ROUNDS; round++) {
+		uint64_t interval = 1 + rach_opp_test_rand_range(MS_TO_MODEM_TICKS(2000));
+		uint64_t beacon_rcvd =
+			interval + rach_opp_test_rand_range(MS_TO_MODEM_TICKS((uint64_t)100000));
+		uint64_t not_before = beacon_rcvd - rach_opp_test_rand_range(interval) +
+				      rach_opp_test_rand_range(RACH_OPP_TEST_MAX_PERIODS * interval);
+		uint64_t expected =
+			rach_opp_ref_next_beacon_frame_get(beacon_rcvd, interval, not_before);
+
+		zassert_equal(dect_phy_mac_rach_opp_next_beacon_frame_get(beacon_rcvd, interval,
+									  not_before),
+			      expected, "round %u", round);
+	}
+}
+
+ZTEST(mac_rach_opp, test_iter_vs_stepping)
+{
+	struct dect_phy_mac_nbr_info_list_item nbr;
+
+	test_state = RACH_OPP_TEST_SEED;
+
+	for (uint32_t round = 0; round < RACH_OPP_TEST_ROUNDS; round++) {
+		struct dect_phy_mac_rach_opp_params params;
+		struct dect_phy_mac_rach_opp_iter iter;
+		uint64_t expected[RACH_OPP_TEST_OPP_COUNT];
+		uint64_t not_before;
+		uint32_t count;
+		int ret;
+
+		rach_opp_test_nbr_fill(&nbr);
+		ret = dect_phy_mac_rach_opp_params_from_nbr(&nbr, rach_opp_test_rand() & 1,
+							    &params);
+		zassert_equal(ret, 0, "round %u", round);
+
+		not_before = nbr.time_rcvd_mdm_ticks +
+			     rach_opp_test_rand_range(RACH_OPP_TEST_MAX_PERIODS *
+						      params.beacon_interval_mdm_ticks);
+
+		count = rach_opp_ref_get(&params, not_before, expected, ARRAY_SIZE(expected));
+
+		dect_phy_mac_rach_opp_iter_init(&iter, &params, not_before);
+		for (uint32_t i = 0; i < count; i++) {
+			uint64_t opp = dect_phy_mac_rach_opp_iter_next(&iter);
+
+			zassert_equal(opp, expected[i],
+				      "round %u, opp %u: %llu, expected %llu (repeat %d, "
+				      "skip 1st %d, busy %d)",
+				      round, i, (unsigned long long)opp,
+				      (unsigned long long)expected[i], nbr.ra_ie.repeat,
+				      params.skip_first_ra, own_beacon_running);
+		}
+		if (count < ARRAY_SIZE(expected)) {
+			/* Reference gave up: all RAs excluded by our own beacon */
+			zassert_equal(dect_phy_mac_rach_opp_iter_next(&iter), 0,
+				      "round %u: opp after %u, reference gave up", round, count);
+		}
+	}
+}
+
+ZTEST_SUITE(mac_rach_opp, NULL, NULL, NULL, NULL, NULL);